@@ -0,0 +1,420 @@
+/**
+ * @file deriv_bench.cpp
+ * @brief Standalone benchmark for the block derivative kernels.
+ *
+ * Times the compact derivatives (cfd_x/y/z, cfd_xx/yy/zz) of every base
+ * DerType, the compact filters (filter_cfd_x/y/z) of every FilterType and the
+ * explicit stencils (deriv42, deriv644, deriv8642, ko_deriv42/64) on
+ * synthetic blocks, without a mesh or an MPI run.
+ *
+ * The blocks hold u = sin(kx x + 0.3) sin(ky y + 0.7) sin(kz z + 1.1), so the
+ * derivatives are checked against their analytic values on the points that
+ * are not padding. Filters report how much they change u instead.
+ *
+ * The rates are nominal: GF/s counts 2 flops per matrix entry (compact, dense
+ * R) or per stencil point (explicit), GB/s counts one read of u and one write
+ * of the result per point.
+ *
+ * Build with -DEM2_BUILD_BENCHMARKS=ON, and with EM2_DEBUG_COMPACT_DERIVS off
+ * since its NaN checks are part of the timed kernels.
+ *
+ * Usage: em2DerivBench [-n block size] [-p padding width] [-b num blocks]
+ *                      [-r repetitions] [-k wavenumber * dx] [-f bflag]
+ */
+
+#include <mpi.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compact_derivs.h"
+#include "derivs.h"
+
+namespace {
+
+using namespace dendro_cfd;
+
+typedef void (*explicit_kernel_t)(double *const, const double *const,
+                                  const double, const unsigned int *,
+                                  unsigned);
+
+/**@brief: benchmark configuration from the command line*/
+struct BenchConfig {
+    unsigned int n = 13;
+    unsigned int pw = 3;
+    unsigned int num_blocks = 64;
+    unsigned int reps = 50;
+    double kh = 0.25;
+    unsigned int bflag = 0;
+};
+
+/**@brief: synthetic blocks and the analytic derivatives of block 0*/
+struct BenchData {
+    unsigned int sz[3];
+    size_t blk_sz;
+    double dx;
+    std::vector<double> u;    // num_blocks copies of the field
+    std::vector<double> out;  // num_blocks outputs
+    std::vector<double> work;
+    // analytic values, indexed by direction then derivative order
+    std::vector<double> exact[3][2];
+};
+
+/**@brief: one benchmarked kernel*/
+struct BenchKernel {
+    std::string name;
+    std::string type;
+    // applies the kernel to one block
+    std::function<void(double *, const double *)> apply;
+    // 0, 1, 2 for x, y, z
+    unsigned int dir;
+    // 1st or 2nd derivative, 0 for filters/dissipation (no analytic check)
+    unsigned int order;
+    // filters modify their input in place
+    bool in_place;
+    double flops_per_pt;
+};
+
+void print_usage(const char *prog) {
+    std::printf(
+        "Usage: %s [-n block size] [-p padding width] [-b num blocks]\n"
+        "          [-r repetitions] [-k wavenumber * dx] [-f bflag]\n",
+        prog);
+}
+
+BenchConfig parse_args(int argc, char **argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            throw std::invalid_argument(std::string("missing value for ") +
+                                        argv[i]);
+        }
+        const std::string flag(argv[i]);
+        const char *val = argv[++i];
+        if (flag == "-n")
+            cfg.n = std::atoi(val);
+        else if (flag == "-p")
+            cfg.pw = std::atoi(val);
+        else if (flag == "-b")
+            cfg.num_blocks = std::atoi(val);
+        else if (flag == "-r")
+            cfg.reps = std::atoi(val);
+        else if (flag == "-k")
+            cfg.kh = std::atof(val);
+        else if (flag == "-f")
+            cfg.bflag = std::atoi(val);
+        else {
+            print_usage(argv[0]);
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+
+    if (cfg.n < 2 * cfg.pw + 1 || cfg.num_blocks == 0 || cfg.reps == 0) {
+        throw std::invalid_argument(
+            "block size must be at least 2 * padding + 1, and the number of "
+            "blocks and repetitions must be positive");
+    }
+    return cfg;
+}
+
+void fill_data(const BenchConfig &cfg, BenchData &data) {
+    const unsigned int n = cfg.n;
+    const unsigned int nx = n, ny = n;
+    data.sz[0] = data.sz[1] = data.sz[2] = n;
+    data.blk_sz = (size_t)n * n * n;
+    data.dx = 1.0 / (n - 1);
+
+    const double k[3] = {cfg.kh / data.dx, 0.8 * cfg.kh / data.dx,
+                         0.6 * cfg.kh / data.dx};
+    const double phase[3] = {0.3, 0.7, 1.1};
+
+    data.u.resize(data.blk_sz * cfg.num_blocks);
+    data.out.resize(data.blk_sz * cfg.num_blocks);
+    data.work.resize(data.blk_sz);
+    for (unsigned int d = 0; d < 3; d++)
+        for (unsigned int o = 0; o < 2; o++) data.exact[d][o].resize(n * n * n);
+
+    for (unsigned int kk = 0; kk < n; kk++) {
+        for (unsigned int j = 0; j < n; j++) {
+            for (unsigned int i = 0; i < n; i++) {
+                const unsigned int idx[3] = {i, j, kk};
+                double s[3], c[3];
+                for (unsigned int d = 0; d < 3; d++) {
+                    const double arg = k[d] * idx[d] * data.dx + phase[d];
+                    s[d] = std::sin(arg);
+                    c[d] = std::cos(arg);
+                }
+                const unsigned int pp = INDEX_3D(i, j, kk);
+                const double u = s[0] * s[1] * s[2];
+                data.u[pp] = u;
+                data.exact[0][0][pp] = k[0] * c[0] * s[1] * s[2];
+                data.exact[1][0][pp] = k[1] * s[0] * c[1] * s[2];
+                data.exact[2][0][pp] = k[2] * s[0] * s[1] * c[2];
+                for (unsigned int d = 0; d < 3; d++)
+                    data.exact[d][1][pp] = -k[d] * k[d] * u;
+            }
+        }
+    }
+
+    for (unsigned int b = 1; b < cfg.num_blocks; b++)
+        std::memcpy(data.u.data() + b * data.blk_sz, data.u.data(),
+                    data.blk_sz * sizeof(double));
+}
+
+/**@brief: max abs difference over the non-padding points, relative to the
+ * max abs of the reference*/
+double rel_error(const BenchConfig &cfg, const double *val,
+                 const double *ref) {
+    const unsigned int n = cfg.n;
+    const unsigned int nx = n, ny = n;
+    double err = 0.0, nrm = 0.0;
+    for (unsigned int k = cfg.pw; k < n - cfg.pw; k++)
+        for (unsigned int j = cfg.pw; j < n - cfg.pw; j++)
+            for (unsigned int i = cfg.pw; i < n - cfg.pw; i++) {
+                const unsigned int pp = INDEX_3D(i, j, k);
+                err = std::max(err, std::fabs(val[pp] - ref[pp]));
+                nrm = std::max(nrm, std::fabs(ref[pp]));
+            }
+    return (nrm > 0.0) ? err / nrm : err;
+}
+
+void run_kernel(const BenchConfig &cfg, BenchData &data,
+                const BenchKernel &kernel) {
+    const size_t blk_sz = data.blk_sz;
+    std::vector<double> pristine;
+    if (kernel.in_place) pristine = data.u;
+
+    auto sweep = [&]() {
+        for (unsigned int b = 0; b < cfg.num_blocks; b++) {
+            if (kernel.in_place)
+                kernel.apply(data.u.data() + b * blk_sz, nullptr);
+            else
+                kernel.apply(data.out.data() + b * blk_sz,
+                             data.u.data() + b * blk_sz);
+        }
+    };
+
+    // warm up, also the result that gets checked
+    sweep();
+    double err = -1.0;
+    if (kernel.in_place)
+        err = rel_error(cfg, data.u.data(), pristine.data());
+    else if (kernel.order > 0)
+        err = rel_error(cfg, data.out.data(),
+                        data.exact[kernel.dir][kernel.order - 1].data());
+
+    // filters are timed on their own output, it stays smooth
+    const double t1 = MPI_Wtime();
+    for (unsigned int r = 0; r < cfg.reps; r++) sweep();
+    const double t = MPI_Wtime() - t1;
+
+    if (kernel.in_place) data.u = pristine;
+
+    const double pts = (double)blk_sz * cfg.num_blocks * cfg.reps;
+    const double gflops = kernel.flops_per_pt * pts / t * 1e-9;
+    const double gbytes = 2.0 * sizeof(double) * pts / t * 1e-9;
+
+    if (err >= 0.0)
+        std::printf("%-14s %-18s %9.3f %9.3f %9.3f %12.3e\n",
+                    kernel.name.c_str(), kernel.type.c_str(), gflops, gbytes,
+                    t / pts * 1e9, err);
+    else
+        std::printf("%-14s %-18s %9.3f %9.3f %9.3f %12s\n",
+                    kernel.name.c_str(), kernel.type.c_str(), gflops, gbytes,
+                    t / pts * 1e9, "-");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+
+    BenchConfig cfg;
+    try {
+        cfg = parse_args(argc, argv);
+    } catch (const std::exception &e) {
+        std::printf("%s\n", e.what());
+        MPI_Finalize();
+        return 1;
+    }
+
+    BenchData data;
+    fill_data(cfg, data);
+    const double dx = data.dx;
+    const unsigned int *sz = data.sz;
+    const unsigned int bflag = cfg.bflag;
+
+    std::printf(
+        "block size %u, padding %u, %u blocks, %u reps, k*dx %.3f, bflag "
+        "%u\n\n",
+        cfg.n, cfg.pw, cfg.num_blocks, cfg.reps, cfg.kh, cfg.bflag);
+    std::printf("%-14s %-18s %9s %9s %9s %12s\n", "kernel", "type", "GF/s",
+                "GB/s", "ns/pt", "rel err");
+
+    // the compact operators, one object per base type
+    const DerType der_types[] = {CFD_P1_O4,    CFD_P1_O6,    CFD_Q1_O6_ETA1,
+                                 CFD_KIM_O4,   CFD_HAMR_O4,  CFD_JT_O6,
+                                 EXPLCT_FD_O4, EXPLCT_FD_O6, EXPLCT_FD_O8};
+    // second derivative matching each entry above (KIM/HAMR/JT have none)
+    const DerType2nd der2_types[] = {
+        CFD2ND_P2_O4,    CFD2ND_P2_O6,    CFD2ND_Q2_O6_ETA1,
+        CFD2ND_NONE,     CFD2ND_NONE,     CFD2ND_NONE,
+        EXPLCT2ND_FD_O4, EXPLCT2ND_FD_O6, EXPLCT2ND_FD_O8};
+    const FilterType filt_types[] = {FILT_KO_DISS, FILT_KIM_6,
+                                     FILT_JT_6,    FILT_JT_8,
+                                     FILT_JT_10,   FILT_SBP_FILTER,
+                                     EXPLCT_KO};
+
+    const double cfd_flops = 2.0 * cfg.n;
+
+    for (unsigned int t = 0; t < sizeof(der_types) / sizeof(DerType); t++) {
+        const DerType type = der_types[t];
+        const DerType2nd type2 = der2_types[t];
+        const std::string name = DER_TYPE_NAMES[type + 1];
+
+        std::unique_ptr<CompactFiniteDiff> c;
+        try {
+            c.reset(new CompactFiniteDiff(cfg.n, cfg.pw, type, type2,
+                                          FILT_NONE));
+        } catch (const std::exception &e) {
+            std::printf("%-14s %-18s skipped: %s\n", "cfd", name.c_str(),
+                        e.what());
+            continue;
+        }
+        CompactFiniteDiff *cp = c.get();
+
+        std::vector<BenchKernel> kernels = {
+            {"cfd_x", name,
+             [=](double *o, const double *u) {
+                 cp->cfd_x(o, u, dx, sz, bflag);
+             },
+             0, 1, false, cfd_flops},
+            {"cfd_y", name,
+             [=](double *o, const double *u) {
+                 cp->cfd_y(o, u, dx, sz, bflag);
+             },
+             1, 1, false, cfd_flops},
+            {"cfd_z", name,
+             [=](double *o, const double *u) {
+                 cp->cfd_z(o, u, dx, sz, bflag);
+             },
+             2, 1, false, cfd_flops},
+        };
+        if (type2 != CFD2ND_NONE) {
+            const std::string name2 = DER_TYPE_2ND_NAMES[type2 + 1];
+            kernels.push_back(
+                {"cfd_xx", name2,
+                 [=](double *o, const double *u) {
+                     cp->cfd_xx(o, u, dx, sz, bflag);
+                 },
+                 0, 2, false, cfd_flops});
+            kernels.push_back(
+                {"cfd_yy", name2,
+                 [=](double *o, const double *u) {
+                     cp->cfd_yy(o, u, dx, sz, bflag);
+                 },
+                 1, 2, false, cfd_flops});
+            kernels.push_back(
+                {"cfd_zz", name2,
+                 [=](double *o, const double *u) {
+                     cp->cfd_zz(o, u, dx, sz, bflag);
+                 },
+                 2, 2, false, cfd_flops});
+        }
+
+        for (const auto &kernel : kernels) run_kernel(cfg, data, kernel);
+    }
+
+    // the compact filters
+    for (const FilterType type : filt_types) {
+        const std::string name = FILT_TYPE_NAMES[type + 1];
+
+        std::unique_ptr<CompactFiniteDiff> c;
+        try {
+            c.reset(new CompactFiniteDiff(cfg.n, cfg.pw, CFD_NONE,
+                                          CFD2ND_NONE, type));
+        } catch (const std::exception &e) {
+            std::printf("%-14s %-18s skipped: %s\n", "filter_cfd", name.c_str(),
+                        e.what());
+            continue;
+        }
+        CompactFiniteDiff *cp = c.get();
+        double *work = data.work.data();
+
+        const BenchKernel kernels[] = {
+            {"filter_cfd_x", name,
+             [=](double *u, const double *) {
+                 cp->filter_cfd_x(u, work, dx, sz, bflag);
+             },
+             0, 0, true, cfd_flops},
+            {"filter_cfd_y", name,
+             [=](double *u, const double *) {
+                 cp->filter_cfd_y(u, work, dx, sz, bflag);
+             },
+             1, 0, true, cfd_flops},
+            {"filter_cfd_z", name,
+             [=](double *u, const double *) {
+                 cp->filter_cfd_z(u, work, dx, sz, bflag);
+             },
+             2, 0, true, cfd_flops},
+        };
+        for (const auto &kernel : kernels) run_kernel(cfg, data, kernel);
+    }
+
+    // the explicit stencils, only the ones that fit the padding width
+    struct ExplicitEntry {
+        const char *name;
+        explicit_kernel_t fn;
+        unsigned int dir;
+        unsigned int order;
+        unsigned int pw;
+        unsigned int stencil_pts;
+    };
+    const ExplicitEntry explicit_kernels[] = {
+        {"deriv42_x", deriv42_x, 0, 1, 3, 4},
+        {"deriv42_y", deriv42_y, 1, 1, 3, 4},
+        {"deriv42_z", deriv42_z, 2, 1, 3, 4},
+        {"deriv42_xx", deriv42_xx, 0, 2, 3, 5},
+        {"deriv42_yy", deriv42_yy, 1, 2, 3, 5},
+        {"deriv42_zz", deriv42_zz, 2, 2, 3, 5},
+        {"deriv644_x", deriv644_x, 0, 1, 3, 6},
+        {"deriv644_y", deriv644_y, 1, 1, 3, 6},
+        {"deriv644_z", deriv644_z, 2, 1, 3, 6},
+        {"deriv644_xx", deriv644_xx, 0, 2, 3, 7},
+        {"deriv644_yy", deriv644_yy, 1, 2, 3, 7},
+        {"deriv644_zz", deriv644_zz, 2, 2, 3, 7},
+        {"ko_deriv42_x", ko_deriv42_x, 0, 0, 3, 7},
+        {"ko_deriv42_y", ko_deriv42_y, 1, 0, 3, 7},
+        {"ko_deriv42_z", ko_deriv42_z, 2, 0, 3, 7},
+        {"deriv8642_x", deriv8642_x, 0, 1, 4, 8},
+        {"deriv8642_y", deriv8642_y, 1, 1, 4, 8},
+        {"deriv8642_z", deriv8642_z, 2, 1, 4, 8},
+        {"deriv8642_xx", deriv8642_xx, 0, 2, 4, 9},
+        {"deriv8642_yy", deriv8642_yy, 1, 2, 4, 9},
+        {"deriv8642_zz", deriv8642_zz, 2, 2, 4, 9},
+        {"ko_deriv64_x", ko_deriv64_x, 0, 0, 4, 9},
+        {"ko_deriv64_y", ko_deriv64_y, 1, 0, 4, 9},
+        {"ko_deriv64_z", ko_deriv64_z, 2, 0, 4, 9},
+    };
+
+    for (const auto &e : explicit_kernels) {
+        if (e.pw != cfg.pw) continue;
+        const explicit_kernel_t fn = e.fn;
+        const BenchKernel kernel = {
+            e.name, "explicit",
+            [=](double *o, const double *u) { fn(o, u, dx, sz, bflag); },
+            e.dir, e.order, false, 2.0 * e.stencil_pts};
+        run_kernel(cfg, data, kernel);
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file rhs_bench.cpp
+ * @brief Single-block RHS benchmark, without a mesh or a ghost exchange.
+ *
+ * Fills padded blocks with the analytic initial data (analyticalSolEM2) and
+ * calls the per-block RHS the solver uses (solverrhs_compact_derivs with
+ * EM2_ENABLE_COMPACT_DERIVS, solverrhs otherwise) on them directly. For each
+ * block size it reports the time per block, the split between derivatives
+ * (t_deriv), RHS evaluation (t_rhs) and boundary conditions (t_bdyc), and the
+ * number of interior points updated per second.
+ *
+ * The block sizes are the unzipped sizes of a block of 2^l elements per side,
+ * ELE_ORDER * 2^l + 1 + 2 * PW for l = 0 .. L. The blocks are centered on
+ * (x0, x0, x0) with grid spacing h.
+ *
+ * The blocks are handed out to the threads like solverRHS does, so the
+ * throughput includes the OpenMP scaling. The timers only follow thread 0
+ * (see timer::start_master), the split is thread 0's share of the work.
+ *
+ * Build with -DEM2_BUILD_BENCHMARKS=ON.
+ *
+ * Usage: em2RhsBench paramFile [-L max level] [-b num blocks]
+ *                    [-r repetitions] [-h grid spacing] [-x block center]
+ */
+
+#include <mpi.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "compact_derivs.h"
+#include "derivs.h"
+#include "grUtils.h"
+#include "parameters.h"
+#include "profile_params.h"
+#include "rhs.h"
+
+namespace {
+
+/**@brief: benchmark configuration from the command line*/
+struct BenchConfig {
+    unsigned int max_level = 2;
+    unsigned int num_blocks = 16;
+    unsigned int reps = 5;
+    double h = 0.05;
+    double x0 = 0.0;
+};
+
+/**@brief: timings of one block size and boundary flag*/
+struct BenchResult {
+    double t_total;
+    double t_deriv;
+    double t_rhs;
+    double t_bdyc;
+};
+
+void print_usage(const char *prog) {
+    printf(
+        "Usage: %s paramFile [-L max level] [-b num blocks] "
+        "[-r repetitions]\n"
+        "       [-h grid spacing] [-x block center]\n",
+        prog);
+}
+
+bool parse_args(int argc, char **argv, BenchConfig &cfg) {
+    for (int i = 2; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (!strcmp(argv[i], "-L"))
+            cfg.max_level = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b"))
+            cfg.num_blocks = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r"))
+            cfg.reps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-h"))
+            cfg.h = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-x"))
+            cfg.x0 = atof(argv[++i]);
+        else
+            return false;
+    }
+    return cfg.num_blocks > 0 && cfg.reps > 0 && cfg.h > 0.0;
+}
+
+/**@brief: same compact/explicit derivative setup as the SOLVERCtx*/
+void setup_derivs() {
+#ifdef EM2_ENABLE_COMPACT_DERIVS
+    dendro_cfd::cfd.set_filter_type(dsolve::SOLVER_FILTER_TYPE);
+    dendro_cfd::cfd.set_deriv_type(dsolve::SOLVER_DERIV_TYPE);
+    dendro_cfd::cfd.set_second_deriv_type(dsolve::SOLVER_2ND_DERIV_TYPE);
+    dendro_cfd::cfd.set_padding_size(dsolve::SOLVER_PADDING_WIDTH);
+    dendro_cfd::cfd.set_kim_params(dsolve::SOLVER_KIM_FILTER_KC,
+                                   dsolve::SOLVER_KIM_FILTER_EPS);
+    dendro_cfd::cfd.set_deriv_boundary_type(dsolve::SOLVER_DERIV_CLOSURE_TYPE);
+    dendro_cfd::cfd.change_dim_size(2 * dsolve::SOLVER_ELE_ORDER + 1);
+#endif
+
+    dendro_derivs::set_appropriate_derivs(dsolve::SOLVER_PADDING_WIDTH);
+}
+
+/**
+ * @brief fills num_blocks copies of a block with the analytic initial data
+ * @param[out] vars: SOLVER_NUM_VARS arrays of num_blocks * n^3 values
+ * @param[in] n: block size (with padding)
+ * @param[in] num_blocks: number of copies
+ * @param[in] pmin: coordinates of the first block point
+ * @param[in] h: grid spacing
+ */
+void fill_blocks(std::vector<std::vector<double>> &vars, unsigned int n,
+                 unsigned int num_blocks, const double *pmin, double h) {
+    const size_t blk_sz = (size_t)n * n * n;
+    double var[dsolve::SOLVER_NUM_VARS];
+
+    for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++)
+        vars[v].resize(blk_sz * num_blocks);
+
+    for (unsigned int k = 0; k < n; k++)
+        for (unsigned int j = 0; j < n; j++)
+            for (unsigned int i = 0; i < n; i++) {
+                const double x = pmin[0] + i * h;
+                const double y = pmin[1] + j * h;
+                const double z = pmin[2] + k * h;
+                dsolve::analyticalSolEM2(x, y, z, 0.0, var, false);
+
+                const size_t pp = i + n * (j + n * k);
+                for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++)
+                    for (unsigned int b = 0; b < num_blocks; b++)
+                        vars[v][b * blk_sz + pp] = var[v];
+            }
+}
+
+/**@brief: the block RHS solverRHS calls*/
+void block_rhs(double **rhs, double **u, unsigned int offset,
+               const double *pmin, const double *pmax, const unsigned int *sz,
+               unsigned int bflag) {
+#ifdef EM2_ENABLE_COMPACT_DERIVS
+    solverrhs_compact_derivs(rhs, u, offset, pmin, pmax, sz, bflag);
+#else
+    solverrhs(rhs, (const double **)u, offset, pmin, pmax, sz, bflag);
+#endif
+}
+
+/**
+ * @brief runs the block RHS on all blocks, reps times
+ * @return wall time and the timer deltas of all the repetitions
+ */
+BenchResult run_blocks(double **rhs, double **u, unsigned int n,
+                       unsigned int num_blocks, unsigned int reps,
+                       const double *pmin, const double *pmax,
+                       unsigned int bflag) {
+    const unsigned int sz[3] = {n, n, n};
+    const size_t blk_sz = (size_t)n * n * n;
+
+    const double deriv0 = dsolve::timer::t_deriv.seconds;
+    const double rhs0 = dsolve::timer::t_rhs.seconds;
+    const double bdyc0 = dsolve::timer::t_bdyc.seconds;
+    const double start = MPI_Wtime();
+
+    for (unsigned int r = 0; r < reps; r++) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (unsigned int blk = 0; blk < num_blocks; blk++) {
+            block_rhs(rhs, u, blk * blk_sz, pmin, pmax, sz, bflag);
+        }
+    }
+
+    BenchResult res;
+    res.t_total = MPI_Wtime() - start;
+    res.t_deriv = dsolve::timer::t_deriv.seconds - deriv0;
+    res.t_rhs = dsolve::timer::t_rhs.seconds - rhs0;
+    res.t_bdyc = dsolve::timer::t_bdyc.seconds - bdyc0;
+    return res;
+}
+
+void print_result(unsigned int n, unsigned int bflag, const BenchConfig &cfg,
+                  const BenchResult &res) {
+    const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
+    const double interior = (double)(n - 2 * PW) * (n - 2 * PW) * (n - 2 * PW);
+    const double num_calls = (double)cfg.num_blocks * cfg.reps;
+    const double t_split = res.t_deriv + res.t_rhs + res.t_bdyc;
+
+    // percentages of thread 0's time, see the file description
+    const double f = t_split > 0.0 ? 100.0 / t_split : 0.0;
+
+    printf("%4u %6u %12.4f %8.1f %8.1f %8.1f %10.3f\n", n, bflag,
+           1e3 * res.t_total / num_calls, f * res.t_deriv, f * res.t_rhs,
+           f * res.t_bdyc, 1e-6 * interior * num_calls / res.t_total);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 0;
+    }
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    BenchConfig cfg;
+    if (!parse_args(argc, argv, cfg)) {
+        if (!rank) print_usage(argv[0]);
+        MPI_Finalize();
+        return 1;
+    }
+
+    dsolve::readParamFile(argv[1], comm);
+    dsolve::timer::initFlops();
+    setup_derivs();
+
+    // every rank runs the same benchmark, only rank 0 reports
+    const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
+    const unsigned int max_n =
+        dsolve::SOLVER_ELE_ORDER * (1u << cfg.max_level) + 1 + 2 * PW;
+    dsolve::allocate_deriv_workspace(max_n * max_n * max_n, 1);
+
+    if (!rank) {
+        printf("EM2 block RHS benchmark: ELE_ORDER %u, PW %u, %u blocks, "
+               "%u reps, h %g\n",
+               dsolve::SOLVER_ELE_ORDER, PW, cfg.num_blocks, cfg.reps, cfg.h);
+#ifdef EM2_ENABLE_COMPACT_DERIVS
+        printf("compact derivatives (solverrhs_compact_derivs)\n");
+#else
+        printf("explicit derivatives (solverrhs)\n");
+#endif
+        printf("%4s %6s %12s %8s %8s %8s %10s\n", "n", "bflag", "ms/block",
+               "deriv%", "rhs%", "bdyc%", "Mpts/s");
+    }
+
+    std::vector<std::vector<double>> u_store(dsolve::SOLVER_NUM_VARS);
+    std::vector<std::vector<double>> rhs_store(dsolve::SOLVER_NUM_VARS);
+    double *u[dsolve::SOLVER_NUM_VARS];
+    double *rhs[dsolve::SOLVER_NUM_VARS];
+
+    for (unsigned int l = 0; l <= cfg.max_level; l++) {
+        const unsigned int n =
+            dsolve::SOLVER_ELE_ORDER * (1u << l) + 1 + 2 * PW;
+
+        // padded block centered on x0
+        double pmin[3], pmax[3];
+        for (unsigned int d = 0; d < 3; d++) {
+            pmin[d] = cfg.x0 - 0.5 * (n - 1) * cfg.h;
+            pmax[d] = cfg.x0 + 0.5 * (n - 1) * cfg.h;
+        }
+
+        try {
+#if defined(EM2_ENABLE_COMPACT_DERIVS) && !defined(SOLVER_ENABLE_MERGED_BLOCKS)
+            // without merged blocks the cfd object only holds one size
+            dendro_cfd::cfd.change_dim_size(n);
+#endif
+
+            fill_blocks(u_store, n, cfg.num_blocks, pmin, cfg.h);
+            for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++) {
+                rhs_store[v].assign(u_store[v].size(), 0.0);
+                u[v] = u_store[v].data();
+                rhs[v] = rhs_store[v].data();
+            }
+
+            // interior block, then a block touching all six domain faces
+            const unsigned int bflags[2] = {0, 63};
+            for (unsigned int b = 0; b < 2; b++) {
+                // warm up the workspaces and the memory pools. outside of
+                // the parallel region, so unsupported sizes throw here
+                const unsigned int sz[3] = {n, n, n};
+                block_rhs(rhs, u, 0, pmin, pmax, sz, bflags[b]);
+                run_blocks(rhs, u, n, cfg.num_blocks, 1, pmin, pmax,
+                           bflags[b]);
+                const BenchResult res = run_blocks(
+                    rhs, u, n, cfg.num_blocks, cfg.reps, pmin, pmax, bflags[b]);
+                if (!rank) print_result(n, bflags[b], cfg, res);
+            }
+        } catch (const std::exception &e) {
+            if (!rank)
+                printf("%4u skipped: block size not supported (%s)\n", n,
+                       e.what());
+        }
+    }
+
+    dsolve::deallocate_deriv_workspace();
+
+    MPI_Finalize();
+    return 0;
+}
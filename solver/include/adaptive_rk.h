@@ -0,0 +1,319 @@
+/**
+ * @file adaptive_rk.h
+ * @brief Embedded Runge-Kutta time stepper with error based step size control
+ * for the ts::Ctx based solver.
+ *
+ * Exposes the same interface the main evolution loop uses from ts::ETS. Each
+ * step evaluates the stages of an embedded pair, advances with the higher
+ * order solution and uses the difference to the lower order one as the local
+ * error estimate,
+ *
+ *   err = max |dt * sum_s (B[s] - Bhat[s]) * k_s| / (tol * (1 + |u|))
+ *
+ * with tol = SOLVER_RK45_DESIRED_TOL, over all the variables and nodes. A
+ * step with err > 1 is rejected and retried with a smaller dt. After an
+ * accepted step the next dt comes from a PI controller,
+ *
+ *   dt_new = dt * safety * err^(-0.7 / q) * err_prev^(0.4 / q)
+ *
+ * where q is the order of the lower order solution plus one. The change per
+ * step is limited to [FAC_MIN, FAC_MAX], dt is not grown on the step right
+ * after a rejection and never beyond SOLVER_RK45_DT_MAX_FAC times the CFL
+ * time step SOLVER_RK45_TIME_STEP_SIZE (which follows the remesh).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ctx.h"
+#include "mesh.h"
+#include "parUtils.h"
+#include "parameters.h"
+
+namespace dsolve {
+
+template <typename T, typename Ctx>
+class AdaptiveRK {
+   protected:
+    /**@brief: application context that computes the rhs*/
+    Ctx *m_uiAppCtx;
+
+    /**@brief: rhs of each stage*/
+    std::vector<ot::DVector<T, unsigned int>> m_uiStage;
+
+    /**@brief: stage input, then the new solution until it is accepted*/
+    ot::DVector<T, unsigned int> m_uiTmp;
+
+    /**@brief: Butcher tableau, A is numStages x numStages (row major)*/
+    const double *m_uiA = nullptr;
+    const double *m_uiB = nullptr;
+    const double *m_uiBhat = nullptr;
+    const double *m_uiT = nullptr;
+    unsigned int m_uiNumStages = 0;
+
+    /**@brief: order of the lower order (Bhat) solution*/
+    unsigned int m_uiEstOrder = 4;
+
+    /**@brief: scaled error of the last accepted step*/
+    T m_uiErrPrev = 1.0;
+
+    /**@brief: true if the step right before was rejected*/
+    bool m_uiRejected = false;
+
+    /**@brief: number of rejected steps so far*/
+    DendroIntL m_uiNumRejected = 0;
+
+    /**@brief: allocates the registers on the current ctx mesh*/
+    void allocate_registers() {
+        const ot::Mesh *pMesh = m_uiAppCtx->get_mesh();
+        const unsigned int dof = m_uiAppCtx->get_evolution_vars().get_dof();
+        m_uiStage.resize(m_uiNumStages);
+        for (auto &k : m_uiStage)
+            k.create_vector(pMesh, ot::DVEC_TYPE::OCT_SHARED_NODES,
+                            ot::DVEC_LOC::HOST, dof, true);
+        m_uiTmp.create_vector(pMesh, ot::DVEC_TYPE::OCT_SHARED_NODES,
+                              ot::DVEC_LOC::HOST, dof, true);
+    }
+
+    void destroy_registers() {
+        for (auto &k : m_uiStage) k.destroy_vector();
+        m_uiTmp.destroy_vector();
+    }
+
+    /**
+     * @brief evaluates the stages and the new solution (into m_uiTmp) for a
+     * step of size dt.
+     * @return the scaled error, the same on all ranks.
+     */
+    T attempt_step(const T current_t, const T dt);
+
+   public:
+    /**@brief: limits of dt_new / dt per step*/
+    static constexpr double FAC_MIN = 0.2;
+    static constexpr double FAC_MAX = 5.0;
+
+    /**
+     * @brief Construct a new AdaptiveRK object
+     * @param appCtx : application context, not owned by the stepper.
+     */
+    AdaptiveRK(Ctx *appCtx) : m_uiAppCtx(appCtx) {}
+
+    ~AdaptiveRK() { destroy_registers(); }
+
+    /**
+     * @brief sets the embedded pair to use, the arrays are not copied.
+     * @param A : stage weights, numStages x numStages, row major
+     * @param B : weights of the solution that is propagated
+     * @param Bhat : weights of the embedded solution (numStages entries)
+     * @param Tc : time offsets of each stage in units of dt (Tc[0] is not
+     * read, the first stage is always at t)
+     * @param numStages : number of stages
+     * @param estOrder : order of the embedded (Bhat) solution
+     */
+    void set_coefficients(const double *A, const double *B, const double *Bhat,
+                          const double *Tc, unsigned int numStages,
+                          unsigned int estOrder) {
+        m_uiA = A;
+        m_uiB = B;
+        m_uiBhat = Bhat;
+        m_uiT = Tc;
+        m_uiNumStages = numStages;
+        m_uiEstOrder = estOrder;
+    }
+
+    /**@brief: initializes the ctx (initial data or checkpoint restore) and
+     * allocates the registers*/
+    int init() {
+        m_uiAppCtx->initialize();
+        allocate_registers();
+        return 0;
+    }
+
+    /**@brief: reallocates the registers after the ctx mesh changed*/
+    void sync_with_mesh() {
+        destroy_registers();
+        allocate_registers();
+    }
+
+    T curr_time() { return m_uiAppCtx->get_ts_info()._m_uiT; }
+
+    DendroIntL curr_step() { return m_uiAppCtx->get_ts_info()._m_uiStep; }
+
+    /**@brief: dt of the next step*/
+    T ts_size() { return m_uiAppCtx->get_ts_info()._m_uiTh; }
+
+    DendroIntL num_rejected() { return m_uiNumRejected; }
+
+    bool is_active() { return m_uiAppCtx->get_mesh()->isActive(); }
+
+    unsigned int get_global_rank() {
+        return m_uiAppCtx->get_mesh()->getMPIRankGlobal();
+    }
+
+    MPI_Comm get_global_comm() {
+        return m_uiAppCtx->get_mesh()->getMPIGlobalCommunicator();
+    }
+
+    /**@brief: no internal profiling, kept for interface parity with ETS*/
+    void init_pt() {}
+    void dump_pt(std::ostream &sout) {}
+
+    /**@brief: advances the evolution variables of the ctx by one accepted
+     * step, retrying with smaller dt as needed*/
+    int evolve();
+};
+
+template <typename T, typename Ctx>
+T AdaptiveRK<T, Ctx>::attempt_step(const T current_t, const T dt) {
+    const ot::Mesh *pMesh = m_uiAppCtx->get_mesh();
+    ot::DVector<T, unsigned int> &evar = m_uiAppCtx->get_evolution_vars();
+
+    T err_local = 0.0;
+    if (pMesh->isActive()) {
+        const unsigned int dof = evar.get_dof();
+        const unsigned int nodeLocalBegin = pMesh->getNodeLocalBegin();
+        const unsigned int nodeLocalEnd = pMesh->getNodeLocalEnd();
+        const unsigned int S = m_uiNumStages;
+
+        std::vector<T *> u(dof), tmp(dof);
+        std::vector<std::vector<T *>> k(S, std::vector<T *>(dof));
+        evar.to_2d(u.data());
+        m_uiTmp.to_2d(tmp.data());
+        for (unsigned int s = 0; s < S; s++) m_uiStage[s].to_2d(k[s].data());
+
+        for (unsigned int stage = 0; stage < S; stage++) {
+            ot::DVector<T, unsigned int> *in = &evar;
+            if (stage > 0) {
+                // u_s = u + dt * sum_j A[s][j] k_j
+                const double *a = m_uiA + stage * S;
+                for (unsigned int v = 0; v < dof; v++) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                    for (unsigned int node = nodeLocalBegin;
+                         node < nodeLocalEnd; node++) {
+                        T sum = 0.0;
+                        for (unsigned int j = 0; j < stage; j++)
+                            sum += a[j] * k[j][v][node];
+                        tmp[v][node] = u[v][node] + dt * sum;
+                    }
+                }
+                in = &m_uiTmp;
+            }
+
+            m_uiAppCtx->pre_stage(*in);
+            const T t_stage = (stage == 0) ? current_t
+                                           : current_t + m_uiT[stage] * dt;
+            m_uiAppCtx->rhs(in, &m_uiStage[stage], 1, t_stage);
+            m_uiAppCtx->post_stage(*in);
+        }
+
+        // new solution and the error estimate in one pass
+        const T tol = dsolve::SOLVER_RK45_DESIRED_TOL;
+        for (unsigned int v = 0; v < dof; v++) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(max : err_local)
+#endif
+            for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd;
+                 node++) {
+                T sol = 0.0;
+                T est = 0.0;
+                for (unsigned int s = 0; s < S; s++) {
+                    sol += m_uiB[s] * k[s][v][node];
+                    est += (m_uiB[s] - m_uiBhat[s]) * k[s][v][node];
+                }
+                const T u_old = u[v][node];
+                const T u_new = u_old + dt * sol;
+                tmp[v][node] = u_new;
+
+                const T scale =
+                    tol * (1.0 + std::max(std::fabs(u_old), std::fabs(u_new)));
+                err_local = std::max(err_local, std::fabs(dt * est) / scale);
+            }
+        }
+    }
+
+    // the inactive ranks take part too, they get the same dt
+    T err = 0.0;
+    par::Mpi_Allreduce(&err_local, &err, 1, MPI_MAX, get_global_comm());
+    return err;
+}
+
+template <typename T, typename Ctx>
+int AdaptiveRK<T, Ctx>::evolve() {
+    const ot::Mesh *pMesh = m_uiAppCtx->get_mesh();
+    ts::TSInfo ts_info = m_uiAppCtx->get_ts_info();
+    const T current_t = ts_info._m_uiT;
+    T dt = ts_info._m_uiTh;
+
+    ot::DVector<T, unsigned int> &evar = m_uiAppCtx->get_evolution_vars();
+
+    m_uiAppCtx->pre_timestep(evar);
+
+    // exponents of the PI controller
+    const double q = m_uiEstOrder + 1.0;
+    const double alpha = 0.7 / q;
+    const double beta = 0.4 / q;
+    const double safety = dsolve::SOLVER_SAFETY_FAC;
+
+    T err = attempt_step(current_t, dt);
+    while (!(err <= 1.0)) {
+        // rejected, also for a NaN error: shrink with the plain I controller
+        const double fac =
+            std::isfinite(err)
+                ? std::max(FAC_MIN, safety * std::pow(err, -1.0 / q))
+                : FAC_MIN;
+        dt *= fac;
+        if (dt < 1e-8 * dsolve::SOLVER_RK45_TIME_STEP_SIZE)
+            throw std::runtime_error(
+                "[AdaptiveRK] : time step underflow at step " +
+                std::to_string(ts_info._m_uiStep) + ", t = " +
+                std::to_string(current_t));
+        m_uiRejected = true;
+        m_uiNumRejected++;
+        if (!get_global_rank())
+            std::cout << "[AdaptiveRK] : step " << ts_info._m_uiStep
+                      << " rejected (error " << err << "), retrying with dt "
+                      << dt << std::endl;
+        err = attempt_step(current_t, dt);
+    }
+
+    if (pMesh->isActive()) {
+        const unsigned int dof = evar.get_dof();
+        const unsigned int nodeLocalBegin = pMesh->getNodeLocalBegin();
+        const unsigned int nodeLocalEnd = pMesh->getNodeLocalEnd();
+        std::vector<T *> u(dof), tmp(dof);
+        evar.to_2d(u.data());
+        m_uiTmp.to_2d(tmp.data());
+        for (unsigned int v = 0; v < dof; v++)
+            std::copy(tmp[v] + nodeLocalBegin, tmp[v] + nodeLocalEnd,
+                      u[v] + nodeLocalBegin);
+    }
+
+    m_uiAppCtx->post_timestep(evar);
+
+    // PI controller for the next step, err is floored so a (near) exact step
+    // only grows dt by FAC_MAX
+    const double err_c = std::max(err, (T)1e-10);
+    double fac = safety * std::pow(err_c, -alpha) * std::pow(m_uiErrPrev, beta);
+    fac = std::min(m_uiRejected ? 1.0 : FAC_MAX, std::max(FAC_MIN, fac));
+    m_uiErrPrev = err_c;
+    m_uiRejected = false;
+
+    ts_info._m_uiT += dt;
+    ts_info._m_uiStep++;
+    ts_info._m_uiTh = std::min(
+        dt * fac,
+        dsolve::SOLVER_RK45_DT_MAX_FAC * dsolve::SOLVER_RK45_TIME_STEP_SIZE);
+    m_uiAppCtx->set_ts_info(ts_info);
+
+    return 0;
+}
+
+}  // namespace dsolve
@@ -0,0 +1,113 @@
+/**
+ * @file checkpointWriter.h
+ * @brief Background writer for the .oct/.var/.cp checkpoint files.
+ *
+ * In async mode a checkpoint is staged by copying the octree and the evolved
+ * variables into buffers owned by the writer. The files are then written by a
+ * dedicated I/O thread while time stepping continues, and the buffers are
+ * released again by flush(). The I/O thread never calls MPI, so
+ * MPI_THREAD_FUNNELED is enough (solver_main asks for it and falls back to
+ * synchronous writes if the MPI library does not provide it). Synchronous
+ * writes read the mesh and the variables in place, without staging.
+ *
+ * The json .cp file is what makes a checkpoint index restorable (the restore
+ * picks the .cp with the newest step). It is only written by rank 0 in
+ * flush(), after every rank has reported that its .oct and .var files for
+ * that index are complete. A new checkpoint always flushes the previous one
+ * first. This keeps the cpIndex 0/1 alternation safe: while index i is being
+ * overwritten, the .cp of index 1 - i is newer and points to complete files.
+ */
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TreeNode.h"
+#include "dendro.h"
+#include "mesh.h"
+#include "mpi.h"
+
+namespace dsolve {
+
+class CheckpointWriter {
+   protected:
+    /**@brief: I/O thread of the checkpoint in flight*/
+    std::thread m_uiIOThread;
+
+    /**@brief: true if a checkpoint was staged but not flushed yet*/
+    bool m_uiIsPending = false;
+
+    /**@brief: mesh the staged checkpoint belongs to*/
+    const ot::Mesh *m_uiMesh = nullptr;
+
+    /**@brief: local octants of the staged checkpoint (async only)*/
+    std::vector<ot::TreeNode> m_uiOctants;
+
+    /**@brief: staged copy of the evolved vars, one mesh vector per var
+     * (async only, freed by flush)*/
+    std::vector<DendroScalar> m_uiStaging;
+
+    unsigned int m_uiNumVars = 0;
+    unsigned int m_uiCpIndex = 0;
+    std::string m_uiPrefix;
+
+    /**@brief: contents of the .cp file, only used on rank 0*/
+    std::string m_uiCpJson;
+
+    /**@brief: local status of the .oct/.var writes (0 on success)*/
+    int m_uiWriteStatus = 0;
+
+    /**
+     * @brief writes the .oct and .var files of this rank
+     * @param[in] octants: local octants
+     * @param[in] numOctants: number of local octants
+     * @param[in] vars: zipped evolution vars (m_uiNumVars mesh vectors)
+     */
+    void write_files(const ot::TreeNode *octants, size_t numOctants,
+                     const DendroScalar *const *vars);
+
+    /**@brief: writes the staged copies, run on the I/O thread*/
+    void write_staged();
+
+   public:
+    CheckpointWriter() = default;
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /**@brief: waits for the I/O thread, the pending checkpoint is not
+     * committed (call flush() for that, it is collective)*/
+    ~CheckpointWriter();
+
+    /**
+     * @brief writes the .oct/.var files of a checkpoint. With async the data
+     * is staged and written in the background, otherwise it is written in
+     * place and committed. Flushes the previous checkpoint first.
+     * Collective on the mesh communicator, call on active ranks only.
+     * @param[in] pMesh: mesh of the vars, must stay alive until flush()
+     * @param[in] vars: zipped evolution vars (numVars mesh vectors)
+     * @param[in] numVars: number of vars
+     * @param[in] cpIndex: checkpoint index (0 or 1)
+     * @param[in] prefix: checkpoint file prefix
+     * @param[in] cpJson: contents of the .cp file (only used on rank 0)
+     * @param[in] async: write from the I/O thread and return right away
+     */
+    void write(const ot::Mesh *pMesh, const DendroScalar *const *vars,
+               unsigned int numVars, unsigned int cpIndex,
+               const std::string &prefix, const std::string &cpJson,
+               bool async);
+
+    /**
+     * @brief waits for the pending checkpoint and commits its .cp file once
+     * every rank wrote its data. Collective on the communicator of the
+     * pending checkpoint's mesh. No-op if nothing is pending.
+     * @return 0 if the checkpoint was committed (or none was pending)
+     */
+    int flush();
+
+    /**@brief: true if a checkpoint is staged and not flushed yet*/
+    bool is_pending() const { return m_uiIsPending; }
+};
+
+}  // namespace dsolve
@@ -7,8 +7,10 @@
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <iosfwd>
 #include <map>
 #include <stdexcept>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -16,7 +18,12 @@
 #include <libxsmm.h>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "dendro.h"
+#include "mpi.h"
 
 #define INDEX_3D(i, j, k) ((i) + nx * ((j) + ny * (k)))
 
@@ -578,6 +585,107 @@ void setArrToZero(double *Mat, const int n);
  */
 void mulMM(double *C, double *A, double *B, int na, int nb);
 
+/**
+ * @brief Banded form of a compact derivative operator, D = P^-1 Q.
+ *
+ * Instead of storing the dense n x n product P^-1 Q, this stores Q as a
+ * short stencil per row and P as its LU factors (no pivoting) restricted to
+ * the band of P. Applying the operator to a line is then O(n) instead of
+ * O(n^2): the stencil of Q is evaluated and the banded system is solved with
+ * a forward and backward sweep.
+ *
+ * The boundary closures only change a handful of rows in P and Q, so the
+ * LEFT/RIGHT/LEFTRIGHT variants have the same structure as the interior
+ * operator, only with (slightly) wider rows near the edges.
+ */
+struct BandedDerivOperator {
+    uint32_t n = 0;
+    /// lower and upper bandwidths of P
+    uint32_t kl = 0;
+    uint32_t ku = 0;
+    /// largest number of (consecutive) entries in a row of Q
+    uint32_t q_width = 0;
+
+    /// L(r, r - d) stored at lower[r * kl + d - 1], unit diagonal implied
+    std::vector<double> lower;
+    /// U(r, r + d) stored at upper[r * ku + d - 1]
+    std::vector<double> upper;
+    /// 1 / U(r, r)
+    std::vector<double> inv_diag;
+
+    /// row r of Q covers columns [q_start[r], q_start[r] + q_len[r])
+    std::vector<uint32_t> q_start;
+    std::vector<uint32_t> q_len;
+    std::vector<double> q_coeffs;
+
+    /// only true if the factorization succeeded *and* the band is narrow
+    /// enough to beat the dense matrix multiplication
+    bool valid = false;
+
+    void clear() {
+        n = kl = ku = q_width = 0;
+        lower.clear();
+        upper.clear();
+        inv_diag.clear();
+        q_start.clear();
+        q_len.clear();
+        q_coeffs.clear();
+        valid = false;
+    }
+};
+
+/**
+ * @brief Builds the banded form of D = P^-1 Q from the dense P and Q.
+ *
+ * P and Q are column-major n x n matrices, like the ones built by
+ * buildPandQMatrices. Neither is modified.
+ *
+ * @param[out] op The banded operator, op.valid is set on success.
+ * @param[in] P Pointer to the first element of matrix P.
+ * @param[in] Q Pointer to the first element of matrix Q.
+ * @param[in] n Size of the square matrices (i.e. n x n).
+ * @return true if a banded operator was built and should be used.
+ */
+bool buildBandedDerivOperator(BandedDerivOperator &op, const double *P,
+                              const double *Q, const uint32_t n);
+
+/**
+ * @brief Applies a banded derivative operator to a "panel" of lines.
+ *
+ * The panel is n rows (the derivative direction) by m columns (independent
+ * lines), with element (r, c) stored at in[r * ld + c]. Keeping the lines
+ * as the contiguous index means the inner loops run over contiguous memory.
+ *
+ * @param[in] op The banded operator to apply (must be valid).
+ * @param[out] out Output panel, must not alias in.
+ * @param[in] in Input panel.
+ * @param[in] m Number of lines (columns) in the panel.
+ * @param[in] ld Distance between consecutive rows of the panel.
+ * @param[in] scale Scaling applied to the result (i.e. 1 / dx).
+ */
+void applyBandedDerivOperator(const BandedDerivOperator &op, double *out,
+                              const double *in, const uint32_t m,
+                              const uint32_t ld, const double scale);
+
+/**
+ * @brief Largest relative difference between a banded operator and the
+ * dense column-major matrix D it is supposed to reproduce.
+ */
+double bandedDerivOperatorError(const BandedDerivOperator &op, const double *D);
+
+/**
+ * @brief Writes a banded operator in a raw binary form, used by the on-disk
+ * matrix cache and to hand the operators out to the ranks of a node.
+ */
+void writeBandedDerivOperator(std::ostream &out, const BandedDerivOperator &op);
+
+/**
+ * @brief Reads back an operator written by writeBandedDerivOperator.
+ *
+ * @return false (and a cleared op) if the stream ended early or is corrupt.
+ */
+bool readBandedDerivOperator(std::istream &in, BandedDerivOperator &op);
+
 /**
  * The order in which we compute the various compact derivatives.
  *
@@ -601,6 +709,102 @@ enum CompactDerivValueOrder {
     R_MAT_END             ///< Used to mark the end of the enum.
 };
 
+/**
+ * @brief Scratch space used while a compact derivative or filter is applied.
+ *
+ * Once the R matrices, banded operators and kernels of a CompactFiniteDiff
+ * object are built they are only ever read. Everything a derivative or filter
+ * call writes to lives in one of these instead, and the object keeps one per
+ * OpenMP thread, so threads can run derivatives on different blocks (or
+ * variables) at the same time while sharing a single copy of the matrices.
+ */
+struct CFDWorkspace {
+    // Temporary storage for operations in progress
+    double *u1d = nullptr;
+    double *u2d = nullptr;
+    // Additional temporary storage for operations in progress
+    double *du1d = nullptr;
+    double *du2d = nullptr;
+
+    // 3d block workspaces, used for the transposes of the banded and XSMM
+    // paths in y and z
+    double *du3d_block1 = nullptr;
+    double *du3d_block2 = nullptr;
+
+    // output block for the in-place batched filters, only grows, since the
+    // batched calls don't know the block size up front
+    double *batch_block1 = nullptr;
+    size_t batch_sz = 0;
+
+#ifdef EM2_USE_XSMM_MAT_MUL
+    // R matrices pre-multiplied by 1/h or 1/h^2, keyed by the unscaled matrix
+    // and the scale. There is one scale per refinement level, so this stays
+    // small, and it is cleared whenever the R matrices are rebuilt
+    std::map<std::pair<const double *, double>, std::vector<double>> scaled_R;
+#endif
+
+    unsigned int dim_size = 0;
+    unsigned int max_blk_sz = 0;
+
+    CFDWorkspace() = default;
+    CFDWorkspace(const CFDWorkspace &) = delete;
+    CFDWorkspace &operator=(const CFDWorkspace &) = delete;
+    ~CFDWorkspace() {
+        delete_line_storage();
+        delete_block_storage();
+        delete_batch_storage();
+    }
+
+    void initialize_line_storage(const unsigned int n) {
+        delete_line_storage();
+        dim_size = n;
+        u1d = new double[n];
+        u2d = new double[n * n];
+        du1d = new double[n];
+        du2d = new double[n * n];
+    }
+
+    void delete_line_storage() {
+        delete[] u1d;
+        delete[] u2d;
+        delete[] du1d;
+        delete[] du2d;
+        u1d = u2d = du1d = du2d = nullptr;
+        dim_size = 0;
+    }
+
+    void initialize_block_storage(const unsigned int blk_sz) {
+        // memory already allocated for this size
+        if (max_blk_sz == blk_sz) return;
+
+        delete_block_storage();
+        max_blk_sz = blk_sz;
+        du3d_block1 = new double[blk_sz];
+        du3d_block2 = new double[blk_sz];
+    }
+
+    void delete_block_storage() {
+        delete[] du3d_block1;
+        delete[] du3d_block2;
+        du3d_block1 = du3d_block2 = nullptr;
+        max_blk_sz = 0;
+    }
+
+    void reserve_batch_storage(const size_t sz) {
+        if (batch_sz >= sz) return;
+
+        delete_batch_storage();
+        batch_sz = sz;
+        batch_block1 = new double[sz];
+    }
+
+    void delete_batch_storage() {
+        delete[] batch_block1;
+        batch_block1 = nullptr;
+        batch_sz = 0;
+    }
+};
+
 class CompactFiniteDiff {
    private:
 // STORAGE VARIABLES USED FOR THE DIFFERENT DIMENSIONS
@@ -613,16 +817,155 @@ class CompactFiniteDiff {
     double *m_RMatrices[CompactDerivValueOrder::R_MAT_END] = {};
 #endif
 
-    // Temporary storage for operations in progress
-    double *m_u1d = nullptr;
-    double *m_u2d = nullptr;
-    // Additional temporary storage for operations in progress
-    double *m_du1d = nullptr;
-    double *m_du2d = nullptr;
+    // every R matrix of every size lives in this one buffer, owned by the
+    // object or, with node sharing, the node-shared window m_R_win
+    double *m_R_buffer = nullptr;
+    size_t m_R_buffer_sz = 0;
+    MPI_Win m_R_win = MPI_WIN_NULL;
+
+    // ranks on this node sharing the R matrices, MPI_COMM_NULL if not shared
+    MPI_Comm m_node_comm = MPI_COMM_NULL;
+
+    // directory of the on-disk R matrix cache, empty if disabled
+    std::string m_matrix_cache_dir;
+
+#ifdef EM2_CFD_BANDED_SOLVE
+// Banded (factorized P, stencil Q) versions of the derivative operators, used
+// in place of the dense R matrices whenever they are valid
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    std::map<uint32_t, std::vector<BandedDerivOperator>> m_banded_storage;
+#else
+    BandedDerivOperator m_banded_ops[CompactDerivValueOrder::FILT_NORM];
+#endif
+#endif
+
+    /**
+     * @brief Returns the banded operator to use for a block, or nullptr if
+     * the dense R matrix should be used instead.
+     *
+     * @param[in] n Size of the block in the derivative direction.
+     * @param[in] base DERIV_NORM or DERIV_2ND_NORM.
+     * @param[in] left Whether the block touches the "left" boundary.
+     * @param[in] right Whether the block touches the "right" boundary.
+     */
+    const BandedDerivOperator *get_banded_op(const uint32_t n,
+                                             const CompactDerivValueOrder base,
+                                             const bool left,
+                                             const bool right) {
+#ifdef EM2_CFD_BANDED_SOLVE
+        // NORM, LEFT, RIGHT, LEFTRIGHT are consecutive in the enum
+        const uint32_t idx = base + (left ? 1 : 0) + (right ? 2 : 0);
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+        auto it = m_banded_storage.find(n);
+        if (it == m_banded_storage.end()) return nullptr;
+        const BandedDerivOperator *op = &it->second[idx];
+#else
+        const BandedDerivOperator *op = &m_banded_ops[idx];
+#endif
+        return (op->valid && op->n == n) ? op : nullptr;
+#else
+        return nullptr;
+#endif
+    }
 
-    // pointers for our two workspaces, to potentially be set externally
-    double *m_du3d_block1 = nullptr;
-    double *m_du3d_block2 = nullptr;
+    // banded application along each of the directions, the x direction
+    // transposes each z slice through the 3d block workspace
+    void apply_banded_x(double *const Du, const double *const u,
+                        const BandedDerivOperator &op, const double scale,
+                        const unsigned int *sz, CFDWorkspace &ws);
+    void apply_banded_y(double *const Du, const double *const u,
+                        const BandedDerivOperator &op, const double scale,
+                        const unsigned int *sz);
+    void apply_banded_z(double *const Du, const double *const u,
+                        const BandedDerivOperator &op, const double scale,
+                        const unsigned int *sz);
+
+    /**
+     * @brief Returns the dense R matrix to use for a block.
+     *
+     * @param[in] n Size of the block in the derivative direction.
+     * @param[in] base DERIV_NORM, DERIV_2ND_NORM or FILT_NORM.
+     * @param[in] left Whether the block touches the "left" boundary.
+     * @param[in] right Whether the block touches the "right" boundary.
+     */
+    double *get_R_matrix(const uint32_t n, const CompactDerivValueOrder base,
+                         const bool left, const bool right) {
+        // NORM, LEFT, RIGHT, LEFTRIGHT are consecutive in the enum
+        const uint32_t idx = base + (left ? 1 : 0) + (right ? 2 : 0);
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+        return m_R_storage.at(n)[idx];
+#else
+        return m_RMatrices[idx];
+#endif
+    }
+
+#ifdef EM2_USE_XSMM_MAT_MUL
+    /**
+     * @brief Returns R scaled by alpha, from the calling thread's cache.
+     *
+     * The XSMM kernels are dispatched with a fixed alpha of 1, so the grid
+     * spacing is folded into the matrix instead of scaling the output in a
+     * second pass.
+     *
+     * @param[in] R Unscaled n x n R matrix.
+     * @param[in] n Size of the matrix.
+     * @param[in] alpha Scale, 1/h or 1/h^2.
+     */
+    const double *get_scaled_R_matrix(const double *R, const uint32_t n,
+                                      const double alpha);
+#endif
+
+    /**
+     * @brief Applies a dense operator along one direction to several blocks
+     * at once, out[v] = alpha * R u[v] + beta * u[v].
+     *
+     * Each variable goes through the same strided GEMMs as the single
+     * variable versions (see dense_apply_x in compact_derivs.cpp), so no
+     * transposes are needed in any direction. out[v] may be u[v].
+     *
+     * @param[out] out Output blocks.
+     * @param[in] u Input blocks.
+     * @param[in] num_vars Number of blocks.
+     * @param[in] dir Direction, 0, 1, 2 for x, y, z.
+     * @param[in] base DERIV_NORM, DERIV_2ND_NORM or FILT_NORM.
+     * @param[in] alpha Scaling of R u.
+     * @param[in] beta Scaling of u added to the result.
+     * @param[in] sz Block size.
+     * @param[in] bflag Boundary flag of the block.
+     */
+    void apply_dense_batched(double *const *out, const double *const *u,
+                             const unsigned int num_vars,
+                             const unsigned int dir,
+                             const CompactDerivValueOrder base,
+                             const double alpha, const double beta,
+                             const unsigned int *sz, unsigned bflag);
+
+    /**
+     * @brief Shared part of the batched first and second derivatives, falls
+     * back to the single variable version for the banded and XSMM paths.
+     */
+    void deriv_batched(void (CompactFiniteDiff::*single)(
+                           double *const, const double *const, const double,
+                           const unsigned int *, unsigned),
+                       double *const *Du, const double *const *u,
+                       const unsigned int num_vars, const unsigned int dir,
+                       const CompactDerivValueOrder base, const double h,
+                       const unsigned int *sz, unsigned bflag);
+
+    /**
+     * @brief Shared part of the batched filters, falls back to the single
+     * variable version for the XSMM path.
+     */
+    void filter_batched(void (CompactFiniteDiff::*single)(
+                            double *const, double *const, const double,
+                            const unsigned int *, unsigned),
+                        double *const *u, const unsigned int num_vars,
+                        const unsigned int dir, const double h,
+                        const unsigned int *sz, unsigned bflag);
+
+    // one scratch workspace per thread, indexed by the OpenMP thread number
+    CFDWorkspace *m_workspaces = nullptr;
+    unsigned int m_num_workspaces = 0;
     unsigned int m_max_blk_sz = 0;
 
     // TODO: make this a parameter!
@@ -677,18 +1020,134 @@ class CompactFiniteDiff {
 
     void change_dim_size(const unsigned int dim_size);
 
+    /**
+     * @brief Sets a directory for caching the R matrices on disk, empty to
+     * disable. Matrices found there (same types, size, boundary closure and
+     * coefficients) are loaded instead of built. Takes effect the next time
+     * the matrices are built (change_dim_size). The directory has to exist.
+     * With EM2_CFD_BANDED_SOLVE the banded operators are cached too.
+     */
+    void set_matrix_cache_dir(const std::string &dir) {
+        m_matrix_cache_dir = dir;
+    }
+
+    /**
+     * @brief Shares the R matrices between the ranks of comm on the same
+     * node through an MPI shared memory window, MPI_COMM_NULL to stop
+     * sharing. Collective on comm. Takes effect the next time the matrices
+     * are built (change_dim_size), which is then collective on comm as well.
+     * Call free_shared_matrices before MPI_Finalize. With
+     * EM2_CFD_BANDED_SOLVE every rank keeps its own copy of the (small)
+     * banded operators, node rank 0 sends them to the others.
+     */
+    void set_shared_matrices(MPI_Comm comm);
+
+    /**
+     * @brief Frees the node-shared R matrices and stops sharing, the object
+     * can't compute derivatives until the next change_dim_size. Collective
+     * on the node communicator.
+     */
+    void free_shared_matrices();
+
     void initialize_cfd_3dblock_workspace(const unsigned int max_blk_sz);
     void delete_cfd_3dblock_workspace();
 
+    /**
+     * @brief Returns the scratch workspace of the calling thread.
+     *
+     * This is just an index into the per-thread workspaces, so it's cheap
+     * enough to call once per derivative.
+     */
+    CFDWorkspace &get_workspace() {
+#ifdef _OPENMP
+        const unsigned int tid = omp_get_thread_num();
+        if (tid >= m_num_workspaces) {
+            throw std::runtime_error(
+                "CFD workspace requested from thread " + std::to_string(tid) +
+                " but only " + std::to_string(m_num_workspaces) +
+                " were allocated, the thread count changed after the CFD "
+                "object was initialized");
+        }
+        return m_workspaces[tid];
+#else
+        return m_workspaces[0];
+#endif
+    }
+
     void initialize_cfd_storage();
-    void initialize_all_cfd_matrices();
     void initialize_cfd_matrix(const uint32_t curr_size,
-                               double **outputLocation);
-    void initialize_all_cfd_filters();
+                               double **outputLocation,
+                               BandedDerivOperator *bandedLocation = nullptr);
     void initialize_cfd_filter(const uint32_t curr_size,
                                double **outputLocation);
     void delete_cfd_matrices();
 
+    /**
+     * @brief Allocates the R matrix buffer for all the sizes in use, in the
+     * node-shared window if the matrices are shared. Collective on the node
+     * communicator in that case.
+     */
+    void allocate_R_buffer();
+    void free_R_buffer();
+
+    /**
+     * @brief Builds (or loads from the cache) the derivative and filter R
+     * matrices of every size. With node sharing, only node rank 0 does the
+     * work and the other ranks wait for it.
+     */
+    void initialize_all_R_matrices();
+
+#ifdef EM2_CFD_BANDED_SOLVE
+    /**
+     * @brief The FILT_NORM banded operators of size n, allocated if needed.
+     */
+    std::vector<BandedDerivOperator *> banded_operators(const uint32_t n);
+
+    /**
+     * @brief Copies the banded operators of node rank 0 (the builder) to the
+     * other ranks of the node. Collective on the node communicator.
+     */
+    void share_banded_operators(const bool builder);
+#endif
+
+    /**
+     * @brief Loads the derivative and filter R matrices of size n (and the
+     * banded operators if bandedLocation is given) from the cache, or builds
+     * them and stores them in the cache.
+     */
+    void initialize_R_matrices(const uint32_t n, double **outputLocation,
+                               BandedDerivOperator *bandedLocation);
+
+    /**
+     * @brief First line of the cache file for the R matrices of size n, a
+     * cached file is only used if it matches exactly. It holds everything
+     * the matrices depend on, the doubles are written exactly (%a).
+     */
+    std::string R_matrix_cache_key(const uint32_t n) const;
+
+    /**
+     * @brief Path of the cache file for the R matrices of size n, the file
+     * name encodes the operator types and the size.
+     */
+    std::string R_matrix_cache_file(const uint32_t n) const;
+
+    /**
+     * @brief Reads the R_MAT_END matrices of size n, followed by the
+     * FILT_NORM banded operators if bandedLocation is given, from the cache.
+     *
+     * @return true if a complete cache file with a matching header was found.
+     */
+    bool load_cached_R_matrices(const uint32_t n, double **outputLocation,
+                                BandedDerivOperator *bandedLocation);
+
+    /**
+     * @brief Writes the R_MAT_END matrices of size n (and the banded
+     * operators if given) to the cache. Failing to write is not an error,
+     * the matrices are just rebuilt next time.
+     */
+    void store_cached_R_matrices(const uint32_t n, double **outputLocation,
+                                 const BandedDerivOperator *bandedLocation);
+
     void initialize_cfd_kernels();
     void delete_cfd_kernels();
 
@@ -778,6 +1237,72 @@ class CompactFiniteDiff {
                       const double dy, const unsigned int *sz, unsigned bflag);
     void filter_cfd_z(double *const u, double *const filtz_work,
                       const double dz, const unsigned int *sz, unsigned bflag);
+
+    /**
+     * @brief Batched versions of the derivatives, these differentiate
+     * num_vars blocks (all of size sz, with the same bflag) at once. The
+     * operator lookup and the workspace are shared between the variables,
+     * see apply_dense_batched.
+     *
+     * @param[out] Du num_vars output blocks.
+     * @param[in] u num_vars input blocks.
+     * @param[in] num_vars Number of variables.
+     * @param[in] dx Grid spacing in the derivative direction.
+     * @param[in] sz Block size.
+     * @param[in] bflag Boundary flag of the block.
+     */
+    void cfd_x_batched(double *const *Du, const double *const *u,
+                       const unsigned int num_vars, const double dx,
+                       const unsigned int *sz, unsigned bflag);
+    void cfd_y_batched(double *const *Du, const double *const *u,
+                       const unsigned int num_vars, const double dy,
+                       const unsigned int *sz, unsigned bflag);
+    void cfd_z_batched(double *const *Du, const double *const *u,
+                       const unsigned int num_vars, const double dz,
+                       const unsigned int *sz, unsigned bflag);
+
+    void cfd_xx_batched(double *const *Du, const double *const *u,
+                        const unsigned int num_vars, const double dx,
+                        const unsigned int *sz, unsigned bflag);
+    void cfd_yy_batched(double *const *Du, const double *const *u,
+                        const unsigned int num_vars, const double dy,
+                        const unsigned int *sz, unsigned bflag);
+    void cfd_zz_batched(double *const *Du, const double *const *u,
+                        const unsigned int num_vars, const double dz,
+                        const unsigned int *sz, unsigned bflag);
+
+    /**
+     * @brief First and pure second derivatives of one field in all three
+     * directions. The six operators are applied back to back, so u stays in
+     * cache for all of them instead of being streamed once per direction and
+     * order as with the batched calls.
+     *
+     * @param[out] Dxu, Dyu, Dzu First derivatives.
+     * @param[out] Dxxu, Dyyu, Dzzu Pure second derivatives.
+     * @param[in] u Input block.
+     * @param[in] dx, dy, dz Grid spacings.
+     * @param[in] sz Block size.
+     * @param[in] bflag Boundary flag of the block.
+     */
+    void cfd_grad_2nd(double *const Dxu, double *const Dyu, double *const Dzu,
+                      double *const Dxxu, double *const Dyyu,
+                      double *const Dzzu, const double *const u,
+                      const double dx, const double dy, const double dz,
+                      const unsigned int *sz, unsigned bflag);
+
+    /**
+     * @brief Batched versions of the filters, filters num_vars blocks in
+     * place. No work buffers are needed, the thread's workspace is used.
+     */
+    void filter_cfd_x_batched(double *const *u, const unsigned int num_vars,
+                              const double dx, const unsigned int *sz,
+                              unsigned bflag);
+    void filter_cfd_y_batched(double *const *u, const unsigned int num_vars,
+                              const double dy, const unsigned int *sz,
+                              unsigned bflag);
+    void filter_cfd_z_batched(double *const *u, const unsigned int num_vars,
+                              const double dz, const unsigned int *sz,
+                              unsigned bflag);
 };
 
 extern CompactFiniteDiff cfd;
@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include "TreeNode.h"
+#include "simd_utils.h"
 
 #define IDX(i, j, k) ((i) + nx * ((j) + ny * (k)))
 
@@ -30,6 +31,34 @@ extern void (*deriv_yy)(double *const, const double *const, const double,
 extern void (*deriv_zz)(double *const, const double *const, const double,
                         const unsigned int *, unsigned);
 
+/**
+ * @brief Fused first and pure second derivatives of one field along x, y and
+ * z (Dx, Dy, Dz, Dxx, Dyy, Dzz, u, hx, hy, hz, sz, bflag), identical to the
+ * deriv_x ... deriv_zz calls but done in a single sweep over the block.
+ */
+extern void (*deriv_grad_2nd)(double *const, double *const, double *const,
+                              double *const, double *const, double *const,
+                              const double *const, const double, const double,
+                              const double, const unsigned int *, unsigned);
+
+/**
+ * @brief First derivatives along x, y and z (Dx, Dy, Dz, u, hx, hy, hz, sz,
+ * bflag), evaluated only on the boundary faces flagged in bflag, which is
+ * where the boundary conditions need them.
+ */
+extern void (*deriv_face_grad)(double *const, double *const, double *const,
+                               const double *const, const double, const double,
+                               const double, const unsigned int *, unsigned);
+
+/**
+ * @brief Adds the Kreiss-Oliger dissipation of a field to its RHS (rhs, u,
+ * sigma, hx, hy, hz, sz, bflag), rhs += sigma * (KO_x + KO_y + KO_z) u, in a
+ * single pass and without per-direction work arrays.
+ */
+extern void (*ko_dissipation)(double *const, const double *const,
+                              const double, const double, const double,
+                              const double, const unsigned int *, unsigned);
+
 extern void (*ko_deriv_x)(double *const, const double *const, const double,
                           const unsigned int *, unsigned);
 extern void (*ko_deriv_y)(double *const, const double *const, const double,
@@ -0,0 +1,69 @@
+/**
+ * @file ghost_exchange.h
+ * @brief Ghost exchange of the evolution variables with persistent MPI
+ * requests.
+ *
+ * The neighbours, the scatter maps and the message sizes of the ghost
+ * exchange only change when the mesh does, but every stage goes through the
+ * same exchange. The plan keeps one MPI_Send_init/MPI_Recv_init request per
+ * neighbour and the packed buffers of all the variables, so a stage only
+ * packs, starts, waits and unpacks. Rebuild it whenever the mesh changes.
+ */
+
+#pragma once
+
+#include <mpi.h>
+
+#include <vector>
+
+#include "mesh.h"
+
+namespace dsolve {
+
+class GhostExchangePlan {
+   public:
+    GhostExchangePlan() = default;
+    ~GhostExchangePlan() { release(); }
+
+    GhostExchangePlan(const GhostExchangePlan &) = delete;
+    GhostExchangePlan &operator=(const GhostExchangePlan &) = delete;
+
+    /**
+     * @brief sets up the requests and buffers to exchange dof zipped
+     * variables of pMesh together, one message per neighbour. Frees the old
+     * plan first. No-op beyond that on inactive ranks.
+     * @param pMesh : mesh the exchanged variables live on.
+     * @param dof : number of variables exchanged together.
+     */
+    void build(const ot::Mesh *pMesh, const unsigned int dof);
+
+    /**@brief: frees the requests and buffers*/
+    void release();
+
+    /**
+     * @brief packs the local nodes the neighbours need and starts the
+     * exchange. The variables must not be written until finish() returns.
+     * @param vars : the dof zipped variables.
+     */
+    void start(const double *const *vars);
+
+    /**@brief: waits for the exchange and writes the ghost nodes of vars*/
+    void finish(double *const *vars);
+
+   private:
+    /**@brief: message tag, apart from the tags of the Dendro exchanges*/
+    static constexpr int TAG = 4201;
+
+    unsigned int m_uiDof = 0;
+
+    /**@brief: per neighbour node lists, the offsets index the node lists and
+     * (times dof) the buffers*/
+    std::vector<unsigned int> m_uiSendCounts, m_uiSendOffsets;
+    std::vector<unsigned int> m_uiRecvCounts, m_uiRecvOffsets;
+    std::vector<unsigned int> m_uiSendNodes, m_uiRecvNodes;
+
+    std::vector<double> m_uiSendBuf, m_uiRecvBuf;
+    std::vector<MPI_Request> m_uiSendReqs, m_uiRecvReqs;
+};
+
+}  // namespace dsolve
@@ -33,8 +33,8 @@
     (((RgZ / Rz) * (zc - dsolve::SOLVER_COMPD_MIN[2])) + \
      dsolve::SOLVER_OCTREE_MIN[2])
 
-// type of the rk method.
-enum RKType { RK3 = 0, RK4, RK45 };
+// type of the rk method. LSRK3 and LSRK4 are the low-storage (2N) variants
+enum RKType { RK3 = 0, RK4, RK45, LSRK3, LSRK4 };
 
 namespace dsolve {
 // clang-format off
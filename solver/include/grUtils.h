@@ -197,12 +197,37 @@ unsigned int getOctantWeight(const ot::TreeNode *pNode);
  */
 void allocate_deriv_workspace(const ot::Mesh *pMesh, unsigned int s_fac);
 
+/**
+ * @brief Allocate the derivative workspace for blocks of up to max_blk_sz
+ * points, without a mesh (used by the block benchmarks)
+ *
+ * @param max_blk_sz largest block allocation size (nx * ny * nz)
+ * @param s_fac
+ */
+void allocate_deriv_workspace(unsigned int max_blk_sz, unsigned int s_fac);
+
 /**
  * @brief Deallocate the derivative workspace for use in the RHS functionality
  * 
  */
 void deallocate_deriv_workspace();
 
+/**
+ * @brief Get the calling thread's slice of the derivative workspace. Thread 0
+ * (and any serial caller) gets SOLVER_DERIV_WORKSPACE itself.
+ *
+ * @return double* start of the thread's SOLVER_DERIV_WORKSPACE_STRIDE doubles
+ */
+double *get_thread_deriv_workspace();
+
+/**
+ * @brief Get the memory pool owned by the calling thread. Thread 0 (and any
+ * serial caller) gets SOLVER_MEM_POOL.
+ *
+ * @return mem::memory_pool<double>*
+ */
+mem::memory_pool<double> *get_thread_mem_pool();
+
 }  // end of namespace dsolve
 
 namespace dsolve {
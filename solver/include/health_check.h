@@ -0,0 +1,72 @@
+/**
+ * @file health_check.h
+ * @brief NaN/Inf guard for the evolution variables.
+ *
+ * Every SOLVER_HEALTH_CHECK_FREQ steps the local nodes of the evolved state
+ * are reduced to a single finite-ness flag (one read-only pass, no
+ * derivatives, no unzip) which is then combined over the ranks. Only when a
+ * NaN or Inf is found the state is unzipped and the blocks holding it are
+ * written out, so the guard costs next to nothing while everything is fine.
+ */
+
+#pragma once
+
+#include <mpi.h>
+
+#include <string>
+
+#include "mesh.h"
+
+namespace dsolve {
+
+/**
+ * @brief Returns true if none of the n values is NaN or Inf.
+ *
+ * Looks at the exponent bits, so it vectorizes and still works when the
+ * build uses -ffast-math (which lets the compiler assume std::isfinite).
+ */
+bool all_finite(const double *u, const unsigned int n);
+
+/**
+ * @brief Returns true if the local nodes of all the zipped variables are
+ * finite. No communication.
+ */
+bool local_state_finite(const ot::Mesh *pMesh, const double *const *zipVars,
+                        const unsigned int numVars);
+
+/**
+ * @brief Writes every local block whose interior holds a NaN or Inf to
+ * <prefix>_health_<step>_<rank>.txt. For each such block it writes its
+ * octant, coordinates and boundary flag, then all the values (padding
+ * included) of each variable that is not finite.
+ *
+ * @param pMesh : mesh the unzipped variables belong to.
+ * @param unzipVars : unzipped variables.
+ * @param numVars : number of variables.
+ * @param varNames : names of the variables.
+ * @param step : current time step.
+ * @param time : current time.
+ * @param prefix : file prefix.
+ * @return number of blocks written.
+ */
+unsigned int dump_unhealthy_blocks(const ot::Mesh *pMesh,
+                                   const double *const *unzipVars,
+                                   const unsigned int numVars,
+                                   const char *const *varNames,
+                                   const unsigned int step, const double time,
+                                   const std::string &prefix);
+
+/**
+ * @brief Ends the run after a failed health check. Waits for every rank to
+ * finish its dump_unhealthy_blocks files, reports on rank 0 and calls
+ * MPI_Abort, so the whole job stops with a non-zero exit code instead of
+ * dying in std::terminate on some of the ranks. Collective on comm.
+ *
+ * @param comm : communicator of all the ranks of the run.
+ * @param step : time step the check failed at.
+ * @param time : time the check failed at.
+ */
+[[noreturn]] void abort_unhealthy_run(MPI_Comm comm, const unsigned int step,
+                                      const double time);
+
+}  // namespace dsolve
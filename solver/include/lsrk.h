@@ -0,0 +1,188 @@
+/**
+ * @file lsrk.h
+ * @brief Low-storage (2N) explicit Runge-Kutta time stepper for the ts::Ctx
+ * based solver.
+ *
+ * Exposes the same interface the main evolution loop uses from ts::ETS, so
+ * either one can drive a SOLVERCtx. Every stage only needs one extra register
+ * next to the solution,
+ *
+ *   dU = A[s] * dU + dt * rhs(u, t + T[s] * dt)
+ *   u  = u + B[s] * dU
+ *
+ * plus the zip target of the RHS, instead of one full copy of the state per
+ * stage.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "ctx.h"
+#include "mesh.h"
+
+namespace dsolve {
+
+template <typename T, typename Ctx>
+class LSRK {
+   protected:
+    /**@brief: application context that computes the rhs*/
+    Ctx *m_uiAppCtx;
+
+    /**@brief: the dU register*/
+    ot::DVector<T, unsigned int> m_uiDU;
+
+    /**@brief: zip target of the stage rhs*/
+    ot::DVector<T, unsigned int> m_uiRHS;
+
+    /**@brief: stage coefficients, see the file description*/
+    const double *m_uiA = nullptr;
+    const double *m_uiB = nullptr;
+    const double *m_uiT = nullptr;
+    unsigned int m_uiNumStages = 0;
+
+    /**@brief: allocates the registers on the current ctx mesh*/
+    void allocate_registers() {
+        const ot::Mesh *pMesh = m_uiAppCtx->get_mesh();
+        const unsigned int dof = m_uiAppCtx->get_evolution_vars().get_dof();
+        m_uiDU.create_vector(pMesh, ot::DVEC_TYPE::OCT_SHARED_NODES,
+                             ot::DVEC_LOC::HOST, dof, true);
+        m_uiRHS.create_vector(pMesh, ot::DVEC_TYPE::OCT_SHARED_NODES,
+                              ot::DVEC_LOC::HOST, dof, true);
+    }
+
+    void destroy_registers() {
+        m_uiDU.destroy_vector();
+        m_uiRHS.destroy_vector();
+    }
+
+   public:
+    /**
+     * @brief Construct a new LSRK object
+     * @param appCtx : application context, not owned by the stepper.
+     */
+    LSRK(Ctx *appCtx) : m_uiAppCtx(appCtx) {}
+
+    ~LSRK() { destroy_registers(); }
+
+    /**
+     * @brief sets the 2N scheme to use, the arrays are not copied.
+     * @param A : dU weights of each stage (A[0] must be 0)
+     * @param B : solution update weights of each stage
+     * @param Tc : time offsets of each stage in units of dt
+     * @param numStages : number of stages
+     */
+    void set_coefficients(const double *A, const double *B, const double *Tc,
+                          unsigned int numStages) {
+        m_uiA = A;
+        m_uiB = B;
+        m_uiT = Tc;
+        m_uiNumStages = numStages;
+    }
+
+    /**@brief: initializes the ctx (initial data or checkpoint restore) and
+     * allocates the registers*/
+    int init() {
+        m_uiAppCtx->initialize();
+        allocate_registers();
+        return 0;
+    }
+
+    /**@brief: reallocates the registers after the ctx mesh changed*/
+    void sync_with_mesh() {
+        destroy_registers();
+        allocate_registers();
+    }
+
+    T curr_time() { return m_uiAppCtx->get_ts_info()._m_uiT; }
+
+    DendroIntL curr_step() { return m_uiAppCtx->get_ts_info()._m_uiStep; }
+
+    T ts_size() { return m_uiAppCtx->get_ts_info()._m_uiTh; }
+
+    bool is_active() { return m_uiAppCtx->get_mesh()->isActive(); }
+
+    unsigned int get_global_rank() {
+        return m_uiAppCtx->get_mesh()->getMPIRankGlobal();
+    }
+
+    MPI_Comm get_global_comm() {
+        return m_uiAppCtx->get_mesh()->getMPIGlobalCommunicator();
+    }
+
+    /**@brief: no internal profiling, kept for interface parity with ETS*/
+    void init_pt() {}
+    void dump_pt(std::ostream &sout) {}
+
+    /**@brief: advances the evolution variables of the ctx by one step*/
+    int evolve();
+};
+
+template <typename T, typename Ctx>
+int LSRK<T, Ctx>::evolve() {
+    const ot::Mesh *pMesh = m_uiAppCtx->get_mesh();
+    ts::TSInfo ts_info = m_uiAppCtx->get_ts_info();
+    const T current_t = ts_info._m_uiT;
+    const T dt = ts_info._m_uiTh;
+
+    ot::DVector<T, unsigned int> &evar = m_uiAppCtx->get_evolution_vars();
+
+    m_uiAppCtx->pre_timestep(evar);
+
+    if (pMesh->isActive()) {
+        const unsigned int dof = evar.get_dof();
+        const unsigned int nodeLocalBegin = pMesh->getNodeLocalBegin();
+        const unsigned int nodeLocalEnd = pMesh->getNodeLocalEnd();
+
+        std::vector<T *> u(dof), du(dof), k(dof);
+        evar.to_2d(u.data());
+        m_uiDU.to_2d(du.data());
+        m_uiRHS.to_2d(k.data());
+
+        for (unsigned int stage = 0; stage < m_uiNumStages; stage++) {
+            m_uiAppCtx->pre_stage(evar);
+            m_uiAppCtx->rhs(&evar, &m_uiRHS, 1,
+                            current_t + m_uiT[stage] * dt);
+
+            // A[0] is zero, so the first stage doesn't read the old dU
+            const T a = m_uiA[stage];
+            const T b = m_uiB[stage];
+            for (unsigned int v = 0; v < dof; v++) {
+                T *const u_v = u[v];
+                T *const du_v = du[v];
+                const T *const k_v = k[v];
+                if (stage == 0) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                    for (unsigned int node = nodeLocalBegin;
+                         node < nodeLocalEnd; node++) {
+                        du_v[node] = dt * k_v[node];
+                        u_v[node] += b * du_v[node];
+                    }
+                } else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                    for (unsigned int node = nodeLocalBegin;
+                         node < nodeLocalEnd; node++) {
+                        du_v[node] = a * du_v[node] + dt * k_v[node];
+                        u_v[node] += b * du_v[node];
+                    }
+                }
+            }
+
+            m_uiAppCtx->post_stage(evar);
+        }
+    }
+
+    m_uiAppCtx->post_timestep(evar);
+
+    ts_info._m_uiT += dt;
+    ts_info._m_uiStep++;
+    m_uiAppCtx->set_ts_info(ts_info);
+
+    return 0;
+}
+
+}  // namespace dsolve
@@ -53,6 +53,8 @@ extern double SOLVER_CURRENT_RK_COORD_TIME;
 extern unsigned int SOLVER_CURRENT_RK_STEP;
 
 extern double* SOLVER_DERIV_WORKSPACE;
+/**@brief number of doubles in each thread's slice of SOLVER_DERIV_WORKSPACE*/
+extern size_t SOLVER_DERIV_WORKSPACE_STRIDE;
 // number of derivatives, the greater between the RHS and Constraint
 // TODO: this needs to be automated!!!!!!!!! ESPECIALLY WITH ADVANCED
 // DERIVATIVES AS OF THIS MOMENT: THERE ARE 90 IN CONSTRAINTS AS OF THIS MOMENT:
@@ -75,6 +77,14 @@ extern dendro_cfd::BoundaryType SOLVER_DERIV_CLOSURE_TYPE;
 extern double SOLVER_KIM_FILTER_KC;
 extern double SOLVER_KIM_FILTER_EPS;
 
+/** @brief: Directory for caching the compact derivative R matrices on disk
+ * (empty to disable), the directory has to exist */
+extern std::string SOLVER_CFD_MATRIX_CACHE_DIR;
+
+/** @brief: Share the compact derivative R matrices between the ranks of a
+ * node through an MPI shared memory window (1) or keep a copy per rank (0) */
+extern unsigned int SOLVER_CFD_SHARE_MATRICES;
+
 extern double EM2_NOISE_AMPLITUDE;
 
 extern double EM2_ID_AMP1;
@@ -107,6 +117,12 @@ static const unsigned int SOLVER_RK4_STAGES = 4;
 /** @brief: Number of RK3 stages that should be performed */
 static const unsigned int SOLVER_RK3_STAGES = 3;
 
+/** @brief: Number of low-storage RK3 stages that should be performed */
+static const unsigned int SOLVER_LSRK3_STAGES = 3;
+
+/** @brief: Number of low-storage RK4 stages that should be performed */
+static const unsigned int SOLVER_LSRK4_STAGES = 5;
+
 /** @brief: Adaptive time step update safety factor */
 static const double SOLVER_SAFETY_FAC = 0.8;
 
@@ -146,9 +162,17 @@ extern unsigned int SOLVER_REMESH_TEST_FREQ;
 /** @brief: Frequency for checkpoint saving */
 extern unsigned int SOLVER_CHECKPT_FREQ;
 
+/** @brief: Frequency (in time steps) of the NaN/Inf check of the evolution
+ * variables, 0 disables it */
+extern unsigned int SOLVER_HEALTH_CHECK_FREQ;
+
 /** @brief: Option for restoring from a checkpoint (will restore if set to 1) */
 extern unsigned int SOLVER_RESTORE_SOLVER;
 
+/** @brief: Write checkpoints from a background I/O thread (1) or block while
+ * writing them (0) */
+extern unsigned int SOLVER_CHKPT_ASYNC;
+
 /** @brief: Disable AMR and enable block adaptivity */
 extern unsigned int SOLVER_ENABLE_BLOCK_ADAPTIVITY;
 
@@ -211,7 +235,8 @@ extern unsigned int SOLVER_RK_TIME_BEGIN;
 /** @brief: Simulation time end */
 extern double SOLVER_RK_TIME_END;
 
-/** @brief: RK method to use (0 -> RK3 , 1 -> RK4, 2 -> RK45) */
+/** @brief: RK method to use (0 -> RK3 , 1 -> RK4, 2 -> RK45, 3 -> low-storage
+ * RK3, 4 -> low-storage RK4) */
 extern unsigned int SOLVER_RK_TYPE;
 
 /** @brief: Prefered time step size (this is overwritten with the specified CFL
@@ -219,9 +244,14 @@ extern unsigned int SOLVER_RK_TYPE;
 extern double SOLVER_RK45_TIME_STEP_SIZE;
 
 /** @brief: Desired tolerance value for the RK45 method (with adaptive time
- * stepping), NOT CURRENTLY USED */
+ * stepping), scaled error per step of dsolve::AdaptiveRK and the legacy
+ * RK_SOLVER */
 extern double SOLVER_RK45_DESIRED_TOL;
 
+/** @brief: Upper bound of the adaptive RK45 time step, in units of the CFL
+ * time step SOLVER_RK45_TIME_STEP_SIZE */
+extern double SOLVER_RK45_DT_MAX_FAC;
+
 /** @brief: The dissipation type to be used */
 extern unsigned int DISSIPATION_TYPE;
 
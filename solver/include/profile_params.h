@@ -10,6 +10,10 @@
 #ifndef SFCSORTBENCH_PROFILE_PARAMS_H
 #define SFCSORTBENCH_PROFILE_PARAMS_H
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "profiler.h"
 
 namespace dsolve {
@@ -40,6 +44,32 @@ extern profiler_t t_gridTransfer;
 extern profiler_t t_ioVtu;
 extern profiler_t t_ioCheckPoint;
 
+/**
+ * @brief Start a timer from the master thread only. profiler_t is not thread
+ * safe, so inside the block-parallel RHS the timers track thread 0's share of
+ * the work and the other threads skip them.
+ *
+ * @param[in] t timer to start
+ */
+inline void start_master(profiler_t &t) {
+#ifdef _OPENMP
+    if (omp_get_thread_num() != 0) return;
+#endif
+    t.start();
+}
+
+/**
+ * @brief Stop a timer from the master thread only, see start_master.
+ *
+ * @param[in] t timer to stop
+ */
+inline void stop_master(profiler_t &t) {
+#ifdef _OPENMP
+    if (omp_get_thread_num() != 0) return;
+#endif
+    t.stop();
+}
+
 }  // namespace timer
 }  // namespace dsolve
 
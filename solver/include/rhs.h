@@ -31,6 +31,26 @@ void solverRHS(double **uzipVarsRHS, double **uZipVars,
 void solverRHS(double **uzipVarsRHS, const double **uZipVars,
                const ot::Block *blkList, unsigned int numBlocks);
 
+/**@brief applies the compact filter (SOLVER_FILTER_TYPE) in place to the
+ * unzipped evolution variables of all the blocks.
+ * @param[in,out] unzipVars: unzipped variables.
+ * @param[in]  blkList: block list.
+ * @param[in]  numBlocks: number of blocks.
+ */
+void solverFilter(double **uZipVars, const ot::Block *blkList,
+                  unsigned int numBlocks);
+
+/**@brief true if SOLVER_FILTER_TYPE is a compact filter, which acts on the
+ * state through solverFilter every SOLVER_FILTER_FREQ steps (the KO variants
+ * are applied as dissipation inside the RHS instead).
+ */
+bool solverUsesCompactFilter();
+
+/**@brief true if solverFilter is due after step (counted from 1).
+ * @param[in] step: number of steps completed.
+ */
+bool solverFilterDue(unsigned int step);
+
 void solverrhs(double **uzipVarsRHS, const double **uZipVars,
                const unsigned int &offset, const double *ptmin,
                const double *ptmax, const unsigned int *sz,
@@ -5,9 +5,12 @@
 #include <string>
 
 #include "checkPoint.h"
+#include "checkpointWriter.h"
 #include "dataUtils.h"
 #include "fdCoefficient.h"
+#include "ghost_exchange.h"
 #include "grUtils.h"
+#include "health_check.h"
 #include "mesh.h"
 #include "meshTestUtils.h"
 #include "oct2vtk.h"
@@ -37,11 +40,39 @@ static const double RK4_T[] = {0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
 static const double RK4_U[] = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
 //=============================================================
 
+// coefficients for the low-storage (2N) RK solvers ===========
+// each stage only keeps one extra register dU next to the solution u:
+//   dU = A[s] * dU + dt * rhs(u, t + T[s] * dt)
+//   u  = u + B[s] * dU
+
+// Williamson's 3 stage, 3rd order scheme
+static const double LSRK3_A[] = {0.0, -5.0 / 9.0, -153.0 / 128.0};
+static const double LSRK3_B[] = {1.0 / 3.0, 15.0 / 16.0, 8.0 / 15.0};
+static const double LSRK3_T[] = {0.0, 1.0 / 3.0, 3.0 / 4.0};
+
+// Carpenter and Kennedy's 5 stage, 4th order scheme
+static const double LSRK4_A[] = {0.0, -567301805773.0 / 1357537059087.0,
+                                 -2404267990393.0 / 2016746695238.0,
+                                 -3550918686646.0 / 2091501179385.0,
+                                 -1275806237668.0 / 842570457699.0};
+static const double LSRK4_B[] = {1432997174477.0 / 9575080441755.0,
+                                 5161836677717.0 / 13612068292357.0,
+                                 1720146321549.0 / 2090206949498.0,
+                                 3134564353537.0 / 4481467310338.0,
+                                 2277821191437.0 / 14882151754819.0};
+static const double LSRK4_T[] = {0.0, 1432997174477.0 / 9575080441755.0,
+                                 2526269341429.0 / 6820363962896.0,
+                                 2006345519317.0 / 3224310063776.0,
+                                 2802321613138.0 / 2924317926251.0};
+//=============================================================
+
 // coefficients for RK 45 solver ==============================
 static const double RK_5_C[] = {16.0 / 135.0,    0.0,         6656.0 / 12825.0,
                                 28561.0 / 56430, -9.0 / 50.0, 2.0 / 55.0};
-static const double RK_4_C[] = {25.0 / 216.0, 0.0, 1408.0 / 2565.0,
-                                2197.0 / 4101.0, -1.0 / 5.0};
+// the last stage does not enter the 4th order solution, the trailing 0 lets
+// the embedded pair be read with the same stage count as RK_5_C
+static const double RK_4_C[] = {25.0 / 216.0,    0.0,         1408.0 / 2565.0,
+                                2197.0 / 4104.0, -1.0 / 5.0, 0.0};
 
 static const double RK_T[] = {1.0, 1.0 / 4.0, 3.0 / 8.0, 12.0 / 13.0, 1.0, 0.5};
 
@@ -87,6 +118,10 @@ class RK_SOLVER : public RK {
     /** @brief unzip physical constrint vars*/
     DendroScalar **m_uiUnzipConstraintVars;
 
+    /**@brief persistent ghost exchange of the evolution vars, rebuilt when
+     * the mesh changes*/
+    dsolve::GhostExchangePlan m_uiGhostPlan;
+
     /**Send node bufferes for async communication*/
     DendroScalar **m_uiSendNodeBuf;
 
@@ -105,6 +140,9 @@ class RK_SOLVER : public RK {
     /**@brief mpi recv status to sync on recv*/
     MPI_Status **m_uiRecvSts;
 
+    /**@brief writes the checkpoint files, possibly in the background*/
+    dsolve::CheckpointWriter m_uiCheckpointWriter;
+
    public:
     /**
      * @brief default constructor
@@ -160,6 +198,35 @@ class RK_SOLVER : public RK {
     /**@brief zip all the variables specified in VARS*/
     void zipVars(DendroScalar **uzipIn, DendroScalar **zipOut);
 
+    /**
+     * @brief applies the compact filter (SOLVER_FILTER_TYPE) in place to the
+     * zipped variables: ghost exchange, unzip, solverFilter, zip.
+     * @param[in,out] zipIn: zipped evolution variables.
+     */
+    void filterVars(DendroScalar **zipIn);
+
+    /**
+     * @brief NaN/Inf guard of the zipped variables (see health_check.h). If
+     * any rank finds one, the bad blocks are written out and the run is
+     * aborted. Collective on the global communicator.
+     * @param[in] zipIn: zipped evolution variables.
+     */
+    void checkHealth(DendroScalar **zipIn);
+
+    /**
+     * @brief zip the RHS into the stage storage and apply the stage update
+     * varOut = prevVar + dt * sum_s coeffs[s] * stage[s] one variable at a
+     * time, so each variable is streamed through once right after its zip.
+     * @param[in] uzipRHS: unzipped RHS of the current stage
+     * @param[in] stage: stage index the RHS is zipped into
+     * @param[in] coeffs: weights of stages 0..stage, zero weights are skipped
+     * @param[in] prevVar: solution at the beginning of the time step
+     * @param[out] varOut: updated solution
+     */
+    void zipAndUpdateStage(DendroScalar **uzipRHS, const unsigned int stage,
+                           const double *coeffs, DendroScalar **prevVar,
+                           DendroScalar **varOut);
+
     /** @brief write the solution to vtu file. */
     void writeToVTU(DendroScalar **evolZipVarIn, DendroScalar **constrZipVarIn,
                     unsigned int numEvolVars, unsigned int numConstVars,
@@ -187,6 +254,19 @@ class RK_SOLVER : public RK {
      * iteration */
     void performSingleIterationRK45();
 
+    /**
+     * @brief Implementation of the low-storage (2N) Runge-Kutta methods for a
+     * single iteration. m_uiVarIm holds the dU register and no stage storage
+     * is allocated.
+     * @param[in] A: dU weights of each stage
+     * @param[in] B: solution update weights of each stage
+     * @param[in] T: time offsets of each stage (in units of dt)
+     * @param[in] numStages: number of stages
+     */
+    void performSingleIterationLSRK(const double *A, const double *B,
+                                    const double *T,
+                                    const unsigned int numStages);
+
     /** @brief: Implementation of the base class time step function*/
     void performSingleIteration();
 
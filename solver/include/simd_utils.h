@@ -0,0 +1,78 @@
+/**
+ * @file simd_utils.h
+ * @brief Portable vectorization hints and runtime CPU dispatch for the
+ * derivative stencils and the pointwise RHS loops.
+ *
+ * SOLVER_SIMD_LOOP(len) goes right before an innermost loop without loop
+ * carried dependencies. It is "omp simd" on any OpenMP 4 compiler (OpenMP is
+ * required by the build), the old vector/ivdep pragmas on the Intel compiler,
+ * and the GCC/Clang specific hints otherwise. It is empty unless
+ * SOLVER_ENABLE_AVX is defined.
+ *
+ * SOLVER_SIMD_CLONES marks a hot function to be compiled once per instruction
+ * set level (AVX-512, AVX2/FMA and the baseline). The loader picks the best
+ * clone for the CPU the binary runs on, so one build serves mixed clusters.
+ * It needs ifunc support (x86-64 Linux/glibc with GCC >= 6 or Clang >= 14)
+ * and is empty everywhere else or unless SOLVER_ENABLE_SIMD_DISPATCH is
+ * defined.
+ */
+#pragma once
+
+// pulls in features.h, which defines __GLIBC__ for the ifunc check below
+#include <cstdlib>
+
+#define SOLVER_PRAGMA_(x) _Pragma(#x)
+#define SOLVER_PRAGMA(x) SOLVER_PRAGMA_(x)
+
+#ifdef SOLVER_ENABLE_AVX
+#if defined(__INTEL_COMPILER)
+#define SOLVER_SIMD_LOOP(len)                            \
+    SOLVER_PRAGMA(vector vectorlength(len) vecremainder) \
+    SOLVER_PRAGMA(ivdep)
+#elif defined(_OPENMP) && _OPENMP >= 201307
+#define SOLVER_SIMD_LOOP(len) SOLVER_PRAGMA(omp simd)
+#elif defined(__clang__)
+#define SOLVER_SIMD_LOOP(len) SOLVER_PRAGMA(clang loop vectorize(enable))
+#elif defined(__GNUC__)
+#define SOLVER_SIMD_LOOP(len) SOLVER_PRAGMA(GCC ivdep)
+#endif
+#endif
+
+#ifndef SOLVER_SIMD_LOOP
+#define SOLVER_SIMD_LOOP(len)
+#endif
+
+// the unrolled stencil taps only vectorize once they are fully inlined into
+// the loop, which the inliner's size budget does not guarantee in the bigger
+// fused kernels
+#if defined(__GNUC__) || defined(__clang__)
+#define SOLVER_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SOLVER_FORCE_INLINE __forceinline
+#else
+#define SOLVER_FORCE_INLINE inline
+#endif
+
+#if defined(SOLVER_ENABLE_SIMD_DISPATCH) && defined(__x86_64__) && \
+    defined(__linux__) && defined(__GLIBC__) && !defined(__INTEL_COMPILER)
+#if defined(__clang__)
+#if __clang_major__ >= 14
+#define SOLVER_SIMD_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#elif defined(__GNUC__)
+#if __GNUC__ >= 12
+// the x86-64 micro-architecture levels also turn on FMA for the AVX2 clone
+#define SOLVER_SIMD_CLONES                                           \
+    __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", \
+                                 "default")))
+#elif __GNUC__ >= 6
+#define SOLVER_SIMD_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#endif
+
+#ifndef SOLVER_SIMD_CLONES
+#define SOLVER_SIMD_CLONES
+#endif
@@ -13,13 +13,17 @@
 
 #pragma once
 #include <iostream>
+#include <vector>
 
 #include "checkPoint.h"
+#include "checkpointWriter.h"
 #include "ctx.h"
 #include "dataUtils.h"
 #include "derivs.h"
+#include "ghost_exchange.h"
 #include "grDef.h"
 #include "grUtils.h"
+#include "health_check.h"
 #include "mathMeshUtils.h"
 #include "oct2vtk.h"
 #include "parUtils.h"
@@ -67,6 +71,43 @@ class SOLVERCtx : public ts::Ctx<SOLVERCtx, DendroScalar, unsigned int> {
      * timestep */
     bool m_analyticalComputed = false;
 
+    /** @brief: writes the checkpoint files, possibly in the background */
+    CheckpointWriter m_uiCheckpointWriter;
+
+    /** @brief: local blocks whose unzip reads no ghost nodes, their RHS runs
+     * while the ghost exchange is in flight */
+    std::vector<ot::Block> m_uiIndepBlocks;
+
+    /** @brief: local blocks that need ghost nodes */
+    std::vector<ot::Block> m_uiDepBlocks;
+
+    /** @brief: local block ids of m_uiIndepBlocks and m_uiDepBlocks, each
+     * group is unzipped on its own */
+    std::vector<unsigned int> m_uiIndepBlkIds;
+    std::vector<unsigned int> m_uiDepBlkIds;
+
+    /** @brief: persistent ghost exchange of the evolution variables, rebuilt
+     * with the mpi ctx whenever the mesh changes */
+    GhostExchangePlan m_uiGhostPlan;
+
+    /** @brief: false once the mesh changed, the block split above is redone
+     * on the next rhs call */
+    bool m_uiBlkSplitSynced = false;
+
+    /** @brief: sorts the local blocks into m_uiIndepBlocks and m_uiDepBlocks
+     * by unzipping a probe vector that is NaN on the ghost nodes */
+    void split_blocks_by_ghost_dependence();
+
+    /** @brief: true while CPU_EV_UZ_IN holds the unzip of the current
+     * evolution variables, so the remesh test, the constraints and the first
+     * stage of the next step share one exchange and unzip. Cleared by rhs,
+     * the filter, any mesh change and resetForNextStep */
+    bool m_uiEvUnzipSynced = false;
+
+    /** @brief: unzips the evolution variables into CPU_EV_UZ_IN unless they
+     * are there already */
+    void unzip_evolution_vars();
+
    public:
     /**@brief: default constructor*/
     SOLVERCtx(ot::Mesh *pMesh);
@@ -83,6 +124,7 @@ class SOLVERCtx : public ts::Ctx<SOLVERCtx, DendroScalar, unsigned int> {
     void resetForNextStep() {
         m_analyticalComputed = false;
         m_constraintsComputed = false;
+        m_uiEvUnzipSynced = false;
     }
 
     /**
@@ -169,6 +211,22 @@ class SOLVERCtx : public ts::Ctx<SOLVERCtx, DendroScalar, unsigned int> {
     /**@brief: function execute after each step*/
     int post_timestep(DVec &sIn);
 
+    /**
+     * @brief applies the compact filter (SOLVER_FILTER_TYPE) in place to the
+     * evolution variables. Called from post_timestep every SOLVER_FILTER_FREQ
+     * steps.
+     * @param sIn: time synced evolution vector.
+     */
+    void filter(DVec &sIn);
+
+    /**
+     * @brief checks the evolution variables for NaN and Inf. If any rank
+     * finds one, the offending blocks are written out (see health_check.h)
+     * and the run is aborted with MPI_Abort.
+     * @param sIn: time synced evolution vector.
+     */
+    void check_health(DVec &sIn);
+
     /**@brief: function execute after each step*/
     bool is_remesh();
 
@@ -18,6 +18,8 @@
 #include "solverCtx.h"
 #include "enuts.h"
 #include "ets.h"
+#include "lsrk.h"
+#include "adaptive_rk.h"
 
 #define BLD "\033[1m"
 
@@ -0,0 +1,55 @@
+#ifndef SOURCES_H
+#define SOURCES_H
+
+/**
+ * @file sources.h
+ * @brief Charge and current density sources (rho_e and J) of the evolution
+ * equations.
+ *
+ * Without SOLVER_ENABLE_SOURCES the sources are compiled out. rho_e, J0, J1
+ * and J2 in the RHS are then ZeroSource objects whose zeros fold away in the
+ * generated equations, so the block RHS does no allocation and no
+ * initialization for them.
+ *
+ * With SOLVER_ENABLE_SOURCES the four fields are taken from the thread's
+ * memory pool and filled per block by the function given to
+ * set_source_function (zero everywhere until one is set).
+ */
+
+namespace dsolve {
+
+/** @brief Stand-in for an absent source field, every point reads zero. */
+struct ZeroSource {
+    constexpr double operator[](const unsigned int) const { return 0.0; }
+};
+
+/**
+ * @brief Fills rho_e, J0, J1 and J2 at every point of a padded block.
+ *
+ * @param[out] rho_e Charge density.
+ * @param[out] J0, J1, J2 Current density.
+ * @param[in] pmin, pmax Coordinates of the corners of the padded block.
+ * @param[in] sz Block size, the grid spacing is (pmax - pmin) / (sz - 1).
+ */
+typedef void (*SourceFunction)(double *const rho_e, double *const J0,
+                               double *const J1, double *const J2,
+                               const double *pmin, const double *pmax,
+                               const unsigned int *sz);
+
+/** @brief Source fields that are zero everywhere, the default. */
+void zero_sources(double *const rho_e, double *const J0, double *const J1,
+                  double *const J2, const double *pmin, const double *pmax,
+                  const unsigned int *sz);
+
+/**
+ * @brief Sets the function evaluating the sources. Only used when the solver
+ * is built with SOLVER_ENABLE_SOURCES.
+ */
+void set_source_function(SourceFunction f);
+
+/** @brief The function evaluating the sources, zero_sources by default. */
+SourceFunction get_source_function();
+
+}  // namespace dsolve
+
+#endif
@@ -0,0 +1,664 @@
+/**
+ * @file stencil_derivs.h
+ * @brief Compile-time generated explicit finite difference stencils.
+ *
+ * Every explicit derivative family (deriv42, deriv644, deriv8642, ...) and the
+ * Kreiss-Oliger dissipation operators are instances of the same kernel: a
+ * centred interior stencil and, on physical boundaries, a set of one-sided
+ * closure rows. The families only differ in their coefficient tables, so the
+ * tables live in small structs below and a single kernel template is
+ * instantiated for each (table, direction, padding width) combination.
+ *
+ * The stencil taps are unrolled at compile time and zero coefficients of the
+ * interior stencils are dropped, so every family gets the same innermost loop
+ * over the contiguous x index.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "derivs.h"
+
+namespace dendro_derivs {
+
+/**
+ * @brief Coefficient table layout shared by all of the stencils below.
+ *
+ * - ORDER: power of 1/h the stencil is scaled by
+ * - HALF_WIDTH: interior stencil covers u[i - HALF_WIDTH .. i + HALF_WIDTH]
+ * - NUM_CLOSURE: number of boundary points that use a closure row
+ * - CLOSURE_WIDTH: closure row b covers the first CLOSURE_WIDTH points of the
+ *   domain, starting at the boundary point itself (not at point b)
+ * - PARITY: the right closures are the mirrored left ones times PARITY, -1 for
+ *   odd derivatives and +1 for even derivatives and dissipation
+ *
+ * Each row is a list of numerators over a single denominator, as the stencils
+ * are usually written.
+ */
+#define DENDRO_DERIVS_STENCIL_TRAITS(order, half_width, num_closure,        \
+                                     closure_width, parity)                  \
+    static constexpr int ORDER = order;                                      \
+    static constexpr int HALF_WIDTH = half_width;                            \
+    static constexpr int NUM_CLOSURE = num_closure;                          \
+    static constexpr int CLOSURE_WIDTH = closure_width;                      \
+    static constexpr double PARITY = parity;
+
+/** @brief 4th order 1st derivative, 2nd order closure (deriv42_x) */
+struct StencilD1_42 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 2, 2, 3, -1.0)
+    static constexpr double interior[5] = {1.0, -8.0, 0.0, 8.0, -1.0};
+    static constexpr double interior_den = 12.0;
+    static constexpr double closure[2][3] = {{-3.0, 4.0, -1.0},
+                                             {-1.0, 0.0, 1.0}};
+    static constexpr double closure_den[2] = {2.0, 2.0};
+};
+
+/** @brief 4th order 2nd derivative, 2nd order closure (deriv42_xx) */
+struct StencilD2_42 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 2, 2, 4, 1.0)
+    static constexpr double interior[5] = {-1.0, 16.0, -30.0, 16.0, -1.0};
+    static constexpr double interior_den = 12.0;
+    static constexpr double closure[2][4] = {{2.0, -5.0, 4.0, -1.0},
+                                             {1.0, -2.0, 1.0, 0.0}};
+    static constexpr double closure_den[2] = {1.0, 1.0};
+};
+
+/** @brief 6th order 1st derivative, 4th order closure (deriv644_x) */
+struct StencilD1_644 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 3, 3, 5, -1.0)
+    static constexpr double interior[7] = {-1.0, 9.0,  -45.0, 0.0,
+                                           45.0, -9.0, 1.0};
+    static constexpr double interior_den = 60.0;
+    static constexpr double closure[3][5] = {{-25.0, 48.0, -36.0, 16.0, -3.0},
+                                             {-3.0, -10.0, 18.0, -6.0, 1.0},
+                                             {1.0, -8.0, 0.0, 8.0, -1.0}};
+    static constexpr double closure_den[3] = {12.0, 12.0, 12.0};
+};
+
+/** @brief 6th order 2nd derivative, 4th order closure (deriv644_xx) */
+struct StencilD2_644 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 3, 3, 6, 1.0)
+    static constexpr double interior[7] = {2.0,   -27.0, 270.0, -490.0,
+                                           270.0, -27.0, 2.0};
+    static constexpr double interior_den = 180.0;
+    static constexpr double closure[3][6] = {
+        {45.0, -154.0, 214.0, -156.0, 61.0, -10.0},
+        {10.0, -15.0, -4.0, 14.0, -6.0, 1.0},
+        {-1.0, 16.0, -30.0, 16.0, -1.0, 0.0}};
+    static constexpr double closure_den[3] = {12.0, 12.0, 12.0};
+};
+
+/** @brief 6th order 1st derivative, 2nd order closure (deriv642_x) */
+struct StencilD1_642 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 3, 3, 5, -1.0)
+    static constexpr double interior[7] = {-1.0, 9.0,  -45.0, 0.0,
+                                           45.0, -9.0, 1.0};
+    static constexpr double interior_den = 60.0;
+    static constexpr double closure[3][5] = {{-3.0, 4.0, -1.0, 0.0, 0.0},
+                                             {-1.0, 0.0, 1.0, 0.0, 0.0},
+                                             {1.0, -8.0, 0.0, 8.0, -1.0}};
+    static constexpr double closure_den[3] = {2.0, 2.0, 12.0};
+};
+
+/** @brief 6th order 2nd derivative, 2nd order closure (deriv642_xx) */
+struct StencilD2_642 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 3, 3, 5, 1.0)
+    static constexpr double interior[7] = {2.0,   -27.0, 270.0, -490.0,
+                                           270.0, -27.0, 2.0};
+    static constexpr double interior_den = 180.0;
+    static constexpr double closure[3][5] = {{2.0, -5.0, 4.0, -1.0, 0.0},
+                                             {1.0, -2.0, 1.0, 0.0, 0.0},
+                                             {-1.0, 16.0, -30.0, 16.0, -1.0}};
+    static constexpr double closure_den[3] = {1.0, 1.0, 12.0};
+};
+
+/** @brief 8th order 1st derivative, 6/4/2 order closure (deriv8642_x) */
+struct StencilD1_8642 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 4, 4, 7, -1.0)
+    static constexpr double interior[9] = {3.0,   -32.0, 168.0, -672.0, 0.0,
+                                           672.0, -168.0, 32.0, -3.0};
+    static constexpr double interior_den = 840.0;
+    static constexpr double closure[4][7] = {
+        {-3.0, 4.0, -1.0, 0.0, 0.0, 0.0, 0.0},
+        {-1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0, -8.0, 0.0, 8.0, -1.0, 0.0, 0.0},
+        {-1.0, 9.0, -45.0, 0.0, 45.0, -9.0, 1.0}};
+    static constexpr double closure_den[4] = {2.0, 2.0, 12.0, 60.0};
+};
+
+/** @brief 8th order 2nd derivative, 6/4/2 order closure (deriv8642_xx) */
+struct StencilD2_8642 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 4, 4, 7, 1.0)
+    static constexpr double interior[9] = {-9.0,    128.0,  -1008.0,
+                                           8064.0,  -14350.0, 8064.0,
+                                           -1008.0, 128.0,  -9.0};
+    static constexpr double interior_den = 5040.0;
+    static constexpr double closure[4][7] = {
+        {2.0, -5.0, 4.0, -1.0, 0.0, 0.0, 0.0},
+        {1.0, -2.0, 1.0, 0.0, 0.0, 0.0, 0.0},
+        {-1.0, 16.0, -30.0, 16.0, -1.0, 0.0, 0.0},
+        {2.0, -27.0, 270.0, -490.0, 270.0, -27.0, 2.0}};
+    static constexpr double closure_den[4] = {1.0, 1.0, 12.0, 180.0};
+};
+
+/** @brief 8th order 1st derivative, 6/4 order closure (deriv8664_x) */
+struct StencilD1_8664 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 4, 4, 7, -1.0)
+    static constexpr double interior[9] = {3.0,   -32.0, 168.0, -672.0, 0.0,
+                                           672.0, -168.0, 32.0, -3.0};
+    static constexpr double interior_den = 840.0;
+    static constexpr double closure[4][7] = {
+        {-25.0, 48.0, -36.0, 16.0, -3.0, 0.0, 0.0},
+        {-3.0, -10.0, 18.0, -6.0, 1.0, 0.0, 0.0},
+        {2.0, -24.0, -35.0, 80.0, -30.0, 8.0, -1.0},
+        {-1.0, 9.0, -45.0, 0.0, 45.0, -9.0, 1.0}};
+    static constexpr double closure_den[4] = {12.0, 12.0, 60.0, 60.0};
+};
+
+/** @brief 8th order 2nd derivative, 6/4 order closure (deriv8664_xx) */
+struct StencilD2_8664 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 4, 4, 8, 1.0)
+    static constexpr double interior[9] = {-9.0,    128.0,  -1008.0,
+                                           8064.0,  -14350.0, 8064.0,
+                                           -1008.0, 128.0,  -9.0};
+    static constexpr double interior_den = 5040.0;
+    static constexpr double closure[4][8] = {
+        {45.0, -154.0, 214.0, -156.0, 61.0, -10.0, 0.0, 0.0},
+        {10.0, -15.0, -4.0, 14.0, -6.0, 1.0, 0.0, 0.0},
+        {-11.0, 214.0, -378.0, 130.0, 85.0, -54.0, 16.0, -2.0},
+        {2.0, -27.0, 270.0, -490.0, 270.0, -27.0, 2.0, 0.0}};
+    static constexpr double closure_den[4] = {12.0, 12.0, 180.0, 180.0};
+};
+
+/** @brief 8th order 1st derivative, 6th order closure (deriv8666_x) */
+struct StencilD1_8666 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 4, 4, 7, -1.0)
+    static constexpr double interior[9] = {3.0,   -32.0, 168.0, -672.0, 0.0,
+                                           672.0, -168.0, 32.0, -3.0};
+    static constexpr double interior_den = 840.0;
+    static constexpr double closure[4][7] = {
+        {-147.0, 360.0, -450.0, 400.0, -225.0, 72.0, -10.0},
+        {-10.0, -77.0, 150.0, -100.0, 50.0, -15.0, 2.0},
+        {2.0, -24.0, -35.0, 80.0, -30.0, 8.0, -1.0},
+        {-1.0, 9.0, -45.0, 0.0, 45.0, -9.0, 1.0}};
+    static constexpr double closure_den[4] = {60.0, 60.0, 60.0, 60.0};
+};
+
+/** @brief 8th order 2nd derivative, 6th order closure (deriv8666_xx) */
+struct StencilD2_8666 {
+    DENDRO_DERIVS_STENCIL_TRAITS(2, 4, 4, 8, 1.0)
+    static constexpr double interior[9] = {-9.0,    128.0,  -1008.0,
+                                           8064.0,  -14350.0, 8064.0,
+                                           -1008.0, 128.0,  -9.0};
+    static constexpr double interior_den = 5040.0;
+    static constexpr double closure[4][8] = {
+        {938.0, -4014.0, 7911.0, -9490.0, 7380.0, -3618.0, 1019.0, -126.0},
+        {126.0, -70.0, -486.0, 855.0, -670.0, 324.0, -90.0, 11.0},
+        {-11.0, 214.0, -378.0, 130.0, 85.0, -54.0, 16.0, -2.0},
+        {2.0, -27.0, 270.0, -490.0, 270.0, -27.0, 2.0, 0.0}};
+    static constexpr double closure_den[4] = {180.0, 180.0, 180.0, 180.0};
+};
+
+/** @brief 4th derivative Kreiss-Oliger dissipation (ko_deriv21_x) */
+struct StencilKO_21 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 2, 2, 3, 1.0)
+    static constexpr double interior[5] = {-1.0, 4.0, -6.0, 4.0, -1.0};
+    static constexpr double interior_den = 16.0;
+    static constexpr double closure[2][3] = {{1.0, -2.0, 1.0},
+                                             {1.0, -2.0, 1.0}};
+    static constexpr double closure_den[2] = {4.0, 4.0};
+};
+
+/** @brief 6th derivative Kreiss-Oliger dissipation (ko_deriv42_x) */
+struct StencilKO_42 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 3, 3, 6, 1.0)
+    static constexpr double interior[7] = {1.0,  -6.0, 15.0, -20.0,
+                                           15.0, -6.0, 1.0};
+    static constexpr double interior_den = 64.0;
+    static constexpr double closure[3][6] = {
+        {-1.0, 3.0, -3.0, 1.0, 0.0, 0.0},
+        {3.0, -10.0, 12.0, -6.0, 1.0, 0.0},
+        {-3.0, 12.0, -19.0, 15.0, -6.0, 1.0}};
+    static constexpr double closure_den[3] = {
+        59.0 / 48.0 * 64.0, 43.0 / 48.0 * 64.0, 49.0 / 48.0 * 64.0};
+};
+
+/** @brief 8th derivative Kreiss-Oliger dissipation (ko_deriv64_x) */
+struct StencilKO_64 {
+    DENDRO_DERIVS_STENCIL_TRAITS(1, 4, 4, 7, 1.0)
+    static constexpr double interior[9] = {-1.0, 8.0,   -28.0, 56.0, -70.0,
+                                           56.0, -28.0, 8.0,   -1.0};
+    static constexpr double interior_den = 256.0;
+    static constexpr double closure[4][7] = {
+        {-1.0, 4.0, -6.0, 4.0, -1.0, 0.0, 0.0},
+        {3.0, -11.0, 15.0, -9.0, 2.0, 0.0, 0.0},
+        {-3.0, 9.0, -8.0, 0.0, 3.0, -1.0, 0.0},
+        {1.0, -1.0, -6.0, 15.0, -14.0, 6.0, -1.0}};
+    static constexpr double closure_den[4] = {
+        17.0 / 48.0 * 256.0, 59.0 / 48.0 * 256.0, 43.0 / 48.0 * 256.0,
+        49.0 / 48.0 * 256.0};
+};
+
+#undef DENDRO_DERIVS_STENCIL_TRAITS
+
+/**
+ * @brief Unrolled dot product of N stencil taps, c[m] * u[m * s].
+ *
+ * Taps whose coefficient is a compile-time zero fold away once the kernel is
+ * inlined with one of the constexpr tables above.
+ */
+template <int M, int N>
+struct StencilTaps {
+    static SOLVER_FORCE_INLINE double sum(const double acc,
+                                          const double *const c,
+                                          const double *const u,
+                                          const int s) {
+        return StencilTaps<M + 1, N>::sum(
+            (c[M] == 0.0) ? acc : acc + c[M] * u[M * s], c, u, s);
+    }
+};
+
+template <int N>
+struct StencilTaps<N, N> {
+    static SOLVER_FORCE_INLINE double sum(const double acc,
+                                          const double *const,
+                                          const double *const, const int) {
+        return acc;
+    }
+};
+
+template <int N>
+SOLVER_FORCE_INLINE double stencil_taps(const double *const c,
+                                        const double *const u, const int s) {
+    return StencilTaps<1, N>::sum(c[0] * u[0], c, u, s);
+}
+
+/**
+ * @brief Per-block setup of the stencil S along direction DIR (0, 1, 2 for x,
+ * y, z): the scalings and the number of closure points on each face. apply()
+ * then differentiates one x line of the interior [PW, n - PW)^3, so that
+ * several stencils can share a single sweep over the block.
+ */
+template <class S, unsigned DIR, unsigned PW>
+struct StencilLine {
+    static_assert(DIR < 3, "stencil direction must be 0, 1 or 2");
+    static_assert(S::ORDER == 1 || S::ORDER == 2,
+                  "only 1st and 2nd order scalings are supported");
+    static_assert(S::HALF_WIDTH <= (int)PW,
+                  "stencil is wider than the padding region");
+
+    static const int NW = 2 * S::HALF_WIDTH + 1;
+    static const int CW = S::CLOSURE_WIDTH;
+
+    int ib, ie;  // interior along x
+    int qb, qe;  // interior along DIR
+    int s;       // stride along DIR
+    int nl, nr;  // closure points on the left and right faces
+    double scale;
+    double lscale[S::NUM_CLOSURE];
+    double rscale[S::NUM_CLOSURE];
+
+    StencilLine(const double h, const unsigned int *sz, unsigned bflag) {
+        const unsigned left = (DIR == 0)   ? OCT_DIR_LEFT
+                              : (DIR == 1) ? OCT_DIR_DOWN
+                                           : OCT_DIR_BACK;
+        const unsigned right = (DIR == 0)   ? OCT_DIR_RIGHT
+                               : (DIR == 1) ? OCT_DIR_UP
+                                            : OCT_DIR_FRONT;
+        ib = PW;
+        ie = (int)sz[0] - PW;
+        qb = PW;
+        qe = (int)sz[DIR] - PW;
+        s = (DIR == 0) ? 1 : ((DIR == 1) ? sz[0] : sz[0] * sz[1]);
+        nl = (bflag & (1u << left)) ? S::NUM_CLOSURE : 0;
+        nr = (bflag & (1u << right)) ? S::NUM_CLOSURE : 0;
+
+        const double inv_h = (S::ORDER == 1) ? 1.0 / h : 1.0 / (h * h);
+        scale = inv_h / S::interior_den;
+        for (int b = 0; b < S::NUM_CLOSURE; b++) {
+            lscale[b] = inv_h / S::closure_den[b];
+            rscale[b] = S::PARITY * lscale[b];
+        }
+    }
+
+    /**
+     * @brief Closure row b on a y or z line. b is matched against B at
+     * compile time so that the zero taps of the row fold away, as they do for
+     * the interior stencil, and the loop stays branch free.
+     */
+    template <int B>
+    SOLVER_FORCE_INLINE void closure_line(double *const Dl,
+                                          const double *const ub,
+                                          const int t,
+                                          const double *const cscale,
+                                          const int b) const {
+        if (B + 1 < S::NUM_CLOSURE && b != B) {
+            closure_line<(B + 1 < S::NUM_CLOSURE) ? B + 1 : B>(Dl, ub, t,
+                                                                cscale, b);
+            return;
+        }
+        SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+        for (int i = ib; i < ie; i++)
+            Dl[i] = cscale[B] * stencil_taps<CW>(S::closure[B], ub + i, t);
+    }
+
+    /**
+     * @brief Differentiates the x line starting at row = IDX(0, j, k) of u.
+     * Dl is the matching output line, the result for point i goes to Dl[i].
+     */
+    SOLVER_FORCE_INLINE void apply(double *const Dl, const double *const u,
+                                   const int row, const int j,
+                                   const int k) const {
+        if (DIR == 0) {
+            // closures sit at the ends of each x line
+            const double *const ul = u + row + qb;
+            const double *const ur = u + row + qe - 1;
+            for (int b = 0; b < nl; b++)
+                Dl[qb + b] =
+                    lscale[b] * stencil_taps<CW>(S::closure[b], ul, 1);
+            for (int b = 0; b < nr; b++)
+                Dl[qe - 1 - b] =
+                    rscale[b] * stencil_taps<CW>(S::closure[b], ur, -1);
+
+            const double *const uc = u + row - S::HALF_WIDTH;
+            SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+            for (int i = ib + nl; i < ie - nr; i++)
+                Dl[i] = scale * stencil_taps<NW>(S::interior, uc + i, 1);
+            return;
+        }
+
+        // y and z: the whole x line shares one row of coefficients
+        const int q = (DIR == 1) ? j : k;
+        // on small blocks the right closure wins, as it is applied last
+        if (q >= qe - nr) {
+            const double *const ur = u + row + (qe - 1 - q) * s;
+            closure_line<0>(Dl, ur, -s, rscale, qe - 1 - q);
+        } else if (q < qb + nl) {
+            const double *const ul = u + row + (qb - q) * s;
+            closure_line<0>(Dl, ul, s, lscale, q - qb);
+        } else {
+            const double *const uc = u + row - S::HALF_WIDTH * s;
+            SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+            for (int i = ib; i < ie; i++)
+                Dl[i] = scale * stencil_taps<NW>(S::interior, uc + i, s);
+        }
+    }
+
+    /**
+     * @brief Derivative at the single point pp, whose index along DIR is q.
+     * Same rows as apply(), for the few points on the boundary faces.
+     */
+    SOLVER_FORCE_INLINE double point(const double *const u, const int pp,
+                                     const int q) const {
+        if (q >= qe - nr) {
+            const int b = qe - 1 - q;
+            return rscale[b] *
+                   stencil_taps<CW>(S::closure[b], u + pp + b * s, -s);
+        }
+        if (q < qb + nl) {
+            const int b = q - qb;
+            return lscale[b] *
+                   stencil_taps<CW>(S::closure[b], u + pp - b * s, s);
+        }
+        return scale *
+               stencil_taps<NW>(S::interior, u + pp - S::HALF_WIDTH * s, s);
+    }
+};
+
+/**
+ * @brief Applies a first and a second derivative stencil along the same
+ * direction to one x line. On interior y and z lines both are evaluated in
+ * the same loop, so the neighbouring lines of u are loaded only once.
+ */
+template <class D1, class D2, unsigned DIR, unsigned PW>
+SOLVER_FORCE_INLINE void stencil_line_pair(
+    const StencilLine<D1, DIR, PW> &l1, const StencilLine<D2, DIR, PW> &l2,
+    double *const Du1, double *const Du2, const double *const u,
+    const int row, const int j, const int k) {
+    const int q = (DIR == 1) ? j : k;
+    const int lo = std::max(l1.qb + l1.nl, l2.qb + l2.nl);
+    const int hi = std::min(l1.qe - l1.nr, l2.qe - l2.nr);
+    if (DIR == 0 || q < lo || q >= hi) {
+        l1.apply(Du1 + row, u, row, j, k);
+        l2.apply(Du2 + row, u, row, j, k);
+        return;
+    }
+
+    const int NW1 = StencilLine<D1, DIR, PW>::NW;
+    const int NW2 = StencilLine<D2, DIR, PW>::NW;
+    const int s = l1.s;
+    const double *const u1 = u + row - D1::HALF_WIDTH * s;
+    const double *const u2 = u + row - D2::HALF_WIDTH * s;
+    SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+    for (int i = l1.ib; i < l1.ie; i++) {
+        // both sums are formed before either store, so the loads are shared
+        const double d1 = stencil_taps<NW1>(D1::interior, u1 + i, s);
+        const double d2 = stencil_taps<NW2>(D2::interior, u2 + i, s);
+        Du1[row + i] = l1.scale * d1;
+        Du2[row + i] = l2.scale * d2;
+    }
+}
+
+#ifdef DEBUG_DERIVS_COMP
+template <unsigned PW>
+void stencil_nan_check(const double *const Du, const unsigned int *sz,
+                       const char *func) {
+    const int nx = sz[0];
+    const int ny = sz[1];
+    for (int k = PW; k < (int)sz[2] - (int)PW; k++) {
+        for (int j = PW; j < ny - (int)PW; j++) {
+            for (int i = PW; i < nx - (int)PW; i++) {
+                if (std::isnan(Du[IDX(i, j, k)]))
+                    std::cout << "NAN detected function " << func
+                              << " file: " << __FILE__ << " line: " << __LINE__
+                              << std::endl;
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Applies the stencil S along direction DIR (0, 1, 2 for x, y, z) to
+ * the interior [PW, n - PW)^3 of a padded block, with the one-sided closures
+ * on the faces flagged in bflag.
+ *
+ * The signature matches the deriv_x/ko_deriv_x function pointers so that the
+ * instantiations can be handed out by set_appropriate_derivs directly. With
+ * SOLVER_ENABLE_SIMD_DISPATCH each instantiation carries AVX2 and AVX-512
+ * clones that are picked at load time.
+ */
+template <class S, unsigned DIR, unsigned PW>
+SOLVER_SIMD_CLONES void stencil_deriv(double *const Du, const double *const u,
+                                      const double h, const unsigned int *sz,
+                                      unsigned bflag) {
+    const StencilLine<S, DIR, PW> line(h, sz, bflag);
+
+    const int nx = sz[0];
+    const int ny = sz[1];
+    for (int k = PW; k < (int)sz[2] - (int)PW; k++) {
+        for (int j = PW; j < ny - (int)PW; j++) {
+            const int row = IDX(0, j, k);
+            line.apply(Du + row, u, row, j, k);
+        }
+    }
+
+#ifdef DEBUG_DERIVS_COMP
+    stencil_nan_check<PW>(Du, sz, __func__);
+#endif
+}
+
+/**
+ * @brief Fused gradient and pure second derivatives of one field: the first
+ * derivative stencil D1 and the second derivative stencil D2 along x, y and z
+ * in a single sweep over the block.
+ *
+ * All six outputs of an x line are computed while the neighbouring lines of u
+ * are still in cache, instead of streaming the whole block through six
+ * separate kernels. The results are identical to calling stencil_deriv six
+ * times.
+ */
+template <class D1, class D2, unsigned PW>
+SOLVER_SIMD_CLONES void stencil_grad_2nd(
+    double *const Dxu, double *const Dyu, double *const Dzu,
+    double *const Dxxu, double *const Dyyu, double *const Dzzu,
+    const double *const u, const double hx, const double hy, const double hz,
+    const unsigned int *sz, unsigned bflag) {
+    const StencilLine<D1, 0, PW> dx(hx, sz, bflag);
+    const StencilLine<D1, 1, PW> dy(hy, sz, bflag);
+    const StencilLine<D1, 2, PW> dz(hz, sz, bflag);
+    const StencilLine<D2, 0, PW> dxx(hx, sz, bflag);
+    const StencilLine<D2, 1, PW> dyy(hy, sz, bflag);
+    const StencilLine<D2, 2, PW> dzz(hz, sz, bflag);
+
+    const int nx = sz[0];
+    const int ny = sz[1];
+    for (int k = PW; k < (int)sz[2] - (int)PW; k++) {
+        for (int j = PW; j < ny - (int)PW; j++) {
+            const int row = IDX(0, j, k);
+            stencil_line_pair(dx, dxx, Dxu, Dxxu, u, row, j, k);
+            stencil_line_pair(dy, dyy, Dyu, Dyyu, u, row, j, k);
+            stencil_line_pair(dz, dzz, Dzu, Dzzu, u, row, j, k);
+        }
+    }
+
+#ifdef DEBUG_DERIVS_COMP
+    stencil_nan_check<PW>(Dxu, sz, __func__);
+    stencil_nan_check<PW>(Dyu, sz, __func__);
+    stencil_nan_check<PW>(Dzu, sz, __func__);
+    stencil_nan_check<PW>(Dxxu, sz, __func__);
+    stencil_nan_check<PW>(Dyyu, sz, __func__);
+    stencil_nan_check<PW>(Dzzu, sz, __func__);
+#endif
+}
+
+/**
+ * @brief Kreiss-Oliger dissipation of u added straight into its RHS,
+ * rhs += sigma * (KO_x u + KO_y u + KO_z u), over the interior of the block.
+ *
+ * Away from the boundaries the three directions are evaluated in the same
+ * loop and summed into rhs right away, instead of being written to three
+ * full block arrays and summed in a separate pass. Lines that need y or z
+ * closures go through a small line buffer.
+ */
+template <class KO, unsigned PW>
+SOLVER_SIMD_CLONES void stencil_ko_dissipation(
+    double *const rhs, const double *const u, const double sigma,
+    const double hx, const double hy, const double hz, const unsigned int *sz,
+    unsigned bflag) {
+    typedef StencilLine<KO, 0, PW> LineX;
+    const LineX kx(hx, sz, bflag);
+    const StencilLine<KO, 1, PW> ky(hy, sz, bflag);
+    const StencilLine<KO, 2, PW> kz(hz, sz, bflag);
+
+    const int nx = sz[0];
+    const int ny = sz[1];
+    const int H = KO::HALF_WIDTH;
+
+    // only blocks on the domain boundary have closure lines
+    std::vector<double> lines(bflag ? 3 * nx : 0);
+    double *const lx = lines.data();
+    double *const ly = lx + (bflag ? nx : 0);
+    double *const lz = ly + (bflag ? nx : 0);
+
+    for (int k = PW; k < (int)sz[2] - (int)PW; k++) {
+        for (int j = PW; j < ny - (int)PW; j++) {
+            const int row = IDX(0, j, k);
+            double *const rl = rhs + row;
+
+            if (j < ky.qb + ky.nl || j >= ky.qe - ky.nr ||
+                k < kz.qb + kz.nl || k >= kz.qe - kz.nr) {
+                kx.apply(lx, u, row, j, k);
+                ky.apply(ly, u, row, j, k);
+                kz.apply(lz, u, row, j, k);
+                SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+                for (int i = kx.ib; i < kx.ie; i++)
+                    rl[i] += sigma * (lx[i] + ly[i] + lz[i]);
+                continue;
+            }
+
+            // interior y/z line, only the ends can have x closures (which
+            // may overlap on small blocks, hence the clamp)
+            const int il = kx.ib + kx.nl;
+            const int ir = std::max(kx.ie - kx.nr, il);
+            for (int i = kx.ib; i < il; i++)
+                rl[i] += sigma * (kx.point(u, row + i, i) +
+                                  ky.point(u, row + i, j) +
+                                  kz.point(u, row + i, k));
+            for (int i = ir; i < kx.ie; i++)
+                rl[i] += sigma * (kx.point(u, row + i, i) +
+                                  ky.point(u, row + i, j) +
+                                  kz.point(u, row + i, k));
+
+            const double *const ux = u + row - H;
+            const double *const uy = u + row - H * ky.s;
+            const double *const uz = u + row - H * kz.s;
+            SOLVER_SIMD_LOOP(__DERIV_AVX_SIMD_LEN__)
+            for (int i = il; i < ir; i++)
+                rl[i] += sigma *
+                         (kx.scale * stencil_taps<LineX::NW>(KO::interior,
+                                                             ux + i, 1) +
+                          ky.scale * stencil_taps<LineX::NW>(KO::interior,
+                                                             uy + i, ky.s) +
+                          kz.scale * stencil_taps<LineX::NW>(KO::interior,
+                                                             uz + i, kz.s));
+        }
+    }
+}
+
+/**
+ * @brief Gradient of u with the stencil D1, but only on the outermost interior
+ * planes of the faces flagged in bflag.
+ *
+ * These are the only points where the asymptotic boundary conditions read the
+ * gradients of E and A, the RHS equations themselves do not use them, so the
+ * rest of the block is left untouched. Edge and corner points are shared by
+ * two or three faces and are simply evaluated again.
+ *
+ * The stencil rows are the ones of stencil_deriv, but the values are not
+ * bit for bit the same: the compiler contracts the taps into FMAs
+ * differently in the point-wise and the vectorized loops, which leaves
+ * differences of about 1e-14 (absolute, for O(1) fields).
+ */
+template <class D1, unsigned PW>
+void stencil_face_grad(double *const Dxu, double *const Dyu, double *const Dzu,
+                       const double *const u, const double hx, const double hy,
+                       const double hz, const unsigned int *sz,
+                       unsigned bflag) {
+    const StencilLine<D1, 0, PW> dx(hx, sz, bflag);
+    const StencilLine<D1, 1, PW> dy(hy, sz, bflag);
+    const StencilLine<D1, 2, PW> dz(hz, sz, bflag);
+
+    const unsigned faces[6] = {OCT_DIR_LEFT, OCT_DIR_RIGHT, OCT_DIR_DOWN,
+                               OCT_DIR_UP,   OCT_DIR_BACK,  OCT_DIR_FRONT};
+    const int nx = sz[0];
+    const int ny = sz[1];
+
+    for (int f = 0; f < 6; f++) {
+        if (!(bflag & (1u << faces[f]))) continue;
+
+        // the face is a single plane of the interior along direction f / 2
+        int lo[3] = {(int)PW, (int)PW, (int)PW};
+        int hi[3] = {nx - (int)PW, ny - (int)PW, (int)sz[2] - (int)PW};
+        if (f % 2 == 0)
+            hi[f / 2] = lo[f / 2] + 1;
+        else
+            lo[f / 2] = hi[f / 2] - 1;
+
+        for (int k = lo[2]; k < hi[2]; k++) {
+            for (int j = lo[1]; j < hi[1]; j++) {
+                for (int i = lo[0]; i < hi[0]; i++) {
+                    const int pp = IDX(i, j, k);
+                    Dxu[pp] = dx.point(u, pp, i);
+                    Dyu[pp] = dy.point(u, pp, j);
+                    Dzu[pp] = dz.point(u, pp, k);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace dendro_derivs
@@ -9,6 +9,15 @@
 
 using namespace dsolve;
 
+namespace dsolve {
+/**
+ * @brief Whether enforce_system_constraints below actually does anything. The
+ * generated body is empty for EM2, so the RK updates skip the per-node
+ * constraint pass entirely. Set this to true if constraints get generated.
+ */
+static const bool SOLVER_HAS_SYSTEM_CONSTRAINTS = false;
+}  // namespace dsolve
+
 /*----------------------------------------------------------------------;
  *
  * enforce physical constraints on SOLVER variables:
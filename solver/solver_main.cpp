@@ -21,22 +21,204 @@
 #include "parameters.h"
 #include "rkSolver.h"
 
+/**
+ * @brief runs the main evolution loop of the ts::Ctx based solver
+ * @param ets : time stepper (ts::ETS, ts::ExplicitNUTS, dsolve::LSRK or
+ * dsolve::AdaptiveRK)
+ * @param solverCtx : solver context evolved by the time stepper
+ * @param rank : rank on MPI_COMM_WORLD
+ * @param npes : size of MPI_COMM_WORLD
+ */
+template <typename TimeStepper>
+void evolve_with(TimeStepper* ets, dsolve::SOLVERCtx* solverCtx, int rank,
+                 int npes) {
+#if defined __PROFILE_CTX__ && defined __PROFILE_ETS__
+    std::ofstream outfile;
+    char fname[256];
+    sprintf(fname, "solverCtx_%d.txt", npes);
+    if (!rank) {
+        outfile.open(fname, std::ios_base::app);
+        time_t now = time(0);
+        // convert now to string form
+        char* dt = ctime(&now);
+        outfile << "======================================================="
+                   "====="
+                << std::endl;
+        outfile << "Current time : " << dt << " --- " << std::endl;
+        outfile << "======================================================="
+                   "====="
+                << std::endl;
+    }
+
+    ets->init_pt();
+    solverCtx->reset_pt();
+    ets->dump_pt(outfile);
+    // solverCtx->dump_pt(outfile);
+#endif
+
+    // merging
+    double t1 = MPI_Wtime();
+    bool did_print_output_time = false;
+
+    if (!rank) {
+        std::cout << CYN << BLD << "Starting to evolve through time..."
+                  << NRM << std::endl;
+    }
+
+    while (ets->curr_time() < dsolve::SOLVER_RK_TIME_END) {
+        const DendroIntL step = ets->curr_step();
+        const DendroScalar time = ets->curr_time();
+
+        dsolve::SOLVER_CURRENT_RK_COORD_TIME = time;
+        dsolve::SOLVER_CURRENT_RK_STEP = step;
+
+        const bool isActive = ets->is_active();
+
+        const unsigned int rank_global = ets->get_global_rank();
+
+        if ((step % dsolve::SOLVER_REMESH_TEST_FREQ) == 0 && step != 0) {
+            if (!rank_global)
+                std::cout << "[ETS] : Remesh time reached, checking to see "
+                             "if remesh should occur.  \n";
+
+            bool isRemesh = solverCtx->is_remesh();
+            if (isRemesh) {
+                if (!rank_global)
+                    std::cout << "[ETS] : Remesh has been triggered.  \n";
+
+                solverCtx->remesh_and_gridtransfer(
+                    dsolve::SOLVER_DENDRO_GRAIN_SZ,
+                    dsolve::SOLVER_LOAD_IMB_TOL, dsolve::SOLVER_SPLIT_FIX);
+                dsolve::deallocate_deriv_workspace();
+                dsolve::allocate_deriv_workspace(solverCtx->get_mesh(), 1);
+                ets->sync_with_mesh();
+
+                ot::Mesh* pmesh = solverCtx->get_mesh();
+                unsigned int lmin, lmax;
+                pmesh->computeMinMaxLevel(lmin, lmax);
+                if (!rank_global)
+                    printf("New min and max level = (%d, %d)\n", lmin,
+                           lmax);
+                dsolve::SOLVER_RK45_TIME_STEP_SIZE =
+                    dsolve::SOLVER_CFL_FACTOR *
+                    ((dsolve::SOLVER_COMPD_MAX[0] -
+                      dsolve::SOLVER_COMPD_MIN[0]) *
+                     ((1u << (m_uiMaxDepth - lmax)) /
+                      ((double)dsolve::SOLVER_ELE_ORDER)) /
+                     ((double)(1u << (m_uiMaxDepth))));
+                ts::TSInfo ts_in = solverCtx->get_ts_info();
+                ts_in._m_uiTh = dsolve::SOLVER_RK45_TIME_STEP_SIZE;
+                solverCtx->set_ts_info(ts_in);
+            } else {
+                if (!rank_global)
+                    std::cout << "[ETS] : Remesh *not* triggered!.  \n";
+            }
+        }
+
+        // NOTE: this is where the train,validate, etc. steps would go for
+        // ML data
+        did_print_output_time = false;
+
+        if ((step % dsolve::SOLVER_TIME_STEP_OUTPUT_FREQ) == 0) {
+            if (!rank_global)
+                std::cout << BLD << GRN << "==========\n"
+                          << "[ETS - SOLVER] : SOLVER UPDATE\n"
+                          << NRM << "\tCurrent Step: " << ets->curr_step()
+                          << "\t\tCurrent time: " << ets->curr_time()
+                          << "\tdt: " << ets->ts_size() << std::endl;
+
+            solverCtx->terminal_output();
+            did_print_output_time = true;
+        }
+
+        if ((step % dsolve::SOLVER_IO_OUTPUT_FREQ) == 0) {
+            if (!rank_global) {
+                if (!did_print_output_time) {
+                    std::cout << BLD << GRN << "==========\n"
+                              << "[ETS - SOLVER] : SOLVER UPDATE\n"
+                              << NRM
+                              << "\tCurrent Step: " << ets->curr_step()
+                              << "\t\tCurrent time: " << ets->curr_time()
+                              << "\tdt: " << ets->ts_size() << std::endl;
+                }
+
+                std::cout << BLD << BLU << "  --- NOW SAVING TO VTU" << NRM
+                          << std::endl;
+                did_print_output_time = true;
+            }
+
+            solverCtx->write_vtu();
+            if (!rank_global)
+                std::cout << BLD << GRN << "  --- FINISHED SAVING TO VTU"
+                          << NRM << std::endl;
+        }
+
+        if ((step % dsolve::SOLVER_PROFILE_OUTPUT_FREQ) == 0) {
+            if (!rank_global) {
+                if (!did_print_output_time) {
+                    std::cout << BLD << GRN << "==========\n"
+                              << "[ETS - SOLVER] : SOLVER UPDATE\n"
+                              << NRM
+                              << "\tCurrent Step: " << ets->curr_step()
+                              << "\t\tCurrent time: " << ets->curr_time()
+                              << "\tdt: " << ets->ts_size() << std::endl;
+                }
+
+                std::cout << BLD << BLU << "  --- NOW WRITING PROFILE DATA"
+                          << NRM << std::endl;
+                did_print_output_time = true;
+            }
+
+            // dsolve::timer::profileInfoIntermediate(
+            //     dsolve::SOLVER_PROFILE_FILE_PREFIX.c_str(),
+            //     solverCtx->get_mesh(), step);
+
+            // if (!rank_global)
+            //     std::cout << BLD << GRN
+            //               << "  --- FINISHED WRITING PROFILE DATA" << NRM
+            //               << std::endl;
+        }
+
+        if ((step % dsolve::SOLVER_CHECKPT_FREQ) == 0)
+            solverCtx->write_checkpt();
+
+        ets->evolve();
+        solverCtx->resetForNextStep();
+    }
+
+#if defined __PROFILE_CTX__ && defined __PROFILE_ETS__
+    ets->dump_pt(outfile);
+    // solverCtx->dump_pt(outfile);
+#endif
+
+    double t2 = MPI_Wtime() - t1;
+    double t2_g;
+    par::Mpi_Allreduce(&t2, &t2_g, 1, MPI_MAX, ets->get_global_comm());
+    if (!(ets->get_global_rank()))
+        std::cout << " ETS time (max) : " << t2_g << std::endl;
+}
+
 int main(int argc, char** argv) {
     unsigned int ts_mode = 1;
 
     if (argc < 2) {
         std::cout << "No parameter file was given, exiting..." << std::endl;
-        std::cout << "Usage: " << argv[0] << " paramFile" << std::endl;
+        std::cout << "Usage: " << argv[0] << " paramFile [ts_mode]"
+                  << std::endl;
         exit(0);
     }
 
-    // get the time stepper mode
+    // get the time stepper mode: 0 is the old RK_SOLVER, 1 ts::ETS (or LSRK,
+    // AdaptiveRK) and 2 local time stepping with ts::ExplicitNUTS
     if (argc > 2) ts_mode = std::atoi(argv[2]);
 
     // seed the randomness used later
     srand(static_cast<unsigned>(time(0)));
 
-    MPI_Init(&argc, &argv);
+    // the async checkpoint writer runs file I/O on its own thread, only the
+    // main thread calls MPI
+    int mpiThreadLevel;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &mpiThreadLevel);
     MPI_Comm comm = MPI_COMM_WORLD;
 
     int rank, npes;
@@ -111,6 +293,15 @@ int main(int argc, char** argv) {
     }
     dsolve::readParamFile(argv[1], comm);
 
+    if (dsolve::SOLVER_CHKPT_ASYNC && mpiThreadLevel < MPI_THREAD_FUNNELED) {
+        if (!rank)
+            std::cout << YLW
+                      << "  MPI does not provide MPI_THREAD_FUNNELED, "
+                         "writing checkpoints synchronously"
+                      << NRM << std::endl;
+        dsolve::SOLVER_CHKPT_ASYNC = 0;
+    }
+
     int root = std::min(1, npes - 1);
     // dump parameter file
     dsolve::dumpParamFile(std::cout, root, comm);
@@ -293,202 +484,162 @@ int main(int argc, char** argv) {
             std::cout << CYN << BLD << "Time stepper successfully initialized!"
                       << NRM << std::endl;
         }
-        ts::ETS<DendroScalar, dsolve::SOLVERCtx>* ets =
-            new ts::ETS<DendroScalar, dsolve::SOLVERCtx>(solverCtx);
-        ets->set_evolve_vars(solverCtx->get_evolution_vars());
-        if (!rank) {
-            std::cout << CYN << BLD << "Evolution variables now set..." << NRM
-                      << std::endl;
-        }
-
-        if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK3)
-            ets->set_ets_coefficients(ts::ETSType::RK3);
-        else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK4)
-            ets->set_ets_coefficients(ts::ETSType::RK4);
-        else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK45)
-            ets->set_ets_coefficients(ts::ETSType::RK5);
-
-        if (!rank) {
-            std::cout << CYN << BLD << "Now initializing time stepper..." << NRM
-                      << std::endl;
-        }
+        if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::LSRK3 ||
+            (RKType)dsolve::SOLVER_RK_TYPE == RKType::LSRK4) {
+            // low-storage schemes are not part of ts::ETS
+            dsolve::LSRK<DendroScalar, dsolve::SOLVERCtx>* lsrk =
+                new dsolve::LSRK<DendroScalar, dsolve::SOLVERCtx>(solverCtx);
+            if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::LSRK3)
+                lsrk->set_coefficients(
+                    ode::solver::LSRK3_A, ode::solver::LSRK3_B,
+                    ode::solver::LSRK3_T, dsolve::SOLVER_LSRK3_STAGES);
+            else
+                lsrk->set_coefficients(
+                    ode::solver::LSRK4_A, ode::solver::LSRK4_B,
+                    ode::solver::LSRK4_T, dsolve::SOLVER_LSRK4_STAGES);
+
+            if (!rank) {
+                std::cout << CYN << BLD
+                          << "Now initializing low-storage time stepper..."
+                          << NRM << std::endl;
+            }
 
-        ets->init();
+            lsrk->init();
 
-        if (!rank) {
-            std::cout << GRN << BLD << "...Initialized!" << NRM << std::endl;
-        }
+            if (!rank) {
+                std::cout << GRN << BLD << "...Initialized!" << NRM
+                          << std::endl;
+            }
 
-#if defined __PROFILE_CTX__ && defined __PROFILE_ETS__
-        std::ofstream outfile;
-        char fname[256];
-        sprintf(fname, "solverCtx_%d.txt", npes);
-        if (!rank) {
-            outfile.open(fname, std::ios_base::app);
-            time_t now = time(0);
-            // convert now to string form
-            char* dt = ctime(&now);
-            outfile << "======================================================="
-                       "====="
-                    << std::endl;
-            outfile << "Current time : " << dt << " --- " << std::endl;
-            outfile << "======================================================="
-                       "====="
-                    << std::endl;
-        }
+            evolve_with(lsrk, solverCtx, rank, npes);
+            delete lsrk;
+        } else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK45) {
+            // RK45 with the embedded error estimate driving dt, ts::ETS only
+            // has fixed step schemes
+            dsolve::AdaptiveRK<DendroScalar, dsolve::SOLVERCtx>* ark =
+                new dsolve::AdaptiveRK<DendroScalar, dsolve::SOLVERCtx>(
+                    solverCtx);
+            ark->set_coefficients(&ode::solver::RK_U[0][0],
+                                  ode::solver::RK_5_C, ode::solver::RK_4_C,
+                                  ode::solver::RK_T,
+                                  dsolve::SOLVER_RK45_STAGES, 4);
+
+            if (!rank) {
+                std::cout << CYN << BLD
+                          << "Now initializing adaptive time stepper (tol: "
+                          << dsolve::SOLVER_RK45_DESIRED_TOL << ")..." << NRM
+                          << std::endl;
+            }
 
-        ets->init_pt();
-        solverCtx->reset_pt();
-        ets->dump_pt(outfile);
-        // solverCtx->dump_pt(outfile);
-#endif
+            ark->init();
 
-        // merging
-        double t1 = MPI_Wtime();
-        bool did_print_output_time = false;
+            if (!rank) {
+                std::cout << GRN << BLD << "...Initialized!" << NRM
+                          << std::endl;
+            }
 
-        if (!rank) {
-            std::cout << CYN << BLD << "Starting to evolve through time..."
-                      << NRM << std::endl;
-        }
+            evolve_with(ark, solverCtx, rank, npes);
 
-        while (ets->curr_time() < dsolve::SOLVER_RK_TIME_END) {
-            const DendroIntL step = ets->curr_step();
-            const DendroScalar time = ets->curr_time();
+            if (!rank) {
+                std::cout << "[AdaptiveRK] : rejected steps: "
+                          << ark->num_rejected() << std::endl;
+            }
+            delete ark;
+        } else {
+            ts::ETS<DendroScalar, dsolve::SOLVERCtx>* ets =
+                new ts::ETS<DendroScalar, dsolve::SOLVERCtx>(solverCtx);
+            ets->set_evolve_vars(solverCtx->get_evolution_vars());
+            if (!rank) {
+                std::cout << CYN << BLD << "Evolution variables now set..."
+                          << NRM << std::endl;
+            }
 
-            dsolve::SOLVER_CURRENT_RK_COORD_TIME = time;
-            dsolve::SOLVER_CURRENT_RK_STEP = step;
+            if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK3)
+                ets->set_ets_coefficients(ts::ETSType::RK3);
+            else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK4)
+                ets->set_ets_coefficients(ts::ETSType::RK4);
 
-            const bool isActive = ets->is_active();
+            if (!rank) {
+                std::cout << CYN << BLD << "Now initializing time stepper..."
+                          << NRM << std::endl;
+            }
 
-            const unsigned int rank_global = ets->get_global_rank();
+            ets->init();
 
-            if ((step % dsolve::SOLVER_REMESH_TEST_FREQ) == 0 && step != 0) {
-                if (!rank_global)
-                    std::cout << "[ETS] : Remesh time reached, checking to see "
-                                 "if remesh should occur.  \n";
-
-                bool isRemesh = solverCtx->is_remesh();
-                if (isRemesh) {
-                    if (!rank_global)
-                        std::cout << "[ETS] : Remesh has been triggered.  \n";
-
-                    solverCtx->remesh_and_gridtransfer(
-                        dsolve::SOLVER_DENDRO_GRAIN_SZ,
-                        dsolve::SOLVER_LOAD_IMB_TOL, dsolve::SOLVER_SPLIT_FIX);
-                    dsolve::deallocate_deriv_workspace();
-                    dsolve::allocate_deriv_workspace(solverCtx->get_mesh(), 1);
-                    ets->sync_with_mesh();
-
-                    ot::Mesh* pmesh = solverCtx->get_mesh();
-                    unsigned int lmin, lmax;
-                    pmesh->computeMinMaxLevel(lmin, lmax);
-                    if (!rank_global)
-                        printf("New min and max level = (%d, %d)\n", lmin,
-                               lmax);
-                    dsolve::SOLVER_RK45_TIME_STEP_SIZE =
-                        dsolve::SOLVER_CFL_FACTOR *
-                        ((dsolve::SOLVER_COMPD_MAX[0] -
-                          dsolve::SOLVER_COMPD_MIN[0]) *
-                         ((1u << (m_uiMaxDepth - lmax)) /
-                          ((double)dsolve::SOLVER_ELE_ORDER)) /
-                         ((double)(1u << (m_uiMaxDepth))));
-                    ts::TSInfo ts_in = solverCtx->get_ts_info();
-                    ts_in._m_uiTh = dsolve::SOLVER_RK45_TIME_STEP_SIZE;
-                    solverCtx->set_ts_info(ts_in);
-                } else {
-                    if (!rank_global)
-                        std::cout << "[ETS] : Remesh *not* triggered!.  \n";
-                }
+            if (!rank) {
+                std::cout << GRN << BLD << "...Initialized!" << NRM
+                          << std::endl;
             }
 
-            // NOTE: this is where the train,validate, etc. steps would go for
-            // ML data
-            did_print_output_time = false;
+            evolve_with(ets, solverCtx, rank, npes);
+            delete ets;
+        }
 
-            if ((step % dsolve::SOLVER_TIME_STEP_OUTPUT_FREQ) == 0) {
-                if (!rank_global)
-                    std::cout << BLD << GRN << "==========\n"
-                              << "[ETS - SOLVER] : SOLVER UPDATE\n"
-                              << NRM << "\tCurrent Step: " << ets->curr_step()
-                              << "\t\tCurrent time: " << ets->curr_time()
-                              << "\tdt: " << ets->ts_size() << std::endl;
+        // cleanup
+        ot::Mesh* tmp_mesh = solverCtx->get_mesh();
+        delete solverCtx;
+        delete tmp_mesh;
 
-                solverCtx->terminal_output();
-                did_print_output_time = true;
+    } else if (ts_mode == 2) {
+        // local time stepping: a block steps with dt * getBlkTimestepFac of
+        // its level, only the finest SOLVER_LTS_TS_OFFSET levels use the
+        // global dt. ExplicitNUTS interpolates the RK stages of the coarser
+        // neighbours to the stage times of the finer blocks at the interfaces
+        if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::LSRK3 ||
+            (RKType)dsolve::SOLVER_RK_TYPE == RKType::LSRK4) {
+            if (!rank) {
+                std::cout << "[LTS error]: the low-storage RK schemes are not "
+                             "supported with local time stepping, use RK3, "
+                             "RK4 or RK45"
+                          << std::endl;
             }
+            MPI_Abort(comm, 0);
+        }
 
-            if ((step % dsolve::SOLVER_IO_OUTPUT_FREQ) == 0) {
-                if (!rank_global) {
-                    if (!did_print_output_time) {
-                        std::cout << BLD << GRN << "==========\n"
-                                  << "[ETS - SOLVER] : SOLVER UPDATE\n"
-                                  << NRM
-                                  << "\tCurrent Step: " << ets->curr_step()
-                                  << "\t\tCurrent time: " << ets->curr_time()
-                                  << "\tdt: " << ets->ts_size() << std::endl;
-                    }
-
-                    std::cout << BLD << BLU << "  --- NOW SAVING TO VTU" << NRM
-                              << std::endl;
-                    did_print_output_time = true;
-                }
-
-                solverCtx->write_vtu();
-                if (!rank_global)
-                    std::cout << BLD << GRN << "  --- FINISHED SAVING TO VTU"
-                              << NRM << std::endl;
+        // ExplicitNUTS keeps block local copies of the state and the stages
+        // between the synchronization points, a filter applied to the zipped
+        // vector from outside would not be seen by them
+        if (solverUsesCompactFilter()) {
+            if (!rank) {
+                std::cout << "[LTS error]: the compact filters are not "
+                             "supported with local time stepping, use a KO "
+                             "SOLVER_FILTER_TYPE or ts mode 0/1"
+                          << std::endl;
             }
+            MPI_Abort(comm, 0);
+        }
 
-            if ((step % dsolve::SOLVER_PROFILE_OUTPUT_FREQ) == 0) {
-                if (!rank_global) {
-                    if (!did_print_output_time) {
-                        std::cout << BLD << GRN << "==========\n"
-                                  << "[ETS - SOLVER] : SOLVER UPDATE\n"
-                                  << NRM
-                                  << "\tCurrent Step: " << ets->curr_step()
-                                  << "\t\tCurrent time: " << ets->curr_time()
-                                  << "\tdt: " << ets->ts_size() << std::endl;
-                    }
-
-                    std::cout << BLD << BLU << "  --- NOW WRITING PROFILE DATA"
-                              << NRM << std::endl;
-                    did_print_output_time = true;
-                }
+        dsolve::SOLVERCtx* solverCtx = new dsolve::SOLVERCtx(mesh);
+        ts::ExplicitNUTS<DendroScalar, dsolve::SOLVERCtx>* enuts =
+            new ts::ExplicitNUTS<DendroScalar, dsolve::SOLVERCtx>(solverCtx);
 
-                // dsolve::timer::profileInfoIntermediate(
-                //     dsolve::SOLVER_PROFILE_FILE_PREFIX.c_str(),
-                //     solverCtx->get_mesh(), step);
+        if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK3)
+            enuts->set_ets_coefficients(ts::ETSType::RK3);
+        else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK4)
+            enuts->set_ets_coefficients(ts::ETSType::RK4);
+        else if ((RKType)dsolve::SOLVER_RK_TYPE == RKType::RK45)
+            enuts->set_ets_coefficients(ts::ETSType::RK5);
 
-                // if (!rank_global)
-                //     std::cout << BLD << GRN
-                //               << "  --- FINISHED WRITING PROFILE DATA" << NRM
-                //               << std::endl;
-            }
+        if (!rank) {
+            std::cout << CYN << BLD
+                      << "Now initializing local time stepper (LTS offset: "
+                      << dsolve::SOLVER_LTS_TS_OFFSET << ")..." << NRM
+                      << std::endl;
+        }
 
-            if ((step % dsolve::SOLVER_CHECKPT_FREQ) == 0)
-                solverCtx->write_checkpt();
+        enuts->init();
 
-            ets->evolve();
-            solverCtx->resetForNextStep();
+        if (!rank) {
+            std::cout << GRN << BLD << "...Initialized!" << NRM << std::endl;
         }
 
-#if defined __PROFILE_CTX__ && defined __PROFILE_ETS__
-        ets->dump_pt(outfile);
-        // solverCtx->dump_pt(outfile);
-#endif
-
-        double t2 = MPI_Wtime() - t1;
-        double t2_g;
-        par::Mpi_Allreduce(&t2, &t2_g, 1, MPI_MAX, ets->get_global_comm());
-        if (!(ets->get_global_rank()))
-            std::cout << " ETS time (max) : " << t2_g << std::endl;
+        evolve_with(enuts, solverCtx, rank, npes);
+        delete enuts;
 
         // cleanup
         ot::Mesh* tmp_mesh = solverCtx->get_mesh();
         delete solverCtx;
         delete tmp_mesh;
-        delete ets;
 
     } else {
         // ========================================
@@ -534,6 +685,11 @@ int main(int argc, char** argv) {
         rk_solver.freeMesh();
     }
 
+#ifdef EM2_ENABLE_COMPACT_DERIVS
+    // the node-shared matrices live in an MPI window
+    dendro_cfd::cfd.free_shared_matrices();
+#endif
+
     MPI_Finalize();
 
     if (!rank) {
@@ -0,0 +1,152 @@
+/**
+ * @file checkpointWriter.cpp
+ * @brief Background writer for the .oct/.var/.cp checkpoint files.
+ */
+
+#include "checkpointWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "checkPoint.h"
+#include "parUtils.h"
+
+namespace dsolve {
+
+CheckpointWriter::~CheckpointWriter() {
+    if (m_uiIOThread.joinable()) m_uiIOThread.join();
+}
+
+void CheckpointWriter::write_files(const ot::TreeNode *octants,
+                                   size_t numOctants,
+                                   const DendroScalar *const *vars) {
+    const unsigned int rank = m_uiMesh->getMPIRank();
+    char fName[256];
+    int status = 0;
+
+    sprintf(fName, "%s_octree_%d_%d.oct", m_uiPrefix.c_str(), m_uiCpIndex,
+            rank);
+    status |= io::checkpoint::writeOctToFile(fName, octants, numOctants);
+
+    sprintf(fName, "%s_%d_%d.var", m_uiPrefix.c_str(), m_uiCpIndex, rank);
+    status |= io::checkpoint::writeVecToFile(fName, m_uiMesh, vars,
+                                             m_uiNumVars);
+
+    m_uiWriteStatus = status;
+}
+
+void CheckpointWriter::write_staged() {
+    const unsigned int dof = m_uiMesh->getDegOfFreedom();
+
+    std::vector<const DendroScalar *> vars(m_uiNumVars);
+    for (unsigned int v = 0; v < m_uiNumVars; v++)
+        vars[v] = m_uiStaging.data() + (size_t)v * dof;
+
+    write_files(m_uiOctants.data(), m_uiOctants.size(), vars.data());
+}
+
+void CheckpointWriter::write(const ot::Mesh *pMesh,
+                             const DendroScalar *const *vars,
+                             unsigned int numVars, unsigned int cpIndex,
+                             const std::string &prefix,
+                             const std::string &cpJson, bool async) {
+    // the other index has to be restorable before this one is overwritten
+    flush();
+
+    m_uiMesh = pMesh;
+    m_uiNumVars = numVars;
+    m_uiCpIndex = cpIndex;
+    m_uiPrefix = prefix;
+    m_uiCpJson = cpJson;
+    m_uiWriteStatus = 0;
+
+    const ot::TreeNode *pNodes = &(*(pMesh->getAllElements().begin() +
+                                     pMesh->getElementLocalBegin()));
+    const size_t numOctants = pMesh->getNumLocalMeshElements();
+
+    m_uiIsPending = true;
+
+    // nothing runs concurrently, write straight from the mesh and the vars
+    if (!async) {
+        write_files(pNodes, numOctants, vars);
+        flush();
+        return;
+    }
+
+    m_uiOctants.assign(pNodes, pNodes + numOctants);
+
+    // only the local nodes are written, the rest of the staging vectors is
+    // never read
+    const unsigned int dof = pMesh->getDegOfFreedom();
+    const unsigned int nodeLocalBegin = pMesh->getNodeLocalBegin();
+    const unsigned int nodeLocalEnd = pMesh->getNodeLocalEnd();
+    m_uiStaging.resize((size_t)numVars * dof);
+    for (unsigned int v = 0; v < numVars; v++) {
+        DendroScalar *const dst = m_uiStaging.data() + (size_t)v * dof;
+        const DendroScalar *const src = vars[v];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd; node++)
+            dst[node] = src[node];
+    }
+
+    m_uiIOThread = std::thread(&CheckpointWriter::write_staged, this);
+}
+
+int CheckpointWriter::flush() {
+    if (!m_uiIsPending) return 0;
+
+    if (m_uiIOThread.joinable()) m_uiIOThread.join();
+    m_uiIsPending = false;
+
+    // checkpoints are rare, don't hold a second copy of the state until the
+    // next one
+    m_uiOctants.clear();
+    m_uiOctants.shrink_to_fit();
+    m_uiStaging.clear();
+    m_uiStaging.shrink_to_fit();
+
+    MPI_Comm comm = m_uiMesh->getMPICommunicator();
+    const unsigned int rank = m_uiMesh->getMPIRank();
+
+    int statusGlobal = 0;
+    par::Mpi_Allreduce(&m_uiWriteStatus, &statusGlobal, 1, MPI_MAX, comm);
+
+    if (statusGlobal != 0) {
+        if (!rank)
+            std::cout << "[CheckpointWriter] : writing checkpoint index "
+                      << m_uiCpIndex << " failed, keeping the previous one"
+                      << std::endl;
+        return 1;
+    }
+
+    int status = 0;
+    if (!rank) {
+        // write to a temporary and rename, so a crash never leaves a
+        // truncated .cp behind
+        char fName[256];
+        sprintf(fName, "%s_step_%d.cp", m_uiPrefix.c_str(), m_uiCpIndex);
+        const std::string tmpName = std::string(fName) + ".tmp";
+        std::cout << "[CheckpointWriter] \t writing checkpoint file : "
+                  << fName << std::endl;
+
+        std::ofstream outfile(tmpName);
+        if (!outfile) {
+            std::cout << tmpName << " file open failed " << std::endl;
+            status = 1;
+        } else {
+            outfile << m_uiCpJson << std::endl;
+            outfile.close();
+            if (!outfile || std::rename(tmpName.c_str(), fName) != 0) {
+                std::cout << fName << " file write failed " << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    return status;
+}
+
+}  // namespace dsolve
@@ -1,7 +1,11 @@
 #include "compact_derivs.h"
 
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 
 #include "mpi.h"
 
@@ -48,20 +52,22 @@ CompactFiniteDiff::CompactFiniteDiff(const unsigned int num_dim,
 
     m_deriv_type = deriv_type;
     m_second_deriv_type = second_deriv_type;
-    m_filter_type = filter_type;
+    // also sets the filter beta, the filters may come from the cache
+    set_filter_type(filter_type);
     m_curr_dim_size = num_dim;
     m_padding_size = padding_size;
 
+    // the merged block sizes have to be known before the storage is
+    // allocated, an empty object has none
+    if (num_dim != 0) calculate_sizes_that_work();
+
     initialize_cfd_storage();
 
     if (num_dim == 0) {
         return;
     }
 
-    calculate_sizes_that_work();
-
-    initialize_all_cfd_matrices();
-    initialize_all_cfd_filters();
+    initialize_all_R_matrices();
 
     // then make sure we initialize our kernel type
     initialize_cfd_kernels();
@@ -71,6 +77,14 @@ CompactFiniteDiff::~CompactFiniteDiff() {
     // make sure we delete the cfd matrix to avoid memory leaks
     delete_cfd_matrices();
     delete_cfd_kernels();
+
+    delete[] m_workspaces;
+
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (m_node_comm != MPI_COMM_NULL && !finalized) {
+        MPI_Comm_free(&m_node_comm);
+    }
 }
 
 void CompactFiniteDiff::change_dim_size(const unsigned int dim_size) {
@@ -88,8 +102,7 @@ void CompactFiniteDiff::change_dim_size(const unsigned int dim_size) {
 
         // if deriv type is none, for some reason, just exit
 
-        initialize_all_cfd_matrices();
-        initialize_all_cfd_filters();
+        initialize_all_R_matrices();
         initialize_cfd_kernels();
     }
 }
@@ -97,37 +110,24 @@ void CompactFiniteDiff::change_dim_size(const unsigned int dim_size) {
 void CompactFiniteDiff::initialize_cfd_storage() {
     // NOTE: 0 indicates that it's initialized with all elements set to 0
 
-#ifdef SOLVER_ENABLE_MERGED_BLOCKS
-    for (auto &element : m_available_r_sizes) {
-        // std::cout << "Initializing storage for " << element << std::endl;
-        m_R_storage[element] = std::vector<double *>();
-
-        // then iterate through the types and build up the sizes
-        std::vector<double *> *tempVec = &m_R_storage[element];
+    allocate_R_buffer();
 
-        for (CompactDerivValueOrder ii = CompactDerivValueOrder::DERIV_NORM;
-             ii < CompactDerivValueOrder::R_MAT_END;
-             ii = static_cast<CompactDerivValueOrder>((size_t)ii + 1)) {
-            double *tempR = new double[element * element]();
-            tempVec->push_back(tempR);
-        }
-    }
+    // the scratch space is kept per thread so the derivatives and filters
+    // can be called concurrently, the matrices above are shared between them
+#ifdef _OPENMP
+    const unsigned int num_threads = omp_get_max_threads();
 #else
-    for (CompactDerivValueOrder ii = CompactDerivValueOrder::DERIV_NORM;
-         ii < CompactDerivValueOrder::R_MAT_END;
-         ii = static_cast<CompactDerivValueOrder>((size_t)ii + 1)) {
-        m_RMatrices[ii] = new double[m_curr_dim_size * m_curr_dim_size]();
-    }
+    const unsigned int num_threads = 1;
 #endif
+    if (m_num_workspaces != num_threads) {
+        delete[] m_workspaces;
+        m_num_workspaces = num_threads;
+        m_workspaces = new CFDWorkspace[m_num_workspaces];
+    }
 
-    // NOTE: the () syntax only works with C++ 11 or greater, may need to
-    // use std::fill_n(array, n, 0); to 0 set the data or use std::memset(array,
-    // 0, sizeof *array * size)
-
-    m_u1d = new double[m_curr_dim_size];
-    m_u2d = new double[m_curr_dim_size * m_curr_dim_size];
-    m_du1d = new double[m_curr_dim_size];
-    m_du2d = new double[m_curr_dim_size * m_curr_dim_size];
+    for (unsigned int t = 0; t < m_num_workspaces; t++) {
+        m_workspaces[t].initialize_line_storage(m_curr_dim_size);
+    }
 
     initialize_cfd_3dblock_workspace(m_curr_dim_size * m_curr_dim_size *
                                      m_curr_dim_size);
@@ -135,33 +135,20 @@ void CompactFiniteDiff::initialize_cfd_storage() {
 
 void CompactFiniteDiff::initialize_cfd_3dblock_workspace(
     const unsigned int max_blk_sz) {
-    if (m_max_blk_sz == max_blk_sz) {
-        // do nothing and return, memory already allocated for this size
-        return;
-    }
-
     // std::cout << "3D BLOCK INITIALIZATION SETTING MAX BLOCK SIZE TO "
     // << max_blk_sz << std::endl;
 
-    // otherwise, let's make sure we delete the workspace because we're resizing
-    delete_cfd_3dblock_workspace();
-
-    // set the value for internal purposes
+    // set the value for internal purposes, each workspace only reallocates
+    // if its size actually changes
     m_max_blk_sz = max_blk_sz;
-    m_du3d_block1 = new double[max_blk_sz];
-    m_du3d_block2 = new double[max_blk_sz];
+    for (unsigned int t = 0; t < m_num_workspaces; t++) {
+        m_workspaces[t].initialize_block_storage(max_blk_sz);
+    }
 }
 
 void CompactFiniteDiff::delete_cfd_3dblock_workspace() {
-    // only attempt to delete if it's a nullptr
-    if (m_du3d_block1 != nullptr) {
-        delete[] m_du3d_block1;
-        m_du3d_block1 = nullptr;
-    }
-
-    if (m_du3d_block2 != nullptr) {
-        delete[] m_du3d_block2;
-        m_du3d_block2 = nullptr;
+    for (unsigned int t = 0; t < m_num_workspaces; t++) {
+        m_workspaces[t].delete_block_storage();
     }
 
     // make sure we internally set the size back to 0
@@ -224,6 +211,10 @@ void CompactFiniteDiff::delete_cfd_kernels() {
 }
 
 void CompactFiniteDiff::calculate_sizes_that_work() {
+    // the storage is sized from these, so start over on every resize
+    m_matrix_size_pairs.clear();
+    m_available_r_sizes.clear();
+
     for (uint16_t i = 1; i < m_largest_fusion; i++) {
         for (uint16_t j = i; j < m_largest_fusion; j++) {
             uint32_t i_dim = (1 + i) * (m_padding_size * 2) + 1;
@@ -266,20 +257,337 @@ void CompactFiniteDiff::calculate_sizes_that_work() {
     // std::cout << std::endl;
 }
 
-void CompactFiniteDiff::initialize_all_cfd_matrices() {
+void CompactFiniteDiff::allocate_R_buffer() {
+    const size_t num_mats = CompactDerivValueOrder::R_MAT_END;
+
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    m_R_buffer_sz = 0;
     for (auto &element : m_available_r_sizes) {
-        // std::cout << "Initializing matrices for " << element << std::endl;
+        m_R_buffer_sz += num_mats * element * element;
+    }
+#else
+    m_R_buffer_sz = num_mats * m_curr_dim_size * m_curr_dim_size;
+#endif
 
-        initialize_cfd_matrix(element, m_R_storage[element].data());
+    if (m_node_comm != MPI_COMM_NULL) {
+        // node rank 0 holds the memory, the other ranks map it
+        int node_rank;
+        MPI_Comm_rank(m_node_comm, &node_rank);
+        const MPI_Aint local_sz =
+            (node_rank == 0) ? m_R_buffer_sz * sizeof(double) : 0;
+        MPI_Win_allocate_shared(local_sz, sizeof(double), MPI_INFO_NULL,
+                                m_node_comm, &m_R_buffer, &m_R_win);
+
+        MPI_Aint win_sz;
+        int disp_unit;
+        MPI_Win_shared_query(m_R_win, 0, &win_sz, &disp_unit, &m_R_buffer);
+    } else {
+        m_R_buffer = new double[m_R_buffer_sz]();
+    }
+
+    // then hand out the matrices, in the same order on every rank
+    double *next = m_R_buffer;
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    for (auto &element : m_available_r_sizes) {
+        std::vector<double *> &mats = m_R_storage[element];
+        mats.resize(num_mats);
+        for (size_t ii = 0; ii < num_mats; ii++) {
+            mats[ii] = next;
+            next += element * element;
+        }
     }
 #else
-    initialize_cfd_matrix(m_curr_dim_size, m_RMatrices);
+    for (size_t ii = 0; ii < num_mats; ii++) {
+        m_RMatrices[ii] = next;
+        next += m_curr_dim_size * m_curr_dim_size;
+    }
 #endif
 }
 
-void CompactFiniteDiff::initialize_cfd_matrix(const uint32_t curr_size,
-                                              double **outputLocation) {
+void CompactFiniteDiff::free_R_buffer() {
+#ifdef EM2_USE_XSMM_MAT_MUL
+    // the cached copies refer to the matrices freed below
+    for (unsigned int t = 0; t < m_num_workspaces; t++) {
+        m_workspaces[t].scaled_R.clear();
+    }
+#endif
+
+    if (m_R_win != MPI_WIN_NULL) {
+        // the global object is destroyed after MPI_Finalize, the window goes
+        // away with MPI in that case
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized) MPI_Win_free(&m_R_win);
+        m_R_win = MPI_WIN_NULL;
+    } else {
+        delete[] m_R_buffer;
+    }
+    m_R_buffer = nullptr;
+    m_R_buffer_sz = 0;
+
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    m_R_storage.clear();
+#else
+    std::fill_n(m_RMatrices, CompactDerivValueOrder::R_MAT_END, nullptr);
+#endif
+}
+
+void CompactFiniteDiff::set_shared_matrices(MPI_Comm comm) {
+    if (m_node_comm != MPI_COMM_NULL) MPI_Comm_free(&m_node_comm);
+
+    if (comm != MPI_COMM_NULL) {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                            &m_node_comm);
+    }
+}
+
+void CompactFiniteDiff::free_shared_matrices() {
+    if (m_R_win != MPI_WIN_NULL) {
+        free_R_buffer();
+        // so the next change_dim_size rebuilds, whatever the size
+        m_curr_dim_size = 0;
+    }
+
+    set_shared_matrices(MPI_COMM_NULL);
+}
+
+void CompactFiniteDiff::initialize_all_R_matrices() {
+    // with node sharing, node rank 0 builds the matrices in the window and
+    // the other ranks wait for it
+    bool builder = true;
+    if (m_R_win != MPI_WIN_NULL) {
+        int node_rank;
+        MPI_Comm_rank(m_node_comm, &node_rank);
+        builder = (node_rank == 0);
+
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_R_win);
+        if (builder) std::fill_n(m_R_buffer, m_R_buffer_sz, 0.0);
+    }
+
+    if (builder) {
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+        for (auto &element : m_available_r_sizes) {
+#ifdef EM2_CFD_BANDED_SOLVE
+            m_banded_storage[element].resize(CompactDerivValueOrder::FILT_NORM);
+            initialize_R_matrices(element, m_R_storage[element].data(),
+                                  m_banded_storage[element].data());
+#else
+            initialize_R_matrices(element, m_R_storage[element].data(),
+                                  nullptr);
+#endif
+        }
+#else
+#ifdef EM2_CFD_BANDED_SOLVE
+        initialize_R_matrices(m_curr_dim_size, m_RMatrices, m_banded_ops);
+#else
+        initialize_R_matrices(m_curr_dim_size, m_RMatrices, nullptr);
+#endif
+#endif
+    }
+
+    if (m_R_win != MPI_WIN_NULL) {
+        MPI_Win_sync(m_R_win);
+        MPI_Barrier(m_node_comm);
+        MPI_Win_sync(m_R_win);
+        MPI_Win_unlock_all(m_R_win);
+
+#ifdef EM2_CFD_BANDED_SOLVE
+        share_banded_operators(builder);
+#endif
+    }
+}
+
+#ifdef EM2_CFD_BANDED_SOLVE
+std::vector<BandedDerivOperator *> CompactFiniteDiff::banded_operators(
+    const uint32_t n) {
+    std::vector<BandedDerivOperator *> ops;
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    std::vector<BandedDerivOperator> &stored = m_banded_storage[n];
+    stored.resize(CompactDerivValueOrder::FILT_NORM);
+    for (auto &op : stored) ops.push_back(&op);
+#else
+    (void)n;
+    for (auto &op : m_banded_ops) ops.push_back(&op);
+#endif
+    return ops;
+}
+
+void CompactFiniteDiff::share_banded_operators(const bool builder) {
+    // the operators are small, node rank 0 packs all of them into one
+    // message, in the same size order the matrices were built in
+#ifdef SOLVER_ENABLE_MERGED_BLOCKS
+    const std::vector<uint32_t> sizes = m_available_r_sizes;
+#else
+    const std::vector<uint32_t> sizes(1, m_curr_dim_size);
+#endif
+
+    std::string bytes;
+    if (builder) {
+        std::ostringstream out(std::ios::binary);
+        for (const uint32_t n : sizes) {
+            for (BandedDerivOperator *op : banded_operators(n)) {
+                writeBandedDerivOperator(out, *op);
+            }
+        }
+        bytes = out.str();
+    }
+
+    unsigned long long num_bytes = bytes.size();
+    MPI_Bcast(&num_bytes, 1, MPI_UNSIGNED_LONG_LONG, 0, m_node_comm);
+    bytes.resize(num_bytes);
+    MPI_Bcast(&bytes[0], (int)num_bytes, MPI_CHAR, 0, m_node_comm);
+
+    if (builder) return;
+
+    std::istringstream in(bytes, std::ios::binary);
+    for (const uint32_t n : sizes) {
+        for (BandedDerivOperator *op : banded_operators(n)) {
+            if (!readBandedDerivOperator(in, *op)) {
+                throw std::runtime_error(
+                    "Couldn't unpack the banded derivative operators shared "
+                    "by node rank 0");
+            }
+        }
+    }
+}
+#endif
+
+void CompactFiniteDiff::initialize_R_matrices(
+    const uint32_t n, double **outputLocation,
+    BandedDerivOperator *bandedLocation) {
+    // a cache hit skips the factorizations and inversions altogether, the
+    // banded operators are cached along with the matrices
+    const bool use_cache = !m_matrix_cache_dir.empty();
+
+    if (use_cache &&
+        load_cached_R_matrices(n, outputLocation, bandedLocation)) {
+        return;
+    }
+
+    initialize_cfd_matrix(n, outputLocation, bandedLocation);
+    initialize_cfd_filter(n, outputLocation);
+
+    if (use_cache) store_cached_R_matrices(n, outputLocation, bandedLocation);
+}
+
+// bump whenever the way the matrices are built changes, so stale cache files
+// are rebuilt
+static const unsigned int R_MATRIX_CACHE_VERSION = 2;
+
+#ifdef EM2_CFD_BANDED_SOLVE
+static const int R_MATRIX_CACHE_BANDED = 1;
+#else
+static const int R_MATRIX_CACHE_BANDED = 0;
+#endif
+
+std::string CompactFiniteDiff::R_matrix_cache_key(const uint32_t n) const {
+    char key[512];
+    snprintf(key, sizeof(key),
+             "EM2 CFD R matrices v%u deriv %d deriv2nd %d filter %d "
+             "closure %d padding %u n %u mats %u kc %a eps %a filt_alpha %a "
+             "filt_bound %a banded %d",
+             R_MATRIX_CACHE_VERSION, (int)m_deriv_type,
+             (int)m_second_deriv_type, (int)m_filter_type,
+             (int)m_deriv_boundary_type, m_padding_size, n,
+             (unsigned int)CompactDerivValueOrder::R_MAT_END, m_kim_filt_kc,
+             m_kim_filt_eps, m_filt_alpha, (double)m_filt_bound_enable,
+             R_MATRIX_CACHE_BANDED);
+    return key;
+}
+
+std::string CompactFiniteDiff::R_matrix_cache_file(const uint32_t n) const {
+    char fName[256];
+    snprintf(fName, sizeof(fName), "%s/cfd_R_%d_%d_%d_%d_p%u_n%u%s.bin",
+             m_matrix_cache_dir.c_str(), (int)m_deriv_type,
+             (int)m_second_deriv_type, (int)m_filter_type,
+             (int)m_deriv_boundary_type, m_padding_size, n,
+             R_MATRIX_CACHE_BANDED ? "_banded" : "");
+    return fName;
+}
+
+bool CompactFiniteDiff::load_cached_R_matrices(
+    const uint32_t n, double **outputLocation,
+    BandedDerivOperator *bandedLocation) {
+    std::ifstream infile(R_matrix_cache_file(n), std::ios::binary);
+    if (!infile) return false;
+
+    std::string key;
+    if (!std::getline(infile, key) || key != R_matrix_cache_key(n)) {
+        return false;
+    }
+
+    for (unsigned int ii = 0; ii < CompactDerivValueOrder::R_MAT_END; ii++) {
+        infile.read((char *)outputLocation[ii], sizeof(double) * n * n);
+    }
+
+    bool banded_ok = true;
+    if (bandedLocation != nullptr) {
+        for (unsigned int ii = 0; ii < CompactDerivValueOrder::FILT_NORM;
+             ii++) {
+            if (!readBandedDerivOperator(infile, bandedLocation[ii])) {
+                banded_ok = false;
+                break;
+            }
+        }
+    }
+
+    if (!infile || !banded_ok) {
+        // truncated file, build from scratch (the skipped matrices are
+        // expected to be zero)
+        for (unsigned int ii = 0; ii < CompactDerivValueOrder::R_MAT_END;
+             ii++) {
+            std::fill_n(outputLocation[ii], n * n, 0.0);
+        }
+        if (bandedLocation != nullptr) {
+            for (unsigned int ii = 0; ii < CompactDerivValueOrder::FILT_NORM;
+                 ii++) {
+                bandedLocation[ii].clear();
+            }
+        }
+        return false;
+    }
+
+    return true;
+}
+
+void CompactFiniteDiff::store_cached_R_matrices(
+    const uint32_t n, double **outputLocation,
+    const BandedDerivOperator *bandedLocation) {
+    // every writer (one per node with sharing, every rank otherwise) writes
+    // its own temporary and renames it into place, so readers never see a
+    // partial file
+    int rank = 0;
+    int initialized;
+    MPI_Initialized(&initialized);
+    if (initialized) MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const std::string fName = R_matrix_cache_file(n);
+    const std::string tmpName = fName + ".tmp" + std::to_string(rank);
+
+    std::ofstream outfile(tmpName, std::ios::binary);
+    if (!outfile) return;
+
+    outfile << R_matrix_cache_key(n) << '\n';
+    for (unsigned int ii = 0; ii < CompactDerivValueOrder::R_MAT_END; ii++) {
+        outfile.write((const char *)outputLocation[ii],
+                      sizeof(double) * n * n);
+    }
+    if (bandedLocation != nullptr) {
+        for (unsigned int ii = 0; ii < CompactDerivValueOrder::FILT_NORM;
+             ii++) {
+            writeBandedDerivOperator(outfile, bandedLocation[ii]);
+        }
+    }
+    outfile.close();
+
+    if (!outfile || std::rename(tmpName.c_str(), fName.c_str()) != 0) {
+        std::remove(tmpName.c_str());
+    }
+}
+
+void CompactFiniteDiff::initialize_cfd_matrix(
+    const uint32_t curr_size, double **outputLocation,
+    BandedDerivOperator *bandedLocation) {
     // temporary P and Q storage used in calculations
     double *P = new double[curr_size * curr_size]();
     double *Q = new double[curr_size * curr_size]();
@@ -315,6 +623,10 @@ void CompactFiniteDiff::initialize_cfd_matrix(const uint32_t curr_size,
         setArrToZero(P, curr_size * curr_size);
         setArrToZero(Q, curr_size * curr_size);
 
+        if (bandedLocation != nullptr) {
+            bandedLocation[ii].clear();
+        }
+
         if (ii < CompactDerivValueOrder::DERIV_2ND_NORM) {
             if (m_deriv_type == CFD_NONE) continue;
         } else if (ii < CompactDerivValueOrder::FILT_NORM) {
@@ -341,6 +653,15 @@ void CompactFiniteDiff::initialize_cfd_matrix(const uint32_t curr_size,
                 buildDerivExplicitRMatrix(outputLocation[ii], m_padding_size,
                                           curr_size, m_deriv_type, left_b,
                                           right_b);
+
+                // explicit operators are just P = I and Q = R
+                if (bandedLocation != nullptr) {
+                    for (uint32_t jj = 0; jj < curr_size; jj++) {
+                        P[INDEX_N2D(jj, jj, curr_size)] = 1.0;
+                    }
+                    buildBandedDerivOperator(bandedLocation[ii], P,
+                                             outputLocation[ii], curr_size);
+                }
                 continue;
             }
         }
@@ -355,6 +676,14 @@ void CompactFiniteDiff::initialize_cfd_matrix(const uint32_t curr_size,
                 build2ndDerivExplicitRMatrix(outputLocation[ii], m_padding_size,
                                              curr_size, m_second_deriv_type,
                                              left_b, right_b);
+
+                if (bandedLocation != nullptr) {
+                    for (uint32_t jj = 0; jj < curr_size; jj++) {
+                        P[INDEX_N2D(jj, jj, curr_size)] = 1.0;
+                    }
+                    buildBandedDerivOperator(bandedLocation[ii], P,
+                                             outputLocation[ii], curr_size);
+                }
                 continue;
             }
         }
@@ -387,32 +716,39 @@ void CompactFiniteDiff::initialize_cfd_matrix(const uint32_t curr_size,
         print_square_mat(Q, curr_size);
 #endif
 
+        // the banded form has to be built first, P is overwritten by the LU
+        // factorization in calculateDerivMatrix
+        if (bandedLocation != nullptr) {
+            buildBandedDerivOperator(bandedLocation[ii], P, Q, curr_size);
+        }
+
         calculateDerivMatrix(outputLocation[ii], P, Q, curr_size);
 
 #ifdef PRINT_COMPACT_MATRICES
         std::cout << "\nDERIV MATRIX no=" << ii << std::endl;
         print_square_mat(outputLocation[ii], curr_size);
 #endif
+
+        // the dense matrix is the reference, if the banded (unpivoted)
+        // solve doesn't reproduce it we just fall back to the dense R
+        if (bandedLocation != nullptr && bandedLocation[ii].valid) {
+            const double err = bandedDerivOperatorError(bandedLocation[ii],
+                                                        outputLocation[ii]);
+            if (err > 1.0e-10) {
+#ifdef PRINT_COMPACT_MATRICES
+                std::cout << "Banded operator no=" << ii
+                          << " does not match the dense matrix (err = " << err
+                          << "), falling back to dense" << std::endl;
+#endif
+                bandedLocation[ii].clear();
+            }
+        }
     }
 
     delete[] P;
     delete[] Q;
 }
 
-void CompactFiniteDiff::initialize_all_cfd_filters() {
-#ifdef SOLVER_ENABLE_MERGED_BLOCKS
-
-    for (auto &element : m_available_r_sizes) {
-        // std::cout << "Initializing filter matrices for " << element
-        //           << std::endl;
-
-        initialize_cfd_filter(element, m_R_storage[element].data());
-    }
-#else
-    initialize_cfd_filter(m_curr_dim_size, m_RMatrices);
-#endif
-}
-
 void CompactFiniteDiff::initialize_cfd_filter(const uint32_t curr_size,
                                               double **outputLocation) {
     // exit early on filter none
@@ -476,29 +812,23 @@ void CompactFiniteDiff::initialize_cfd_filter(const uint32_t curr_size,
 }
 
 void CompactFiniteDiff::delete_cfd_matrices() {
-    delete[] m_u1d;
-    delete[] m_u2d;
-    delete[] m_du1d;
-    delete[] m_du2d;
+    for (unsigned int t = 0; t < m_num_workspaces; t++) {
+        m_workspaces[t].delete_line_storage();
+    }
 
     delete_cfd_3dblock_workspace();
 
+    free_R_buffer();
+
+#ifdef EM2_CFD_BANDED_SOLVE
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
-    for (auto &element : m_available_r_sizes) {
-        // then iterate through the types and build up the sizes
-        for (CompactDerivValueOrder ii = CompactDerivValueOrder::DERIV_NORM;
-             ii < CompactDerivValueOrder::R_MAT_END;
-             ii = static_cast<CompactDerivValueOrder>((size_t)ii + 1)) {
-            delete[] m_R_storage[element][ii];
-        }
-    }
+    m_banded_storage.clear();
 #else
-    for (CompactDerivValueOrder ii = CompactDerivValueOrder::DERIV_NORM;
-         ii < CompactDerivValueOrder::R_MAT_END;
-         ii = static_cast<CompactDerivValueOrder>((size_t)ii + 1)) {
-        delete[] m_RMatrices[ii];
+    for (auto &op : m_banded_ops) {
+        op.clear();
     }
 #endif
+#endif
 }
 
 void CompactFiniteDiff::clear_boundary_padding_nans(double *u,
@@ -621,12 +951,141 @@ void CompactFiniteDiff::clear_boundary_padding_nans(double *u,
     // DONE
 }
 
+// Dense application of an R matrix along each direction,
+// D = alpha * R u + beta * D. x is the contiguous direction, so R is applied
+// from the left in x and as R^T from the right in y and z. That keeps x
+// contiguous everywhere and needs no transposes. D must not overlap u.
+static void dense_apply_x(double *const D, const double *const u, double *R,
+                          double alpha, double beta, const unsigned int *sz) {
+    // the block is an nx x (ny nz) matrix
+    char TRANSA = 'N';
+    char TRANSB = 'N';
+    int M = sz[0];
+    int N = sz[1] * sz[2];
+    int K = sz[0];
+
+    dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R, &M, (double *)u, &K,
+           &beta, D, &M);
+}
+
+static void dense_apply_y(double *const D, const double *const u, double *R,
+                          double alpha, double beta, const unsigned int *sz) {
+    // each z slice is an nx x ny matrix
+    const unsigned int nx = sz[0];
+    const unsigned int ny = sz[1];
+    const unsigned int nz = sz[2];
+
+    char TRANSA = 'N';
+    char TRANSB = 'T';
+    int M = nx;
+    int N = ny;
+    int K = ny;
+
+    for (unsigned int k = 0; k < nz; k++) {
+        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha,
+               (double *)&u[INDEX_3D(0, 0, k)], &M, R, &N, &beta,
+               &D[INDEX_3D(0, 0, k)], &M);
+    }
+}
+
+static void dense_apply_z(double *const D, const double *const u, double *R,
+                          double alpha, double beta, const unsigned int *sz) {
+    // the block is an (nx ny) x nz matrix
+    char TRANSA = 'N';
+    char TRANSB = 'T';
+    int M = sz[0] * sz[1];
+    int N = sz[2];
+    int K = sz[2];
+
+    dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, (double *)u, &M, R, &N,
+           &beta, D, &M);
+}
+
+#ifdef EM2_USE_XSMM_MAT_MUL
+const double *CompactFiniteDiff::get_scaled_R_matrix(const double *R,
+                                                     const uint32_t n,
+                                                     const double alpha) {
+    std::vector<double> &R_scaled =
+        get_workspace().scaled_R[std::make_pair(R, alpha)];
+
+    if (R_scaled.empty()) {
+        R_scaled.resize(n * n);
+        for (uint32_t ii = 0; ii < n * n; ii++) {
+            R_scaled[ii] = alpha * R[ii];
+        }
+    }
+
+    return R_scaled.data();
+}
+#endif
+
+void CompactFiniteDiff::apply_banded_x(double *const Du, const double *const u,
+                                       const BandedDerivOperator &op,
+                                       const double scale,
+                                       const unsigned int *sz,
+                                       CFDWorkspace &ws) {
+    const unsigned int nx = sz[0];
+    const unsigned int ny = sz[1];
+    const unsigned int nz = sz[2];
+
+    // x is the contiguous direction, so each z slice is transposed into the
+    // workspace to put the ny lines next to each other
+    for (unsigned int k = 0; k < nz; k++) {
+        for (unsigned int j = 0; j < ny; j++) {
+            for (unsigned int i = 0; i < nx; i++) {
+                ws.du3d_block1[j + i * ny] = u[INDEX_3D(i, j, k)];
+            }
+        }
+
+        applyBandedDerivOperator(op, ws.du3d_block2, ws.du3d_block1, ny, ny,
+                                 scale);
+
+        for (unsigned int j = 0; j < ny; j++) {
+            for (unsigned int i = 0; i < nx; i++) {
+                Du[INDEX_3D(i, j, k)] = ws.du3d_block2[j + i * ny];
+            }
+        }
+    }
+}
+
+void CompactFiniteDiff::apply_banded_y(double *const Du, const double *const u,
+                                       const BandedDerivOperator &op,
+                                       const double scale,
+                                       const unsigned int *sz) {
+    const unsigned int nx = sz[0];
+    const unsigned int ny = sz[1];
+    const unsigned int nz = sz[2];
+
+    // each z slice is already an ny x nx panel with x contiguous, no
+    // transposes needed
+    for (unsigned int k = 0; k < nz; k++) {
+        applyBandedDerivOperator(op, &Du[INDEX_3D(0, 0, k)],
+                                 &u[INDEX_3D(0, 0, k)], nx, nx, scale);
+    }
+}
+
+void CompactFiniteDiff::apply_banded_z(double *const Du, const double *const u,
+                                       const BandedDerivOperator &op,
+                                       const double scale,
+                                       const unsigned int *sz) {
+    const unsigned int nx = sz[0];
+    const unsigned int ny = sz[1];
+
+    // the whole block is an nz x (nx * ny) panel
+    applyBandedDerivOperator(op, Du, u, nx * ny, nx * ny, scale);
+}
+
 void CompactFiniteDiff::cfd_x(double *const Dxu, const double *const u,
                               const double dx, const unsigned int *sz,
                               unsigned bflag) {
     const unsigned int nx = sz[0];
+#if defined(EM2_USE_XSMM_MAT_MUL) || defined(EM2_DEBUG_COMPACT_DERIVS)
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
+#endif
+
+    // scratch space belonging to the calling thread
+    CFDWorkspace &ws = get_workspace();
 
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     // the padding for this is stored in the cfd object
@@ -672,37 +1131,27 @@ void CompactFiniteDiff::cfd_x(double *const Dxu, const double *const u,
 
     // std::cout << "Nx, ny, nz: " << nx << " " << ny << " " << nz << std::endl;
 
-    char TRANSA = 'N';
-    char TRANSB = 'N';
-
-    int M = nx;
-    int N = ny;
-    int K = nx;
-    // NOTE: LDA = M, LDB = K, and LDC = M
 #ifdef EM2_USE_XSMM_MAT_MUL
     const double alpha = 1.0 / dx;
 #else
     double alpha = 1.0 / dx;
 #endif
 
-    double *u_curr_chunk = (double *)u;
-    double *du_curr_chunk = (double *)Dxu;
-
     double beta = 0.0;
 
     double *R_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_LEFT)) && !(bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_NORM];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_NORM];
     } else if ((bflag & (1u << OCT_DIR_LEFT)) &&
                !(bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_LEFT];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_LEFT)) &&
                (bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_RIGHT];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_RIGHT];
     } else {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_LEFTRIGHT];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -736,47 +1185,30 @@ void CompactFiniteDiff::cfd_x(double *const Dxu, const double *const u,
 
 #endif
 
-    for (unsigned int k = 0; k < nz; k++) {
-#ifdef EM2_USE_XSMM_MAT_MUL
-        // N = ny;
-        // thanks to memory layout, we can just... use this as a matrix
-        // so we can just grab the "matrix" of ny x nx for this one
-
-        // performs C_mn = alpha * A_mk * B_kn + beta * C_mn
-
-        // for the x_der case, m = k = nx
-
-        (*m_kernel_x)(R_mat_use, u_curr_chunk, du_curr_chunk);
-
-#else
+    const BandedDerivOperator *banded_op = get_banded_op(
+        nx, CompactDerivValueOrder::DERIV_NORM, bflag & (1u << OCT_DIR_LEFT),
+        bflag & (1u << OCT_DIR_RIGHT));
 
-#ifdef EM2_DEBUG_COMPACT_DERIVS_OFF
+    if (banded_op != nullptr) {
+        apply_banded_x(Dxu, u, *banded_op, alpha, sz, ws);
+    } else {
+#ifdef EM2_USE_XSMM_MAT_MUL
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, nx, alpha);
+        double *u_curr_chunk = (double *)u;
+        double *du_curr_chunk = (double *)Dxu;
 
-        if ((bflag & (1u << OCT_DIR_LEFT)) || (bflag & (1u << OCT_DIR_RIGHT))) {
-            std::cout << "here's the u_curr_chunk:" << std::endl;
-            print_square_mat(u_curr_chunk, nx);
+        for (unsigned int k = 0; k < nz; k++) {
+            (*m_kernel_x)(R_scaled, u_curr_chunk, du_curr_chunk);
 
-            std::cout << std::endl << std::endl;
+            u_curr_chunk += nx * ny;
+            du_curr_chunk += nx * ny;
         }
-
-#endif
-
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               u_curr_chunk, &K, &beta, du_curr_chunk, &M);
-
+#else
+        dense_apply_x(Dxu, u, R_mat_use, alpha, beta, sz);
 #endif
-
-        u_curr_chunk += nx * ny;
-        du_curr_chunk += nx * ny;
     }
 
-    // TODO: investigate why the kernel won't take 1/dx as its alpha
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dxu[ii] *= 1 / dx;
-    }
-#endif
-
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     // check for nans
     for (int k = zstart; k < zend; k++) {
@@ -827,9 +1259,11 @@ void CompactFiniteDiff::cfd_x(double *const Dxu, const double *const u,
 void CompactFiniteDiff::cfd_y(double *const Dyu, const double *const u,
                               const double dy, const unsigned int *sz,
                               unsigned bflag) {
-    const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
+#if defined(EM2_USE_XSMM_MAT_MUL) || defined(EM2_DEBUG_COMPACT_DERIVS)
+    const unsigned int nx = sz[0];
     const unsigned int nz = sz[2];
+#endif
 
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     const unsigned int xstart =
@@ -863,33 +1297,25 @@ void CompactFiniteDiff::cfd_y(double *const Dyu, const double *const u,
     }
 #endif
 
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = ny;
-    int N = nx;
-    int K = ny;
     // NOTE: LDA = M, LDB = N, and LDC = M
     // LDB is N because in memory, Y is transposed!
 
     double alpha = 1.0 / dy;
     double beta = 0.0;
 
-    double *u_curr_chunk = (double *)u;
-    double *du_curr_chunk = (double *)Dyu;
-
     double *R_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_DOWN)) && !(bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_NORM];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_NORM];
     } else if ((bflag & (1u << OCT_DIR_DOWN)) &&
                !(bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_LEFT];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_DOWN)) &&
                (bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_RIGHT];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_RIGHT];
     } else {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_LEFTRIGHT];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -919,55 +1345,36 @@ void CompactFiniteDiff::cfd_y(double *const Dyu, const double *const u,
 
 #endif
 
-    for (unsigned int k = 0; k < nz; k++) {
-#ifdef EM2_USE_XSMM_MAT_MUL
-        // thanks to memory layout, we can just... use this as a matrix
-        // so we can just grab the "matrix" of ny x nx for this one
-
-        (*m_kernel_y)(R_mat_use, u_curr_chunk, m_du3d_block1);
+    const BandedDerivOperator *banded_op = get_banded_op(
+        ny, CompactDerivValueOrder::DERIV_NORM, bflag & (1u << OCT_DIR_DOWN),
+        bflag & (1u << OCT_DIR_UP));
 
-#else
+    if (banded_op != nullptr) {
+        apply_banded_y(Dyu, u, *banded_op, alpha, sz);
+    } else {
+#ifdef EM2_USE_XSMM_MAT_MUL
+        CFDWorkspace &ws = get_workspace();
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, ny, alpha);
+        double *u_curr_chunk = (double *)u;
 
-#ifdef EM2_DEBUG_COMPACT_DERIVS_OFF
+        for (unsigned int k = 0; k < nz; k++) {
+            // the kernel computes R times the transposed slice
+            (*m_kernel_y)(R_scaled, u_curr_chunk, ws.du3d_block1);
 
-        if ((bflag & (1u << OCT_DIR_DOWN)) || (bflag & (1u << OCT_DIR_UP))) {
-            std::cout << "here's the u_curr_chunk:" << std::endl;
-            print_square_mat(u_curr_chunk, nx);
+            for (unsigned int i = 0; i < nx; i++) {
+                for (unsigned int j = 0; j < ny; j++) {
+                    Dyu[INDEX_3D(i, j, k)] = ws.du3d_block1[j + i * ny];
+                }
+            }
 
-            std::cout << std::endl << std::endl;
+            u_curr_chunk += nx * ny;
         }
-
-#endif
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               u_curr_chunk, &N, &beta, m_du3d_block1, &M);
+#else
+        dense_apply_y(Dyu, u, R_mat_use, alpha, beta, sz);
 #endif
-        // TODO: see if there's a faster way to copy (i.e. SSE?)
-        // the data is transposed so it's much harder to just copy all at
-        // once
-        for (unsigned int i = 0; i < nx; i++) {
-            for (unsigned int j = 0; j < ny; j++) {
-                Dyu[INDEX_3D(i, j, k)] = m_du3d_block1[j + i * ny];
-            }
-        }
-
-        // NOTE: this is probably faster on Intel, but for now we'll do the
-        // form above libxsmm_otrans(du_curr_chunk, m_du2d, sizeof(double),
-        // ny, nx, nx, ny);
-        // TODO: mkl's mkl_domatcopy might be even better!
-
-        // update u_curr_chunk
-        u_curr_chunk += nx * ny;
-        du_curr_chunk += nx * ny;
     }
 
-    // NOTE: it is currently faster for these derivatives if we calculate
-    // them
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dyu[ii] *= 1 / dy;
-    }
-#endif
-
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     // check for nans
     for (int k = zstart; k < zend; k++) {
@@ -1018,9 +1425,11 @@ void CompactFiniteDiff::cfd_y(double *const Dyu, const double *const u,
 void CompactFiniteDiff::cfd_z(double *const Dzu, const double *const u,
                               const double dz, const unsigned int *sz,
                               unsigned bflag) {
+    const unsigned int nz = sz[2];
+#if defined(EM2_USE_XSMM_MAT_MUL) || defined(EM2_DEBUG_COMPACT_DERIVS)
     const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
-    const unsigned int nz = sz[2];
+#endif
 
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     const unsigned int xstart =
@@ -1055,10 +1464,6 @@ void CompactFiniteDiff::cfd_z(double *const Dzu, const double *const u,
     }
 #endif
 
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = nz;
-    int K = nz;
     double alpha = 1.0 / dz;
     double beta = 0.0;
 
@@ -1066,15 +1471,15 @@ void CompactFiniteDiff::cfd_z(double *const Dzu, const double *const u,
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_BACK)) && !(bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_NORM];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_NORM];
     } else if ((bflag & (1u << OCT_DIR_BACK)) &&
                !(bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_LEFT];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_BACK)) &&
                (bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_RIGHT];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_RIGHT];
     } else {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_LEFTRIGHT];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -1104,68 +1509,37 @@ void CompactFiniteDiff::cfd_z(double *const Dzu, const double *const u,
 
 #endif
 
-#ifdef EM2_USE_XSMM_MAT_MUL
-    int N = nx;
-#else
-    int N = nx;
-#endif
-
-    for (unsigned int j = 0; j < ny; j++) {
-        for (unsigned int k = 0; k < nz; k++) {
-            // copy the slice of X values over
-            std::copy_n(&u[INDEX_3D(0, j, k)], nx,
-                        &m_du3d_block1[INDEX_N2D(0, k, nx)]);
-        }
+    const BandedDerivOperator *banded_op = get_banded_op(
+        nz, CompactDerivValueOrder::DERIV_NORM, bflag & (1u << OCT_DIR_BACK),
+        bflag & (1u << OCT_DIR_FRONT));
 
+    if (banded_op != nullptr) {
+        apply_banded_z(Dzu, u, *banded_op, alpha, sz);
+    } else {
 #ifdef EM2_USE_XSMM_MAT_MUL
-        // now do the faster math multiplcation
-        (*m_kernel_z)(R_mat_use, m_du3d_block1, m_du3d_block2);
-
-#else
-
-#ifdef EM2_DEBUG_COMPACT_DERIVS_OFF
-
-        if ((bflag & (1u << OCT_DIR_DOWN)) || (bflag & (1u << OCT_DIR_UP))) {
-            std::cout << "here's the u_curr_chunk:" << std::endl;
-            print_nonsquare_mat(m_du3d_block1, nx, nz);
-
-            std::cout << std::endl;
-        }
-
-#endif
-
-        // now we have a transposed matrix to send into dgemm_
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               m_du3d_block1, &N, &beta, m_du3d_block2, &M);
-
-#ifdef EM2_DEBUG_COMPACT_DERIVS_OFF
-
-        if ((bflag & (1u << OCT_DIR_DOWN)) || (bflag & (1u << OCT_DIR_UP))) {
-            std::cout << "here's the m_du2d:" << std::endl;
-            print_square_mat(m_du2d, nz);
+        CFDWorkspace &ws = get_workspace();
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, nz, alpha);
 
-            std::cout << std::endl << std::endl;
-        }
+        for (unsigned int j = 0; j < ny; j++) {
+            for (unsigned int k = 0; k < nz; k++) {
+                std::copy_n(&u[INDEX_3D(0, j, k)], nx,
+                            &ws.du3d_block1[INDEX_N2D(0, k, nx)]);
+            }
 
-#endif
+            (*m_kernel_z)(R_scaled, ws.du3d_block1, ws.du3d_block2);
 
-        for (unsigned int i = 0; i < nx; i++) {
-            for (unsigned int k = 0; k < nz; k++) {
-                Dzu[INDEX_3D(i, j, k)] = m_du3d_block2[k + i * nz];
+            for (unsigned int i = 0; i < nx; i++) {
+                for (unsigned int k = 0; k < nz; k++) {
+                    Dzu[INDEX_3D(i, j, k)] = ws.du3d_block2[k + i * nz];
+                }
             }
         }
-
+#else
+        dense_apply_z(Dzu, u, R_mat_use, alpha, beta, sz);
 #endif
     }
 
-    // NOTE: it is currently faster for these derivatives if we calculate
-    // them
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dzu[ii] *= 1 / dz;
-    }
-#endif
-
 #ifdef EM2_DEBUG_COMPACT_DERIVS
     // check for nans
     for (int k = zstart; k < zend; k++) {
@@ -1217,44 +1591,39 @@ void CompactFiniteDiff::cfd_xx(double *const Dxu, const double *const u,
                                const double dx, const unsigned int *sz,
                                unsigned bflag) {
     const unsigned int nx = sz[0];
+#ifdef EM2_USE_XSMM_MAT_MUL
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
+#endif
+
+    // scratch space belonging to the calling thread
+    CFDWorkspace &ws = get_workspace();
 
     // std::cout << "Nx, ny, nz: " << nx << " " << ny << " " << nz <<
     // std::endl;
 
-    char TRANSA = 'N';
-    char TRANSB = 'N';
-
-    int M = nx;
-    int N = ny;
-    int K = nx;
-    // NOTE: LDA = M, LDB = K, and LDC = M
 #ifdef EM2_USE_XSMM_MAT_MUL
     const double alpha = 1.0 / (dx * dx);
 #else
     double alpha = 1.0 / (dx * dx);
 #endif
 
-    double *u_curr_chunk = (double *)u;
-    double *du_curr_chunk = (double *)Dxu;
-
     double beta = 0.0;
 
     double *R_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_LEFT)) && !(bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_2ND_NORM];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_2ND_NORM];
     } else if ((bflag & (1u << OCT_DIR_LEFT)) &&
                !(bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_2ND_LEFT];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_2ND_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_LEFT)) &&
                (bflag & (1u << OCT_DIR_RIGHT))) {
-        R_mat_use = m_R_storage[nx][CompactDerivValueOrder::DERIV_2ND_RIGHT];
+        R_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_2ND_RIGHT];
     } else {
         R_mat_use =
-            m_R_storage[nx][CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
+            m_R_storage.at(nx)[CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
         printf("Uh oh, DERIV_2ND_LEFTRIGHT was reached!");
     }
 #else
@@ -1277,35 +1646,30 @@ void CompactFiniteDiff::cfd_xx(double *const Dxu, const double *const u,
     // xmm(LIBXSMM_GEMM_FLAGS(TRANSA, TRANSB), M, N, K, LDA, LDB, LDC,
     // alpha, beta);
 
-    for (unsigned int k = 0; k < nz; k++) {
-#ifdef EM2_USE_XSMM_MAT_MUL
-        // N = ny;
-        // thanks to memory layout, we can just... use this as a matrix
-        // so we can just grab the "matrix" of ny x nx for this one
-
-        // performs C_mn = alpha * A_mk * B_kn + beta * C_mn
+    const BandedDerivOperator *banded_op =
+        get_banded_op(nx, CompactDerivValueOrder::DERIV_2ND_NORM,
+                      bflag & (1u << OCT_DIR_LEFT),
+                      bflag & (1u << OCT_DIR_RIGHT));
 
-        // for the x_der case, m = k = nx
+    if (banded_op != nullptr) {
+        apply_banded_x(Dxu, u, *banded_op, alpha, sz, ws);
+    } else {
+#ifdef EM2_USE_XSMM_MAT_MUL
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, nx, alpha);
+        double *u_curr_chunk = (double *)u;
+        double *du_curr_chunk = (double *)Dxu;
 
-        (*m_kernel_x)(R_mat_use, u_curr_chunk, du_curr_chunk);
+        for (unsigned int k = 0; k < nz; k++) {
+            (*m_kernel_x)(R_scaled, u_curr_chunk, du_curr_chunk);
 
+            u_curr_chunk += nx * ny;
+            du_curr_chunk += nx * ny;
+        }
 #else
-
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               u_curr_chunk, &K, &beta, du_curr_chunk, &M);
-
+        dense_apply_x(Dxu, u, R_mat_use, alpha, beta, sz);
 #endif
-
-        u_curr_chunk += nx * ny;
-        du_curr_chunk += nx * ny;
-    }
-
-    // TODO: investigate why the kernel won't take 1/dx as its alpha
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dxu[ii] *= alpha;
     }
-#endif
 
 #if 0
     for (int k = 0; k < nz; k++) {
@@ -1330,38 +1694,32 @@ void CompactFiniteDiff::cfd_xx(double *const Dxu, const double *const u,
 void CompactFiniteDiff::cfd_yy(double *const Dyu, const double *const u,
                                const double dy, const unsigned int *sz,
                                unsigned bflag) {
-    const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
+#ifdef EM2_USE_XSMM_MAT_MUL
+    const unsigned int nx = sz[0];
     const unsigned int nz = sz[2];
+#endif
 
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = ny;
-    int N = nx;
-    int K = ny;
     // NOTE: LDA = M, LDB = N, and LDC = M
     // LDB is N because in memory, Y is transposed!
 
     double alpha = 1.0 / (dy * dy);
     double beta = 0.0;
 
-    double *u_curr_chunk = (double *)u;
-    double *du_curr_chunk = (double *)Dyu;
-
     double *R_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_DOWN)) && !(bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_2ND_NORM];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_2ND_NORM];
     } else if ((bflag & (1u << OCT_DIR_DOWN)) &&
                !(bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_2ND_LEFT];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_2ND_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_DOWN)) &&
                (bflag & (1u << OCT_DIR_UP))) {
-        R_mat_use = m_R_storage[ny][CompactDerivValueOrder::DERIV_2ND_RIGHT];
+        R_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_2ND_RIGHT];
     } else {
         R_mat_use =
-            m_R_storage[ny][CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
+            m_R_storage.at(ny)[CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
         printf("Uh oh, DERIV_2ND_LEFTRIGHT was reached!");
     }
 #else
@@ -1380,46 +1738,35 @@ void CompactFiniteDiff::cfd_yy(double *const Dyu, const double *const u,
     }
 #endif
 
-    for (unsigned int k = 0; k < nz; k++) {
-#ifdef EM2_USE_XSMM_MAT_MUL
-        // thanks to memory layout, we can just... use this as a matrix
-        // so we can just grab the "matrix" of ny x nx for this one
+    const BandedDerivOperator *banded_op =
+        get_banded_op(ny, CompactDerivValueOrder::DERIV_2ND_NORM,
+                      bflag & (1u << OCT_DIR_DOWN), bflag & (1u << OCT_DIR_UP));
 
-        (*m_kernel_y)(R_mat_use, u_curr_chunk, m_du3d_block1);
-
-#else
+    if (banded_op != nullptr) {
+        apply_banded_y(Dyu, u, *banded_op, alpha, sz);
+    } else {
+#ifdef EM2_USE_XSMM_MAT_MUL
+        CFDWorkspace &ws = get_workspace();
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, ny, alpha);
+        double *u_curr_chunk = (double *)u;
 
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               u_curr_chunk, &N, &beta, m_du3d_block1, &M);
+        for (unsigned int k = 0; k < nz; k++) {
+            // the kernel computes R times the transposed slice
+            (*m_kernel_y)(R_scaled, u_curr_chunk, ws.du3d_block1);
 
-#endif
-        // TODO: see if there's a faster way to copy (i.e. SSE?)
-        // the data is transposed so it's much harder to just copy all at
-        // once
-        // Could also do this after for batched matrix multiplication
-        for (unsigned int i = 0; i < nx; i++) {
-            for (unsigned int j = 0; j < ny; j++) {
-                Dyu[INDEX_3D(i, j, k)] = m_du3d_block1[j + i * ny];
+            for (unsigned int i = 0; i < nx; i++) {
+                for (unsigned int j = 0; j < ny; j++) {
+                    Dyu[INDEX_3D(i, j, k)] = ws.du3d_block1[j + i * ny];
+                }
             }
-        }
-
-        // NOTE: this is probably faster on Intel, but for now we'll do the
-        // form above libxsmm_otrans(du_curr_chunk, m_du2d, sizeof(double),
-        // ny, nx, nx, ny);
-        // TODO: mkl's mkl_domatcopy might be even better!
 
-        // update u_curr_chunk
-        u_curr_chunk += nx * ny;
-        du_curr_chunk += nx * ny;
-    }
-
-    // NOTE: it is currently faster for these derivatives if we calculate
-    // them
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dyu[ii] *= alpha;
-    }
+            u_curr_chunk += nx * ny;
+        }
+#else
+        dense_apply_y(Dyu, u, R_mat_use, alpha, beta, sz);
 #endif
+    }
 
 #if 0
     for (int k = 0; k < nz; k++) {
@@ -1441,14 +1788,12 @@ void CompactFiniteDiff::cfd_yy(double *const Dyu, const double *const u,
 void CompactFiniteDiff::cfd_zz(double *const Dzu, const double *const u,
                                const double dz, const unsigned int *sz,
                                unsigned bflag) {
+    const unsigned int nz = sz[2];
+#ifdef EM2_USE_XSMM_MAT_MUL
     const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
-    const unsigned int nz = sz[2];
+#endif
 
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = nz;
-    int K = nz;
     double alpha = 1.0 / (dz * dz);
     double beta = 0.0;
 
@@ -1456,16 +1801,16 @@ void CompactFiniteDiff::cfd_zz(double *const Dzu, const double *const u,
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_BACK)) && !(bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_2ND_NORM];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_2ND_NORM];
     } else if ((bflag & (1u << OCT_DIR_BACK)) &&
                !(bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_2ND_LEFT];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_2ND_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_BACK)) &&
                (bflag & (1u << OCT_DIR_FRONT))) {
-        R_mat_use = m_R_storage[nz][CompactDerivValueOrder::DERIV_2ND_RIGHT];
+        R_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_2ND_RIGHT];
     } else {
         R_mat_use =
-            m_R_storage[nz][CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
+            m_R_storage.at(nz)[CompactDerivValueOrder::DERIV_2ND_LEFTRIGHT];
         printf("Uh oh, DERIV_2ND_LEFTRIGHT was reached!");
     }
 #else
@@ -1484,45 +1829,37 @@ void CompactFiniteDiff::cfd_zz(double *const Dzu, const double *const u,
     }
 #endif
 
-#ifdef EM2_USE_XSMM_MAT_MUL
-    int N = nx;
-#else
-    int N = nx;
-#endif
+    const BandedDerivOperator *banded_op =
+        get_banded_op(nz, CompactDerivValueOrder::DERIV_2ND_NORM,
+                      bflag & (1u << OCT_DIR_BACK),
+                      bflag & (1u << OCT_DIR_FRONT));
 
-    for (unsigned int j = 0; j < ny; j++) {
-        for (unsigned int k = 0; k < nz; k++) {
-            // copy slice of X values over
-            std::copy_n(&u[INDEX_3D(0, j, k)], nx,
-                        &m_du3d_block1[INDEX_N2D(0, k, nx)]);
-        }
+    if (banded_op != nullptr) {
+        apply_banded_z(Dzu, u, *banded_op, alpha, sz);
+    } else {
 #ifdef EM2_USE_XSMM_MAT_MUL
+        CFDWorkspace &ws = get_workspace();
+        // the kernel's alpha is fixed, so the scale goes into R
+        const double *R_scaled = get_scaled_R_matrix(R_mat_use, nz, alpha);
 
-        // now do the faster math multiplcation
-        (*m_kernel_z)(R_mat_use, m_du3d_block1, m_du3d_block2);
-
-#else
-
-        // now we have a transposed matrix to send into dgemm_
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, R_mat_use, &M,
-               m_du3d_block1, &N, &beta, m_du3d_block2, &M);
+        for (unsigned int j = 0; j < ny; j++) {
+            for (unsigned int k = 0; k < nz; k++) {
+                std::copy_n(&u[INDEX_3D(0, j, k)], nx,
+                            &ws.du3d_block1[INDEX_N2D(0, k, nx)]);
+            }
 
-#endif
+            (*m_kernel_z)(R_scaled, ws.du3d_block1, ws.du3d_block2);
 
-        for (unsigned int i = 0; i < nx; i++) {
-            for (unsigned int k = 0; k < nz; k++) {
-                Dzu[INDEX_3D(i, j, k)] = m_du3d_block2[k + i * nz];
+            for (unsigned int i = 0; i < nx; i++) {
+                for (unsigned int k = 0; k < nz; k++) {
+                    Dzu[INDEX_3D(i, j, k)] = ws.du3d_block2[k + i * nz];
+                }
             }
         }
-    }
-
-    // NOTE: it is currently faster for these derivatives if we calculate
-    // them
-#ifdef EM2_USE_XSMM_MAT_MUL
-    for (uint32_t ii = 0; ii < nx * ny * nz; ii++) {
-        Dzu[ii] *= alpha;
-    }
+#else
+        dense_apply_z(Dzu, u, R_mat_use, alpha, beta, sz);
 #endif
+    }
 
 #if 0
     for (int k = 0; k < nz; k++) {
@@ -1558,35 +1895,20 @@ void CompactFiniteDiff::filter_cfd_x(double *const u, double *const filtx_work,
         std::copy_n(u, nx * ny * nz, filtx_work);
     }
 
-    char TRANSA = 'N';
-    char TRANSB = 'N';
-
-    int M = nx;
-    int N = ny;
-    int K = nx;
-    // NOTE: LDA = M, LDB = K, and LDC = M
-
-    double *u_curr_chunk = (double *)u;
-    double *filtu_curr_chunk = (double *)filtx_work;
-
-    // the alphas here should always be 1.0, there's no additional
-    // computation
-    double alpha = 1.0;
-
     double *RF_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_LEFT)) && !(bflag & (1u << OCT_DIR_RIGHT))) {
-        RF_mat_use = m_R_storage[nx][CompactDerivValueOrder::FILT_NORM];
+        RF_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::FILT_NORM];
     } else if ((bflag & (1u << OCT_DIR_LEFT)) &&
                !(bflag & (1u << OCT_DIR_RIGHT))) {
-        RF_mat_use = m_R_storage[nx][CompactDerivValueOrder::FILT_LEFT];
+        RF_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::FILT_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_LEFT)) &&
                (bflag & (1u << OCT_DIR_RIGHT))) {
-        RF_mat_use = m_R_storage[nx][CompactDerivValueOrder::FILT_RIGHT];
+        RF_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::FILT_RIGHT];
 
     } else {
-        RF_mat_use = m_R_storage[nx][CompactDerivValueOrder::FILT_LEFTRIGHT];
+        RF_mat_use = m_R_storage.at(nx)[CompactDerivValueOrder::FILT_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -1604,8 +1926,11 @@ void CompactFiniteDiff::filter_cfd_x(double *const u, double *const filtx_work,
     }
 #endif
 
-    for (unsigned int k = 0; k < nx; k++) {
 #ifdef EM2_USE_XSMM_MAT_MUL
+    double *u_curr_chunk = (double *)u;
+    double *filtu_curr_chunk = (double *)filtx_work;
+
+    for (unsigned int k = 0; k < nz; k++) {
         // thanks to memory layout, we can just... use this as a matrix
         // so we can just grab the "matrix" of ny x nx for this one
 
@@ -1614,14 +1939,14 @@ void CompactFiniteDiff::filter_cfd_x(double *const u, double *const filtx_work,
         // for the x_der case, m = k = nx
         (*m_kernel_x_filt)(RF_mat_use, u_curr_chunk, filtu_curr_chunk);
 
-#else
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, RF_mat_use, &M,
-               u_curr_chunk, &K, &m_beta_filt, filtu_curr_chunk, &M);
-
-#endif
         u_curr_chunk += nx * ny;
         filtu_curr_chunk += nx * ny;
     }
+#else
+    // the alphas here should always be 1.0, there's no additional
+    // computation
+    dense_apply_x(filtx_work, u, RF_mat_use, 1.0, m_beta_filt, sz);
+#endif
 
     // we don't want B to overwrite C other wise we end up with errors
     std::copy_n(filtx_work, nx * ny * nz, u);
@@ -1638,35 +1963,19 @@ void CompactFiniteDiff::filter_cfd_y(double *const u, double *const filty_work,
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
 
-    // copy u to filtx_work
-    // std::copy_n(u, nx * ny * nz, filty_work);
-
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = ny;
-    int N = nx;
-    int K = ny;
-    // NOTE: LDA = M, LDB = N, and LDC = M
-    // LDB is N because in memory, Y is transposed!
-
-    double alpha = 1.0;
-
-    double *u_curr_chunk = (double *)u;
-    double *filtu_curr_chunk = (double *)filty_work;
-
     double *RF_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_DOWN)) && !(bflag & (1u << OCT_DIR_UP))) {
-        RF_mat_use = m_R_storage[ny][CompactDerivValueOrder::FILT_NORM];
+        RF_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::FILT_NORM];
     } else if ((bflag & (1u << OCT_DIR_DOWN)) &&
                !(bflag & (1u << OCT_DIR_UP))) {
-        RF_mat_use = m_R_storage[ny][CompactDerivValueOrder::FILT_LEFT];
+        RF_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::FILT_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_DOWN)) &&
                (bflag & (1u << OCT_DIR_UP))) {
-        RF_mat_use = m_R_storage[ny][CompactDerivValueOrder::FILT_RIGHT];
+        RF_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::FILT_RIGHT];
     } else {
-        RF_mat_use = m_R_storage[ny][CompactDerivValueOrder::FILT_LEFTRIGHT];
+        RF_mat_use = m_R_storage.at(ny)[CompactDerivValueOrder::FILT_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -1683,6 +1992,9 @@ void CompactFiniteDiff::filter_cfd_y(double *const u, double *const filty_work,
     }
 #endif
 
+#ifdef EM2_USE_XSMM_MAT_MUL
+    double *u_curr_chunk = (double *)u;
+
     for (unsigned int k = 0; k < nz; k++) {
         if (m_filter_type == FilterType::FILT_KIM_6) {
             // transpose into filty_work as a copy
@@ -1693,30 +2005,29 @@ void CompactFiniteDiff::filter_cfd_y(double *const u, double *const filty_work,
             }
         }
 
-#ifdef EM2_USE_XSMM_MAT_MUL
         // thanks to memory layout, we can just... use this as a matrix
         // so we can just grab the "matrix" of ny x nx for this one
 
         (*m_kernel_y_filt)(RF_mat_use, u_curr_chunk, filty_work);
 
-#else
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, RF_mat_use, &M,
-               u_curr_chunk, &N, &m_beta_filt, filty_work, &M);
-
-#endif
-
         // then transpose right back
-        // TODO: see if there's a faster way to copy (i.e. SSE?)
-        // the data is transposed so it's much harder to just copy all at
-        // once
         for (unsigned int i = 0; i < nx; i++) {
             for (unsigned int j = 0; j < ny; j++) {
-                // u[INDEX_3D(i, j, k)] += filty_work[j + i * ny];
                 u_curr_chunk[i + j * nx] = filty_work[j + i * ny];
             }
         }
         u_curr_chunk += nx * ny;
     }
+#else
+    // ONLY COPY if we're doing a KIM filter
+    if (m_filter_type == FilterType::FILT_KIM_6) {
+        std::copy_n(u, nx * ny * nz, filty_work);
+    }
+
+    dense_apply_y(filty_work, u, RF_mat_use, 1.0, m_beta_filt, sz);
+
+    std::copy_n(filty_work, nx * ny * nz, u);
+#endif
 }
 
 void CompactFiniteDiff::filter_cfd_z(double *const u, double *const filtz_work,
@@ -1730,25 +2041,19 @@ void CompactFiniteDiff::filter_cfd_z(double *const u, double *const filtz_work,
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
 
-    char TRANSA = 'N';
-    char TRANSB = 'T';
-    int M = nz;
-    int K = nz;
-    double alpha = 1.0;
-
     double *RF_mat_use = nullptr;
 
 #ifdef SOLVER_ENABLE_MERGED_BLOCKS
     if (!(bflag & (1u << OCT_DIR_BACK)) && !(bflag & (1u << OCT_DIR_FRONT))) {
-        RF_mat_use = m_R_storage[nz][CompactDerivValueOrder::FILT_NORM];
+        RF_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::FILT_NORM];
     } else if ((bflag & (1u << OCT_DIR_BACK)) &&
                !(bflag & (1u << OCT_DIR_FRONT))) {
-        RF_mat_use = m_R_storage[nz][CompactDerivValueOrder::FILT_LEFT];
+        RF_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::FILT_LEFT];
     } else if (!(bflag & (1u << OCT_DIR_BACK)) &&
                (bflag & (1u << OCT_DIR_FRONT))) {
-        RF_mat_use = m_R_storage[nz][CompactDerivValueOrder::FILT_RIGHT];
+        RF_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::FILT_RIGHT];
     } else {
-        RF_mat_use = m_R_storage[nz][CompactDerivValueOrder::FILT_LEFTRIGHT];
+        RF_mat_use = m_R_storage.at(nz)[CompactDerivValueOrder::FILT_LEFTRIGHT];
     }
 #else
     // to reduce the number of checks, check for failing bflag first
@@ -1766,53 +2071,249 @@ void CompactFiniteDiff::filter_cfd_z(double *const u, double *const filtz_work,
 #endif
 
 #ifdef EM2_USE_XSMM_MAT_MUL
-    int N = nx;
-#else
-    int N = nx;
-#endif
+    // scratch space belonging to the calling thread
+    CFDWorkspace &ws = get_workspace();
 
     for (unsigned int j = 0; j < ny; j++) {
         for (unsigned int k = 0; k < nz; k++) {
             // copy slice of X values over
             std::copy_n(&u[INDEX_3D(0, j, k)], nx,
-                        &m_du3d_block1[INDEX_N2D(0, k, nx)]);
-            // std::copy_n(&u[INDEX_3D(0, j, k)], nx,
-            //             &m_du2d[INDEX_N2D(0, k, nx)]);
+                        &ws.du3d_block1[INDEX_N2D(0, k, nx)]);
         }
 
         if (m_filter_type == FilterType::FILT_KIM_6) {
-            // then we need to copy in m_u2d to m_du2d but transposed
+            // the kernel adds beta times the transposed slice already in
+            // filtz_work
             for (unsigned int i = 0; i < nx; i++) {
                 for (unsigned int k = 0; k < nz; k++) {
-                    filtz_work[k + i * nz] = m_du3d_block1[i + k * nx];
+                    filtz_work[k + i * nz] = ws.du3d_block1[i + k * nx];
                 }
             }
         }
 
-#ifdef EM2_USE_XSMM_MAT_MUL
-
         // now do the faster math multiplcation
-        (*m_kernel_z_filt)(RF_mat_use, m_u2d, m_du2d);
+        (*m_kernel_z_filt)(RF_mat_use, ws.du3d_block1, filtz_work);
 
         // then we just stick it back in, but now in memory it's stored as
         // z0, z1, z2,... then increases in x so we can't just do copy_n
         for (unsigned int i = 0; i < nx; i++) {
             for (unsigned int k = 0; k < nz; k++) {
-                u[INDEX_3D(i, j, k)] = m_du2d[k + i * nz];
+                u[INDEX_3D(i, j, k)] = filtz_work[k + i * nz];
             }
         }
+    }
 #else
+    // ONLY COPY if we're doing a KIM filter
+    if (m_filter_type == FilterType::FILT_KIM_6) {
+        std::copy_n(u, nx * ny * nz, filtz_work);
+    }
 
-        dgemm_(&TRANSA, &TRANSB, &M, &N, &K, &alpha, RF_mat_use, &M,
-               m_du3d_block1, &N, &m_beta_filt, filtz_work, &M);
+    dense_apply_z(filtz_work, u, RF_mat_use, 1.0, m_beta_filt, sz);
 
-        for (unsigned int i = 0; i < nx; i++) {
-            for (unsigned int k = 0; k < nz; k++) {
-                u[INDEX_3D(i, j, k)] = filtz_work[k + i * nz];
-            }
+    std::copy_n(filtz_work, nx * ny * nz, u);
+#endif
+}
+
+// whether a block touches the domain boundary at the start (left) or end
+// (right) of direction dir
+static void get_dir_boundaries(const unsigned int dir, const unsigned bflag,
+                               bool &left, bool &right) {
+    const unsigned int lo[3] = {OCT_DIR_LEFT, OCT_DIR_DOWN, OCT_DIR_BACK};
+    const unsigned int hi[3] = {OCT_DIR_RIGHT, OCT_DIR_UP, OCT_DIR_FRONT};
+    left = bflag & (1u << lo[dir]);
+    right = bflag & (1u << hi[dir]);
+}
+
+void CompactFiniteDiff::apply_dense_batched(
+    double *const *out, const double *const *u, const unsigned int num_vars,
+    const unsigned int dir, const CompactDerivValueOrder base,
+    const double alpha, const double beta, const unsigned int *sz,
+    unsigned bflag) {
+    const size_t blk_sz = (size_t)sz[0] * sz[1] * sz[2];
+
+    bool left, right;
+    get_dir_boundaries(dir, bflag, left, right);
+    double *R_mat_use = get_R_matrix(sz[dir], base, left, right);
+
+    // scratch space belonging to the calling thread
+    CFDWorkspace &ws = get_workspace();
+
+    for (unsigned int v = 0; v < num_vars; v++) {
+        // GEMM can't work in place, go through the workspace if needed
+        double *target = out[v];
+        if (out[v] == u[v]) {
+            ws.reserve_batch_storage(blk_sz);
+            target = ws.batch_block1;
+        }
+        if (beta != 0.0) std::copy_n(u[v], blk_sz, target);
+
+        if (dir == 0) {
+            dense_apply_x(target, u[v], R_mat_use, alpha, beta, sz);
+        } else if (dir == 1) {
+            dense_apply_y(target, u[v], R_mat_use, alpha, beta, sz);
+        } else {
+            dense_apply_z(target, u[v], R_mat_use, alpha, beta, sz);
+        }
+
+        if (target != out[v]) std::copy_n(target, blk_sz, out[v]);
+    }
+}
+
+void CompactFiniteDiff::deriv_batched(
+    void (CompactFiniteDiff::*single)(double *const, const double *const,
+                                      const double, const unsigned int *,
+                                      unsigned),
+    double *const *Du, const double *const *u, const unsigned int num_vars,
+    const unsigned int dir, const CompactDerivValueOrder base, const double h,
+    const unsigned int *sz, unsigned bflag) {
+#if defined(EM2_USE_XSMM_MAT_MUL) || defined(EM2_DEBUG_COMPACT_DERIVS)
+    // the XSMM kernels are dispatched for a single block, and the debug
+    // checks live in the single variable versions
+    for (unsigned int v = 0; v < num_vars; v++) {
+        (this->*single)(Du[v], u[v], h, sz, bflag);
+    }
+#else
+    bool left, right;
+    get_dir_boundaries(dir, bflag, left, right);
+
+    if (get_banded_op(sz[dir], base, left, right) != nullptr) {
+        for (unsigned int v = 0; v < num_vars; v++) {
+            (this->*single)(Du[v], u[v], h, sz, bflag);
         }
+        return;
+    }
+
+    const double alpha =
+        (base == CompactDerivValueOrder::DERIV_2ND_NORM) ? 1.0 / (h * h)
+                                                         : 1.0 / h;
+    apply_dense_batched(Du, u, num_vars, dir, base, alpha, 0.0, sz, bflag);
 #endif
+}
+
+void CompactFiniteDiff::filter_batched(
+    void (CompactFiniteDiff::*single)(double *const, double *const,
+                                      const double, const unsigned int *,
+                                      unsigned),
+    double *const *u, const unsigned int num_vars, const unsigned int dir,
+    const double h, const unsigned int *sz, unsigned bflag) {
+    if (m_filter_type == FILT_NONE || m_filter_type == FILT_KO_DISS) {
+        return;
     }
+
+#ifdef EM2_USE_XSMM_MAT_MUL
+    CFDWorkspace &ws = get_workspace();
+    ws.reserve_batch_storage((size_t)sz[0] * sz[1] * sz[2]);
+    for (unsigned int v = 0; v < num_vars; v++) {
+        (this->*single)(u[v], ws.batch_block1, h, sz, bflag);
+    }
+#else
+    apply_dense_batched(u, u, num_vars, dir, CompactDerivValueOrder::FILT_NORM,
+                        1.0, m_beta_filt, sz, bflag);
+#endif
+}
+
+void CompactFiniteDiff::cfd_x_batched(double *const *Du,
+                                      const double *const *u,
+                                      const unsigned int num_vars,
+                                      const double dx, const unsigned int *sz,
+                                      unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_x, Du, u, num_vars, 0,
+                  CompactDerivValueOrder::DERIV_NORM, dx, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_y_batched(double *const *Du,
+                                      const double *const *u,
+                                      const unsigned int num_vars,
+                                      const double dy, const unsigned int *sz,
+                                      unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_y, Du, u, num_vars, 1,
+                  CompactDerivValueOrder::DERIV_NORM, dy, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_z_batched(double *const *Du,
+                                      const double *const *u,
+                                      const unsigned int num_vars,
+                                      const double dz, const unsigned int *sz,
+                                      unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_z, Du, u, num_vars, 2,
+                  CompactDerivValueOrder::DERIV_NORM, dz, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_xx_batched(double *const *Du,
+                                       const double *const *u,
+                                       const unsigned int num_vars,
+                                       const double dx, const unsigned int *sz,
+                                       unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_xx, Du, u, num_vars, 0,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dx, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_yy_batched(double *const *Du,
+                                       const double *const *u,
+                                       const unsigned int num_vars,
+                                       const double dy, const unsigned int *sz,
+                                       unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_yy, Du, u, num_vars, 1,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dy, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_zz_batched(double *const *Du,
+                                       const double *const *u,
+                                       const unsigned int num_vars,
+                                       const double dz, const unsigned int *sz,
+                                       unsigned bflag) {
+    deriv_batched(&CompactFiniteDiff::cfd_zz, Du, u, num_vars, 2,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dz, sz, bflag);
+}
+
+void CompactFiniteDiff::cfd_grad_2nd(double *const Dxu, double *const Dyu,
+                                     double *const Dzu, double *const Dxxu,
+                                     double *const Dyyu, double *const Dzzu,
+                                     const double *const u, const double dx,
+                                     const double dy, const double dz,
+                                     const unsigned int *sz, unsigned bflag) {
+    const double *const in[] = {u};
+    double *const out[] = {Dxu, Dyu, Dzu, Dxxu, Dyyu, Dzzu};
+
+    deriv_batched(&CompactFiniteDiff::cfd_x, &out[0], in, 1, 0,
+                  CompactDerivValueOrder::DERIV_NORM, dx, sz, bflag);
+    deriv_batched(&CompactFiniteDiff::cfd_xx, &out[3], in, 1, 0,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dx, sz, bflag);
+    deriv_batched(&CompactFiniteDiff::cfd_y, &out[1], in, 1, 1,
+                  CompactDerivValueOrder::DERIV_NORM, dy, sz, bflag);
+    deriv_batched(&CompactFiniteDiff::cfd_yy, &out[4], in, 1, 1,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dy, sz, bflag);
+    deriv_batched(&CompactFiniteDiff::cfd_z, &out[2], in, 1, 2,
+                  CompactDerivValueOrder::DERIV_NORM, dz, sz, bflag);
+    deriv_batched(&CompactFiniteDiff::cfd_zz, &out[5], in, 1, 2,
+                  CompactDerivValueOrder::DERIV_2ND_NORM, dz, sz, bflag);
+}
+
+void CompactFiniteDiff::filter_cfd_x_batched(double *const *u,
+                                             const unsigned int num_vars,
+                                             const double dx,
+                                             const unsigned int *sz,
+                                             unsigned bflag) {
+    filter_batched(&CompactFiniteDiff::filter_cfd_x, u, num_vars, 0, dx, sz,
+                   bflag);
+}
+
+void CompactFiniteDiff::filter_cfd_y_batched(double *const *u,
+                                             const unsigned int num_vars,
+                                             const double dy,
+                                             const unsigned int *sz,
+                                             unsigned bflag) {
+    filter_batched(&CompactFiniteDiff::filter_cfd_y, u, num_vars, 1, dy, sz,
+                   bflag);
+}
+
+void CompactFiniteDiff::filter_cfd_z_batched(double *const *u,
+                                             const unsigned int num_vars,
+                                             const double dz,
+                                             const unsigned int *sz,
+                                             unsigned bflag) {
+    filter_batched(&CompactFiniteDiff::filter_cfd_z, u, num_vars, 2, dz, sz,
+                   bflag);
 }
 
 DerType getDerTypeForEdges(const DerType derivtype,
@@ -2529,6 +3030,246 @@ void calculateDerivMatrix(double *D, double *P, double *Q, const int n) {
     delete[] work;
 }
 
+bool buildBandedDerivOperator(BandedDerivOperator &op, const double *P,
+                              const double *Q, const uint32_t n) {
+    op.clear();
+
+    if (n == 0) return false;
+
+    // find the bandwidth of P and the extent of each row of Q
+    uint32_t kl = 0, ku = 0, q_width = 0;
+    std::vector<uint32_t> q_start(n, 0);
+    std::vector<uint32_t> q_len(n, 0);
+    double p_max = 0.0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t first = n, last = 0;
+        for (uint32_t j = 0; j < n; j++) {
+            const double p_ij = P[INDEX_N2D(i, j, n)];
+            if (p_ij != 0.0) {
+                kl = std::max(kl, i > j ? i - j : 0u);
+                ku = std::max(ku, j > i ? j - i : 0u);
+                p_max = std::max(p_max, std::abs(p_ij));
+            }
+            if (Q[INDEX_N2D(i, j, n)] != 0.0) {
+                first = std::min(first, j);
+                last = std::max(last, j);
+            }
+        }
+        if (first <= last) {
+            q_start[i] = first;
+            q_len[i] = last - first + 1;
+            q_width = std::max(q_width, q_len[i]);
+        }
+    }
+
+    // multiply-adds per row of the banded path vs. the n of the dense
+    // matrix multiplication, if the band is as wide as the block there's
+    // nothing to gain
+    if (p_max == 0.0 || (q_width + kl + ku + 1) > n) {
+        return false;
+    }
+
+    // LU factorization of P without pivoting, restricted to the band. The
+    // compact schemes are diagonally dominant, so no fill-in happens outside
+    // of [i - kl, i + ku]. Any questionable pivot just means we fall back to
+    // the dense matrix.
+    std::vector<double> A(P, P + n * n);
+    for (uint32_t k = 0; k < n; k++) {
+        const double pivot = A[INDEX_N2D(k, k, n)];
+        if (std::abs(pivot) < 1.0e-12 * p_max) {
+            return false;
+        }
+        const uint32_t i_end = std::min(n, k + kl + 1);
+        const uint32_t j_end = std::min(n, k + ku + 1);
+        for (uint32_t i = k + 1; i < i_end; i++) {
+            const double l_ik = A[INDEX_N2D(i, k, n)] / pivot;
+            A[INDEX_N2D(i, k, n)] = l_ik;
+            if (l_ik == 0.0) continue;
+            for (uint32_t j = k + 1; j < j_end; j++) {
+                A[INDEX_N2D(i, j, n)] -= l_ik * A[INDEX_N2D(k, j, n)];
+            }
+        }
+    }
+
+    op.n = n;
+    op.kl = kl;
+    op.ku = ku;
+    op.q_width = q_width;
+    op.lower.assign(n * kl, 0.0);
+    op.upper.assign(n * ku, 0.0);
+    op.inv_diag.assign(n, 0.0);
+
+    for (uint32_t r = 0; r < n; r++) {
+        for (uint32_t d = 1; d <= kl && d <= r; d++) {
+            op.lower[r * kl + d - 1] = A[INDEX_N2D(r, r - d, n)];
+        }
+        for (uint32_t d = 1; d <= ku && r + d < n; d++) {
+            op.upper[r * ku + d - 1] = A[INDEX_N2D(r, r + d, n)];
+        }
+        op.inv_diag[r] = 1.0 / A[INDEX_N2D(r, r, n)];
+    }
+
+    op.q_start = q_start;
+    op.q_len = q_len;
+    op.q_coeffs.assign(n * q_width, 0.0);
+    for (uint32_t r = 0; r < n; r++) {
+        for (uint32_t t = 0; t < q_len[r]; t++) {
+            op.q_coeffs[r * q_width + t] = Q[INDEX_N2D(r, q_start[r] + t, n)];
+        }
+    }
+
+    op.valid = true;
+    return true;
+}
+
+void applyBandedDerivOperator(const BandedDerivOperator &op, double *out,
+                              const double *in, const uint32_t m,
+                              const uint32_t ld, const double scale) {
+    const uint32_t n = op.n;
+
+    // the panel is swept in chunks of columns so that the rows of the chunk
+    // stay in cache between the stencil, forward and backward sweeps
+    const uint32_t chunk = 64;
+
+    for (uint32_t c0 = 0; c0 < m; c0 += chunk) {
+        const uint32_t nc = std::min(chunk, m - c0);
+
+        // Q stencil and forward substitution (L y = Q u) in the same sweep,
+        // the forward sweep only needs rows that were already finished
+        for (uint32_t r = 0; r < n; r++) {
+            double *const out_r = &out[r * ld + c0];
+            const double *const q_r = &op.q_coeffs[r * op.q_width];
+            const uint32_t q_s = op.q_start[r];
+            const uint32_t q_l = op.q_len[r];
+
+            std::fill_n(out_r, nc, 0.0);
+
+            for (uint32_t t = 0; t < q_l; t++) {
+                const double q_t = q_r[t] * scale;
+                const double *const in_t = &in[(q_s + t) * ld + c0];
+                for (uint32_t c = 0; c < nc; c++) {
+                    out_r[c] += q_t * in_t[c];
+                }
+            }
+
+            const uint32_t d_end = std::min(op.kl, r);
+            for (uint32_t d = 1; d <= d_end; d++) {
+                const double l_rd = op.lower[r * op.kl + d - 1];
+                const double *const out_d = &out[(r - d) * ld + c0];
+                for (uint32_t c = 0; c < nc; c++) {
+                    out_r[c] -= l_rd * out_d[c];
+                }
+            }
+        }
+
+        // backward substitution (U x = y)
+        for (uint32_t rr = n; rr > 0; rr--) {
+            const uint32_t r = rr - 1;
+            double *const out_r = &out[r * ld + c0];
+
+            const uint32_t d_end = std::min(op.ku, n - 1 - r);
+            for (uint32_t d = 1; d <= d_end; d++) {
+                const double u_rd = op.upper[r * op.ku + d - 1];
+                const double *const out_d = &out[(r + d) * ld + c0];
+                for (uint32_t c = 0; c < nc; c++) {
+                    out_r[c] -= u_rd * out_d[c];
+                }
+            }
+
+            const double inv_d = op.inv_diag[r];
+            for (uint32_t c = 0; c < nc; c++) {
+                out_r[c] *= inv_d;
+            }
+        }
+    }
+}
+
+double bandedDerivOperatorError(const BandedDerivOperator &op,
+                                const double *D) {
+    const uint32_t n = op.n;
+
+    // applying the operator to the identity gives back the dense matrix, but
+    // with the rows in the panel layout: (r, c) -> D(r, c)
+    std::vector<double> eye(n * n, 0.0);
+    std::vector<double> result(n * n, 0.0);
+    for (uint32_t i = 0; i < n; i++) {
+        eye[i * n + i] = 1.0;
+    }
+
+    applyBandedDerivOperator(op, result.data(), eye.data(), n, n, 1.0);
+
+    double max_diff = 0.0;
+    double max_val = 0.0;
+    for (uint32_t r = 0; r < n; r++) {
+        for (uint32_t c = 0; c < n; c++) {
+            const double d_rc = D[INDEX_N2D(r, c, n)];
+            max_diff = std::max(max_diff, std::abs(result[r * n + c] - d_rc));
+            max_val = std::max(max_val, std::abs(d_rc));
+        }
+    }
+
+    return max_val > 0.0 ? max_diff / max_val : max_diff;
+}
+
+template <typename T>
+static void write_raw_vector(std::ostream &out, const std::vector<T> &v) {
+    const uint64_t sz = v.size();
+    out.write((const char *)&sz, sizeof(sz));
+    out.write((const char *)v.data(), sizeof(T) * sz);
+}
+
+template <typename T>
+static bool read_raw_vector(std::istream &in, std::vector<T> &v,
+                            const uint64_t max_sz) {
+    uint64_t sz = 0;
+    in.read((char *)&sz, sizeof(sz));
+    if (!in || sz > max_sz) return false;
+    v.resize(sz);
+    in.read((char *)v.data(), sizeof(T) * sz);
+    return (bool)in;
+}
+
+void writeBandedDerivOperator(std::ostream &out,
+                              const BandedDerivOperator &op) {
+    const uint32_t header[5] = {op.n, op.kl, op.ku, op.q_width,
+                                op.valid ? 1u : 0u};
+    out.write((const char *)header, sizeof(header));
+    write_raw_vector(out, op.lower);
+    write_raw_vector(out, op.upper);
+    write_raw_vector(out, op.inv_diag);
+    write_raw_vector(out, op.q_start);
+    write_raw_vector(out, op.q_len);
+    write_raw_vector(out, op.q_coeffs);
+}
+
+bool readBandedDerivOperator(std::istream &in, BandedDerivOperator &op) {
+    op.clear();
+
+    uint32_t header[5];
+    in.read((char *)header, sizeof(header));
+    if (!in) return false;
+
+    op.n = header[0];
+    op.kl = header[1];
+    op.ku = header[2];
+    op.q_width = header[3];
+    op.valid = header[4] != 0;
+
+    // no array of an operator is bigger than a dense n x n matrix
+    const uint64_t max_sz = (uint64_t)op.n * op.n;
+    if (!read_raw_vector(in, op.lower, max_sz) ||
+        !read_raw_vector(in, op.upper, max_sz) ||
+        !read_raw_vector(in, op.inv_diag, max_sz) ||
+        !read_raw_vector(in, op.q_start, max_sz) ||
+        !read_raw_vector(in, op.q_len, max_sz) ||
+        !read_raw_vector(in, op.q_coeffs, max_sz)) {
+        op.clear();
+        return false;
+    }
+    return true;
+}
+
 void mulMM(double *C, double *A, double *B, int na, int nb) {
     /*  M = number of rows of A and C
         N = number of columns of B and C
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "stencil_derivs.h"
+
 namespace dendro_derivs {
 
 void (*deriv_x)(double *const, const double *const, const double,
@@ -20,6 +22,19 @@ void (*deriv_yy)(double *const, const double *const, const double,
 void (*deriv_zz)(double *const, const double *const, const double,
                  const unsigned int *, unsigned);
 
+void (*deriv_grad_2nd)(double *const, double *const, double *const,
+                       double *const, double *const, double *const,
+                       const double *const, const double, const double,
+                       const double, const unsigned int *, unsigned);
+
+void (*deriv_face_grad)(double *const, double *const, double *const,
+                        const double *const, const double, const double,
+                        const double, const unsigned int *, unsigned);
+
+void (*ko_dissipation)(double *const, const double *const, const double,
+                       const double, const double, const double,
+                       const unsigned int *, unsigned);
+
 void (*ko_deriv_x)(double *const, const double *const, const double,
                    const unsigned int *, unsigned);
 void (*ko_deriv_y)(double *const, const double *const, const double,
@@ -27,50 +42,69 @@ void (*ko_deriv_y)(double *const, const double *const, const double,
 void (*ko_deriv_z)(double *const, const double *const, const double,
                    const unsigned int *, unsigned);
 
+// the tables are odr-used by the kernels, so they need a definition in
+// exactly one translation unit
+#define DENDRO_DERIVS_DEFINE_STENCIL(S)                              \
+    constexpr double S::interior[];                                  \
+    constexpr double S::closure[S::NUM_CLOSURE][S::CLOSURE_WIDTH]; \
+    constexpr double S::closure_den[];
+
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_42)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_42)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_644)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_644)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_642)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_642)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_8642)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_8642)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_8664)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_8664)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD1_8666)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilD2_8666)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilKO_21)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilKO_42)
+DENDRO_DERIVS_DEFINE_STENCIL(StencilKO_64)
+
+#undef DENDRO_DERIVS_DEFINE_STENCIL
+
+/**
+ * @brief Points the deriv and ko_deriv function pointers at the stencil
+ * kernels for the compiled-in order and the given padding width.
+ */
+template <class D1, class D2, class KO, unsigned PW>
+static void set_stencil_derivs() {
+    dendro_derivs::deriv_x = stencil_deriv<D1, 0, PW>;
+    dendro_derivs::deriv_y = stencil_deriv<D1, 1, PW>;
+    dendro_derivs::deriv_z = stencil_deriv<D1, 2, PW>;
+
+    dendro_derivs::deriv_xx = stencil_deriv<D2, 0, PW>;
+    dendro_derivs::deriv_yy = stencil_deriv<D2, 1, PW>;
+    dendro_derivs::deriv_zz = stencil_deriv<D2, 2, PW>;
+
+    dendro_derivs::deriv_grad_2nd = stencil_grad_2nd<D1, D2, PW>;
+    dendro_derivs::deriv_face_grad = stencil_face_grad<D1, PW>;
+
+    dendro_derivs::ko_deriv_x = stencil_deriv<KO, 0, PW>;
+    dendro_derivs::ko_deriv_y = stencil_deriv<KO, 1, PW>;
+    dendro_derivs::ko_deriv_z = stencil_deriv<KO, 2, PW>;
+
+    dendro_derivs::ko_dissipation = stencil_ko_dissipation<KO, PW>;
+}
+
 void set_appropriate_derivs(const unsigned pw) {
 #ifdef SOLVER_USE_4TH_ORDER_DERIVS
     if (pw == 2) {
         std::cout << "4th Order Derivatives set, detected padding width of 2"
                   << std::endl;
-        dendro_derivs::deriv_x = deriv42_x_pw2;
-        dendro_derivs::deriv_y = deriv42_y_pw2;
-        dendro_derivs::deriv_z = deriv42_z_pw2;
-
-        dendro_derivs::deriv_xx = deriv42_xx_pw2;
-        dendro_derivs::deriv_yy = deriv42_yy_pw2;
-        dendro_derivs::deriv_zz = deriv42_zz_pw2;
-
-        dendro_derivs::ko_deriv_x = ko_deriv21_x;
-        dendro_derivs::ko_deriv_y = ko_deriv21_y;
-        dendro_derivs::ko_deriv_z = ko_deriv21_z;
+        set_stencil_derivs<StencilD1_42, StencilD2_42, StencilKO_21, 2>();
     } else if (pw == 3) {
         std::cout << "4th Order Derivatives set, detected padding width of 3"
                   << std::endl;
-        dendro_derivs::deriv_x = deriv42_x;
-        dendro_derivs::deriv_y = deriv42_y;
-        dendro_derivs::deriv_z = deriv42_z;
-
-        dendro_derivs::deriv_xx = deriv42_xx;
-        dendro_derivs::deriv_yy = deriv42_yy;
-        dendro_derivs::deriv_zz = deriv42_zz;
-
-        dendro_derivs::ko_deriv_x = ko_deriv42_x;
-        dendro_derivs::ko_deriv_y = ko_deriv42_y;
-        dendro_derivs::ko_deriv_z = ko_deriv42_z;
+        set_stencil_derivs<StencilD1_42, StencilD2_42, StencilKO_42, 3>();
     } else if (pw == 4) {
         std::cout << "4th Order Derivatives set, detected padding width of 4"
                   << std::endl;
-        dendro_derivs::deriv_x = deriv42_x_pw4;
-        dendro_derivs::deriv_y = deriv42_y_pw4;
-        dendro_derivs::deriv_z = deriv42_z_pw4;
-
-        dendro_derivs::deriv_xx = deriv42_xx_pw4;
-        dendro_derivs::deriv_yy = deriv42_yy_pw4;
-        dendro_derivs::deriv_zz = deriv42_zz_pw4;
-
-        dendro_derivs::ko_deriv_x = ko_pw4_deriv42_x;
-        dendro_derivs::ko_deriv_y = ko_pw4_deriv42_y;
-        dendro_derivs::ko_deriv_z = ko_pw4_deriv42_z;
+        set_stencil_derivs<StencilD1_42, StencilD2_42, StencilKO_42, 4>();
     } else {
         throw std::runtime_error(
             "There is currently no support for 4th order derivatives with a "
@@ -82,32 +116,11 @@ void set_appropriate_derivs(const unsigned pw) {
     if (pw == 3) {
         std::cout << "6th Order Derivatives set, detected padding width of 3"
                   << std::endl;
-        dendro_derivs::deriv_x = deriv644_x;
-        dendro_derivs::deriv_y = deriv644_y;
-        dendro_derivs::deriv_z = deriv644_z;
-
-        dendro_derivs::deriv_xx = deriv42_xx;
-        dendro_derivs::deriv_yy = deriv42_yy;
-        dendro_derivs::deriv_zz = deriv42_zz;
-
-        dendro_derivs::ko_deriv_x = ko_deriv42_x;
-        dendro_derivs::ko_deriv_y = ko_deriv42_y;
-        dendro_derivs::ko_deriv_z = ko_deriv42_z;
-
+        set_stencil_derivs<StencilD1_644, StencilD2_42, StencilKO_42, 3>();
     } else if (pw == 4) {
-        std::cout << "6th Order Derivatives set, detected padding width of 3"
+        std::cout << "6th Order Derivatives set, detected padding width of 4"
                   << std::endl;
-        dendro_derivs::deriv_x = deriv644_x_pw4;
-        dendro_derivs::deriv_y = deriv644_y_pw4;
-        dendro_derivs::deriv_z = deriv644_z_pw4;
-
-        dendro_derivs::deriv_xx = deriv42_xx_pw4;
-        dendro_derivs::deriv_yy = deriv42_yy_pw4;
-        dendro_derivs::deriv_zz = deriv42_zz_pw4;
-
-        dendro_derivs::ko_deriv_x = ko_pw4_deriv42_x;
-        dendro_derivs::ko_deriv_y = ko_pw4_deriv42_y;
-        dendro_derivs::ko_deriv_z = ko_pw4_deriv42_z;
+        set_stencil_derivs<StencilD1_644, StencilD2_42, StencilKO_42, 4>();
     } else {
         throw std::runtime_error(
             "There is currently no support for 6th order derivatives with a "
@@ -119,18 +132,7 @@ void set_appropriate_derivs(const unsigned pw) {
 #ifdef SOLVER_USE_8TH_ORDER_DERIVS
 
     if (pw == 4) {
-        dendro_derivs::deriv_x = deriv8642_x;
-        dendro_derivs::deriv_y = deriv8642_y;
-        dendro_derivs::deriv_z = deriv8642_x;
-
-        dendro_derivs::deriv_xx = deriv8642_xx;
-        dendro_derivs::deriv_yy = deriv8642_yy;
-        dendro_derivs::deriv_zz = deriv8642_zz;
-
-        dendro_derivs::ko_deriv_x = ko_pw4_deriv42_x;
-        dendro_derivs::ko_deriv_y = ko_pw4_deriv42_y;
-        dendro_derivs::ko_deriv_z = ko_pw4_deriv42_z;
-
+        set_stencil_derivs<StencilD1_8642, StencilD2_8642, StencilKO_42, 4>();
     } else {
         throw std::runtime_error(
             "There is currently no support for 8th order derivatives with a "
@@ -231,98 +233,112 @@ void deriv644_z_wrapper(double *const Dzu, const double *const u,
     }
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
 void deriv42_x(double *const Dxu, const double *const u, const double dx,
                const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 0, 3>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 1;
-    const int kb = 1;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 1;
-    const int ke = sz[2] - 1;
+void deriv42_x_pw2(double *const Dxu, const double *const u, const double dx,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 0, 2>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    const int n = 1;
+void deriv42_x_pw4(double *const Dxu, const double *const u, const double dx,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 0, 4>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Dxu[pp] = (u[pp - 2] - 8.0 * u[pp - 1] + 8.0 * u[pp + 1] -
-                           u[pp + 2]) *
-                          idx_by_12;
-            }
-        }
-    }
+void deriv42_y(double *const Dyu, const double *const u, const double dy,
+               const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 1, 3>(
+        Dyu, u, dy, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(3, j, k)] = (-3.0 * u[IDX(3, j, k)] +
-                                     4.0 * u[IDX(4, j, k)] - u[IDX(5, j, k)]) *
-                                    idx_by_2;
-                Dxu[IDX(4, j, k)] =
-                    (-u[IDX(3, j, k)] + u[IDX(5, j, k)]) * idx_by_2;
-            }
-        }
-    }
+void deriv42_y_pw2(double *const Dyu, const double *const u, const double dy,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 1, 2>(
+        Dyu, u, dy, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) * idx_by_2;
+void deriv42_y_pw4(double *const Dyu, const double *const u, const double dy,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 1, 4>(
+        Dyu, u, dy, sz, bflag);
+}
 
-                Dxu[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_2;
-            }
-        }
-    }
+void deriv42_z(double *const Dzu, const double *const u, const double dz,
+               const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 2, 3>(
+        Dzu, u, dz, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv42_z_pw2(double *const Dzu, const double *const u, const double dz,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 2, 2>(
+        Dzu, u, dz, sz, bflag);
+}
+
+void deriv42_z_pw4(double *const Dzu, const double *const u, const double dz,
+                   const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_42, 2, 4>(
+        Dzu, u, dz, sz, bflag);
+}
+
+void deriv42_xx(double *const DxDxu, const double *const u, const double dx,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 0, 3>(
+        DxDxu, u, dx, sz, bflag);
+}
+
+void deriv42_yy(double *const DyDyu, const double *const u, const double dy,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 1, 3>(
+        DyDyu, u, dy, sz, bflag);
+}
+
+void deriv42_zz(double *const DzDzu, const double *const u, const double dz,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 2, 3>(
+        DzDzu, u, dz, sz, bflag);
+}
+
+void deriv42_xx_pw2(double *const DxDxu, const double *const u, const double dx,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 0, 2>(
+        DxDxu, u, dx, sz, bflag);
+}
+
+void deriv42_yy_pw2(double *const DyDyu, const double *const u, const double dy,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 1, 2>(
+        DyDyu, u, dy, sz, bflag);
+}
+
+void deriv42_zz_pw2(double *const DzDzu, const double *const u, const double dz,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 2, 2>(
+        DzDzu, u, dz, sz, bflag);
+}
+
+void deriv42_xx_pw4(double *const DxDxu, const double *const u, const double dx,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 0, 4>(
+        DxDxu, u, dx, sz, bflag);
+}
+
+void deriv42_yy_pw4(double *const DyDyu, const double *const u, const double dy,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 1, 4>(
+        DyDyu, u, dy, sz, bflag);
+}
+
+void deriv42_zz_pw4(double *const DzDzu, const double *const u, const double dz,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_42, 2, 4>(
+        DzDzu, u, dz, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -330,70 +346,100 @@ void deriv42_x(double *const Dxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_x_pw2(double *const Dxu, const double *const u, const double dx,
-                   const unsigned int *sz, unsigned bflag) {
+void deriv42adv_x(double *const Dxu, const double *const u, const double dx,
+                  const unsigned int *sz, const double *const betax,
+                  unsigned bflag) {
     const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
+    const double idx_by_2 = 0.50 * idx;
     const double idx_by_12 = idx / 12.0;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
     for (int k = kb; k < ke; k++) {
         for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int i = ib; i < ie; i++) {
                 const int pp = IDX(i, j, k);
-                Dxu[pp] = (u[pp - 2] - 8.0 * u[pp - 1] + 8.0 * u[pp + 1] -
-                           u[pp + 2]) *
-                          idx_by_12;
+                if (betax[pp] > 0.0) {
+                    Dxu[pp] = (-3.0 * u[pp - 1] - 10.0 * u[pp] +
+                               18.0 * u[pp + 1] - 6.0 * u[pp + 2] + u[pp + 3]) *
+                              idx_by_12;
+                } else {
+                    Dxu[pp] = (-u[pp - 3] + 6.0 * u[pp - 2] - 18.0 * u[pp - 1] +
+                               10.0 * u[pp] + 3.0 * u[pp + 1]) *
+                              idx_by_12;
+                }
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_LEFT)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int j = jb; j < je; j++) {
-                Dxu[IDX(2, j, k)] = (-3.0 * u[IDX(2, j, k)] +
-                                     4.0 * u[IDX(3, j, k)] - u[IDX(4, j, k)]) *
+                Dxu[IDX(3, j, k)] = (-3.0 * u[IDX(3, j, k)] +
+                                     4.0 * u[IDX(4, j, k)] - u[IDX(5, j, k)]) *
                                     idx_by_2;
-                Dxu[IDX(3, j, k)] =
-                    (-u[IDX(2, j, k)] + u[IDX(4, j, k)]) * idx_by_2;
+
+                if (betax[IDX(4, j, k)] > 0.0) {
+                    Dxu[IDX(4, j, k)] =
+                        (-3.0 * u[IDX(4, j, k)] + 4.0 * u[IDX(5, j, k)] -
+                         u[IDX(6, j, k)]) *
+                        idx_by_2;
+                } else {
+                    Dxu[IDX(4, j, k)] =
+                        (-u[IDX(3, j, k)] + u[IDX(5, j, k)]) * idx_by_2;
+                }
+
+                if (betax[IDX(5, j, k)] > 0.0) {
+                    Dxu[IDX(5, j, k)] =
+                        (-3.0 * u[IDX(4, j, k)] - 10.0 * u[IDX(5, j, k)] +
+                         18.0 * u[IDX(6, j, k)] - 6.0 * u[IDX(7, j, k)] +
+                         u[IDX(8, j, k)]) *
+                        idx_by_12;
+                } else {
+                    Dxu[IDX(5, j, k)] =
+                        (u[IDX(3, j, k)] - 4.0 * u[IDX(4, j, k)] +
+                         3.0 * u[IDX(5, j, k)]) *
+                        idx_by_2;
+                }
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_RIGHT)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int j = jb; j < je; j++) {
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) * idx_by_2;
+                if (betax[IDX(ie - 3, j, k)] > 0.0) {
+                    Dxu[IDX(ie - 3, j, k)] =
+                        (-3.0 * u[IDX(ie - 3, j, k)] +
+                         4.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
+                        idx_by_2;
+                } else {
+                    Dxu[IDX(ie - 3, j, k)] =
+                        (-u[IDX(ie - 6, j, k)] + 6.0 * u[IDX(ie - 5, j, k)] -
+                         18.0 * u[IDX(ie - 4, j, k)] +
+                         10.0 * u[IDX(ie - 3, j, k)] +
+                         3.0 * u[IDX(ie - 2, j, k)]) *
+                        idx_by_12;
+                }
+
+                if (betax[IDX(ie - 2, j, k)] > 0.0) {
+                    Dxu[IDX(ie - 2, j, k)] =
+                        (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) *
+                        idx_by_2;
+                } else {
+                    Dxu[IDX(ie - 2, j, k)] =
+                        (u[IDX(ie - 4, j, k)] - 4.0 * u[IDX(ie - 3, j, k)] +
+                         3.0 * u[IDX(ie - 2, j, k)]) *
+                        idx_by_2;
+                }
 
                 Dxu[IDX(ie - 1, j, k)] =
                     (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
@@ -409,7 +455,7 @@ void deriv42_x_pw2(double *const Dxu, const double *const u, const double dx,
         for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
                 const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
+                if (std::isnan(Dxu[pp]))
                     std::cout << "NAN detected function " << __func__
                               << " file: " << __FILE__ << " line: " << __LINE__
                               << std::endl;
@@ -424,75 +470,107 @@ void deriv42_x_pw2(double *const Dxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_x_pw4(double *const Dxu, const double *const u, const double dx,
-                   const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
+void deriv42adv_y(double *const Dyu, const double *const u, const double dy,
+                  const unsigned int *sz, const double *const betay,
+                  unsigned bflag) {
+    const double idy = 1.0 / dy;
+    const double idy_by_2 = 0.50 * idy;
+    const double idy_by_12 = idy / 12.0;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    const int n = 1;
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
     for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
+        for (int i = ib; i < ie; i++) {
+            for (int j = jb; j < je; j++) {
                 const int pp = IDX(i, j, k);
-                Dxu[pp] = (u[pp - 2] - 8.0 * u[pp - 1] + 8.0 * u[pp + 1] -
-                           u[pp + 2]) *
-                          idx_by_12;
+                if (betay[pp] > 0.0) {
+                    Dyu[pp] =
+                        (-3.0 * u[pp - nx] - 10.0 * u[pp] + 18.0 * u[pp + nx] -
+                         6.0 * u[pp + 2 * nx] + u[pp + 3 * nx]) *
+                        idy_by_12;
+                } else {
+                    Dyu[pp] =
+                        (-u[pp - 3 * nx] + 6.0 * u[pp - 2 * nx] -
+                         18.0 * u[pp - nx] + 10.0 * u[pp] + 3.0 * u[pp + nx]) *
+                        idy_by_12;
+                }
             }
         }
     }
 
-    if (bflag & (1u << OCT_DIR_LEFT)) {
+    if (bflag & (1u << OCT_DIR_DOWN)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(4, j, k)] = (-3.0 * u[IDX(4, j, k)] +
-                                     4.0 * u[IDX(5, j, k)] - u[IDX(6, j, k)]) *
-                                    idx_by_2;
-                Dxu[IDX(5, j, k)] =
-                    (-u[IDX(4, j, k)] + u[IDX(6, j, k)]) * idx_by_2;
+            for (int i = ib; i < ie; i++) {
+                Dyu[IDX(i, 3, k)] = (-3.0 * u[IDX(i, 3, k)] +
+                                     4.0 * u[IDX(i, 4, k)] - u[IDX(i, 5, k)]) *
+                                    idy_by_2;
+
+                if (betay[IDX(i, 4, k)] > 0.0) {
+                    Dyu[IDX(i, 4, k)] =
+                        (-3.0 * u[IDX(i, 4, k)] + 4.0 * u[IDX(i, 5, k)] -
+                         u[IDX(i, 6, k)]) *
+                        idy_by_2;
+                } else {
+                    Dyu[IDX(i, 4, k)] =
+                        (-u[IDX(i, 3, k)] + u[IDX(i, 5, k)]) * idy_by_2;
+                }
+
+                if (betay[IDX(i, 5, k)] > 0.0) {
+                    Dyu[IDX(i, 5, k)] =
+                        (-3.0 * u[IDX(i, 4, k)] - 10.0 * u[IDX(i, 5, k)] +
+                         18.0 * u[IDX(i, 6, k)] - 6.0 * u[IDX(i, 7, k)] +
+                         u[IDX(i, 8, k)]) *
+                        idy_by_12;
+                } else {
+                    Dyu[IDX(i, 5, k)] =
+                        (u[IDX(i, 3, k)] - 4.0 * u[IDX(i, 4, k)] +
+                         3.0 * u[IDX(i, 5, k)]) *
+                        idy_by_2;
+                }
             }
         }
     }
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
+    if (bflag & (1u << OCT_DIR_UP)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) * idx_by_2;
+            for (int i = ib; i < ie; i++) {
+                if (betay[IDX(i, je - 3, k)] > 0.0) {
+                    Dyu[IDX(i, je - 3, k)] =
+                        (-3.0 * u[IDX(i, je - 3, k)] +
+                         4.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
+                        idy_by_2;
+                } else {
+                    Dyu[IDX(i, je - 3, k)] =
+                        (-u[IDX(i, je - 6, k)] + 6.0 * u[IDX(i, je - 5, k)] -
+                         18.0 * u[IDX(i, je - 4, k)] +
+                         10.0 * u[IDX(i, je - 3, k)] +
+                         3.0 * u[IDX(i, je - 2, k)]) *
+                        idy_by_12;
+                }
 
-                Dxu[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_2;
+                if (betay[IDX(i, je - 2, k)] > 0.0) {
+                    Dyu[IDX(i, je - 2, k)] =
+                        (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) *
+                        idy_by_2;
+                } else {
+                    Dyu[IDX(i, je - 2, k)] =
+                        (u[IDX(i, je - 4, k)] - 4.0 * u[IDX(i, je - 3, k)] +
+                         3.0 * u[IDX(i, je - 2, k)]) *
+                        idy_by_2;
+                }
+
+                Dyu[IDX(i, je - 1, k)] =
+                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
+                     3.0 * u[IDX(i, je - 1, k)]) *
+                    idy_by_2;
             }
         }
     }
@@ -503,7 +581,7 @@ void deriv42_x_pw4(double *const Dxu, const double *const u, const double dx,
         for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
                 const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
+                if (std::isnan(Dyu[pp]))
                     std::cout << "NAN detected function " << __func__
                               << " file: " << __FILE__ << " line: " << __LINE__
                               << std::endl;
@@ -518,76 +596,109 @@ void deriv42_x_pw4(double *const Dxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_y(double *const Dyu, const double *const u, const double dy,
-               const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.50 * idy;
-    const double idy_by_12 = idy / 12.0;
+void deriv42adv_z(double *const Dzu, const double *const u, const double dz,
+                  const unsigned int *sz, const double *const betaz,
+                  unsigned bflag) {
+    const double idz = 1.0 / dz;
+    const double idz_by_2 = 0.50 * idz;
+    const double idz_by_12 = idz / 12.0;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
     const int ib = 3;
     const int jb = 3;
-    const int kb = 1;
+    const int kb = 3;
     const int ie = sz[0] - 3;
     const int je = sz[1] - 3;
-    const int ke = sz[2] - 1;
+    const int ke = sz[2] - 3;
 
-    const int n = nx;
+    const int n = nx * ny;
 
-    for (int k = kb; k < ke; k++) {
+    for (int j = jb; j < je; j++) {
         for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
+            for (int k = kb; k < ke; k++) {
                 const int pp = IDX(i, j, k);
-                Dyu[pp] = (u[pp - 2 * nx] - 8.0 * u[pp - nx] +
-                           8.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                          idy_by_12;
+                if (betaz[pp] > 0.0) {
+                    Dzu[pp] =
+                        (-3.0 * u[pp - n] - 10.0 * u[pp] + 18.0 * u[pp + n] -
+                         6.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
+                        idz_by_12;
+                } else {
+                    Dzu[pp] =
+                        (-u[pp - 3 * n] + 6.0 * u[pp - 2 * n] -
+                         18.0 * u[pp - n] + 10.0 * u[pp] + 3.0 * u[pp + n]) *
+                        idz_by_12;
+                }
             }
         }
     }
 
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+    if (bflag & (1u << OCT_DIR_BACK)) {
+        for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 3, k)] = (-3.0 * u[IDX(i, 3, k)] +
-                                     4.0 * u[IDX(i, 4, k)] - u[IDX(i, 5, k)]) *
-                                    idy_by_2;
+                Dzu[IDX(i, j, 3)] = (-3.0 * u[IDX(i, j, 3)] +
+                                     4.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 5)]) *
+                                    idz_by_2;
+
+                if (betaz[IDX(i, j, 4)] > 0.0) {
+                    Dzu[IDX(i, j, 4)] =
+                        (-3.0 * u[IDX(i, j, 4)] + 4.0 * u[IDX(i, j, 5)] -
+                         u[IDX(i, j, 6)]) *
+                        idz_by_2;
+                } else {
+                    Dzu[IDX(i, j, 4)] =
+                        (-u[IDX(i, j, 3)] + u[IDX(i, j, 5)]) * idz_by_2;
+                }
 
-                Dyu[IDX(i, 4, k)] =
-                    (-u[IDX(i, 3, k)] + u[IDX(i, 5, k)]) * idy_by_2;
+                if (betaz[IDX(i, j, 5)] > 0.0) {
+                    Dzu[IDX(i, j, 5)] =
+                        (-3.0 * u[IDX(i, j, 4)] - 10.0 * u[IDX(i, j, 5)] +
+                         18.0 * u[IDX(i, j, 6)] - 6.0 * u[IDX(i, j, 7)] +
+                         u[IDX(i, j, 8)]) *
+                        idz_by_12;
+                } else {
+                    Dzu[IDX(i, j, 5)] =
+                        (u[IDX(i, j, 3)] - 4.0 * u[IDX(i, j, 4)] +
+                         3.0 * u[IDX(i, j, 5)]) *
+                        idz_by_2;
+                }
             }
         }
     }
 
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+    if (bflag & (1u << OCT_DIR_FRONT)) {
+        for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) * idy_by_2;
+                if (betaz[IDX(i, j, ke - 3)] > 0.0) {
+                    Dzu[IDX(i, j, ke - 3)] =
+                        (-3.0 * u[IDX(i, j, ke - 3)] +
+                         4.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
+                        idz_by_2;
+                } else {
+                    Dzu[IDX(i, j, ke - 3)] =
+                        (-u[IDX(i, j, ke - 6)] + 6.0 * u[IDX(i, j, ke - 5)] -
+                         18.0 * u[IDX(i, j, ke - 4)] +
+                         10.0 * u[IDX(i, j, ke - 3)] +
+                         3.0 * u[IDX(i, j, ke - 2)]) *
+                        idz_by_12;
+                }
 
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
+                if (betaz[IDX(i, j, ke - 2)] > 0.0) {
+                    Dzu[IDX(i, j, ke - 2)] =
+                        (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) *
+                        idz_by_2;
+                } else {
+                    Dzu[IDX(i, j, ke - 2)] =
+                        (u[IDX(i, j, ke - 4)] - 4.0 * u[IDX(i, j, ke - 3)] +
+                         3.0 * u[IDX(i, j, ke - 2)]) *
+                        idz_by_2;
+                }
+
+                Dzu[IDX(i, j, ke - 1)] =
+                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
+                     3.0 * u[IDX(i, j, ke - 1)]) *
+                    idz_by_2;
             }
         }
     }
@@ -598,7 +709,7 @@ void deriv42_y(double *const Dyu, const double *const u, const double dy,
         for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
                 const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
+                if (std::isnan(Dzu[pp]))
                     std::cout << "NAN detected function " << __func__
                               << " file: " << __FILE__ << " line: " << __LINE__
                               << std::endl;
@@ -608,206 +719,244 @@ void deriv42_y(double *const Dyu, const double *const u, const double dy,
 #endif
 }
 
-/*----------------------------------------------------------------------;
+void ko_deriv21_x(double *const Du, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_21, 0, 2>(
+        Du, u, dx, sz, bflag);
+}
+
+void ko_deriv21_y(double *const Du, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_21, 1, 2>(
+        Du, u, dy, sz, bflag);
+}
+
+void ko_deriv21_z(double *const Du, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_21, 2, 2>(
+        Du, u, dz, sz, bflag);
+}
+
+void ko_deriv42_x(double *const Du, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 0, 3>(
+        Du, u, dx, sz, bflag);
+}
+
+void ko_deriv42_y(double *const Du, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 1, 3>(
+        Du, u, dy, sz, bflag);
+}
+
+void ko_deriv42_z(double *const Du, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 2, 3>(
+        Du, u, dz, sz, bflag);
+}
+
+void ko_pw4_deriv42_x(double *const Du, const double *const u, const double dx,
+                      const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 0, 4>(
+        Du, u, dx, sz, bflag);
+}
+
+void ko_pw4_deriv42_y(double *const Du, const double *const u, const double dy,
+                      const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 1, 4>(
+        Du, u, dy, sz, bflag);
+}
+
+void ko_pw4_deriv42_z(double *const Du, const double *const u, const double dz,
+                      const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_42, 2, 4>(
+        Du, u, dz, sz, bflag);
+}
+
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_y_pw2(double *const Dyu, const double *const u, const double dy,
-                   const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.50 * idy;
-    const double idy_by_12 = idy / 12.0;
+void disstvb3_x(double *const Du, const double *const u,
+                const double *const lam, const double dx,
+                const unsigned int *sz, unsigned bflag) {
+    const double pre_factor = -1.0 / 12.0 / dx;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 0;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 0;
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
-    const int n = nx;
+    const double smr3 = 59.0 / 48.0 * 64 * dx;
+    const double smr2 = 43.0 / 48.0 * 64 * dx;
+    const double smr1 = 49.0 / 48.0 * 64 * dx;
+    const double spr3 = smr3;
+    const double spr2 = smr2;
+    const double spr1 = smr1;
 
     for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
+        for (int j = jb; j < je; j++) {
+            for (int i = ib + 1; i < ie - 1; i++) {
                 const int pp = IDX(i, j, k);
-                Dyu[pp] = (u[pp - 2 * nx] - 8.0 * u[pp - nx] +
-                           8.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                          idy_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 2, k)] = (-3.0 * u[IDX(i, 2, k)] +
-                                     4.0 * u[IDX(i, 3, k)] - u[IDX(i, 4, k)]) *
-                                    idy_by_2;
-
-                Dyu[IDX(i, 3, k)] =
-                    (-u[IDX(i, 2, k)] + u[IDX(i, 4, k)]) * idy_by_2;
+                Du[pp] =
+                    pre_factor *
+                    (lam[pp - 2] * u[pp - 2] - 4.0 * lam[pp - 1] * u[pp - 1] +
+                     6.0 * lam[pp] * u[pp] - 4.0 * lam[pp + 1] * u[pp + 1] +
+                     lam[pp + 2] * u[pp + 2]);
             }
         }
     }
 
-    if (bflag & (1u << OCT_DIR_UP)) {
+    if (bflag & (1u << OCT_DIR_LEFT)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) * idy_by_2;
-
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
+            for (int j = jb; j < je; j++) {
+                Du[IDX(3, j, k)] = (u[IDX(6, j, k)] - 3.0 * u[IDX(5, j, k)] +
+                                    3.0 * u[IDX(4, j, k)] - u[IDX(3, j, k)]) /
+                                   smr3;
+                Du[IDX(4, j, k)] =
+                    (u[IDX(7, j, k)] - 6.0 * u[IDX(6, j, k)] +
+                     12.0 * u[IDX(5, j, k)] - 10.0 * u[IDX(4, j, k)] +
+                     3.0 * u[IDX(3, j, k)]) /
+                    smr2;
+                Du[IDX(5, j, k)] =
+                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
+                     15.0 * u[IDX(6, j, k)] - 19.0 * u[IDX(5, j, k)] +
+                     12.0 * u[IDX(4, j, k)] - 3.0 * u[IDX(3, j, k)]) /
+                    smr1;
             }
         }
     }
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+    if (bflag & (1u << OCT_DIR_RIGHT)) {
+        for (int k = kb; k < ke; k++) {
+            for (int j = jb; j < je; j++) {
+                Du[IDX(ie - 3, j, k)] =
+                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
+                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
+                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
+                    spr1;
+
+                Du[IDX(ie - 2, j, k)] =
+                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
+                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
+                     3.0 * u[IDX(ie - 1, j, k)]) /
+                    spr2;
+
+                Du[IDX(ie - 1, j, k)] =
+                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
+                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
+                    spr3;
             }
         }
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_y_pw4(double *const Dyu, const double *const u, const double dy,
-                   const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.50 * idy;
-    const double idy_by_12 = idy / 12.0;
+void disstvb3_y(double *const Du, const double *const u,
+                const double *const lam, const double dy,
+                const unsigned int *sz, unsigned bflag) {
+    const double pre_factor = -1.0 / 12.0 / dy;
+
+    double smr3 = 59.0 / 48.0 * 64 * dy;
+    double smr2 = 43.0 / 48.0 * 64 * dy;
+    double smr1 = 49.0 / 48.0 * 64 * dy;
+    double spr3 = smr3;
+    double spr2 = smr2;
+    double spr1 = smr1;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 2;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 2;
-
-    const int n = nx;
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
     for (int k = kb; k < ke; k++) {
         for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
+            for (int j = jb + 1; j < je - 1; j++) {
                 const int pp = IDX(i, j, k);
-                Dyu[pp] = (u[pp - 2 * nx] - 8.0 * u[pp - nx] +
-                           8.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                          idy_by_12;
+                Du[pp] = pre_factor * (lam[pp - 2 * nx] * u[pp - 2 * nx] -
+                                       4.0 * lam[pp - nx] * u[pp - nx] +
+                                       6.0 * lam[pp] * u[pp] -
+                                       4.0 * lam[pp + nx] * u[pp + nx] +
+                                       lam[pp + 2 * nx] * u[pp + 2 * nx]);
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_DOWN)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 4, k)] = (-3.0 * u[IDX(i, 4, k)] +
-                                     4.0 * u[IDX(i, 5, k)] - u[IDX(i, 6, k)]) *
-                                    idy_by_2;
-
-                Dyu[IDX(i, 5, k)] =
-                    (-u[IDX(i, 4, k)] + u[IDX(i, 6, k)]) * idy_by_2;
+                Du[IDX(i, 3, k)] = (u[IDX(i, 6, k)] - 3.0 * u[IDX(i, 5, k)] +
+                                    3.0 * u[IDX(i, 4, k)] - u[IDX(i, 3, k)]) /
+                                   smr3;
+                Du[IDX(i, 4, k)] =
+                    (u[IDX(i, 7, k)] - 6.0 * u[IDX(i, 6, k)] +
+                     12.0 * u[IDX(i, 5, k)] - 10.0 * u[IDX(i, 4, k)] +
+                     3.0 * u[IDX(i, 3, k)]) /
+                    smr2;
+                Du[IDX(i, 5, k)] =
+                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
+                     15.0 * u[IDX(i, 6, k)] - 19.0 * u[IDX(i, 5, k)] +
+                     12.0 * u[IDX(i, 4, k)] - 3.0 * u[IDX(i, 3, k)]) /
+                    smr1;
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_UP)) {
         for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) * idy_by_2;
+                Du[IDX(i, je - 3, k)] =
+                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
+                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
+                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
+                    spr1;
 
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
-            }
-        }
-    }
+                Du[IDX(i, je - 2, k)] =
+                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
+                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
+                     3.0 * u[IDX(i, je - 1, k)]) /
+                    spr2;
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+                Du[IDX(i, je - 1, k)] =
+                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
+                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
+                    spr3;
             }
         }
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_z(double *const Dzu, const double *const u, const double dz,
-               const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.50 * idz;
-    const double idz_by_12 = idz / 12.0;
+void disstvb3_z(double *const Du, const double *const u,
+                const double *const lam, const double dz, const unsigned *sz,
+                unsigned bflag) {
+    const double pre_factor = -1.0 / 12.0 / dz;
+
+    double smr3 = 59.0 / 48.0 * 64 * dz;
+    double smr2 = 43.0 / 48.0 * 64 * dz;
+    double smr1 = 49.0 / 48.0 * 64 * dz;
+    double spr3 = smr3;
+    double spr2 = smr2;
+    double spr1 = smr1;
 
     const int nx = sz[0];
     const int ny = sz[1];
@@ -823,275 +972,295 @@ void deriv42_z(double *const Dzu, const double *const u, const double dz,
 
     for (int j = jb; j < je; j++) {
         for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
+            for (int k = kb + 1; k < ke - 1; k++) {
                 const int pp = IDX(i, j, k);
-                Dzu[pp] = (u[pp - 2 * n] - 8.0 * u[pp - n] + 8.0 * u[pp + n] -
-                           u[pp + 2 * n]) *
-                          idz_by_12;
+                Du[pp] = pre_factor * (lam[pp - 2 * n] * u[pp - 2 * n] -
+                                       4.0 * lam[pp - n] * u[pp - n] +
+                                       6.0 * lam[pp] * u[pp] -
+                                       4.0 * lam[pp + n] * u[pp + n] +
+                                       lam[pp + 2 * n] * u[pp + 2 * n]);
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_BACK)) {
         for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 3)] = (-3.0 * u[IDX(i, j, 3)] +
-                                     4.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 5)]) *
-                                    idz_by_2;
-
-                Dzu[IDX(i, j, 4)] =
-                    (-u[IDX(i, j, 3)] + u[IDX(i, j, 5)]) * idz_by_2;
+                Du[IDX(i, j, 3)] = (u[IDX(i, j, 6)] - 3.0 * u[IDX(i, j, 5)] +
+                                    3.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 3)]) /
+                                   smr3;
+                Du[IDX(i, j, 4)] =
+                    (u[IDX(i, j, 7)] - 6.0 * u[IDX(i, j, 6)] +
+                     12.0 * u[IDX(i, j, 5)] - 10.0 * u[IDX(i, j, 4)] +
+                     3.0 * u[IDX(i, j, 3)]) /
+                    smr2;
+                Du[IDX(i, j, 5)] =
+                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
+                     15.0 * u[IDX(i, j, 6)] - 19.0 * u[IDX(i, j, 5)] +
+                     12.0 * u[IDX(i, j, 4)] - 3.0 * u[IDX(i, j, 3)]) /
+                    smr1;
             }
         }
     }
 
     if (bflag & (1u << OCT_DIR_FRONT)) {
         for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
             for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) * idz_by_2;
+                Du[IDX(i, j, ke - 3)] =
+                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
+                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
+                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
+                    spr1;
 
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
-            }
-        }
-    }
+                Du[IDX(i, j, ke - 2)] =
+                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
+                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
+                     3.0 * u[IDX(i, j, ke - 1)]) /
+                    spr2;
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+                Du[IDX(i, j, ke - 1)] =
+                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
+                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
+                    spr3;
             }
         }
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_z_pw2(double *const Dzu, const double *const u, const double dz,
-                   const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.50 * idz;
-    const double idz_by_12 = idz / 12.0;
+void disstvb5_x(double *const Du, const double *const u,
+                const double *const lam, const double dx,
+                const unsigned int *sz, unsigned bflag) {
+    double pre_factor_6_dx = 2.0 / 75.0 / dx;
+
+    double smr3 = 59.0 / 48.0 * 64 * dx;
+    double smr2 = 43.0 / 48.0 * 64 * dx;
+    double smr1 = 49.0 / 48.0 * 64 * dx;
+    double spr3 = smr3;
+    double spr2 = smr2;
+    double spr1 = smr1;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Dzu[pp] = (u[pp - 2 * n] - 8.0 * u[pp - n] + 8.0 * u[pp + n] -
-                           u[pp + 2 * n]) *
-                          idz_by_12;
-            }
-        }
-    }
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
-    if (bflag & (1u << OCT_DIR_BACK)) {
+    for (int k = kb; k < ke; k++) {
         for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 2)] = (-3.0 * u[IDX(i, j, 2)] +
-                                     4.0 * u[IDX(i, j, 3)] - u[IDX(i, j, 4)]) *
-                                    idz_by_2;
+            int pp = IDX(ib, j, k);
+            Du[pp] = (lam[pp + 3] * u[pp + 3] - 6.0 * lam[pp + 2] * u[pp + 2] +
+                      15.0 * lam[pp + 1] * u[pp + 1] - 19.0 * lam[pp] * u[pp] +
+                      12.0 * lam[pp - 1] * u[pp - 1] -
+                      3.0 * lam[pp - 2] * u[pp - 2]) /
+                     smr1;
 
-                Dzu[IDX(i, j, 3)] =
-                    (-u[IDX(i, j, 2)] + u[IDX(i, j, 4)]) * idz_by_2;
+            for (int i = ib + 1; i < ie - 1; i++) {
+                pp = IDX(i, j, k);
+                Du[pp] = pre_factor_6_dx *
+                         (std::max(lam[pp + 3], lam[pp + 2]) *
+                              (u[pp + 3] - u[pp + 2]) -
+                          5.0 * std::max(lam[pp + 2], lam[pp + 1]) *
+                              (u[pp + 2] - u[pp + 1]) +
+                          10.0 * std::max(lam[pp + 1], lam[pp]) *
+                              (u[pp + 1] - u[pp]) -
+                          10.0 * std::max(lam[pp], lam[pp - 1]) *
+                              (u[pp] - u[pp - 1]) +
+                          5.0 * std::max(lam[pp - 1], lam[pp - 2]) *
+                              (u[pp - 1] - u[pp - 2]) -
+                          std::max(lam[pp - 2], lam[pp - 3]) *
+                              (u[pp - 2] - u[pp - 3]));
             }
+
+            pp = IDX(ie - 1, j, k);
+            Du[pp] = (lam[pp - 4] * u[pp - 4] - 6.0 * lam[pp - 3] * u[pp - 3] +
+                      15.0 * lam[pp - 2] * u[pp - 2] -
+                      19.0 * lam[pp - 1] * u[pp - 1] + 12.0 * lam[pp] * u[pp] -
+                      3.0 * lam[pp + 1] * u[pp + 1]) /
+                     spr1;
         }
     }
 
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) * idz_by_2;
-
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
+    if (bflag & (1u << OCT_DIR_LEFT)) {
+        for (int k = kb; k < ke; k++) {
+            for (int j = jb; j < je; j++) {
+                Du[IDX(3, j, k)] = (u[IDX(6, j, k)] - 3.0 * u[IDX(5, j, k)] +
+                                    3.0 * u[IDX(4, j, k)] - u[IDX(3, j, k)]) /
+                                   smr3;
+                Du[IDX(4, j, k)] =
+                    (u[IDX(7, j, k)] - 6.0 * u[IDX(6, j, k)] +
+                     12.0 * u[IDX(5, j, k)] - 10.0 * u[IDX(4, j, k)] +
+                     3.0 * u[IDX(3, j, k)]) /
+                    smr2;
+                Du[IDX(5, j, k)] =
+                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
+                     15.0 * u[IDX(6, j, k)] - 19.0 * u[IDX(5, j, k)] +
+                     12.0 * u[IDX(4, j, k)] - 3.0 * u[IDX(3, j, k)]) /
+                    smr1;
             }
         }
     }
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+    if (bflag & (1u << OCT_DIR_RIGHT)) {
+        for (int k = kb; k < ke; k++) {
+            for (int j = jb; j < je; j++) {
+                Du[IDX(ie - 3, j, k)] =
+                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
+                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
+                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
+                    spr1;
+
+                Du[IDX(ie - 2, j, k)] =
+                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
+                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
+                     3.0 * u[IDX(ie - 1, j, k)]) /
+                    spr2;
+
+                Du[IDX(ie - 1, j, k)] =
+                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
+                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
+                    spr3;
             }
         }
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_z_pw4(double *const Dzu, const double *const u, const double dz,
-                   const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.50 * idz;
-    const double idz_by_12 = idz / 12.0;
+void disstvb5_y(double *const Du, const double *const u,
+                const double *const lam, const double dy,
+                const unsigned int *sz, unsigned bflag) {
+    double pre_factor_6_dy = 2.0 / 75.0 / dy;
+
+    double smr3 = 59.0 / 48.0 * 64 * dy;
+    double smr2 = 43.0 / 48.0 * 64 * dy;
+    double smr1 = 49.0 / 48.0 * 64 * dy;
+    double spr3 = smr3;
+    double spr2 = smr2;
+    double spr1 = smr1;
 
     const int nx = sz[0];
     const int ny = sz[1];
     const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
+    const int ib = 3;
+    const int jb = 3;
+    const int kb = 3;
+    const int ie = sz[0] - 3;
+    const int je = sz[1] - 3;
+    const int ke = sz[2] - 3;
 
-    for (int j = jb; j < je; j++) {
+    for (int k = kb; k < ke; k++) {
         for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Dzu[pp] = (u[pp - 2 * n] - 8.0 * u[pp - n] + 8.0 * u[pp + n] -
-                           u[pp + 2 * n]) *
-                          idz_by_12;
-            }
-        }
-    }
+            int pp = IDX(i, jb, k);
 
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 4)] = (-3.0 * u[IDX(i, j, 4)] +
-                                     4.0 * u[IDX(i, j, 5)] - u[IDX(i, j, 6)]) *
-                                    idz_by_2;
+            Du[pp] =
+                (lam[pp + 3 * nx] * u[pp + 3 * nx] -
+                 6.0 * lam[pp + 2 * nx] * u[pp + 2 * nx] +
+                 15.0 * lam[pp + nx] * u[pp + nx] - 19.0 * lam[pp] * u[pp] +
+                 12.0 * lam[pp - nx] * u[pp - nx] -
+                 3.0 * lam[pp - 2 * nx] * u[pp - 2 * nx]) /
+                smr1;
 
-                Dzu[IDX(i, j, 5)] =
-                    (-u[IDX(i, j, 4)] + u[IDX(i, j, 6)]) * idz_by_2;
+            for (int j = jb + 1; j < je - 1; j++) {
+                pp = IDX(i, j, k);
+                Du[pp] = pre_factor_6_dy *
+                         (std::max(lam[pp + 3 * nx], lam[pp + 2 * nx]) *
+                              (u[pp + 3 * nx] - u[pp + 2 * nx]) -
+                          5.0 * std::max(lam[pp + 2 * nx], lam[pp + nx]) *
+                              (u[pp + 2 * nx] - u[pp + nx]) +
+                          10.0 * std::max(lam[pp + nx], lam[pp]) *
+                              (u[pp + nx] - u[pp]) -
+                          10.0 * std::max(lam[pp], lam[pp - nx]) *
+                              (u[pp] - u[pp - nx]) +
+                          5.0 * std::max(lam[pp - nx], lam[pp - 2 * nx]) *
+                              (u[pp - nx] - u[pp - 2 * nx]) -
+                          std::max(lam[pp - 2 * nx], lam[pp - 3 * nx]) *
+                              (u[pp - 2 * nx] - u[pp - 3 * nx]));
             }
+
+            pp = IDX(i, je - 1, k);
+            Du[pp] =
+                (lam[pp - 4 * nx] * u[pp - 4 * nx] -
+                 6.0 * lam[pp - 3 * nx] * u[pp - 3 * nx] +
+                 15.0 * lam[pp - 2 * nx] * u[pp - 2 * nx] -
+                 19.0 * lam[pp - nx] * u[pp - nx] + 12.0 * lam[pp] * u[pp] -
+                 3.0 * lam[pp + nx] * u[pp + nx]) /
+                spr1;
         }
     }
 
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+    if (bflag & (1u << OCT_DIR_DOWN)) {
+        for (int k = kb; k < ke; k++) {
             for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) * idz_by_2;
-
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
+                Du[IDX(i, 3, k)] = (u[IDX(i, 6, k)] - 3.0 * u[IDX(i, 5, k)] +
+                                    3.0 * u[IDX(i, 4, k)] - u[IDX(i, 3, k)]) /
+                                   smr3;
+                Du[IDX(i, 4, k)] =
+                    (u[IDX(i, 7, k)] - 6.0 * u[IDX(i, 6, k)] +
+                     12.0 * u[IDX(i, 5, k)] - 10.0 * u[IDX(i, 4, k)] +
+                     3.0 * u[IDX(i, 3, k)]) /
+                    smr2;
+                Du[IDX(i, 5, k)] =
+                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
+                     15.0 * u[IDX(i, 6, k)] - 19.0 * u[IDX(i, 5, k)] +
+                     12.0 * u[IDX(i, 4, k)] - 3.0 * u[IDX(i, 3, k)]) /
+                    smr1;
             }
         }
     }
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
+    if (bflag & (1u << OCT_DIR_UP)) {
+        for (int k = kb; k < ke; k++) {
             for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+                Du[IDX(i, je - 3, k)] =
+                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
+                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
+                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
+                    spr1;
+
+                Du[IDX(i, je - 2, k)] =
+                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
+                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
+                     3.0 * u[IDX(i, je - 1, k)]) /
+                    spr2;
+
+                Du[IDX(i, je - 1, k)] =
+                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
+                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
+                    spr3;
             }
         }
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
+/*----------------------------------------------------------------------
  *
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_xx(double *const DxDxu, const double *const u, const double dx,
-                const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
+
+void disstvb5_z(double *const Du, const double *const u,
+                const double *const lam, const double dz, const unsigned *sz,
+                unsigned bflag) {
+    double pre_factor_6_dz = -1.0 / 64.0 / dz;
+
+    double smr3 = 59.0 / 48.0 * 64 * dz;
+    double smr2 = 43.0 / 48.0 * 64 * dz;
+    double smr1 = 49.0 / 48.0 * 64 * dz;
+    double spr3 = smr3;
+    double spr2 = smr2;
+    double spr1 = smr1;
 
     const int nx = sz[0];
     const int ny = sz[1];
@@ -1103,371 +1272,177 @@ void deriv42_xx(double *const DxDxu, const double *const u, const double dx,
     const int je = sz[1] - 3;
     const int ke = sz[2] - 3;
 
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                DxDxu[pp] = (-u[pp - 2] + 16.0 * u[pp - 1] - 30.0 * u[pp] +
-                             16.0 * u[pp + 1] - u[pp + 2]) *
-                            idx_sqrd_by_12;
-            }
-        }
-    }
+    const int n = nx * ny;
 
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(3, j, k)] =
-                    (2.0 * u[IDX(3, j, k)] - 5.0 * u[IDX(4, j, k)] +
-                     4.0 * u[IDX(5, j, k)] - u[IDX(6, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(4, j, k)] = (u[IDX(3, j, k)] - 2.0 * u[IDX(4, j, k)] +
-                                       u[IDX(5, j, k)]) *
-                                      idx_sqrd;
-            }
-        }
-    }
+    for (int j = jb; j < je; j++) {
+        for (int i = ib; i < ie; i++) {
+            int pp = IDX(i, j, kb);
+            Du[pp] = (lam[pp + 3 * n] * u[pp + 3 * n] -
+                      6.0 * lam[pp + 2 * n] * u[pp + 2 * n] +
+                      15.0 * lam[pp + n] * u[pp + n] - 19.0 * lam[pp] * u[pp] +
+                      12.0 * lam[pp - n] * u[pp - n] -
+                      3.0 * lam[pp - 2 * n] * u[pp - 2 * n]) /
+                     smr1;
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 4, j, k)] + 4.0 * u[IDX(ie - 3, j, k)] -
-                     5.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
+            for (int k = kb + 1; k < ke - 1; k++) {
+                pp = IDX(i, j, k);
+                Du[pp] = pre_factor_6_dz *
+                         (std::max(lam[pp + 3 * n], lam[pp + 2 * n]) *
+                              (u[pp + 3 * n] - u[pp + 2 * n]) -
+                          5.0 * std::max(lam[pp + 2 * n], lam[pp + n]) *
+                              (u[pp + 2 * n] - u[pp + n]) +
+                          10.0 * std::max(lam[pp + n], lam[pp]) *
+                              (u[pp + n] - u[pp]) -
+                          10.0 * std::max(lam[pp], lam[pp - n]) *
+                              (u[pp] - u[pp - n]) +
+                          5.0 * std::max(lam[pp - n], lam[pp - 2 * n]) *
+                              (u[pp - n] - u[pp - 2 * n]) -
+                          std::max(lam[pp - 2 * n], lam[pp - 3 * n]) *
+                              (u[pp - 2 * n] - u[pp - 3 * n]));
             }
+
+            pp = IDX(i, j, ke - 1);
+            Du[pp] = (lam[pp - 4 * n] * u[pp - 4 * n] -
+                      6.0 * lam[pp - 3 * n] * u[pp - 3 * n] +
+                      15.0 * lam[pp - 2 * n] * u[pp - 2 * n] -
+                      19.0 * lam[pp - n] * u[pp - n] + 12.0 * lam[pp] * u[pp] -
+                      3.0 * lam[pp + n] * u[pp + n]) /
+                     spr1;
         }
     }
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
+    if (bflag & (1u << OCT_DIR_BACK)) {
         for (int j = jb; j < je; j++) {
             for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
+                Du[IDX(i, j, 3)] = (u[IDX(i, j, 6)] - 3.0 * u[IDX(i, j, 5)] +
+                                    3.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 3)]) /
+                                   smr3;
+                Du[IDX(i, j, 4)] =
+                    (u[IDX(i, j, 7)] - 6.0 * u[IDX(i, j, 6)] +
+                     12.0 * u[IDX(i, j, 5)] - 10.0 * u[IDX(i, j, 4)] +
+                     3.0 * u[IDX(i, j, 3)]) /
+                    smr2;
+                Du[IDX(i, j, 5)] =
+                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
+                     15.0 * u[IDX(i, j, 6)] - 19.0 * u[IDX(i, j, 5)] +
+                     12.0 * u[IDX(i, j, 4)] - 3.0 * u[IDX(i, j, 3)]) /
+                    smr1;
             }
         }
     }
-#endif
-}
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_yy(double *const DyDyu, const double *const u, const double dy,
-                const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
+    if (bflag & (1u << OCT_DIR_FRONT)) {
+        for (int j = jb; j < je; j++) {
+            for (int i = ib; i < ie; i++) {
+                Du[IDX(i, j, ke - 3)] =
+                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
+                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
+                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
+                    spr1;
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
+                Du[IDX(i, j, ke - 2)] =
+                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
+                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
+                     3.0 * u[IDX(i, j, ke - 1)]) /
+                    spr2;
 
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                DyDyu[pp] =
-                    (-u[pp - 2 * nx] + 16.0 * u[pp - nx] - 30.0 * u[pp] +
-                     16.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                    idy_sqrd_by_12;
+                Du[IDX(i, j, ke - 1)] =
+                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
+                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
+                    spr3;
             }
         }
     }
+}
 
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, 3, k)] =
-                    (2.0 * u[IDX(i, 3, k)] - 5.0 * u[IDX(i, 4, k)] +
-                     4.0 * u[IDX(i, 5, k)] - u[IDX(i, 6, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, 4, k)] = (u[IDX(i, 3, k)] - 2.0 * u[IDX(i, 4, k)] +
-                                       u[IDX(i, 5, k)]) *
-                                      idy_sqrd;
-            }
-        }
-    }
+void ko_deriv64_x(double *const Du, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_64, 0, 4>(
+        Du, u, dx, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 4, k)] + 4.0 * u[IDX(i, je - 3, k)] -
-                     5.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-            }
-        }
-    }
+void ko_deriv64_y(double *const Du, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_64, 1, 4>(
+        Du, u, dy, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void ko_deriv64_z(double *const Du, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilKO_64, 2, 4>(
+        Du, u, dz, sz, bflag);
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_zz(double *const DzDzu, const double *const u, const double dz,
+void deriv644_x(double *const Dxu, const double *const u, const double dx,
                 const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 0, 3>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                DzDzu[pp] = (-u[pp - 2 * n] + 16.0 * u[pp - n] - 30.0 * u[pp] +
-                             16.0 * u[pp + n] - u[pp + 2 * n]) *
-                            idz_sqrd_by_12;
-            }
-        }
-    }
+void deriv644_y(double *const Dyu, const double *const u, const double dy,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 1, 3>(
+        Dyu, u, dy, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, 3)] =
-                    (2.0 * u[IDX(i, j, 3)] - 5.0 * u[IDX(i, j, 4)] +
-                     4.0 * u[IDX(i, j, 5)] - u[IDX(i, j, 6)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, 4)] = (u[IDX(i, j, 3)] - 2.0 * u[IDX(i, j, 4)] +
-                                       u[IDX(i, j, 5)]) *
-                                      idz_sqrd;
-            }
-        }
-    }
+void deriv644_z(double *const Dzu, const double *const u, const double dz,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 2, 3>(
+        Dzu, u, dz, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 4)] + 4.0 * u[IDX(i, j, ke - 3)] -
-                     5.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-            }
-        }
-    }
+void deriv644_x_pw4(double *const Dxu, const double *const u, const double dx,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 0, 4>(
+        Dxu, u, dx, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv644_y_pw4(double *const Dyu, const double *const u, const double dy,
+                    const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 1, 4>(
+        Dyu, u, dy, sz, bflag);
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_xx_pw2(double *const DxDxu, const double *const u, const double dx,
+void deriv644_z_pw4(double *const Dzu, const double *const u, const double dz,
                     const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_644, 2, 4>(
+        Dzu, u, dz, sz, bflag);
+}
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
+void deriv644_xx(double *const DxDxu, const double *const u, const double dx,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 0, 3>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                DxDxu[pp] = (-u[pp - 2] + 16.0 * u[pp - 1] - 30.0 * u[pp] +
-                             16.0 * u[pp + 1] - u[pp + 2]) *
-                            idx_sqrd_by_12;
-            }
-        }
-    }
+void deriv644_yy(double *const DyDyu, const double *const u, const double dy,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 1, 3>(
+        DyDyu, u, dy, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(2, j, k)] =
-                    (2.0 * u[IDX(2, j, k)] - 5.0 * u[IDX(3, j, k)] +
-                     4.0 * u[IDX(4, j, k)] - u[IDX(5, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(3, j, k)] = (u[IDX(2, j, k)] - 2.0 * u[IDX(3, j, k)] +
-                                       u[IDX(4, j, k)]) *
-                                      idx_sqrd;
-            }
-        }
-    }
+void deriv644_zz(double *const DzDzu, const double *const u, const double dz,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 2, 3>(
+        DzDzu, u, dz, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 4, j, k)] + 4.0 * u[IDX(ie - 3, j, k)] -
-                     5.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-            }
-        }
-    }
+void deriv644_xx_pw4(double *const DxDxu, const double *const u,
+                     const double dx, const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 0, 4>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv644_yy_pw4(double *const Du, const double *const u, const double dy,
+                     const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 1, 4>(
+        Du, u, dy, sz, bflag);
+}
+
+void deriv644_zz_pw4(double *const Du, const double *const u, const double dz,
+                     const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_644, 2, 4>(
+        Du, u, dz, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -1475,6208 +1450,23 @@ void deriv42_xx_pw2(double *const DxDxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv42_yy_pw2(double *const DyDyu, const double *const u, const double dy,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                DyDyu[pp] =
-                    (-u[pp - 2 * nx] + 16.0 * u[pp - nx] - 30.0 * u[pp] +
-                     16.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                    idy_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, 2, k)] =
-                    (2.0 * u[IDX(i, 2, k)] - 5.0 * u[IDX(i, 3, k)] +
-                     4.0 * u[IDX(i, 4, k)] - u[IDX(i, 5, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, 3, k)] = (u[IDX(i, 2, k)] - 2.0 * u[IDX(i, 3, k)] +
-                                       u[IDX(i, 4, k)]) *
-                                      idy_sqrd;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 4, k)] + 4.0 * u[IDX(i, je - 3, k)] -
-                     5.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_zz_pw2(double *const DzDzu, const double *const u, const double dz,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                DzDzu[pp] = (-u[pp - 2 * n] + 16.0 * u[pp - n] - 30.0 * u[pp] +
-                             16.0 * u[pp + n] - u[pp + 2 * n]) *
-                            idz_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, 2)] =
-                    (2.0 * u[IDX(i, j, 2)] - 5.0 * u[IDX(i, j, 3)] +
-                     4.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 5)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, 3)] = (u[IDX(i, j, 2)] - 2.0 * u[IDX(i, j, 3)] +
-                                       u[IDX(i, j, 4)]) *
-                                      idz_sqrd;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 4)] + 4.0 * u[IDX(i, j, ke - 3)] -
-                     5.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_xx_pw4(double *const DxDxu, const double *const u, const double dx,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                DxDxu[pp] = (-u[pp - 2] + 16.0 * u[pp - 1] - 30.0 * u[pp] +
-                             16.0 * u[pp + 1] - u[pp + 2]) *
-                            idx_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(4, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 5.0 * u[IDX(5, j, k)] +
-                     4.0 * u[IDX(6, j, k)] - u[IDX(7, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(5, j, k)] = (u[IDX(4, j, k)] - 2.0 * u[IDX(5, j, k)] +
-                                       u[IDX(6, j, k)]) *
-                                      idx_sqrd;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-
-                DxDxu[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 4, j, k)] + 4.0 * u[IDX(ie - 3, j, k)] -
-                     5.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_yy_pw4(double *const DyDyu, const double *const u, const double dy,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                DyDyu[pp] =
-                    (-u[pp - 2 * nx] + 16.0 * u[pp - nx] - 30.0 * u[pp] +
-                     16.0 * u[pp + nx] - u[pp + 2 * nx]) *
-                    idy_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, 4, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 5.0 * u[IDX(i, 5, k)] +
-                     4.0 * u[IDX(i, 6, k)] - u[IDX(i, 7, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, 5, k)] = (u[IDX(i, 3, k)] - 2.0 * u[IDX(i, 4, k)] +
-                                       u[IDX(i, 5, k)]) *
-                                      idy_sqrd;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-
-                DyDyu[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 4, k)] + 4.0 * u[IDX(i, je - 3, k)] -
-                     5.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42_zz_pw4(double *const DzDzu, const double *const u, const double dz,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                DzDzu[pp] = (-u[pp - 2 * n] + 16.0 * u[pp - n] - 30.0 * u[pp] +
-                             16.0 * u[pp + n] - u[pp + 2 * n]) *
-                            idz_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, 4)] =
-                    (2.0 * u[IDX(i, j, 4)] - 5.0 * u[IDX(i, j, 5)] +
-                     4.0 * u[IDX(i, j, 6)] - u[IDX(i, j, 7)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, 5)] = (u[IDX(i, j, 4)] - 2.0 * u[IDX(i, j, 5)] +
-                                       u[IDX(i, j, 6)]) *
-                                      idz_sqrd;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-
-                DzDzu[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 4)] + 4.0 * u[IDX(i, j, ke - 3)] -
-                     5.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42adv_x(double *const Dxu, const double *const u, const double dx,
-                  const unsigned int *sz, const double *const betax,
-                  unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.50 * idx;
-    const double idx_by_12 = idx / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (betax[pp] > 0.0) {
-                    Dxu[pp] = (-3.0 * u[pp - 1] - 10.0 * u[pp] +
-                               18.0 * u[pp + 1] - 6.0 * u[pp + 2] + u[pp + 3]) *
-                              idx_by_12;
-                } else {
-                    Dxu[pp] = (-u[pp - 3] + 6.0 * u[pp - 2] - 18.0 * u[pp - 1] +
-                               10.0 * u[pp] + 3.0 * u[pp + 1]) *
-                              idx_by_12;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(3, j, k)] = (-3.0 * u[IDX(3, j, k)] +
-                                     4.0 * u[IDX(4, j, k)] - u[IDX(5, j, k)]) *
-                                    idx_by_2;
-
-                if (betax[IDX(4, j, k)] > 0.0) {
-                    Dxu[IDX(4, j, k)] =
-                        (-3.0 * u[IDX(4, j, k)] + 4.0 * u[IDX(5, j, k)] -
-                         u[IDX(6, j, k)]) *
-                        idx_by_2;
-                } else {
-                    Dxu[IDX(4, j, k)] =
-                        (-u[IDX(3, j, k)] + u[IDX(5, j, k)]) * idx_by_2;
-                }
-
-                if (betax[IDX(5, j, k)] > 0.0) {
-                    Dxu[IDX(5, j, k)] =
-                        (-3.0 * u[IDX(4, j, k)] - 10.0 * u[IDX(5, j, k)] +
-                         18.0 * u[IDX(6, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                         u[IDX(8, j, k)]) *
-                        idx_by_12;
-                } else {
-                    Dxu[IDX(5, j, k)] =
-                        (u[IDX(3, j, k)] - 4.0 * u[IDX(4, j, k)] +
-                         3.0 * u[IDX(5, j, k)]) *
-                        idx_by_2;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                if (betax[IDX(ie - 3, j, k)] > 0.0) {
-                    Dxu[IDX(ie - 3, j, k)] =
-                        (-3.0 * u[IDX(ie - 3, j, k)] +
-                         4.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
-                        idx_by_2;
-                } else {
-                    Dxu[IDX(ie - 3, j, k)] =
-                        (-u[IDX(ie - 6, j, k)] + 6.0 * u[IDX(ie - 5, j, k)] -
-                         18.0 * u[IDX(ie - 4, j, k)] +
-                         10.0 * u[IDX(ie - 3, j, k)] +
-                         3.0 * u[IDX(ie - 2, j, k)]) *
-                        idx_by_12;
-                }
-
-                if (betax[IDX(ie - 2, j, k)] > 0.0) {
-                    Dxu[IDX(ie - 2, j, k)] =
-                        (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) *
-                        idx_by_2;
-                } else {
-                    Dxu[IDX(ie - 2, j, k)] =
-                        (u[IDX(ie - 4, j, k)] - 4.0 * u[IDX(ie - 3, j, k)] +
-                         3.0 * u[IDX(ie - 2, j, k)]) *
-                        idx_by_2;
-                }
-
-                Dxu[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42adv_y(double *const Dyu, const double *const u, const double dy,
-                  const unsigned int *sz, const double *const betay,
-                  unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.50 * idy;
-    const double idy_by_12 = idy / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                if (betay[pp] > 0.0) {
-                    Dyu[pp] =
-                        (-3.0 * u[pp - nx] - 10.0 * u[pp] + 18.0 * u[pp + nx] -
-                         6.0 * u[pp + 2 * nx] + u[pp + 3 * nx]) *
-                        idy_by_12;
-                } else {
-                    Dyu[pp] =
-                        (-u[pp - 3 * nx] + 6.0 * u[pp - 2 * nx] -
-                         18.0 * u[pp - nx] + 10.0 * u[pp] + 3.0 * u[pp + nx]) *
-                        idy_by_12;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 3, k)] = (-3.0 * u[IDX(i, 3, k)] +
-                                     4.0 * u[IDX(i, 4, k)] - u[IDX(i, 5, k)]) *
-                                    idy_by_2;
-
-                if (betay[IDX(i, 4, k)] > 0.0) {
-                    Dyu[IDX(i, 4, k)] =
-                        (-3.0 * u[IDX(i, 4, k)] + 4.0 * u[IDX(i, 5, k)] -
-                         u[IDX(i, 6, k)]) *
-                        idy_by_2;
-                } else {
-                    Dyu[IDX(i, 4, k)] =
-                        (-u[IDX(i, 3, k)] + u[IDX(i, 5, k)]) * idy_by_2;
-                }
-
-                if (betay[IDX(i, 5, k)] > 0.0) {
-                    Dyu[IDX(i, 5, k)] =
-                        (-3.0 * u[IDX(i, 4, k)] - 10.0 * u[IDX(i, 5, k)] +
-                         18.0 * u[IDX(i, 6, k)] - 6.0 * u[IDX(i, 7, k)] +
-                         u[IDX(i, 8, k)]) *
-                        idy_by_12;
-                } else {
-                    Dyu[IDX(i, 5, k)] =
-                        (u[IDX(i, 3, k)] - 4.0 * u[IDX(i, 4, k)] +
-                         3.0 * u[IDX(i, 5, k)]) *
-                        idy_by_2;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                if (betay[IDX(i, je - 3, k)] > 0.0) {
-                    Dyu[IDX(i, je - 3, k)] =
-                        (-3.0 * u[IDX(i, je - 3, k)] +
-                         4.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
-                        idy_by_2;
-                } else {
-                    Dyu[IDX(i, je - 3, k)] =
-                        (-u[IDX(i, je - 6, k)] + 6.0 * u[IDX(i, je - 5, k)] -
-                         18.0 * u[IDX(i, je - 4, k)] +
-                         10.0 * u[IDX(i, je - 3, k)] +
-                         3.0 * u[IDX(i, je - 2, k)]) *
-                        idy_by_12;
-                }
-
-                if (betay[IDX(i, je - 2, k)] > 0.0) {
-                    Dyu[IDX(i, je - 2, k)] =
-                        (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) *
-                        idy_by_2;
-                } else {
-                    Dyu[IDX(i, je - 2, k)] =
-                        (u[IDX(i, je - 4, k)] - 4.0 * u[IDX(i, je - 3, k)] +
-                         3.0 * u[IDX(i, je - 2, k)]) *
-                        idy_by_2;
-                }
-
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv42adv_z(double *const Dzu, const double *const u, const double dz,
-                  const unsigned int *sz, const double *const betaz,
-                  unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.50 * idz;
-    const double idz_by_12 = idz / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                if (betaz[pp] > 0.0) {
-                    Dzu[pp] =
-                        (-3.0 * u[pp - n] - 10.0 * u[pp] + 18.0 * u[pp + n] -
-                         6.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
-                        idz_by_12;
-                } else {
-                    Dzu[pp] =
-                        (-u[pp - 3 * n] + 6.0 * u[pp - 2 * n] -
-                         18.0 * u[pp - n] + 10.0 * u[pp] + 3.0 * u[pp + n]) *
-                        idz_by_12;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 3)] = (-3.0 * u[IDX(i, j, 3)] +
-                                     4.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 5)]) *
-                                    idz_by_2;
-
-                if (betaz[IDX(i, j, 4)] > 0.0) {
-                    Dzu[IDX(i, j, 4)] =
-                        (-3.0 * u[IDX(i, j, 4)] + 4.0 * u[IDX(i, j, 5)] -
-                         u[IDX(i, j, 6)]) *
-                        idz_by_2;
-                } else {
-                    Dzu[IDX(i, j, 4)] =
-                        (-u[IDX(i, j, 3)] + u[IDX(i, j, 5)]) * idz_by_2;
-                }
-
-                if (betaz[IDX(i, j, 5)] > 0.0) {
-                    Dzu[IDX(i, j, 5)] =
-                        (-3.0 * u[IDX(i, j, 4)] - 10.0 * u[IDX(i, j, 5)] +
-                         18.0 * u[IDX(i, j, 6)] - 6.0 * u[IDX(i, j, 7)] +
-                         u[IDX(i, j, 8)]) *
-                        idz_by_12;
-                } else {
-                    Dzu[IDX(i, j, 5)] =
-                        (u[IDX(i, j, 3)] - 4.0 * u[IDX(i, j, 4)] +
-                         3.0 * u[IDX(i, j, 5)]) *
-                        idz_by_2;
-                }
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                if (betaz[IDX(i, j, ke - 3)] > 0.0) {
-                    Dzu[IDX(i, j, ke - 3)] =
-                        (-3.0 * u[IDX(i, j, ke - 3)] +
-                         4.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
-                        idz_by_2;
-                } else {
-                    Dzu[IDX(i, j, ke - 3)] =
-                        (-u[IDX(i, j, ke - 6)] + 6.0 * u[IDX(i, j, ke - 5)] -
-                         18.0 * u[IDX(i, j, ke - 4)] +
-                         10.0 * u[IDX(i, j, ke - 3)] +
-                         3.0 * u[IDX(i, j, ke - 2)]) *
-                        idz_by_12;
-                }
-
-                if (betaz[IDX(i, j, ke - 2)] > 0.0) {
-                    Dzu[IDX(i, j, ke - 2)] =
-                        (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) *
-                        idz_by_2;
-                } else {
-                    Dzu[IDX(i, j, ke - 2)] =
-                        (u[IDX(i, j, ke - 4)] - 4.0 * u[IDX(i, j, ke - 3)] +
-                         3.0 * u[IDX(i, j, ke - 2)]) *
-                        idz_by_2;
-                }
-
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv21_x(double *const Du, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    // According to
-    // https://einsteintoolkit.org/thornguide/CactusNumerical/Dissipation/documentation.html#Xkreiss-oliger
-    // this order has a -1 leading
-    // The internal stencils are the "pure" stencils and the factors out front
-    // will be negative
-    double pre_factor_6_dx = -1.0 / 16.0 / dx;
-
-    double smr2 = 4 * dx;
-    double smr1 = 4 * dx;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dx *
-                         (1.0 * u[pp - 2] - 4.0 * u[pp - 1] + 6.0 * u[pp] -
-                          4.0 * u[pp + 1] + 1.0 * u[pp + 2]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(2, j, k)] = (u[IDX(2, j, k)] - 2.0 * u[IDX(3, j, k)] +
-                                    u[IDX(4, j, k)]) /
-                                   smr2;
-                Du[IDX(3, j, k)] = (u[IDX(2, j, k)] - 2.0 * u[IDX(3, j, k)] +
-                                    u[IDX(4, j, k)]) /
-                                   smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) /
-                    spr2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv21_y(double *const Du, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    // According to
-    // https://einsteintoolkit.org/thornguide/CactusNumerical/Dissipation/documentation.html#Xkreiss-oliger
-    // this order has a -1 leading
-    // The internal stencils are the "pure" stencils and the factors out front
-    // will be negative
-    double pre_factor_6_dy = -1.0 / 16.0 / dy;
-
-    double smr2 = 4 * dy;
-    double smr1 = 4 * dy;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] =
-                    pre_factor_6_dy *
-                    (1.0 * u[pp - 2 * nx] - 4.0 * u[pp - 1 * nx] + 6.0 * u[pp] -
-                     4.0 * u[pp + 1 * nx] + 1.0 * u[pp + 2 * nx]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 2, k)] = (u[IDX(i, 2, k)] - 2.0 * u[IDX(i, 3, k)] +
-                                    u[IDX(i, 4, k)]) /
-                                   smr2;
-                Du[IDX(i, 3, k)] = (u[IDX(i, 2, k)] - 2.0 * u[IDX(i, 3, k)] +
-                                    u[IDX(i, 4, k)]) /
-                                   smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) /
-                    spr2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv21_z(double *const Du, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    // According to
-    // https://einsteintoolkit.org/thornguide/CactusNumerical/Dissipation/documentation.html#Xkreiss-oliger
-    // this order has a -1 leading
-    // The internal stencils are the "pure" stencils and the factors out front
-    // will be negative
-    double pre_factor_6_dz = -1.0 / 16.0 / dz;
-
-    double smr2 = 4 * dz;
-    double smr1 = 4 * dz;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 2;
-    const int jb = 2;
-    const int kb = 2;
-    const int ie = sz[0] - 2;
-    const int je = sz[1] - 2;
-    const int ke = sz[2] - 2;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] =
-                    pre_factor_6_dz *
-                    (1.0 * u[pp - 2 * n] - 4.0 * u[pp - 1 * n] + 6.0 * u[pp] -
-                     4.0 * u[pp + 1 * n] + 1.0 * u[pp + 2 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 2)] = (u[IDX(i, j, 2)] - 2.0 * u[IDX(i, j, 3)] +
-                                    u[IDX(i, j, 4)]) /
-                                   smr2;
-                Du[IDX(i, j, 3)] = (u[IDX(i, j, 2)] - 2.0 * u[IDX(i, j, 3)] +
-                                    u[IDX(i, j, 4)]) /
-                                   smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) /
-                    spr2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv42_x(double *const Du, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dx = -1.0 / 64.0 / dx;
-
-    double smr3 = 59.0 / 48.0 * 64 * dx;
-    double smr2 = 43.0 / 48.0 * 64 * dx;
-    double smr1 = 49.0 / 48.0 * 64 * dx;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dx *
-                         (-u[pp - 3] + 6.0 * u[pp - 2] - 15.0 * u[pp - 1] +
-                          20.0 * u[pp] - 15.0 * u[pp + 1] + 6.0 * u[pp + 2] -
-                          u[pp + 3]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(3, j, k)] = (u[IDX(6, j, k)] - 3.0 * u[IDX(5, j, k)] +
-                                    3.0 * u[IDX(4, j, k)] - u[IDX(3, j, k)]) /
-                                   smr3;
-                Du[IDX(4, j, k)] =
-                    (u[IDX(7, j, k)] - 6.0 * u[IDX(6, j, k)] +
-                     12.0 * u[IDX(5, j, k)] - 10.0 * u[IDX(4, j, k)] +
-                     3.0 * u[IDX(3, j, k)]) /
-                    smr2;
-                Du[IDX(5, j, k)] =
-                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     15.0 * u[IDX(6, j, k)] - 19.0 * u[IDX(5, j, k)] +
-                     12.0 * u[IDX(4, j, k)] - 3.0 * u[IDX(3, j, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
-                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
-                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr2;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
-                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
-                    spr3;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv42_y(double *const Du, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dy = -1.0 / 64.0 / dy;
-
-    double smr3 = 59.0 / 48.0 * 64 * dy;
-    double smr2 = 43.0 / 48.0 * 64 * dy;
-    double smr1 = 49.0 / 48.0 * 64 * dy;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dy *
-                         (-u[pp - 3 * nx] + 6.0 * u[pp - 2 * nx] -
-                          15.0 * u[pp - nx] + 20.0 * u[pp] - 15.0 * u[pp + nx] +
-                          6.0 * u[pp + 2 * nx] - u[pp + 3 * nx]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 3, k)] = (u[IDX(i, 6, k)] - 3.0 * u[IDX(i, 5, k)] +
-                                    3.0 * u[IDX(i, 4, k)] - u[IDX(i, 3, k)]) /
-                                   smr3;
-                Du[IDX(i, 4, k)] =
-                    (u[IDX(i, 7, k)] - 6.0 * u[IDX(i, 6, k)] +
-                     12.0 * u[IDX(i, 5, k)] - 10.0 * u[IDX(i, 4, k)] +
-                     3.0 * u[IDX(i, 3, k)]) /
-                    smr2;
-                Du[IDX(i, 5, k)] =
-                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     15.0 * u[IDX(i, 6, k)] - 19.0 * u[IDX(i, 5, k)] +
-                     12.0 * u[IDX(i, 4, k)] - 3.0 * u[IDX(i, 3, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
-                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
-                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr2;
-
-                Du[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
-                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
-                    spr3;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv42_z(double *const Du, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dz = -1.0 / 64.0 / dz;
-
-    double smr3 = 59.0 / 48.0 * 64 * dz;
-    double smr2 = 43.0 / 48.0 * 64 * dz;
-    double smr1 = 49.0 / 48.0 * 64 * dz;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dz *
-                         (-u[pp - 3 * n] + 6.0 * u[pp - 2 * n] -
-                          15.0 * u[pp - n] + 20.0 * u[pp] - 15.0 * u[pp + n] +
-                          6.0 * u[pp + 2 * n] - u[pp + 3 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 3)] = (u[IDX(i, j, 6)] - 3.0 * u[IDX(i, j, 5)] +
-                                    3.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 3)]) /
-                                   smr3;
-                Du[IDX(i, j, 4)] =
-                    (u[IDX(i, j, 7)] - 6.0 * u[IDX(i, j, 6)] +
-                     12.0 * u[IDX(i, j, 5)] - 10.0 * u[IDX(i, j, 4)] +
-                     3.0 * u[IDX(i, j, 3)]) /
-                    smr2;
-                Du[IDX(i, j, 5)] =
-                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
-                     15.0 * u[IDX(i, j, 6)] - 19.0 * u[IDX(i, j, 5)] +
-                     12.0 * u[IDX(i, j, 4)] - 3.0 * u[IDX(i, j, 3)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
-                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
-                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr2;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
-                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
-                    spr3;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-void ko_pw4_deriv42_x(double *const Du, const double *const u, const double dx,
-                      const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dx = -1.0 / 64.0 / dx;
-    double smr3 = 59.0 / 48.0 * 64 * dx;
-    double smr2 = 43.0 / 48.0 * 64 * dx;
-    double smr1 = 49.0 / 48.0 * 64 * dx;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dx *
-                         (-u[pp - 3] + 6.0 * u[pp - 2] - 15.0 * u[pp - 1] +
-                          20.0 * u[pp] - 15.0 * u[pp + 1] + 6.0 * u[pp + 2] -
-                          u[pp + 3]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(4, j, k)] = (u[IDX(7, j, k)] - 3.0 * u[IDX(6, j, k)] +
-                                    3.0 * u[IDX(5, j, k)] - u[IDX(4, j, k)]) /
-                                   smr3;
-                Du[IDX(5, j, k)] =
-                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     12.0 * u[IDX(6, j, k)] - 10.0 * u[IDX(5, j, k)] +
-                     3.0 * u[IDX(4, j, k)]) /
-                    smr2;
-                Du[IDX(6, j, k)] =
-                    (u[IDX(9, j, k)] - 6.0 * u[IDX(8, j, k)] +
-                     15.0 * u[IDX(7, j, k)] - 19.0 * u[IDX(6, j, k)] +
-                     12.0 * u[IDX(5, j, k)] - 3.0 * u[IDX(4, j, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
-                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
-                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr2;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
-                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-void ko_pw4_deriv42_y(double *const Du, const double *const u, const double dy,
-                      const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dy = -1.0 / 64.0 / dy;
-
-    double smr3 = 59.0 / 48.0 * 64 * dy;
-    double smr2 = 43.0 / 48.0 * 64 * dy;
-    double smr1 = 49.0 / 48.0 * 64 * dy;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dy *
-                         (-u[pp - 3 * nx] + 6.0 * u[pp - 2 * nx] -
-                          15.0 * u[pp - nx] + 20.0 * u[pp] - 15.0 * u[pp + nx] +
-                          6.0 * u[pp + 2 * nx] - u[pp + 3 * nx]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 4, k)] = (u[IDX(i, 7, k)] - 3.0 * u[IDX(i, 6, k)] +
-                                    3.0 * u[IDX(i, 5, k)] - u[IDX(i, 4, k)]) /
-                                   smr3;
-                Du[IDX(i, 5, k)] =
-                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     12.0 * u[IDX(i, 6, k)] - 10.0 * u[IDX(i, 5, k)] +
-                     3.0 * u[IDX(i, 4, k)]) /
-                    smr2;
-                Du[IDX(i, 6, k)] =
-                    (u[IDX(i, 9, k)] - 6.0 * u[IDX(i, 8, k)] +
-                     15.0 * u[IDX(i, 7, k)] - 19.0 * u[IDX(i, 6, k)] +
-                     12.0 * u[IDX(i, 5, k)] - 3.0 * u[IDX(i, 4, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
-                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
-                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr2;
-
-                Du[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
-                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
-                    spr3;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-void ko_pw4_deriv42_z(double *const Du, const double *const u, const double dz,
-                      const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dz = -1.0 / 64.0 / dz;
-
-    double smr3 = 59.0 / 48.0 * 64 * dz;
-    double smr2 = 43.0 / 48.0 * 64 * dz;
-    double smr1 = 49.0 / 48.0 * 64 * dz;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dz *
-                         (-u[pp - 3 * n] + 6.0 * u[pp - 2 * n] -
-                          15.0 * u[pp - n] + 20.0 * u[pp] - 15.0 * u[pp + n] +
-                          6.0 * u[pp + 2 * n] - u[pp + 3 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 4)] = (u[IDX(i, j, 7)] - 3.0 * u[IDX(i, j, 6)] +
-                                    3.0 * u[IDX(i, j, 5)] - u[IDX(i, j, 4)]) /
-                                   smr3;
-                Du[IDX(i, j, 5)] =
-                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
-                     12.0 * u[IDX(i, j, 6)] - 10.0 * u[IDX(i, j, 5)] +
-                     3.0 * u[IDX(i, j, 4)]) /
-                    smr2;
-                Du[IDX(i, j, 6)] =
-                    (u[IDX(i, j, 9)] - 6.0 * u[IDX(i, j, 8)] +
-                     15.0 * u[IDX(i, j, 7)] - 19.0 * u[IDX(i, j, 6)] +
-                     12.0 * u[IDX(i, j, 5)] - 3.0 * u[IDX(i, j, 4)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
-                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
-                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr2;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
-                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
-                    spr3;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void disstvb3_x(double *const Du, const double *const u,
-                const double *const lam, const double dx,
-                const unsigned int *sz, unsigned bflag) {
-    const double pre_factor = -1.0 / 12.0 / dx;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const double smr3 = 59.0 / 48.0 * 64 * dx;
-    const double smr2 = 43.0 / 48.0 * 64 * dx;
-    const double smr1 = 49.0 / 48.0 * 64 * dx;
-    const double spr3 = smr3;
-    const double spr2 = smr2;
-    const double spr1 = smr1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib + 1; i < ie - 1; i++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] =
-                    pre_factor *
-                    (lam[pp - 2] * u[pp - 2] - 4.0 * lam[pp - 1] * u[pp - 1] +
-                     6.0 * lam[pp] * u[pp] - 4.0 * lam[pp + 1] * u[pp + 1] +
-                     lam[pp + 2] * u[pp + 2]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Du[IDX(3, j, k)] = (u[IDX(6, j, k)] - 3.0 * u[IDX(5, j, k)] +
-                                    3.0 * u[IDX(4, j, k)] - u[IDX(3, j, k)]) /
-                                   smr3;
-                Du[IDX(4, j, k)] =
-                    (u[IDX(7, j, k)] - 6.0 * u[IDX(6, j, k)] +
-                     12.0 * u[IDX(5, j, k)] - 10.0 * u[IDX(4, j, k)] +
-                     3.0 * u[IDX(3, j, k)]) /
-                    smr2;
-                Du[IDX(5, j, k)] =
-                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     15.0 * u[IDX(6, j, k)] - 19.0 * u[IDX(5, j, k)] +
-                     12.0 * u[IDX(4, j, k)] - 3.0 * u[IDX(3, j, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
-                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
-                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr2;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
-                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void disstvb3_y(double *const Du, const double *const u,
-                const double *const lam, const double dy,
-                const unsigned int *sz, unsigned bflag) {
-    const double pre_factor = -1.0 / 12.0 / dy;
-
-    double smr3 = 59.0 / 48.0 * 64 * dy;
-    double smr2 = 43.0 / 48.0 * 64 * dy;
-    double smr1 = 49.0 / 48.0 * 64 * dy;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-            for (int j = jb + 1; j < je - 1; j++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor * (lam[pp - 2 * nx] * u[pp - 2 * nx] -
-                                       4.0 * lam[pp - nx] * u[pp - nx] +
-                                       6.0 * lam[pp] * u[pp] -
-                                       4.0 * lam[pp + nx] * u[pp + nx] +
-                                       lam[pp + 2 * nx] * u[pp + 2 * nx]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 3, k)] = (u[IDX(i, 6, k)] - 3.0 * u[IDX(i, 5, k)] +
-                                    3.0 * u[IDX(i, 4, k)] - u[IDX(i, 3, k)]) /
-                                   smr3;
-                Du[IDX(i, 4, k)] =
-                    (u[IDX(i, 7, k)] - 6.0 * u[IDX(i, 6, k)] +
-                     12.0 * u[IDX(i, 5, k)] - 10.0 * u[IDX(i, 4, k)] +
-                     3.0 * u[IDX(i, 3, k)]) /
-                    smr2;
-                Du[IDX(i, 5, k)] =
-                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     15.0 * u[IDX(i, 6, k)] - 19.0 * u[IDX(i, 5, k)] +
-                     12.0 * u[IDX(i, 4, k)] - 3.0 * u[IDX(i, 3, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
-                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
-                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr2;
-
-                Du[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
-                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void disstvb3_z(double *const Du, const double *const u,
-                const double *const lam, const double dz, const unsigned *sz,
-                unsigned bflag) {
-    const double pre_factor = -1.0 / 12.0 / dz;
-
-    double smr3 = 59.0 / 48.0 * 64 * dz;
-    double smr2 = 43.0 / 48.0 * 64 * dz;
-    double smr1 = 49.0 / 48.0 * 64 * dz;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-            for (int k = kb + 1; k < ke - 1; k++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor * (lam[pp - 2 * n] * u[pp - 2 * n] -
-                                       4.0 * lam[pp - n] * u[pp - n] +
-                                       6.0 * lam[pp] * u[pp] -
-                                       4.0 * lam[pp + n] * u[pp + n] +
-                                       lam[pp + 2 * n] * u[pp + 2 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 3)] = (u[IDX(i, j, 6)] - 3.0 * u[IDX(i, j, 5)] +
-                                    3.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 3)]) /
-                                   smr3;
-                Du[IDX(i, j, 4)] =
-                    (u[IDX(i, j, 7)] - 6.0 * u[IDX(i, j, 6)] +
-                     12.0 * u[IDX(i, j, 5)] - 10.0 * u[IDX(i, j, 4)] +
-                     3.0 * u[IDX(i, j, 3)]) /
-                    smr2;
-                Du[IDX(i, j, 5)] =
-                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
-                     15.0 * u[IDX(i, j, 6)] - 19.0 * u[IDX(i, j, 5)] +
-                     12.0 * u[IDX(i, j, 4)] - 3.0 * u[IDX(i, j, 3)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
-                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
-                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr2;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
-                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void disstvb5_x(double *const Du, const double *const u,
-                const double *const lam, const double dx,
-                const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dx = 2.0 / 75.0 / dx;
-
-    double smr3 = 59.0 / 48.0 * 64 * dx;
-    double smr2 = 43.0 / 48.0 * 64 * dx;
-    double smr1 = 49.0 / 48.0 * 64 * dx;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            int pp = IDX(ib, j, k);
-            Du[pp] = (lam[pp + 3] * u[pp + 3] - 6.0 * lam[pp + 2] * u[pp + 2] +
-                      15.0 * lam[pp + 1] * u[pp + 1] - 19.0 * lam[pp] * u[pp] +
-                      12.0 * lam[pp - 1] * u[pp - 1] -
-                      3.0 * lam[pp - 2] * u[pp - 2]) /
-                     smr1;
-
-            for (int i = ib + 1; i < ie - 1; i++) {
-                pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dx *
-                         (std::max(lam[pp + 3], lam[pp + 2]) *
-                              (u[pp + 3] - u[pp + 2]) -
-                          5.0 * std::max(lam[pp + 2], lam[pp + 1]) *
-                              (u[pp + 2] - u[pp + 1]) +
-                          10.0 * std::max(lam[pp + 1], lam[pp]) *
-                              (u[pp + 1] - u[pp]) -
-                          10.0 * std::max(lam[pp], lam[pp - 1]) *
-                              (u[pp] - u[pp - 1]) +
-                          5.0 * std::max(lam[pp - 1], lam[pp - 2]) *
-                              (u[pp - 1] - u[pp - 2]) -
-                          std::max(lam[pp - 2], lam[pp - 3]) *
-                              (u[pp - 2] - u[pp - 3]));
-            }
-
-            pp = IDX(ie - 1, j, k);
-            Du[pp] = (lam[pp - 4] * u[pp - 4] - 6.0 * lam[pp - 3] * u[pp - 3] +
-                      15.0 * lam[pp - 2] * u[pp - 2] -
-                      19.0 * lam[pp - 1] * u[pp - 1] + 12.0 * lam[pp] * u[pp] -
-                      3.0 * lam[pp + 1] * u[pp + 1]) /
-                     spr1;
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Du[IDX(3, j, k)] = (u[IDX(6, j, k)] - 3.0 * u[IDX(5, j, k)] +
-                                    3.0 * u[IDX(4, j, k)] - u[IDX(3, j, k)]) /
-                                   smr3;
-                Du[IDX(4, j, k)] =
-                    (u[IDX(7, j, k)] - 6.0 * u[IDX(6, j, k)] +
-                     12.0 * u[IDX(5, j, k)] - 10.0 * u[IDX(4, j, k)] +
-                     3.0 * u[IDX(3, j, k)]) /
-                    smr2;
-                Du[IDX(5, j, k)] =
-                    (u[IDX(8, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     15.0 * u[IDX(6, j, k)] - 19.0 * u[IDX(5, j, k)] +
-                     12.0 * u[IDX(4, j, k)] - 3.0 * u[IDX(3, j, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     15.0 * u[IDX(ie - 4, j, k)] - 19.0 * u[IDX(ie - 3, j, k)] +
-                     12.0 * u[IDX(ie - 2, j, k)] - 3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 6.0 * u[IDX(ie - 4, j, k)] +
-                     12.0 * u[IDX(ie - 3, j, k)] - 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr2;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 4, j, k)] - 3.0 * u[IDX(ie - 3, j, k)] +
-                     3.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void disstvb5_y(double *const Du, const double *const u,
-                const double *const lam, const double dy,
-                const unsigned int *sz, unsigned bflag) {
-    double pre_factor_6_dy = 2.0 / 75.0 / dy;
-
-    double smr3 = 59.0 / 48.0 * 64 * dy;
-    double smr2 = 43.0 / 48.0 * 64 * dy;
-    double smr1 = 49.0 / 48.0 * 64 * dy;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-            int pp = IDX(i, jb, k);
-
-            Du[pp] =
-                (lam[pp + 3 * nx] * u[pp + 3 * nx] -
-                 6.0 * lam[pp + 2 * nx] * u[pp + 2 * nx] +
-                 15.0 * lam[pp + nx] * u[pp + nx] - 19.0 * lam[pp] * u[pp] +
-                 12.0 * lam[pp - nx] * u[pp - nx] -
-                 3.0 * lam[pp - 2 * nx] * u[pp - 2 * nx]) /
-                smr1;
-
-            for (int j = jb + 1; j < je - 1; j++) {
-                pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dy *
-                         (std::max(lam[pp + 3 * nx], lam[pp + 2 * nx]) *
-                              (u[pp + 3 * nx] - u[pp + 2 * nx]) -
-                          5.0 * std::max(lam[pp + 2 * nx], lam[pp + nx]) *
-                              (u[pp + 2 * nx] - u[pp + nx]) +
-                          10.0 * std::max(lam[pp + nx], lam[pp]) *
-                              (u[pp + nx] - u[pp]) -
-                          10.0 * std::max(lam[pp], lam[pp - nx]) *
-                              (u[pp] - u[pp - nx]) +
-                          5.0 * std::max(lam[pp - nx], lam[pp - 2 * nx]) *
-                              (u[pp - nx] - u[pp - 2 * nx]) -
-                          std::max(lam[pp - 2 * nx], lam[pp - 3 * nx]) *
-                              (u[pp - 2 * nx] - u[pp - 3 * nx]));
-            }
-
-            pp = IDX(i, je - 1, k);
-            Du[pp] =
-                (lam[pp - 4 * nx] * u[pp - 4 * nx] -
-                 6.0 * lam[pp - 3 * nx] * u[pp - 3 * nx] +
-                 15.0 * lam[pp - 2 * nx] * u[pp - 2 * nx] -
-                 19.0 * lam[pp - nx] * u[pp - nx] + 12.0 * lam[pp] * u[pp] -
-                 3.0 * lam[pp + nx] * u[pp + nx]) /
-                spr1;
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 3, k)] = (u[IDX(i, 6, k)] - 3.0 * u[IDX(i, 5, k)] +
-                                    3.0 * u[IDX(i, 4, k)] - u[IDX(i, 3, k)]) /
-                                   smr3;
-                Du[IDX(i, 4, k)] =
-                    (u[IDX(i, 7, k)] - 6.0 * u[IDX(i, 6, k)] +
-                     12.0 * u[IDX(i, 5, k)] - 10.0 * u[IDX(i, 4, k)] +
-                     3.0 * u[IDX(i, 3, k)]) /
-                    smr2;
-                Du[IDX(i, 5, k)] =
-                    (u[IDX(i, 8, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     15.0 * u[IDX(i, 6, k)] - 19.0 * u[IDX(i, 5, k)] +
-                     12.0 * u[IDX(i, 4, k)] - 3.0 * u[IDX(i, 3, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     15.0 * u[IDX(i, je - 4, k)] - 19.0 * u[IDX(i, je - 3, k)] +
-                     12.0 * u[IDX(i, je - 2, k)] - 3.0 * u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 5, k)] - 6.0 * u[IDX(i, je - 4, k)] +
-                     12.0 * u[IDX(i, je - 3, k)] - 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr2;
-
-                Du[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 4, k)] - 3.0 * u[IDX(i, je - 3, k)] +
-                     3.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-
-void disstvb5_z(double *const Du, const double *const u,
-                const double *const lam, const double dz, const unsigned *sz,
-                unsigned bflag) {
-    double pre_factor_6_dz = -1.0 / 64.0 / dz;
-
-    double smr3 = 59.0 / 48.0 * 64 * dz;
-    double smr2 = 43.0 / 48.0 * 64 * dz;
-    double smr1 = 49.0 / 48.0 * 64 * dz;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-            int pp = IDX(i, j, kb);
-            Du[pp] = (lam[pp + 3 * n] * u[pp + 3 * n] -
-                      6.0 * lam[pp + 2 * n] * u[pp + 2 * n] +
-                      15.0 * lam[pp + n] * u[pp + n] - 19.0 * lam[pp] * u[pp] +
-                      12.0 * lam[pp - n] * u[pp - n] -
-                      3.0 * lam[pp - 2 * n] * u[pp - 2 * n]) /
-                     smr1;
-
-            for (int k = kb + 1; k < ke - 1; k++) {
-                pp = IDX(i, j, k);
-                Du[pp] = pre_factor_6_dz *
-                         (std::max(lam[pp + 3 * n], lam[pp + 2 * n]) *
-                              (u[pp + 3 * n] - u[pp + 2 * n]) -
-                          5.0 * std::max(lam[pp + 2 * n], lam[pp + n]) *
-                              (u[pp + 2 * n] - u[pp + n]) +
-                          10.0 * std::max(lam[pp + n], lam[pp]) *
-                              (u[pp + n] - u[pp]) -
-                          10.0 * std::max(lam[pp], lam[pp - n]) *
-                              (u[pp] - u[pp - n]) +
-                          5.0 * std::max(lam[pp - n], lam[pp - 2 * n]) *
-                              (u[pp - n] - u[pp - 2 * n]) -
-                          std::max(lam[pp - 2 * n], lam[pp - 3 * n]) *
-                              (u[pp - 2 * n] - u[pp - 3 * n]));
-            }
-
-            pp = IDX(i, j, ke - 1);
-            Du[pp] = (lam[pp - 4 * n] * u[pp - 4 * n] -
-                      6.0 * lam[pp - 3 * n] * u[pp - 3 * n] +
-                      15.0 * lam[pp - 2 * n] * u[pp - 2 * n] -
-                      19.0 * lam[pp - n] * u[pp - n] + 12.0 * lam[pp] * u[pp] -
-                      3.0 * lam[pp + n] * u[pp + n]) /
-                     spr1;
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 3)] = (u[IDX(i, j, 6)] - 3.0 * u[IDX(i, j, 5)] +
-                                    3.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 3)]) /
-                                   smr3;
-                Du[IDX(i, j, 4)] =
-                    (u[IDX(i, j, 7)] - 6.0 * u[IDX(i, j, 6)] +
-                     12.0 * u[IDX(i, j, 5)] - 10.0 * u[IDX(i, j, 4)] +
-                     3.0 * u[IDX(i, j, 3)]) /
-                    smr2;
-                Du[IDX(i, j, 5)] =
-                    (u[IDX(i, j, 8)] - 6.0 * u[IDX(i, j, 7)] +
-                     15.0 * u[IDX(i, j, 6)] - 19.0 * u[IDX(i, j, 5)] +
-                     12.0 * u[IDX(i, j, 4)] - 3.0 * u[IDX(i, j, 3)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     15.0 * u[IDX(i, j, ke - 4)] - 19.0 * u[IDX(i, j, ke - 3)] +
-                     12.0 * u[IDX(i, j, ke - 2)] - 3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 5)] - 6.0 * u[IDX(i, j, ke - 4)] +
-                     12.0 * u[IDX(i, j, ke - 3)] - 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr2;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 4)] - 3.0 * u[IDX(i, j, ke - 3)] +
-                     3.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) /
-                    spr3;
-            }
-        }
-    }
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv64_x(double *const Du, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_8_dx = -1.0 / 256.0 / dx;
-
-    double smr4 = 17.0 / 48.0 * 256 * dx;
-    double smr3 = 59.0 / 48.0 * 256 * dx;
-    double smr2 = 43.0 / 48.0 * 256 * dx;
-    double smr1 = 49.0 / 48.0 * 256 * dx;
-    double spr4 = smr4;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] = pre_factor_8_dx *
-                         (u[pp - 4] - 8.0 * u[pp - 3] + 28.0 * u[pp - 2] -
-                          56.0 * u[pp - 1] + 70.0 * u[pp] - 56.0 * u[pp + 1] +
-                          28.0 * u[pp + 2] - 8.0 * u[pp + 3] + u[pp + 4]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(4, j, k)] = (-u[IDX(4, j, k)] + 4.0 * u[IDX(5, j, k)] -
-                                    6.0 * u[IDX(6, j, k)] +
-                                    4.0 * u[IDX(7, j, k)] - u[IDX(8, j, k)]) /
-                                   smr4;
-
-                Du[IDX(5, j, k)] =
-                    (3.0 * u[IDX(4, j, k)] - 11.0 * u[IDX(5, j, k)] +
-                     15.0 * u[IDX(6, j, k)] - 9.0 * u[IDX(7, j, k)] +
-                     2.0 * u[IDX(8, j, k)]) /
-                    smr3;
-
-                Du[IDX(6, j, k)] =
-                    (-3.0 * u[IDX(4, j, k)] + 9.0 * u[IDX(5, j, k)] -
-                     8.0 * u[IDX(6, j, k)] + 3.0 * u[IDX(8, j, k)] -
-                     u[IDX(9, j, k)]) /
-                    smr2;
-
-                Du[IDX(7, j, k)] =
-                    (u[IDX(4, j, k)] - u[IDX(5, j, k)] - 6.0 * u[IDX(6, j, k)] +
-                     15.0 * u[IDX(7, j, k)] - 14.0 * u[IDX(8, j, k)] +
-                     6.0 * u[IDX(9, j, k)] - u[IDX(10, j, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                Du[IDX(ie - 4, j, k)] =
-                    (-u[IDX(ie - 7, j, k)] + 6.0 * u[IDX(ie - 6, j, k)] -
-                     14.0 * u[IDX(ie - 5, j, k)] + 15.0 * u[IDX(ie - 4, j, k)] -
-                     6.0 * u[IDX(ie - 3, j, k)] - u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) /
-                    spr1;
-
-                Du[IDX(ie - 3, j, k)] =
-                    (-u[IDX(ie - 6, j, k)] + 3.0 * u[IDX(ie - 5, j, k)] -
-                     8.0 * u[IDX(ie - 3, j, k)] + 9.0 * u[IDX(ie - 2, j, k)] -
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr2;
-
-                Du[IDX(ie - 2, j, k)] =
-                    (2.0 * u[IDX(ie - 5, j, k)] - 9.0 * u[IDX(ie - 4, j, k)] +
-                     15.0 * u[IDX(ie - 3, j, k)] - 11.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) /
-                    spr3;
-
-                Du[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 4.0 * u[IDX(ie - 4, j, k)] -
-                     6.0 * u[IDX(ie - 3, j, k)] + 4.0 * u[IDX(ie - 2, j, k)] -
-                     u[IDX(ie - 1, j, k)]) /
-                    spr4;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv64_y(double *const Du, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_8_dy = -1.0 / 256.0 / dy;
-
-    double smr4 = 17.0 / 48.0 * 256 * dy;
-    double smr3 = 59.0 / 48.0 * 256 * dy;
-    double smr2 = 43.0 / 48.0 * 256 * dy;
-    double smr1 = 49.0 / 48.0 * 256 * dy;
-    double spr4 = smr4;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] =
-                    pre_factor_8_dy *
-                    (u[pp - 4 * n] - 8.0 * u[pp - 3 * n] +
-                     28.0 * u[pp - 2 * n] - 56.0 * u[pp - n] + 70.0 * u[pp] -
-                     56.0 * u[pp + n] + 28.0 * u[pp + 2 * n] -
-                     8.0 * u[pp + 3 * n] + u[pp + 4 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, 4, k)] = (-u[IDX(i, 4, k)] + 4.0 * u[IDX(i, 5, k)] -
-                                    6.0 * u[IDX(i, 6, k)] +
-                                    4.0 * u[IDX(i, 7, k)] - u[IDX(i, 8, k)]) /
-                                   smr4;
-
-                Du[IDX(i, 5, k)] =
-                    (3.0 * u[IDX(i, 4, k)] - 11.0 * u[IDX(i, 5, k)] +
-                     15.0 * u[IDX(i, 6, k)] - 9.0 * u[IDX(i, 7, k)] +
-                     2.0 * u[IDX(i, 8, k)]) /
-                    smr3;
-
-                Du[IDX(i, 6, k)] =
-                    (-3.0 * u[IDX(i, 4, k)] + 9.0 * u[IDX(i, 5, k)] -
-                     8.0 * u[IDX(i, 6, k)] + 3.0 * u[IDX(i, 8, k)] -
-                     u[IDX(i, 9, k)]) /
-                    smr2;
-
-                Du[IDX(i, 7, k)] =
-                    (u[IDX(i, 4, k)] - u[IDX(i, 5, k)] - 6.0 * u[IDX(i, 6, k)] +
-                     15.0 * u[IDX(i, 7, k)] - 14.0 * u[IDX(i, 8, k)] +
-                     6.0 * u[IDX(i, 9, k)] - u[IDX(i, 10, k)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, je - 4, k)] =
-                    (-u[IDX(i, je - 7, k)] + 6.0 * u[IDX(i, je - 6, k)] -
-                     14.0 * u[IDX(i, je - 5, k)] + 15.0 * u[IDX(i, je - 4, k)] -
-                     6.0 * u[IDX(i, je - 3, k)] - u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) /
-                    spr1;
-
-                Du[IDX(i, je - 3, k)] =
-                    (-u[IDX(i, je - 6, k)] + 3.0 * u[IDX(i, je - 5, k)] -
-                     8.0 * u[IDX(i, je - 3, k)] + 9.0 * u[IDX(i, je - 2, k)] -
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr2;
-
-                Du[IDX(i, je - 2, k)] =
-                    (2.0 * u[IDX(i, je - 5, k)] - 9.0 * u[IDX(i, je - 4, k)] +
-                     15.0 * u[IDX(i, je - 3, k)] - 11.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) /
-                    spr3;
-
-                Du[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 5, k)] + 4.0 * u[IDX(i, je - 4, k)] -
-                     6.0 * u[IDX(i, je - 3, k)] + 4.0 * u[IDX(i, je - 2, k)] -
-                     u[IDX(i, je - 1, k)]) /
-                    spr4;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------
- *
- *
- *
- *----------------------------------------------------------------------*/
-void ko_deriv64_z(double *const Du, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    double pre_factor_8_dz = -1.0 / 256.0 / dz;
-
-    double smr4 = 17.0 / 48.0 * 256 * dz;
-    double smr3 = 59.0 / 48.0 * 256 * dz;
-    double smr2 = 43.0 / 48.0 * 256 * dz;
-    double smr1 = 49.0 / 48.0 * 256 * dz;
-    double spr4 = smr4;
-    double spr3 = smr3;
-    double spr2 = smr2;
-    double spr1 = smr1;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Du[pp] =
-                    pre_factor_8_dz *
-                    (u[pp - 4 * n] - 8.0 * u[pp - 3 * n] +
-                     28.0 * u[pp - 2 * n] - 56.0 * u[pp - n] + 70.0 * u[pp] -
-                     56.0 * u[pp + n] + 28.0 * u[pp + 2 * n] -
-                     8.0 * u[pp + 3 * n] + u[pp + 4 * n]);
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, 4)] = (-u[IDX(i, j, 4)] + 4.0 * u[IDX(i, j, 5)] -
-                                    6.0 * u[IDX(i, j, 6)] +
-                                    4.0 * u[IDX(i, j, 7)] - u[IDX(i, j, 8)]) /
-                                   smr4;
-
-                Du[IDX(i, j, 5)] =
-                    (3.0 * u[IDX(i, j, 4)] - 11.0 * u[IDX(i, j, 5)] +
-                     15.0 * u[IDX(i, j, 6)] - 9.0 * u[IDX(i, j, 7)] +
-                     2.0 * u[IDX(i, j, 8)]) /
-                    smr3;
-
-                Du[IDX(i, j, 6)] =
-                    (-3.0 * u[IDX(i, j, 4)] + 9.0 * u[IDX(i, j, 5)] -
-                     8.0 * u[IDX(i, j, 6)] + 3.0 * u[IDX(i, j, 8)] -
-                     u[IDX(i, j, 9)]) /
-                    smr2;
-
-                Du[IDX(i, j, 7)] =
-                    (u[IDX(i, j, 4)] - u[IDX(i, j, 5)] - 6.0 * u[IDX(i, j, 6)] +
-                     15.0 * u[IDX(i, j, 7)] - 14.0 * u[IDX(i, j, 8)] +
-                     6.0 * u[IDX(i, j, 9)] - u[IDX(i, j, 10)]) /
-                    smr1;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Du[IDX(i, j, ke - 4)] =
-                    (-u[IDX(i, j, ke - 7)] + 6.0 * u[IDX(i, j, ke - 6)] -
-                     14.0 * u[IDX(i, j, ke - 5)] + 15.0 * u[IDX(i, j, ke - 4)] -
-                     6.0 * u[IDX(i, j, ke - 3)] - u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) /
-                    spr1;
-
-                Du[IDX(i, j, ke - 3)] =
-                    (-u[IDX(i, j, ke - 6)] + 3.0 * u[IDX(i, j, ke - 5)] -
-                     8.0 * u[IDX(i, j, ke - 3)] + 9.0 * u[IDX(i, j, ke - 2)] -
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr2;
-
-                Du[IDX(i, j, ke - 2)] =
-                    (2.0 * u[IDX(i, j, ke - 5)] - 9.0 * u[IDX(i, j, ke - 4)] +
-                     15.0 * u[IDX(i, j, ke - 3)] - 11.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) /
-                    spr3;
-
-                Du[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 5)] + 4.0 * u[IDX(i, j, ke - 4)] -
-                     6.0 * u[IDX(i, j, ke - 3)] + 4.0 * u[IDX(i, j, ke - 2)] -
-                     u[IDX(i, j, ke - 1)]) /
-                    spr4;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Du[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_x(double *const Dxu, const double *const u, const double dx,
-                const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Dxu[pp] = (-u[pp - 3] + 9.0 * u[pp - 2] - 45.0 * u[pp - 1] +
-                           45.0 * u[pp + 1] - 9.0 * u[pp + 2] + u[pp + 3]) *
-                          idx_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(3, j, k)] =
-                    (-25.0 * u[IDX(3, j, k)] + 48.0 * u[IDX(4, j, k)] -
-                     36.0 * u[IDX(5, j, k)] + 16.0 * u[IDX(6, j, k)] -
-                     3.0 * u[IDX(7, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(4, j, k)] =
-                    (-3.0 * u[IDX(3, j, k)] - 10.0 * u[IDX(4, j, k)] +
-                     18.0 * u[IDX(5, j, k)] - 6.0 * u[IDX(6, j, k)] +
-                     u[IDX(7, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(5, j, k)] = (+u[IDX(3, j, k)] - 8.0 * u[IDX(4, j, k)] +
-                                     8.0 * u[IDX(6, j, k)] - u[IDX(7, j, k)]) *
-                                    idx_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(ie - 3, j, k)] =
-                    (+u[IDX(ie - 5, j, k)] - 8.0 * u[IDX(ie - 4, j, k)] +
-                     8.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 6.0 * u[IDX(ie - 4, j, k)] -
-                     18.0 * u[IDX(ie - 3, j, k)] + 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(ie - 1, j, k)] =
-                    (3.0 * u[IDX(ie - 5, j, k)] - 16.0 * u[IDX(ie - 4, j, k)] +
-                     36.0 * u[IDX(ie - 3, j, k)] - 48.0 * u[IDX(ie - 2, j, k)] +
-                     25.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_y(double *const Dyu, const double *const u, const double dy,
-                const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 0;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 0;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Dyu[pp] = (-u[pp - 3 * nx] + 9.0 * u[pp - 2 * nx] -
-                           45.0 * u[pp - nx] + 45.0 * u[pp + nx] -
-                           9.0 * u[pp + 2 * nx] + u[pp + 3 * nx]) *
-                          idy_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 3, k)] =
-                    (-25.0 * u[IDX(i, 3, k)] + 48.0 * u[IDX(i, 4, k)] -
-                     36.0 * u[IDX(i, 5, k)] + 16.0 * u[IDX(i, 6, k)] -
-                     3.0 * u[IDX(i, 7, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, 4, k)] =
-                    (-3.0 * u[IDX(i, 3, k)] - 10.0 * u[IDX(i, 4, k)] +
-                     18.0 * u[IDX(i, 5, k)] - 6.0 * u[IDX(i, 6, k)] +
-                     u[IDX(i, 7, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, 5, k)] = (u[IDX(i, 3, k)] - 8.0 * u[IDX(i, 4, k)] +
-                                     8.0 * u[IDX(i, 6, k)] - u[IDX(i, 7, k)]) *
-                                    idy_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 5, k)] - 8.0 * u[IDX(i, je - 4, k)] +
-                     8.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 5, k)] + 6.0 * u[IDX(i, je - 4, k)] -
-                     18.0 * u[IDX(i, je - 3, k)] + 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, je - 1, k)] =
-                    (+3.0 * u[IDX(i, je - 5, k)] - 16.0 * u[IDX(i, je - 4, k)] +
-                     36.0 * u[IDX(i, je - 3, k)] - 48.0 * u[IDX(i, je - 2, k)] +
-                     25.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_z(double *const Dzu, const double *const u, const double dz,
-                const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Dzu[pp] =
-                    (-u[pp - 3 * n] + 9.0 * u[pp - 2 * n] - 45.0 * u[pp - n] +
-                     45.0 * u[pp + n] - 9.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 3)] =
-                    (-25.0 * u[IDX(i, j, 3)] + 48.0 * u[IDX(i, j, 4)] -
-                     36.0 * u[IDX(i, j, 5)] + 16.0 * u[IDX(i, j, 6)] -
-                     3.0 * u[IDX(i, j, 7)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, 4)] =
-                    (-3.0 * u[IDX(i, j, 3)] - 10.0 * u[IDX(i, j, 4)] +
-                     18.0 * u[IDX(i, j, 5)] - 6.0 * u[IDX(i, j, 6)] +
-                     u[IDX(i, j, 7)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, 5)] = (u[IDX(i, j, 3)] - 8.0 * u[IDX(i, j, 4)] +
-                                     8.0 * u[IDX(i, j, 6)] - u[IDX(i, j, 7)]) *
-                                    idz_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 5)] - 8.0 * u[IDX(i, j, ke - 4)] +
-                     8.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 5)] + 6.0 * u[IDX(i, j, ke - 4)] -
-                     18.0 * u[IDX(i, j, ke - 3)] + 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, ke - 1)] =
-                    (3.0 * u[IDX(i, j, ke - 5)] - 16.0 * u[IDX(i, j, ke - 4)] +
-                     36.0 * u[IDX(i, j, ke - 3)] - 48.0 * u[IDX(i, j, ke - 2)] +
-                     25.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_x_pw4(double *const Dxu, const double *const u, const double dx,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Dxu[pp] = (-u[pp - 3] + 9.0 * u[pp - 2] - 45.0 * u[pp - 1] +
-                           45.0 * u[pp + 1] - 9.0 * u[pp + 2] + u[pp + 3]) *
-                          idx_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(4, j, k)] =
-                    (-25.0 * u[IDX(4, j, k)] + 48.0 * u[IDX(5, j, k)] -
-                     36.0 * u[IDX(6, j, k)] + 16.0 * u[IDX(7, j, k)] -
-                     3.0 * u[IDX(8, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(5, j, k)] =
-                    (-3.0 * u[IDX(4, j, k)] - 10.0 * u[IDX(5, j, k)] +
-                     18.0 * u[IDX(6, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     u[IDX(8, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(6, j, k)] = (+u[IDX(4, j, k)] - 8.0 * u[IDX(5, j, k)] +
-                                     8.0 * u[IDX(7, j, k)] - u[IDX(8, j, k)]) *
-                                    idx_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                Dxu[IDX(ie - 3, j, k)] =
-                    (+u[IDX(ie - 5, j, k)] - 8.0 * u[IDX(ie - 4, j, k)] +
-                     8.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 6.0 * u[IDX(ie - 4, j, k)] -
-                     18.0 * u[IDX(ie - 3, j, k)] + 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                Dxu[IDX(ie - 1, j, k)] =
-                    (3.0 * u[IDX(ie - 5, j, k)] - 16.0 * u[IDX(ie - 4, j, k)] +
-                     36.0 * u[IDX(ie - 3, j, k)] - 48.0 * u[IDX(ie - 2, j, k)] +
-                     25.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_y_pw4(double *const Dyu, const double *const u, const double dy,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 0;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Dyu[pp] = (-u[pp - 3 * nx] + 9.0 * u[pp - 2 * nx] -
-                           45.0 * u[pp - nx] + 45.0 * u[pp + nx] -
-                           9.0 * u[pp + 2 * nx] + u[pp + 3 * nx]) *
-                          idy_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, 4, k)] =
-                    (-25.0 * u[IDX(i, 4, k)] + 48.0 * u[IDX(i, 5, k)] -
-                     36.0 * u[IDX(i, 6, k)] + 16.0 * u[IDX(i, 7, k)] -
-                     3.0 * u[IDX(i, 8, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, 5, k)] =
-                    (-3.0 * u[IDX(i, 4, k)] - 10.0 * u[IDX(i, 5, k)] +
-                     18.0 * u[IDX(i, 6, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     u[IDX(i, 8, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, 6, k)] = (u[IDX(i, 4, k)] - 8.0 * u[IDX(i, 5, k)] +
-                                     8.0 * u[IDX(i, 7, k)] - u[IDX(i, 8, k)]) *
-                                    idy_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 5, k)] - 8.0 * u[IDX(i, je - 4, k)] +
-                     8.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 5, k)] + 6.0 * u[IDX(i, je - 4, k)] -
-                     18.0 * u[IDX(i, je - 3, k)] + 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                Dyu[IDX(i, je - 1, k)] =
-                    (+3.0 * u[IDX(i, je - 5, k)] - 16.0 * u[IDX(i, je - 4, k)] +
-                     36.0 * u[IDX(i, je - 3, k)] - 48.0 * u[IDX(i, je - 2, k)] +
-                     25.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_z_pw4(double *const Dzu, const double *const u, const double dz,
-                    const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Dzu[pp] =
-                    (-u[pp - 3 * n] + 9.0 * u[pp - 2 * n] - 45.0 * u[pp - n] +
-                     45.0 * u[pp + n] - 9.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, 4)] =
-                    (-25.0 * u[IDX(i, j, 4)] + 48.0 * u[IDX(i, j, 5)] -
-                     36.0 * u[IDX(i, j, 6)] + 16.0 * u[IDX(i, j, 7)] -
-                     3.0 * u[IDX(i, j, 8)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, 5)] =
-                    (-3.0 * u[IDX(i, j, 4)] - 10.0 * u[IDX(i, j, 5)] +
-                     18.0 * u[IDX(i, j, 6)] - 6.0 * u[IDX(i, j, 7)] +
-                     u[IDX(i, j, 8)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, 6)] = (u[IDX(i, j, 4)] - 8.0 * u[IDX(i, j, 5)] +
-                                     8.0 * u[IDX(i, j, 7)] - u[IDX(i, j, 8)]) *
-                                    idz_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 5)] - 8.0 * u[IDX(i, j, ke - 4)] +
-                     8.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 5)] + 6.0 * u[IDX(i, j, ke - 4)] -
-                     18.0 * u[IDX(i, j, ke - 3)] + 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                Dzu[IDX(i, j, ke - 1)] =
-                    (3.0 * u[IDX(i, j, ke - 5)] - 16.0 * u[IDX(i, j, ke - 4)] +
-                     36.0 * u[IDX(i, j, ke - 3)] - 48.0 * u[IDX(i, j, ke - 2)] +
-                     25.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_xx(double *const DxDxu, const double *const u, const double dx,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_180 = idx_sqrd / 180.0;
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                DxDxu[pp] =
-                    (2.0 * u[pp - 3] - 27.0 * u[pp - 2] + 270.0 * u[pp - 1] -
-                     490.0 * u[pp] + 270.0 * u[pp + 1] - 27.0 * u[pp + 2] +
-                     2.0 * u[pp + 3]) *
-                    idx_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // The above two should be replaced by 4th order approximations:
-                DxDxu[IDX(3, j, k)] =
-                    (45.0 * u[IDX(3, j, k)] - 154.0 * u[IDX(4, j, k)] +
-                     214.0 * u[IDX(5, j, k)] - 156.0 * u[IDX(6, j, k)] +
-                     61.0 * u[IDX(7, j, k)] - 10.0 * u[IDX(8, j, k)]) *
-                    idx_sqrd_by_12;
-
-                DxDxu[IDX(4, j, k)] =
-                    (10.0 * u[IDX(3, j, k)] - 15.0 * u[IDX(4, j, k)] -
-                     4.0 * u[IDX(5, j, k)] + 14.0 * u[IDX(6, j, k)] -
-                     6.0 * u[IDX(7, j, k)] + u[IDX(8, j, k)]) *
-                    idx_sqrd_by_12;
-
-                DxDxu[IDX(5, j, k)] =
-                    (-u[IDX(3, j, k)] + 16.0 * u[IDX(4, j, k)] -
-                     30.0 * u[IDX(5, j, k)] + 16.0 * u[IDX(6, j, k)] -
-                     u[IDX(7, j, k)]) *
-                    idx_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                DxDxu[IDX(ie - 3, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 16.0 * u[IDX(ie - 4, j, k)] -
-                     30.0 * u[IDX(ie - 3, j, k)] + 16.0 * u[IDX(ie - 2, j, k)] -
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // The above two should be replaced by 4th order approximations:
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     14.0 * u[IDX(ie - 4, j, k)] - 4.0 * u[IDX(ie - 3, j, k)] -
-                     15.0 * u[IDX(ie - 2, j, k)] +
-                     10.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_12;
-
-                DxDxu[IDX(ie - 1, j, k)] = (-10.0 * u[IDX(ie - 6, j, k)] +
-                                            61.0 * u[IDX(ie - 5, j, k)] -
-                                            156.0 * u[IDX(ie - 4, j, k)] +
-                                            214.0 * u[IDX(ie - 3, j, k)] -
-                                            154.0 * u[IDX(ie - 2, j, k)] +
-                                            45.0 * u[IDX(ie - 1, j, k)]) *
-                                           idx_sqrd_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_yy(double *const DyDyu, const double *const u, const double dy,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_180 = idy_sqrd / 180.0;
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                DyDyu[pp] =
-                    (2.0 * u[pp - 3 * nx] - 27.0 * u[pp - 2 * nx] +
-                     270.0 * u[pp - nx] - 490.0 * u[pp] + 270.0 * u[pp + nx] -
-                     27.0 * u[pp + 2 * nx] + 2.0 * u[pp + 3 * nx]) *
-                    idy_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // The above two should be replaced by 4th order approximations:
-                DyDyu[IDX(i, 3, k)] =
-                    (45.0 * u[IDX(i, 3, k)] - 154.0 * u[IDX(i, 4, k)] +
-                     214.0 * u[IDX(i, 5, k)] - 156.0 * u[IDX(i, 6, k)] +
-                     61.0 * u[IDX(i, 7, k)] - 10.0 * u[IDX(i, 8, k)]) *
-                    idy_sqrd_by_12;
-
-                DyDyu[IDX(i, 4, k)] =
-                    (10.0 * u[IDX(i, 3, k)] - 15.0 * u[IDX(i, 4, k)] -
-                     4.0 * u[IDX(i, 5, k)] + 14.0 * u[IDX(i, 6, k)] -
-                     6.0 * u[IDX(i, 7, k)] + u[IDX(i, 8, k)]) *
-                    idy_sqrd_by_12;
-
-                DyDyu[IDX(i, 5, k)] =
-                    (-u[IDX(i, 3, k)] + 16.0 * u[IDX(i, 4, k)] -
-                     30.0 * u[IDX(i, 5, k)] + 16.0 * u[IDX(i, 6, k)] -
-                     u[IDX(i, 7, k)]) *
-                    idy_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DyDyu[IDX(i, je - 3, k)] =
-                    (-u[IDX(i, je - 5, k)] + 16.0 * u[IDX(i, je - 4, k)] -
-                     30.0 * u[IDX(i, je - 3, k)] + 16.0 * u[IDX(i, je - 2, k)] -
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_12;
-
-                // The above two should be replaced by 4th order approximations:
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     14.0 * u[IDX(i, je - 4, k)] - 4.0 * u[IDX(i, je - 3, k)] -
-                     15.0 * u[IDX(i, je - 2, k)] +
-                     10.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_12;
-
-                DyDyu[IDX(i, je - 1, k)] = (-10.0 * u[IDX(i, je - 6, k)] +
-                                            61.0 * u[IDX(i, je - 5, k)] -
-                                            156.0 * u[IDX(i, je - 4, k)] +
-                                            214.0 * u[IDX(i, je - 3, k)] -
-                                            154.0 * u[IDX(i, je - 2, k)] +
-                                            45.0 * u[IDX(i, je - 1, k)]) *
-                                           idy_sqrd_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644_zz(double *const DzDzu, const double *const u, const double dz,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_180 = idz_sqrd / 180.0;
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                DzDzu[pp] =
-                    (2.0 * u[pp - 3 * n] - 27.0 * u[pp - 2 * n] +
-                     270.0 * u[pp - n] - 490.0 * u[pp] + 270.0 * u[pp + n] -
-                     27.0 * u[pp + 2 * n] + 2.0 * u[pp + 3 * n]) *
-                    idz_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // The above two should be replaced by 4th order approximations:
-                DzDzu[IDX(i, j, 3)] =
-                    (45.0 * u[IDX(i, j, 3)] - 154.0 * u[IDX(i, j, 4)] +
-                     214.0 * u[IDX(i, j, 5)] - 156.0 * u[IDX(i, j, 6)] +
-                     61.0 * u[IDX(i, j, 7)] - 10.0 * u[IDX(i, j, 8)]) *
-                    idz_sqrd_by_12;
-
-                DzDzu[IDX(i, j, 4)] =
-                    (10.0 * u[IDX(i, j, 3)] - 15.0 * u[IDX(i, j, 4)] -
-                     4.0 * u[IDX(i, j, 5)] + 14.0 * u[IDX(i, j, 6)] -
-                     6.0 * u[IDX(i, j, 7)] + u[IDX(i, j, 8)]) *
-                    idz_sqrd_by_12;
-
-                DzDzu[IDX(i, j, 5)] =
-                    (-u[IDX(i, j, 3)] + 16.0 * u[IDX(i, j, 4)] -
-                     30.0 * u[IDX(i, j, 5)] + 16.0 * u[IDX(i, j, 6)] -
-                     u[IDX(i, j, 7)]) *
-                    idz_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                DzDzu[IDX(i, j, ke - 3)] =
-                    (-u[IDX(i, j, ke - 5)] + 16.0 * u[IDX(i, j, ke - 4)] -
-                     30.0 * u[IDX(i, j, ke - 3)] + 16.0 * u[IDX(i, j, ke - 2)] -
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_12;
-                // The above two should be replaced by 4th order approximations:
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     14.0 * u[IDX(i, j, ke - 4)] - 4.0 * u[IDX(i, j, ke - 3)] -
-                     15.0 * u[IDX(i, j, ke - 2)] +
-                     10.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_12;
-
-                DzDzu[IDX(i, j, ke - 1)] = (-10.0 * u[IDX(i, j, ke - 6)] +
-                                            61.0 * u[IDX(i, j, ke - 5)] -
-                                            156.0 * u[IDX(i, j, ke - 4)] +
-                                            214.0 * u[IDX(i, j, ke - 3)] -
-                                            154.0 * u[IDX(i, j, ke - 2)] +
-                                            45.0 * u[IDX(i, j, ke - 1)]) *
-                                           idz_sqrd_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644adv_x(double *const Dxu, const double *const u, const double dx,
-                   const unsigned int *sz, const double *const betax,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv644_x(Dxu, u, dx, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644adv_y(double *const Dyu, const double *const u, const double dy,
-                   const unsigned int *sz, const double *const betay,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv644_y(Dyu, u, dy, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv644adv_z(double *const Dzu, const double *const u, const double dz,
-                   const unsigned int *sz, const double *const betaz,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv644_z(Dzu, u, dz, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_x(double *const Dxu, const double *const u, const double dx,
-                const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                Dxu[pp] = (-u[pp - 3] + 9.0 * u[pp - 2] - 45.0 * u[pp - 1] +
-                           45.0 * u[pp + 1] - 9.0 * u[pp + 2] + u[pp + 3]) *
-                          idx_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted second order stencil.
-                Dxu[IDX(3, j, k)] = (-3.0 * u[IDX(3, j, k)] +
-                                     4.0 * u[IDX(4, j, k)] - u[IDX(5, j, k)]) *
-                                    idx_by_2;
-
-                // This is a centered second order stencil.
-                Dxu[IDX(4, j, k)] =
-                    (-u[IDX(3, j, k)] + u[IDX(5, j, k)]) * idx_by_2;
-
-                // This is a centered fourth order stencil.
-                Dxu[IDX(5, j, k)] = (u[IDX(3, j, k)] - 8.0 * u[IDX(4, j, k)] +
-                                     8.0 * u[IDX(6, j, k)] - u[IDX(7, j, k)]) *
-                                    idx_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered fourth order stencil.
-                Dxu[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 8.0 * u[IDX(ie - 4, j, k)] +
-                     8.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                // This is a centered second order stencil.
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) * idx_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dxu[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_y(double *const Dyu, const double *const u, const double dy,
-                const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.5 * idy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 0;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 0;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-                Dyu[pp] =
-                    (-u[pp - 3 * n] + 9.0 * u[pp - 2 * n] - 45.0 * u[pp - n] +
-                     45.0 * u[pp + n] - 9.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
-                    idy_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                Dyu[IDX(i, 3, k)] = (-3.0 * u[IDX(i, 3, k)] +
-                                     4.0 * u[IDX(i, 4, k)] - u[IDX(i, 5, k)]) *
-                                    idy_by_2;
-
-                // This is a centered second order stencil.
-                Dyu[IDX(i, 4, k)] =
-                    (-u[IDX(i, 3, k)] + u[IDX(i, 5, k)]) * idy_by_2;
-
-                // This is a centered fourth order stencil.
-                Dyu[IDX(i, 5, k)] = (u[IDX(i, 3, k)] - 8.0 * u[IDX(i, 4, k)] +
-                                     8.0 * u[IDX(i, 6, k)] - u[IDX(i, 7, k)]) *
-                                    idy_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered fourth order stencil.
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 5, k)] - 8.0 * u[IDX(i, je - 4, k)] +
-                     8.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                // This is a centered second order stencil.
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) * idy_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_z(double *const Dzu, const double *const u, const double dz,
-                const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.5 * idz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                Dzu[pp] =
-                    (-u[pp - 3 * n] + 9.0 * u[pp - 2 * n] - 45.0 * u[pp - n] +
-                     45.0 * u[pp + n] - 9.0 * u[pp + 2 * n] + u[pp + 3 * n]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                Dzu[IDX(i, j, 3)] = (-3.0 * u[IDX(i, j, 3)] +
-                                     4.0 * u[IDX(i, j, 4)] - u[IDX(i, j, 5)]) *
-                                    idz_by_2;
-
-                // This is a centered second order stencil.
-                Dzu[IDX(i, j, 4)] =
-                    (-u[IDX(i, j, 3)] + u[IDX(i, j, 5)]) * idz_by_2;
-
-                // This is a centered fourth order stencil.
-                Dzu[IDX(i, j, 5)] = (u[IDX(i, j, 3)] - 8.0 * u[IDX(i, j, 4)] +
-                                     8.0 * u[IDX(i, j, 6)] - u[IDX(i, j, 7)]) *
-                                    idz_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered fourth order stencil.
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 5)] - 8.0 * u[IDX(i, j, ke - 4)] +
-                     8.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                // This is a centered second order stencil.
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) * idz_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_xx(double *const DxDxu, const double *const u, const double dx,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_180 = idx_sqrd / 180.0;
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                DxDxu[pp] =
-                    (2.0 * u[pp - 3] - 27.0 * u[pp - 2] + 270.0 * u[pp - 1] -
-                     490.0 * u[pp] + 270.0 * u[pp + 1] - 27.0 * u[pp + 2] +
-                     2.0 * u[pp + 3]) *
-                    idx_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted second order stencil.
-                DxDxu[IDX(3, j, k)] =
-                    (2.0 * u[IDX(3, j, k)] - 5.0 * u[IDX(4, j, k)] +
-                     4.0 * u[IDX(5, j, k)] - u[IDX(6, j, k)]) *
-                    idx_sqrd;
-
-                // This is a centered second order stencil.
-                DxDxu[IDX(4, j, k)] = (u[IDX(3, j, k)] - 2.0 * u[IDX(4, j, k)] +
-                                       u[IDX(5, j, k)]) *
-                                      idx_sqrd;
-
-                // This is a centered fourth order stencil.
-                DxDxu[IDX(5, j, k)] =
-                    (-u[IDX(3, j, k)] + 16.0 * u[IDX(4, j, k)] -
-                     30.0 * u[IDX(5, j, k)] + 16.0 * u[IDX(6, j, k)] -
-                     u[IDX(7, j, k)]) *
-                    idx_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered fourth order stencil.
-                DxDxu[IDX(ie - 3, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 16.0 * u[IDX(ie - 4, j, k)] -
-                     30.0 * u[IDX(ie - 3, j, k)] + 16.0 * u[IDX(ie - 2, j, k)] -
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DxDxu[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 4, j, k)] + 4.0 * u[IDX(ie - 3, j, k)] -
-                     5.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_yy(double *const DyDyu, const double *const u, const double dy,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_180 = idy_sqrd / 180.0;
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                DyDyu[pp] =
-                    (2.0 * u[pp - 3 * nx] - 27.0 * u[pp - 2 * nx] +
-                     270.0 * u[pp - nx] - 490.0 * u[pp] + 270.0 * u[pp + nx] -
-                     27.0 * u[pp + 2 * nx] + 2.0 * u[pp + 3 * nx]) *
-                    idy_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                DyDyu[IDX(i, 3, k)] =
-                    (2.0 * u[IDX(i, 3, k)] - 5.0 * u[IDX(i, 4, k)] +
-                     4.0 * u[IDX(i, 5, k)] - u[IDX(i, 6, k)]) *
-                    idy_sqrd;
-
-                // This is a centered second order stencil.
-                DyDyu[IDX(i, 4, k)] = (u[IDX(i, 3, k)] - 2.0 * u[IDX(i, 4, k)] +
-                                       u[IDX(i, 5, k)]) *
-                                      idy_sqrd;
-
-                // This is a centered fourth order stencil.
-                DyDyu[IDX(i, 5, k)] =
-                    (-u[IDX(i, 3, k)] + 16.0 * u[IDX(i, 4, k)] -
-                     30.0 * u[IDX(i, 5, k)] + 16.0 * u[IDX(i, 6, k)] -
-                     u[IDX(i, 7, k)]) *
-                    idy_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered fourth order stencil.
-                DyDyu[IDX(i, je - 3, k)] =
-                    (-u[IDX(i, je - 5, k)] + 16.0 * u[IDX(i, je - 4, k)] -
-                     30.0 * u[IDX(i, je - 3, k)] + 16.0 * u[IDX(i, je - 2, k)] -
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DyDyu[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 4, k)] + 4.0 * u[IDX(i, je - 3, k)] -
-                     5.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642_zz(double *const DzDzu, const double *const u, const double dz,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_180 = idz_sqrd / 180.0;
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 3;
-    const int jb = 3;
-    const int kb = 3;
-    const int ie = sz[0] - 3;
-    const int je = sz[1] - 3;
-    const int ke = sz[2] - 3;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-
-                DzDzu[pp] =
-                    (2.0 * u[pp - 3 * n] - 27.0 * u[pp - 2 * n] +
-                     270.0 * u[pp - n] - 490.0 * u[pp] + 270.0 * u[pp + n] -
-                     27.0 * u[pp + 2 * n] + 2.0 * u[pp + 3 * n]) *
-                    idz_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                DzDzu[IDX(i, j, 3)] =
-                    (2.0 * u[IDX(i, j, 3)] - 5.0 * u[IDX(i, j, 4)] +
-                     4.0 * u[IDX(i, j, 5)] - u[IDX(i, j, 6)]) *
-                    idz_sqrd;
-
-                // This is a centered second order stencil.
-                DzDzu[IDX(i, j, 4)] = (u[IDX(i, j, 3)] - 2.0 * u[IDX(i, j, 4)] +
-                                       u[IDX(i, j, 5)]) *
-                                      idz_sqrd;
-
-                // This is a centered fourth order stencil.
-                DzDzu[IDX(i, j, 5)] =
-                    (-u[IDX(i, j, 3)] + 16.0 * u[IDX(i, j, 4)] -
-                     30.0 * u[IDX(i, j, 5)] + 16.0 * u[IDX(i, j, 6)] -
-                     u[IDX(i, j, 7)]) *
-                    idz_sqrd_by_12;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered fourth order stencil.
-                DzDzu[IDX(i, j, ke - 3)] =
-                    (-u[IDX(i, j, ke - 5)] + 16.0 * u[IDX(i, j, ke - 4)] -
-                     30.0 * u[IDX(i, j, ke - 3)] + 16.0 * u[IDX(i, j, ke - 2)] -
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DzDzu[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 4)] + 4.0 * u[IDX(i, j, ke - 3)] -
-                     5.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642adv_x(double *const Dxu, const double *const u, const double dx,
-                   const unsigned int *sz, const double *const betax,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv642_x(Dxu, u, dx, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642adv_y(double *const Dyu, const double *const u, const double dy,
-                   const unsigned int *sz, const double *const betay,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv642_y(Dyu, u, dy, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv642adv_z(double *const Dzu, const double *const u, const double dz,
-                   const unsigned int *sz, const double *const betaz,
-                   unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv642_z(Dzu, u, dz, sz, bflag);
-}
-
-void deriv8642_x_wrapper(double *const Dxu, const double *const u,
-                         const double dx, const unsigned int *sz,
-                         unsigned bflag, const unsigned pw) {
-    if (pw == 4) {
-        deriv8642_x(Dxu, u, dx, sz, bflag);
-    } else {
-        throw std::runtime_error(
-            "X Derivative cannot be computed for a padding width that differs "
-            "from 4!");
-    }
-}
-
-void deriv8642_y_wrapper(double *const Dyu, const double *const u,
-                         const double dy, const unsigned int *sz,
-                         unsigned bflag, const unsigned pw) {
-    if (pw == 4) {
-        deriv8642_y(Dyu, u, dy, sz, bflag);
-    } else {
-        throw std::runtime_error(
-            "Y Derivative cannot be computed for a padding width that differs "
-            "from 4!");
-    }
-}
-
-void deriv8642_z_wrapper(double *const Dzu, const double *const u,
-                         const double dz, const unsigned int *sz,
-                         unsigned bflag, const unsigned pw) {
-    if (pw == 4) {
-        deriv8642_z(Dzu, u, dz, sz, bflag);
-    } else {
-        throw std::runtime_error(
-            "Z Derivative cannot be computed for a padding width that differs "
-            "from 4!");
-    }
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_x(double *const Dxu, const double *const u, const double dx,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-    const double idx_by_2520 = idx / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                Dxu[pp] =
-                    (9.0 * u[pp - 4] - 96.0 * u[pp - 3] + 504.0 * u[pp - 2] -
-                     2016.0 * u[pp - 1] + 2016.0 * u[pp + 1] -
-                     504.0 * u[pp + 2] + 96.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted second order stencil.
-                Dxu[IDX(4, j, k)] = (-3.0 * u[IDX(4, j, k)] +
-                                     4.0 * u[IDX(5, j, k)] - u[IDX(6, j, k)]) *
-                                    idx_by_2;
-
-                // This is a centered second order stencil.
-                Dxu[IDX(5, j, k)] =
-                    (-u[IDX(4, j, k)] + u[IDX(6, j, k)]) * idx_by_2;
-
-                // This is a centered fourth order stencil.
-                Dxu[IDX(6, j, k)] = (u[IDX(4, j, k)] - 8.0 * u[IDX(5, j, k)] +
-                                     8.0 * u[IDX(7, j, k)] - u[IDX(8, j, k)]) *
-                                    idx_by_12;
-
-                // This is a centered sixth order stencil.
-                Dxu[IDX(7, j, k)] =
-                    (-u[IDX(4, j, k)] + 9.0 * u[IDX(5, j, k)] -
-                     45.0 * u[IDX(6, j, k)] + 45.0 * u[IDX(8, j, k)] -
-                     9.0 * u[IDX(9, j, k)] + u[IDX(10, j, k)]) *
-                    idx_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                Dxu[IDX(ie - 4, j, k)] =
-                    (-u[IDX(ie - 7, j, k)] + 9.0 * u[IDX(ie - 6, j, k)] -
-                     45.0 * u[IDX(ie - 5, j, k)] + 45.0 * u[IDX(ie - 3, j, k)] -
-                     9.0 * u[IDX(ie - 2, j, k)] + u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a centered fourth order stencil.
-                Dxu[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 5, j, k)] - 8.0 * u[IDX(ie - 4, j, k)] +
-                     8.0 * u[IDX(ie - 2, j, k)] - u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                // This is a centered second order stencil.
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 3, j, k)] + u[IDX(ie - 1, j, k)]) * idx_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dxu[IDX(ie - 1, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 4.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_y(double *const Dyu, const double *const u, const double dy,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.5 * idy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-    const double idy_by_2520 = idy / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 0;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                Dyu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idy_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                Dyu[IDX(i, 4, k)] = (-3.0 * u[IDX(i, 4, k)] +
-                                     4.0 * u[IDX(i, 5, k)] - u[IDX(i, 6, k)]) *
-                                    idy_by_2;
-
-                // This is a centered second order stencil.
-                Dyu[IDX(i, 5, k)] =
-                    (-u[IDX(i, 4, k)] + u[IDX(i, 6, k)]) * idy_by_2;
-
-                // This is a centered fourth order stencil.
-                Dyu[IDX(i, 6, k)] = (u[IDX(i, 4, k)] - 8.0 * u[IDX(i, 5, k)] +
-                                     8.0 * u[IDX(i, 7, k)] - u[IDX(i, 8, k)]) *
-                                    idy_by_12;
-
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, 7, k)] =
-                    (-u[IDX(i, 4, k)] + 9.0 * u[IDX(i, 5, k)] -
-                     45.0 * u[IDX(i, 6, k)] + 45.0 * u[IDX(i, 8, k)] -
-                     9.0 * u[IDX(i, 9, k)] + u[IDX(i, 10, k)]) *
-                    idy_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, je - 4, k)] =
-                    (-u[IDX(i, je - 7, k)] + 9.0 * u[IDX(i, je - 6, k)] -
-                     45.0 * u[IDX(i, je - 5, k)] + 45.0 * u[IDX(i, je - 3, k)] -
-                     9.0 * u[IDX(i, je - 2, k)] + u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a centered fourth order stencil.
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 5, k)] - 8.0 * u[IDX(i, je - 4, k)] +
-                     8.0 * u[IDX(i, je - 2, k)] - u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                // This is a centered second order stencil.
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 3, k)] + u[IDX(i, je - 1, k)]) * idy_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dyu[IDX(i, je - 1, k)] =
-                    (u[IDX(i, je - 3, k)] - 4.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_z(double *const Dzu, const double *const u, const double dz,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.5 * idz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-    const double idz_by_2520 = idz / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-
-                Dzu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idz_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                Dzu[IDX(i, j, 4)] = (-3.0 * u[IDX(i, j, 4)] +
-                                     4.0 * u[IDX(i, j, 5)] - u[IDX(i, j, 6)]) *
-                                    idz_by_2;
-
-                // This is a centered second order stencil.
-                Dzu[IDX(i, j, 5)] =
-                    (-u[IDX(i, j, 4)] + u[IDX(i, j, 6)]) * idz_by_2;
-
-                // This is a centered fourth order stencil.
-                Dzu[IDX(i, j, 6)] = (u[IDX(i, j, 4)] - 8.0 * u[IDX(i, j, 5)] +
-                                     8.0 * u[IDX(i, j, 7)] - u[IDX(i, j, 8)]) *
-                                    idz_by_12;
-
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, 7)] =
-                    (-u[IDX(i, j, 4)] + 9.0 * u[IDX(i, j, 5)] -
-                     45.0 * u[IDX(i, j, 6)] + 45.0 * u[IDX(i, j, 8)] -
-                     9.0 * u[IDX(i, j, 9)] + u[IDX(i, j, 10)]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, ke - 4)] =
-                    (-u[IDX(i, j, ke - 7)] + 9.0 * u[IDX(i, j, ke - 6)] -
-                     45.0 * u[IDX(i, j, ke - 5)] + 45.0 * u[IDX(i, j, ke - 3)] -
-                     9.0 * u[IDX(i, j, ke - 2)] + u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a centered fourth order stencil.
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 5)] - 8.0 * u[IDX(i, j, ke - 4)] +
-                     8.0 * u[IDX(i, j, ke - 2)] - u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                // This is a centered second order stencil.
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 3)] + u[IDX(i, j, ke - 1)]) * idz_by_2;
-
-                // This is a (totally) shifted second order stencil.
-                Dzu[IDX(i, j, ke - 1)] =
-                    (u[IDX(i, j, ke - 3)] - 4.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_2;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_xx(double *const DxDxu, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-    const double idx_sqrd_by_180 = idx_sqrd / 180.0;
-    const double idx_sqrd_by_5040 = idx_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                DxDxu[pp] =
-                    (-9.0 * u[pp - 4] + 128.0 * u[pp - 3] - 1008.0 * u[pp - 2] +
-                     8064.0 * u[pp - 1] - 14350.0 * u[pp] + 8064.0 * u[pp + 1] -
-                     1008.0 * u[pp + 2] + 128.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted second order stencil.
-                DxDxu[IDX(4, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 5.0 * u[IDX(5, j, k)] +
-                     4.0 * u[IDX(6, j, k)] - u[IDX(7, j, k)]) *
-                    idx_sqrd;
-
-                // This is a centered second order stencil.
-                DxDxu[IDX(5, j, k)] = (u[IDX(4, j, k)] - 2.0 * u[IDX(5, j, k)] +
-                                       u[IDX(6, j, k)]) *
-                                      idx_sqrd;
-
-                // This is a centered fourth order stencil.
-                DxDxu[IDX(6, j, k)] =
-                    (-u[IDX(4, j, k)] + 16.0 * u[IDX(5, j, k)] -
-                     30.0 * u[IDX(6, j, k)] + 16.0 * u[IDX(7, j, k)] -
-                     u[IDX(8, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(7, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 27.0 * u[IDX(5, j, k)] +
-                     270.0 * u[IDX(6, j, k)] - 490.0 * u[IDX(7, j, k)] +
-                     270.0 * u[IDX(8, j, k)] - 27.0 * u[IDX(9, j, k)] +
-                     2.0 * u[IDX(10, j, k)]) *
-                    idx_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(ie - 4, j, k)] =
-                    (2.0 * u[IDX(ie - 7, j, k)] - 27.0 * u[IDX(ie - 6, j, k)] +
-                     270.0 * u[IDX(ie - 5, j, k)] -
-                     490.0 * u[IDX(ie - 4, j, k)] +
-                     270.0 * u[IDX(ie - 3, j, k)] -
-                     27.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a centered fourth order stencil.
-                DxDxu[IDX(ie - 3, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 16.0 * u[IDX(ie - 4, j, k)] -
-                     30.0 * u[IDX(ie - 3, j, k)] + 16.0 * u[IDX(ie - 2, j, k)] -
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 3, j, k)] - 2.0 * u[IDX(ie - 2, j, k)] +
-                     u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DxDxu[IDX(ie - 1, j, k)] =
-                    (-u[IDX(ie - 4, j, k)] + 4.0 * u[IDX(ie - 3, j, k)] -
-                     5.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_yy(double *const DyDyu, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-    const double idy_sqrd_by_180 = idy_sqrd / 180.0;
-    const double idy_sqrd_by_5040 = idy_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                DyDyu[pp] = (-9.0 * u[pp - 4 * nx] + 128.0 * u[pp - 3 * nx] -
-                             1008.0 * u[pp - 2 * nx] + 8064.0 * u[pp - nx] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + nx] -
-                             1008.0 * u[pp + 2 * nx] + 128.0 * u[pp + 3 * nx] -
-                             9.0 * u[pp + 4 * nx]) *
-                            idy_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                DyDyu[IDX(i, 4, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 5.0 * u[IDX(i, 5, k)] +
-                     4.0 * u[IDX(i, 6, k)] - u[IDX(i, 7, k)]) *
-                    idy_sqrd;
-
-                // This is a centered second order stencil.
-                DyDyu[IDX(i, 5, k)] = (u[IDX(i, 4, k)] - 2.0 * u[IDX(i, 5, k)] +
-                                       u[IDX(i, 6, k)]) *
-                                      idy_sqrd;
-
-                // This is a centered fourth order stencil.
-                DyDyu[IDX(i, 6, k)] =
-                    (-u[IDX(i, 4, k)] + 16.0 * u[IDX(i, 5, k)] -
-                     30.0 * u[IDX(i, 6, k)] + 16.0 * u[IDX(i, 7, k)] -
-                     u[IDX(i, 8, k)]) *
-                    idy_sqrd_by_12;
-
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, 7, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 27.0 * u[IDX(i, 5, k)] +
-                     270.0 * u[IDX(i, 6, k)] - 490.0 * u[IDX(i, 7, k)] +
-                     270.0 * u[IDX(i, 8, k)] - 27.0 * u[IDX(i, 9, k)] +
-                     2.0 * u[IDX(i, 10, k)]) *
-                    idy_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, je - 4, k)] =
-                    (2.0 * u[IDX(i, je - 7, k)] - 27.0 * u[IDX(i, je - 6, k)] +
-                     270.0 * u[IDX(i, je - 5, k)] -
-                     490.0 * u[IDX(i, je - 4, k)] +
-                     270.0 * u[IDX(i, je - 3, k)] -
-                     27.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a centered fourth order stencil.
-                DyDyu[IDX(i, je - 3, k)] =
-                    (-u[IDX(i, je - 5, k)] + 16.0 * u[IDX(i, je - 4, k)] -
-                     30.0 * u[IDX(i, je - 3, k)] + 16.0 * u[IDX(i, je - 2, k)] -
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 3, k)] - 2.0 * u[IDX(i, je - 2, k)] +
-                     u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DyDyu[IDX(i, je - 1, k)] =
-                    (-u[IDX(i, je - 4, k)] + 4.0 * u[IDX(i, je - 3, k)] -
-                     5.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642_zz(double *const DzDzu, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-    const double idz_sqrd_by_180 = idz_sqrd / 180.0;
-    const double idz_sqrd_by_5040 = idz_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-
-                DzDzu[pp] = (-9.0 * u[pp - 4 * n] + 128.0 * u[pp - 3 * n] -
-                             1008.0 * u[pp - 2 * n] + 8064.0 * u[pp - n] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + n] -
-                             1008.0 * u[pp + 2 * n] + 128.0 * u[pp + 3 * n] -
-                             9.0 * u[pp + 4 * n]) *
-                            idz_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted second order stencil.
-                DzDzu[IDX(i, j, 4)] =
-                    (2.0 * u[IDX(i, j, 4)] - 5.0 * u[IDX(i, j, 5)] +
-                     4.0 * u[IDX(i, j, 6)] - u[IDX(i, j, 7)]) *
-                    idz_sqrd;
-
-                // This is a centered second order stencil.
-                DzDzu[IDX(i, j, 5)] = (u[IDX(i, j, 4)] - 2.0 * u[IDX(i, j, 5)] +
-                                       u[IDX(i, j, 6)]) *
-                                      idz_sqrd;
-
-                // This is a centered fourth order stencil.
-                DzDzu[IDX(i, j, 6)] =
-                    (-u[IDX(i, j, 4)] + 16.0 * u[IDX(i, j, 5)] -
-                     30.0 * u[IDX(i, j, 6)] + 16.0 * u[IDX(i, j, 7)] -
-                     u[IDX(i, j, 8)]) *
-                    idz_sqrd_by_12;
-
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, 7)] =
-                    (2.0 * u[IDX(i, j, 4)] - 27.0 * u[IDX(i, j, 5)] +
-                     270.0 * u[IDX(i, j, 6)] - 490.0 * u[IDX(i, j, 7)] +
-                     270.0 * u[IDX(i, j, 8)] - 27.0 * u[IDX(i, j, 9)] +
-                     2.0 * u[IDX(i, j, 10)]) *
-                    idz_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, ke - 4)] =
-                    (2.0 * u[IDX(i, j, ke - 7)] - 27.0 * u[IDX(i, j, ke - 6)] +
-                     270.0 * u[IDX(i, j, ke - 5)] -
-                     490.0 * u[IDX(i, j, ke - 4)] +
-                     270.0 * u[IDX(i, j, ke - 3)] -
-                     27.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // This is a centered fourth order stencil.
-                DzDzu[IDX(i, j, ke - 3)] =
-                    (-u[IDX(i, j, ke - 5)] + 16.0 * u[IDX(i, j, ke - 4)] -
-                     30.0 * u[IDX(i, j, ke - 3)] + 16.0 * u[IDX(i, j, ke - 2)] -
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_12;
-
-                // This is a centered second order stencil.
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 3)] - 2.0 * u[IDX(i, j, ke - 2)] +
-                     u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-
-                // This is a (totally) shifted second order stencil.
-                DzDzu[IDX(i, j, ke - 1)] =
-                    (-u[IDX(i, j, ke - 4)] + 4.0 * u[IDX(i, j, ke - 3)] -
-                     5.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642adv_x(double *const Dxu, const double *const u, const double dx,
-                    const unsigned int *sz, const double *const betax,
-                    unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv8642_x(Dxu, u, dx, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642adv_y(double *const Dyu, const double *const u, const double dy,
-                    const unsigned int *sz, const double *const betay,
-                    unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv8642_y(Dyu, u, dy, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8642adv_z(double *const Dzu, const double *const u, const double dz,
-                    const unsigned int *sz, const double *const betaz,
-                    unsigned bflag) {
-    // hardcoded for not to use adv derivs,
-    deriv8642_z(Dzu, u, dz, sz, bflag);
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8664_x(double *const Dxu, const double *const u, const double dx,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-    const double idx_by_2520 = idx / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                Dxu[pp] =
-                    (9.0 * u[pp - 4] - 96.0 * u[pp - 3] + 504.0 * u[pp - 2] -
-                     2016.0 * u[pp - 1] + 2016.0 * u[pp + 1] -
-                     504.0 * u[pp + 2] + 96.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted fourth order stencil.
-                Dxu[IDX(4, j, k)] =
-                    (-25.0 * u[IDX(4, j, k)] + 48.0 * u[IDX(5, j, k)] -
-                     36.0 * u[IDX(6, j, k)] + 16.0 * u[IDX(7, j, k)] -
-                     3.0 * u[IDX(8, j, k)]) *
-                    idx_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dxu[IDX(5, j, k)] =
-                    (-3.0 * u[IDX(4, j, k)] - 10.0 * u[IDX(5, j, k)] +
-                     18.0 * u[IDX(6, j, k)] - 6.0 * u[IDX(7, j, k)] +
-                     u[IDX(8, j, k)]) *
-                    idx_by_12;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(6, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 24.0 * u[IDX(5, j, k)] -
-                     35.0 * u[IDX(6, j, k)] + 80.0 * u[IDX(7, j, k)] -
-                     30.0 * u[IDX(8, j, k)] + 8.0 * u[IDX(9, j, k)] -
-                     u[IDX(10, j, k)]) *
-                    idx_by_60;
-
-                // This is a centered sixth order stencil.
-                Dxu[IDX(7, j, k)] =
-                    (-u[IDX(4, j, k)] + 9.0 * u[IDX(5, j, k)] -
-                     45.0 * u[IDX(6, j, k)] + 45.0 * u[IDX(8, j, k)] -
-                     9.0 * u[IDX(9, j, k)] + u[IDX(10, j, k)]) *
-                    idx_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                Dxu[IDX(ie - 4, j, k)] =
-                    (-u[IDX(ie - 7, j, k)] + 9.0 * u[IDX(ie - 6, j, k)] -
-                     45.0 * u[IDX(ie - 5, j, k)] + 45.0 * u[IDX(ie - 3, j, k)] -
-                     9.0 * u[IDX(ie - 2, j, k)] + u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 7, j, k)] - 8.0 * u[IDX(ie - 6, j, k)] +
-                     30.0 * u[IDX(ie - 5, j, k)] - 80.0 * u[IDX(ie - 4, j, k)] +
-                     35.0 * u[IDX(ie - 3, j, k)] + 24.0 * u[IDX(ie - 2, j, k)] -
-                     2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-u[IDX(ie - 5, j, k)] + 6.0 * u[IDX(ie - 4, j, k)] -
-                     18.0 * u[IDX(ie - 3, j, k)] + 10.0 * u[IDX(ie - 2, j, k)] +
-                     3.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-
-                // This is a (totally) shifted fourth order stencil.
-                Dxu[IDX(ie - 1, j, k)] =
-                    (3.0 * u[IDX(ie - 5, j, k)] - 16.0 * u[IDX(ie - 4, j, k)] +
-                     36.0 * u[IDX(ie - 3, j, k)] - 48.0 * u[IDX(ie - 2, j, k)] +
-                     25.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8664_y(double *const Dyu, const double *const u, const double dy,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.5 * idy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-    const double idy_by_2520 = idy / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 0;
-
-    const int n = nx;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                Dyu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idy_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted fourth order stencil.
-                Dyu[IDX(i, 4, k)] =
-                    (-25.0 * u[IDX(i, 4, k)] + 48.0 * u[IDX(i, 5, k)] -
-                     36.0 * u[IDX(i, 6, k)] + 16.0 * u[IDX(i, 7, k)] -
-                     3.0 * u[IDX(i, 8, k)]) *
-                    idy_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dyu[IDX(i, 5, k)] =
-                    (-3.0 * u[IDX(i, 4, k)] - 10.0 * u[IDX(i, 5, k)] +
-                     18.0 * u[IDX(i, 6, k)] - 6.0 * u[IDX(i, 7, k)] +
-                     u[IDX(i, 8, k)]) *
-                    idy_by_12;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, 6, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 24.0 * u[IDX(i, 5, k)] -
-                     35.0 * u[IDX(i, 6, k)] + 80.0 * u[IDX(i, 7, k)] -
-                     30.0 * u[IDX(i, 8, k)] + 8.0 * u[IDX(i, 9, k)] -
-                     u[IDX(i, 10, k)]) *
-                    idy_by_60;
-
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, 7, k)] =
-                    (-u[IDX(i, 4, k)] + 9.0 * u[IDX(i, 5, k)] -
-                     45.0 * u[IDX(i, 6, k)] + 45.0 * u[IDX(i, 8, k)] -
-                     9.0 * u[IDX(i, 9, k)] + u[IDX(i, 10, k)]) *
-                    idy_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, je - 4, k)] =
-                    (-u[IDX(i, je - 7, k)] + 9.0 * u[IDX(i, je - 6, k)] -
-                     45.0 * u[IDX(i, je - 5, k)] + 45.0 * u[IDX(i, je - 3, k)] -
-                     9.0 * u[IDX(i, je - 2, k)] + u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 7, k)] - 8.0 * u[IDX(i, je - 6, k)] +
-                     30.0 * u[IDX(i, je - 5, k)] - 80.0 * u[IDX(i, je - 4, k)] +
-                     35.0 * u[IDX(i, je - 3, k)] + 24.0 * u[IDX(i, je - 2, k)] -
-                     2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dyu[IDX(i, je - 2, k)] =
-                    (-u[IDX(i, je - 5, k)] + 6.0 * u[IDX(i, je - 4, k)] -
-                     18.0 * u[IDX(i, je - 3, k)] + 10.0 * u[IDX(i, je - 2, k)] +
-                     3.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-
-                // This is a (totally) shifted fourth order stencil.
-                Dyu[IDX(i, je - 1, k)] =
-                    (3.0 * u[IDX(i, je - 5, k)] - 16.0 * u[IDX(i, je - 4, k)] +
-                     36.0 * u[IDX(i, je - 3, k)] - 48.0 * u[IDX(i, je - 2, k)] +
-                     25.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8664_z(double *const Dzu, const double *const u, const double dz,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.5 * idz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-    const double idz_by_2520 = idz / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-
-                Dzu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idz_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted fourth order stencil.
-                Dzu[IDX(i, j, 4)] =
-                    (-25.0 * u[IDX(i, j, 4)] + 48.0 * u[IDX(i, j, 5)] -
-                     36.0 * u[IDX(i, j, 6)] + 16.0 * u[IDX(i, j, 7)] -
-                     3.0 * u[IDX(i, j, 8)]) *
-                    idz_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dzu[IDX(i, j, 5)] =
-                    (-3.0 * u[IDX(i, j, 4)] - 10.0 * u[IDX(i, j, 5)] +
-                     18.0 * u[IDX(i, j, 6)] - 6.0 * u[IDX(i, j, 7)] +
-                     u[IDX(i, j, 8)]) *
-                    idz_by_12;
-
-                // This is a shifted sixth order stencil.
-                Dzu[IDX(i, j, 6)] =
-                    (2.0 * u[IDX(i, j, 4)] - 24.0 * u[IDX(i, j, 5)] -
-                     35.0 * u[IDX(i, j, 6)] + 80.0 * u[IDX(i, j, 7)] -
-                     30.0 * u[IDX(i, j, 8)] + 8.0 * u[IDX(i, j, 9)] -
-                     u[IDX(i, j, 10)]) *
-                    idz_by_60;
-
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, 7)] =
-                    (-u[IDX(i, j, 4)] + 9.0 * u[IDX(i, j, 5)] -
-                     45.0 * u[IDX(i, j, 6)] + 45.0 * u[IDX(i, j, 8)] -
-                     9.0 * u[IDX(i, j, 9)] + u[IDX(i, j, 10)]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, ke - 4)] =
-                    (-u[IDX(i, j, ke - 7)] + 9.0 * u[IDX(i, j, ke - 6)] -
-                     45.0 * u[IDX(i, j, ke - 5)] + 45.0 * u[IDX(i, j, ke - 3)] -
-                     9.0 * u[IDX(i, j, ke - 2)] + u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 7)] - 8.0 * u[IDX(i, j, ke - 6)] +
-                     30.0 * u[IDX(i, j, ke - 5)] - 80.0 * u[IDX(i, j, ke - 4)] +
-                     35.0 * u[IDX(i, j, ke - 3)] + 24.0 * u[IDX(i, j, ke - 2)] -
-                     2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a (partially) shifted fourth order stencil.
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-u[IDX(i, j, ke - 5)] + 6.0 * u[IDX(i, j, ke - 4)] -
-                     18.0 * u[IDX(i, j, ke - 3)] + 10.0 * u[IDX(i, j, ke - 2)] +
-                     3.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-
-                // This is a (totally) shifted fourth order stencil.
-                Dzu[IDX(i, j, ke - 1)] =
-                    (3.0 * u[IDX(i, j, ke - 5)] - 16.0 * u[IDX(i, j, ke - 4)] +
-                     36.0 * u[IDX(i, j, ke - 3)] - 48.0 * u[IDX(i, j, ke - 2)] +
-                     25.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
-}
-
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8664_xx(double *const DxDxu, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-    const double idx_sqrd_by_180 = idx_sqrd / 180.0;
-    const double idx_sqrd_by_5040 = idx_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                DxDxu[pp] =
-                    (-9.0 * u[pp - 4] + 128.0 * u[pp - 3] - 1008.0 * u[pp - 2] +
-                     8064.0 * u[pp - 1] - 14350.0 * u[pp] + 8064.0 * u[pp + 1] -
-                     1008.0 * u[pp + 2] + 128.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted fourth order stencil.
-                DxDxu[IDX(4, j, k)] =
-                    (45.0 * u[IDX(4, j, k)] - 154.0 * u[IDX(5, j, k)] +
-                     214.0 * u[IDX(6, j, k)] - 156.0 * u[IDX(7, j, k)] +
-                     61.0 * u[IDX(8, j, k)] - 10.0 * u[IDX(9, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                DxDxu[IDX(5, j, k)] =
-                    (10.0 * u[IDX(4, j, k)] - 15.0 * u[IDX(5, j, k)] -
-                     4.0 * u[IDX(6, j, k)] + 14.0 * u[IDX(7, j, k)] -
-                     6.0 * u[IDX(8, j, k)] + u[IDX(9, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // This is a shifted sixth order stencil.
-                DxDxu[IDX(6, j, k)] =
-                    (-11.0 * u[IDX(4, j, k)] + 214.0 * u[IDX(5, j, k)] -
-                     378.0 * u[IDX(6, j, k)] + 130.0 * u[IDX(7, j, k)] +
-                     85.0 * u[IDX(8, j, k)] - 54.0 * u[IDX(9, j, k)] +
-                     16.0 * u[IDX(10, j, k)] - 2.0 * u[IDX(11, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(7, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 27.0 * u[IDX(5, j, k)] +
-                     270.0 * u[IDX(6, j, k)] - 490.0 * u[IDX(7, j, k)] +
-                     270.0 * u[IDX(8, j, k)] - 27.0 * u[IDX(9, j, k)] +
-                     2.0 * u[IDX(10, j, k)]) *
-                    idx_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(ie - 4, j, k)] =
-                    (2.0 * u[IDX(ie - 7, j, k)] - 27.0 * u[IDX(ie - 6, j, k)] +
-                     270.0 * u[IDX(ie - 5, j, k)] -
-                     490.0 * u[IDX(ie - 4, j, k)] +
-                     270.0 * u[IDX(ie - 3, j, k)] -
-                     27.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DxDxu[IDX(ie - 3, j, k)] =
-                    (-2.0 * u[IDX(ie - 8, j, k)] + 16.0 * u[IDX(ie - 7, j, k)] -
-                     54.0 * u[IDX(ie - 6, j, k)] + 85.0 * u[IDX(ie - 5, j, k)] +
-                     130.0 * u[IDX(ie - 4, j, k)] -
-                     378.0 * u[IDX(ie - 3, j, k)] +
-                     214.0 * u[IDX(ie - 2, j, k)] -
-                     11.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a (partially) shifted fourth order stencil.
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (u[IDX(ie - 6, j, k)] - 6.0 * u[IDX(ie - 5, j, k)] +
-                     14.0 * u[IDX(ie - 4, j, k)] - 4.0 * u[IDX(ie - 3, j, k)] -
-                     15.0 * u[IDX(ie - 2, j, k)] +
-                     10.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_12;
-
-                // XThis is a (totally) shifted fourth order stencil.
-                DxDxu[IDX(ie - 1, j, k)] = (-10.0 * u[IDX(ie - 6, j, k)] +
-                                            61.0 * u[IDX(ie - 5, j, k)] -
-                                            156.0 * u[IDX(ie - 4, j, k)] +
-                                            214.0 * u[IDX(ie - 3, j, k)] -
-                                            154.0 * u[IDX(ie - 2, j, k)] +
-                                            45.0 * u[IDX(ie - 1, j, k)]) *
-                                           idx_sqrd_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv644adv_x(double *const Dxu, const double *const u, const double dx,
+                   const unsigned int *sz, const double *const betax,
+                   unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv644_x(Dxu, u, dx, sz, bflag);
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8664_yy(double *const DyDyu, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-    const double idy_sqrd_by_180 = idy_sqrd / 180.0;
-    const double idy_sqrd_by_5040 = idy_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                DyDyu[pp] = (-9.0 * u[pp - 4 * nx] + 128.0 * u[pp - 3 * nx] -
-                             1008.0 * u[pp - 2 * nx] + 8064.0 * u[pp - nx] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + nx] -
-                             1008.0 * u[pp + 2 * nx] + 128.0 * u[pp + 3 * nx] -
-                             9.0 * u[pp + 4 * nx]) *
-                            idy_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted fourth order stencil.
-                DyDyu[IDX(i, 4, k)] =
-                    (45.0 * u[IDX(i, 4, k)] - 154.0 * u[IDX(i, 5, k)] +
-                     214.0 * u[IDX(i, 6, k)] - 156.0 * u[IDX(i, 7, k)] +
-                     61.0 * u[IDX(i, 8, k)] - 10.0 * u[IDX(i, 9, k)]) *
-                    idy_sqrd_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                DyDyu[IDX(i, 5, k)] =
-                    (10.0 * u[IDX(i, 4, k)] - 15.0 * u[IDX(i, 5, k)] -
-                     4.0 * u[IDX(i, 6, k)] + 14.0 * u[IDX(i, 7, k)] -
-                     6.0 * u[IDX(i, 8, k)] + u[IDX(i, 9, k)]) *
-                    idy_sqrd_by_12;
-
-                // This is a shifted sixth order stencil.
-                DyDyu[IDX(i, 6, k)] =
-                    (-11.0 * u[IDX(i, 4, k)] + 214.0 * u[IDX(i, 5, k)] -
-                     378.0 * u[IDX(i, 6, k)] + 130.0 * u[IDX(i, 7, k)] +
-                     85.0 * u[IDX(i, 8, k)] - 54.0 * u[IDX(i, 9, k)] +
-                     16.0 * u[IDX(i, 10, k)] - 2.0 * u[IDX(i, 11, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, 7, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 27.0 * u[IDX(i, 5, k)] +
-                     270.0 * u[IDX(i, 6, k)] - 490.0 * u[IDX(i, 7, k)] +
-                     270.0 * u[IDX(i, 8, k)] - 27.0 * u[IDX(i, 9, k)] +
-                     2.0 * u[IDX(i, 10, k)]) *
-                    idy_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, je - 4, k)] =
-                    (2.0 * u[IDX(i, je - 7, k)] - 27.0 * u[IDX(i, je - 6, k)] +
-                     270.0 * u[IDX(i, je - 5, k)] -
-                     490.0 * u[IDX(i, je - 4, k)] +
-                     270.0 * u[IDX(i, je - 3, k)] -
-                     27.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DyDyu[IDX(i, je - 3, k)] =
-                    (-2.0 * u[IDX(i, je - 8, k)] + 16.0 * u[IDX(i, je - 7, k)] -
-                     54.0 * u[IDX(i, je - 6, k)] + 85.0 * u[IDX(i, je - 5, k)] +
-                     130.0 * u[IDX(i, je - 4, k)] -
-                     378.0 * u[IDX(i, je - 3, k)] +
-                     214.0 * u[IDX(i, je - 2, k)] -
-                     11.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a (partially) shifted fourth order stencil.
-                DyDyu[IDX(i, je - 2, k)] =
-                    (u[IDX(i, je - 6, k)] - 6.0 * u[IDX(i, je - 5, k)] +
-                     14.0 * u[IDX(i, je - 4, k)] - 4.0 * u[IDX(i, je - 3, k)] -
-                     15.0 * u[IDX(i, je - 2, k)] +
-                     10.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_12;
-
-                // XThis is a (totally) shifted fourth order stencil.
-                DyDyu[IDX(i, je - 1, k)] = (-10.0 * u[IDX(i, je - 6, k)] +
-                                            61.0 * u[IDX(i, je - 5, k)] -
-                                            156.0 * u[IDX(i, je - 4, k)] +
-                                            254.0 * u[IDX(i, je - 3, k)] -
-                                            154.0 * u[IDX(i, je - 2, k)] +
-                                            45.0 * u[IDX(i, je - 1, k)]) *
-                                           idy_sqrd_by_12;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+/*----------------------------------------------------------------------;
+ *
+ *
+ *
+ *----------------------------------------------------------------------*/
+void deriv644adv_y(double *const Dyu, const double *const u, const double dy,
+                   const unsigned int *sz, const double *const betay,
+                   unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv644_y(Dyu, u, dy, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -7684,149 +1474,47 @@ void deriv8664_yy(double *const DyDyu, const double *const u, const double dy,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8664_zz(double *const DzDzu, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-    const double idz_sqrd_by_180 = idz_sqrd / 180.0;
-    const double idz_sqrd_by_5040 = idz_sqrd / 5040.0;
+void deriv644adv_z(double *const Dzu, const double *const u, const double dz,
+                   const unsigned int *sz, const double *const betaz,
+                   unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv644_z(Dzu, u, dz, sz, bflag);
+}
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
+void deriv642_x(double *const Dxu, const double *const u, const double dx,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_642, 0, 3>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    const int n = nx * ny;
+void deriv642_y(double *const Dyu, const double *const u, const double dy,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_642, 1, 3>(
+        Dyu, u, dy, sz, bflag);
+}
 
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-                DzDzu[pp] = (-9.0 * u[pp - 4 * n] + 128.0 * u[pp - 3 * n] -
-                             1008.0 * u[pp - 2 * n] + 8064.0 * u[pp - n] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + n] -
-                             1008.0 * u[pp + 2 * n] + 128.0 * u[pp + 3 * n] -
-                             9.0 * u[pp + 4 * n]) *
-                            idz_sqrd_by_5040;
-            }
-        }
-    }
+void deriv642_z(double *const Dzu, const double *const u, const double dz,
+                const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_642, 2, 3>(
+        Dzu, u, dz, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted fourth order stencil.
-                DzDzu[IDX(i, j, 4)] =
-                    (45.0 * u[IDX(i, j, 4)] - 154.0 * u[IDX(i, j, 5)] +
-                     214.0 * u[IDX(i, j, 6)] - 156.0 * u[IDX(i, j, 7)] +
-                     61.0 * u[IDX(i, j, 8)] - 10.0 * u[IDX(i, j, 9)]) *
-                    idz_sqrd_by_12;
-
-                // This is a (partially) shifted fourth order stencil.
-                DzDzu[IDX(i, j, 5)] =
-                    (10.0 * u[IDX(i, j, 4)] - 15.0 * u[IDX(i, j, 5)] -
-                     4.0 * u[IDX(i, j, 6)] + 14.0 * u[IDX(i, j, 7)] -
-                     6.0 * u[IDX(i, j, 8)] + u[IDX(i, j, 9)]) *
-                    idz_sqrd_by_12;
-
-                // This is a shifted sixth order stencil.
-                DzDzu[IDX(i, j, 6)] =
-                    (-11.0 * u[IDX(i, j, 4)] + 214.0 * u[IDX(i, j, 5)] -
-                     378.0 * u[IDX(i, j, 6)] + 130.0 * u[IDX(i, j, 7)] +
-                     85.0 * u[IDX(i, j, 8)] - 54.0 * u[IDX(i, j, 9)] +
-                     16.0 * u[IDX(i, j, 10)] - 2.0 * u[IDX(i, j, 11)]) *
-                    idz_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, 7)] =
-                    (2.0 * u[IDX(i, j, 4)] - 27.0 * u[IDX(i, j, 5)] +
-                     270.0 * u[IDX(i, j, 6)] - 490.0 * u[IDX(i, j, 7)] +
-                     270.0 * u[IDX(i, j, 8)] - 27.0 * u[IDX(i, j, 9)] +
-                     2.0 * u[IDX(i, j, 10)]) *
-                    idz_sqrd_by_180;
-            }
-        }
-    }
+void deriv642_xx(double *const DxDxu, const double *const u, const double dx,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_642, 0, 3>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, ke - 4)] =
-                    (2.0 * u[IDX(i, j, ke - 7)] - 27.0 * u[IDX(i, j, ke - 6)] +
-                     270.0 * u[IDX(i, j, ke - 5)] -
-                     490.0 * u[IDX(i, j, ke - 4)] +
-                     270.0 * u[IDX(i, j, ke - 3)] -
-                     27.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DzDzu[IDX(i, j, ke - 3)] =
-                    (-2.0 * u[IDX(i, j, ke - 8)] + 16.0 * u[IDX(i, j, ke - 7)] -
-                     54.0 * u[IDX(i, j, ke - 6)] + 85.0 * u[IDX(i, j, ke - 5)] +
-                     130.0 * u[IDX(i, j, ke - 4)] -
-                     378.0 * u[IDX(i, j, ke - 3)] +
-                     214.0 * u[IDX(i, j, ke - 2)] -
-                     11.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // This is a (partially) shifted fourth order stencil.
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (u[IDX(i, j, ke - 6)] - 6.0 * u[IDX(i, j, ke - 5)] +
-                     14.0 * u[IDX(i, j, ke - 4)] - 4.0 * u[IDX(i, j, ke - 3)] -
-                     15.0 * u[IDX(i, j, ke - 2)] +
-                     10.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_12;
-
-                // XThis is a (totally) shifted fourth order stencil.
-                DzDzu[IDX(i, j, ke - 1)] = (-10.0 * u[IDX(i, j, ke - 6)] +
-                                            61.0 * u[IDX(i, j, ke - 5)] -
-                                            156.0 * u[IDX(i, j, ke - 4)] +
-                                            214.0 * u[IDX(i, j, ke - 3)] -
-                                            154.0 * u[IDX(i, j, ke - 2)] +
-                                            45.0 * u[IDX(i, j, ke - 1)]) *
-                                           idz_sqrd_by_12;
-            }
-        }
-    }
+void deriv642_yy(double *const DyDyu, const double *const u, const double dy,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_642, 1, 3>(
+        DyDyu, u, dy, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv642_zz(double *const DzDzu, const double *const u, const double dz,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_642, 2, 3>(
+        DzDzu, u, dz, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -7834,11 +1522,11 @@ void deriv8664_zz(double *const DzDzu, const double *const u, const double dz,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8664adv_x(double *const Dxu, const double *const u, const double dx,
-                    const unsigned int *sz, const double *const betax,
-                    unsigned bflag) {
+void deriv642adv_x(double *const Dxu, const double *const u, const double dx,
+                   const unsigned int *sz, const double *const betax,
+                   unsigned bflag) {
     // hardcoded for not to use adv derivs,
-    deriv8664_x(Dxu, u, dx, sz, bflag);
+    deriv642_x(Dxu, u, dx, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -7846,11 +1534,11 @@ void deriv8664adv_x(double *const Dxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8664adv_y(double *const Dyu, const double *const u, const double dy,
-                    const unsigned int *sz, const double *const betay,
-                    unsigned bflag) {
+void deriv642adv_y(double *const Dyu, const double *const u, const double dy,
+                   const unsigned int *sz, const double *const betay,
+                   unsigned bflag) {
     // hardcoded for not to use adv derivs,
-    deriv8664_y(Dyu, u, dy, sz, bflag);
+    deriv642_y(Dyu, u, dy, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -7858,313 +1546,95 @@ void deriv8664adv_y(double *const Dyu, const double *const u, const double dy,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8664adv_z(double *const Dzu, const double *const u, const double dz,
-                    const unsigned int *sz, const double *const betaz,
-                    unsigned bflag) {
+void deriv642adv_z(double *const Dzu, const double *const u, const double dz,
+                   const unsigned int *sz, const double *const betaz,
+                   unsigned bflag) {
     // hardcoded for not to use adv derivs,
-    deriv8664_z(Dzu, u, dz, sz, bflag);
+    deriv642_z(Dzu, u, dz, sz, bflag);
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8666_x(double *const Dxu, const double *const u, const double dx,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idx = 1.0 / dx;
-    const double idx_by_2 = 0.5 * idx;
-    const double idx_by_12 = idx / 12.0;
-    const double idx_by_60 = idx / 60.0;
-    const double idx_by_2520 = idx / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 0;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 0;
-    const int ke = sz[2] - 0;
-
-    const int n = 1;
-
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-
-                Dxu[pp] =
-                    (9.0 * u[pp - 4] - 96.0 * u[pp - 3] + 504.0 * u[pp - 2] -
-                     2016.0 * u[pp - 1] + 2016.0 * u[pp + 1] -
-                     504.0 * u[pp + 2] + 96.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted sixth order stencil.
-                Dxu[IDX(4, j, k)] =
-                    (-147.0 * u[IDX(4, j, k)] + 360.0 * u[IDX(5, j, k)] -
-                     450.0 * u[IDX(6, j, k)] + 400.0 * u[IDX(7, j, k)] -
-                     225.0 * u[IDX(8, j, k)] + 72.0 * u[IDX(9, j, k)] -
-                     10.0 * u[IDX(10, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(5, j, k)] =
-                    (-10.0 * u[IDX(4, j, k)] - 77.0 * u[IDX(5, j, k)] +
-                     150.0 * u[IDX(6, j, k)] - 100.0 * u[IDX(7, j, k)] +
-                     50.0 * u[IDX(8, j, k)] - 15.0 * u[IDX(9, j, k)] +
-                     2.0 * u[IDX(10, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(6, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 24.0 * u[IDX(5, j, k)] -
-                     35.0 * u[IDX(6, j, k)] + 80.0 * u[IDX(7, j, k)] -
-                     30.0 * u[IDX(8, j, k)] + 8.0 * u[IDX(9, j, k)] -
-                     u[IDX(10, j, k)]) *
-                    idx_by_60;
-
-                // This is a centered sixth order stencil.
-                Dxu[IDX(7, j, k)] =
-                    (-u[IDX(4, j, k)] + 9.0 * u[IDX(5, j, k)] -
-                     45.0 * u[IDX(6, j, k)] + 45.0 * u[IDX(8, j, k)] -
-                     9.0 * u[IDX(9, j, k)] + u[IDX(10, j, k)]) *
-                    idx_by_60;
-            }
-        }
+void deriv8642_x_wrapper(double *const Dxu, const double *const u,
+                         const double dx, const unsigned int *sz,
+                         unsigned bflag, const unsigned pw) {
+    if (pw == 4) {
+        deriv8642_x(Dxu, u, dx, sz, bflag);
+    } else {
+        throw std::runtime_error(
+            "X Derivative cannot be computed for a padding width that differs "
+            "from 4!");
     }
+}
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                Dxu[IDX(ie - 4, j, k)] =
-                    (-u[IDX(ie - 7, j, k)] + 9.0 * u[IDX(ie - 6, j, k)] -
-                     45.0 * u[IDX(ie - 5, j, k)] + 45.0 * u[IDX(ie - 3, j, k)] -
-                     9.0 * u[IDX(ie - 2, j, k)] + u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(ie - 3, j, k)] =
-                    (u[IDX(ie - 7, j, k)] - 8.0 * u[IDX(ie - 6, j, k)] +
-                     30.0 * u[IDX(ie - 5, j, k)] - 80.0 * u[IDX(ie - 4, j, k)] +
-                     35.0 * u[IDX(ie - 3, j, k)] + 24.0 * u[IDX(ie - 2, j, k)] -
-                     2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(ie - 2, j, k)] =
-                    (-2.0 * u[IDX(ie - 7, j, k)] + 15.0 * u[IDX(ie - 6, j, k)] -
-                     50.0 * u[IDX(ie - 5, j, k)] +
-                     100.0 * u[IDX(ie - 4, j, k)] -
-                     150.0 * u[IDX(ie - 3, j, k)] +
-                     77.0 * u[IDX(ie - 2, j, k)] +
-                     10.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dxu[IDX(ie - 1, j, k)] =
-                    (10.0 * u[IDX(ie - 7, j, k)] - 72.0 * u[IDX(ie - 6, j, k)] +
-                     225.0 * u[IDX(ie - 5, j, k)] -
-                     400.0 * u[IDX(ie - 4, j, k)] +
-                     450.0 * u[IDX(ie - 3, j, k)] -
-                     360.0 * u[IDX(ie - 2, j, k)] +
-                     147.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_by_60;
-            }
-        }
+void deriv8642_y_wrapper(double *const Dyu, const double *const u,
+                         const double dy, const unsigned int *sz,
+                         unsigned bflag, const unsigned pw) {
+    if (pw == 4) {
+        deriv8642_y(Dyu, u, dy, sz, bflag);
+    } else {
+        throw std::runtime_error(
+            "Y Derivative cannot be computed for a padding width that differs "
+            "from 4!");
     }
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < sz[2] - 4; k++) {
-        for (int j = jb; j < sz[1] - 4; j++) {
-            for (int i = ib; i < sz[0] - 4; i++) {
-                const int pp = IDX(i, j, k);
-                if (isnan(Dxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
+void deriv8642_z_wrapper(double *const Dzu, const double *const u,
+                         const double dz, const unsigned int *sz,
+                         unsigned bflag, const unsigned pw) {
+    if (pw == 4) {
+        deriv8642_z(Dzu, u, dz, sz, bflag);
+    } else {
+        throw std::runtime_error(
+            "Z Derivative cannot be computed for a padding width that differs "
+            "from 4!");
     }
-#endif
 }
 
-/*----------------------------------------------------------------------;
- *
- *
- *
- *----------------------------------------------------------------------*/
-void deriv8666_y(double *const Dyu, const double *const u, const double dy,
+void deriv8642_x(double *const Dxu, const double *const u, const double dx,
                  const unsigned int *sz, unsigned bflag) {
-    const double idy = 1.0 / dy;
-    const double idy_by_2 = 0.5 * idy;
-    const double idy_by_12 = idy / 12.0;
-    const double idy_by_60 = idy / 60.0;
-    const double idy_by_2520 = idy / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 0;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 0;
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8642, 0, 4>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    const int n = nx;
+void deriv8642_y(double *const Dyu, const double *const u, const double dy,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8642, 1, 4>(
+        Dyu, u, dy, sz, bflag);
+}
 
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
+void deriv8642_z(double *const Dzu, const double *const u, const double dz,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8642, 2, 4>(
+        Dzu, u, dz, sz, bflag);
+}
 
-                Dyu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idy_by_2520;
-            }
-        }
-    }
+void deriv8642_xx(double *const DxDxu, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8642, 0, 4>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted sixth order stencil.
-                Dyu[IDX(i, 4, k)] =
-                    (-147.0 * u[IDX(i, 4, k)] + 360.0 * u[IDX(i, 5, k)] -
-                     450.0 * u[IDX(i, 6, k)] + 400.0 * u[IDX(i, 7, k)] -
-                     225.0 * u[IDX(i, 8, k)] + 72.0 * u[IDX(i, 9, k)] -
-                     10.0 * u[IDX(i, 10, k)]) *
-                    idy_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, 5, k)] =
-                    (-10.0 * u[IDX(i, 4, k)] - 77.0 * u[IDX(i, 5, k)] +
-                     150.0 * u[IDX(i, 6, k)] - 100.0 * u[IDX(i, 7, k)] +
-                     50.0 * u[IDX(i, 8, k)] - 15.0 * u[IDX(i, 9, k)] +
-                     2.0 * u[IDX(i, 10, k)]) *
-                    idy_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, 6, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 24.0 * u[IDX(i, 5, k)] -
-                     35.0 * u[IDX(i, 6, k)] + 80.0 * u[IDX(i, 7, k)] -
-                     30.0 * u[IDX(i, 8, k)] + 8.0 * u[IDX(i, 9, k)] -
-                     u[IDX(i, 10, k)]) *
-                    idy_by_60;
-
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, 7, k)] =
-                    (-u[IDX(i, 4, k)] + 9.0 * u[IDX(i, 5, k)] -
-                     45.0 * u[IDX(i, 6, k)] + 45.0 * u[IDX(i, 8, k)] -
-                     9.0 * u[IDX(i, 9, k)] + u[IDX(i, 10, k)]) *
-                    idy_by_60;
-            }
-        }
-    }
+void deriv8642_yy(double *const DyDyu, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8642, 1, 4>(
+        DyDyu, u, dy, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dyu[IDX(i, je - 4, k)] =
-                    (-u[IDX(i, je - 7, k)] + 9.0 * u[IDX(i, je - 6, k)] -
-                     45.0 * u[IDX(i, je - 5, k)] + 45.0 * u[IDX(i, je - 3, k)] -
-                     9.0 * u[IDX(i, je - 2, k)] + u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, je - 3, k)] =
-                    (u[IDX(i, je - 7, k)] - 8.0 * u[IDX(i, je - 6, k)] +
-                     30.0 * u[IDX(i, je - 5, k)] - 80.0 * u[IDX(i, je - 4, k)] +
-                     35.0 * u[IDX(i, je - 3, k)] + 24.0 * u[IDX(i, je - 2, k)] -
-                     2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dyu[IDX(i, je - 2, k)] =
-                    (-2.0 * u[IDX(i, je - 7, k)] + 15.0 * u[IDX(i, je - 6, k)] -
-                     50.0 * u[IDX(i, je - 5, k)] +
-                     100.0 * u[IDX(i, je - 4, k)] -
-                     150.0 * u[IDX(i, je - 3, k)] +
-                     77.0 * u[IDX(i, je - 2, k)] +
-                     10.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_60;
-
-                // This is a (totally) shifted sixth order stencil.
-                Dyu[IDX(i, je - 1, k)] =
-                    (10.0 * u[IDX(i, je - 7, k)] - 72.0 * u[IDX(i, je - 6, k)] +
-                     225.0 * u[IDX(i, je - 5, k)] -
-                     400.0 * u[IDX(i, je - 4, k)] +
-                     450.0 * u[IDX(i, je - 3, k)] -
-                     360.0 * u[IDX(i, je - 2, k)] +
-                     147.0 * u[IDX(i, je - 1, k)]) *
-                    idy_by_12;
-            }
-        }
-    }
+void deriv8642_zz(double *const DzDzu, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8642, 2, 4>(
+        DzDzu, u, dz, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < sz[2] - 4; k++) {
-        for (int j = jb; j < sz[1] - 4; j++) {
-            for (int i = ib; i < sz[0] - 4; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+/*----------------------------------------------------------------------;
+ *
+ *
+ *
+ *----------------------------------------------------------------------*/
+void deriv8642adv_x(double *const Dxu, const double *const u, const double dx,
+                    const unsigned int *sz, const double *const betax,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8642_x(Dxu, u, dx, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -8172,150 +1642,11 @@ void deriv8666_y(double *const Dyu, const double *const u, const double dy,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8666_z(double *const Dzu, const double *const u, const double dz,
-                 const unsigned int *sz, unsigned bflag) {
-    const double idz = 1.0 / dz;
-    const double idz_by_2 = 0.5 * idz;
-    const double idz_by_12 = idz / 12.0;
-    const double idz_by_60 = idz / 60.0;
-    const double idz_by_2520 = idz / 2520.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    const int n = nx * ny;
-
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
-
-                Dzu[pp] = (9.0 * u[pp - 4 * n] - 96.0 * u[pp - 3 * n] +
-                           504.0 * u[pp - 2 * n] - 2016.0 * u[pp - n] +
-                           2016.0 * u[pp + n] - 504.0 * u[pp + 2 * n] +
-                           96.0 * u[pp + 3 * n] - 9.0 * u[pp + 4 * n]) *
-                          idz_by_2520;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted sixth order stencil.
-                Dzu[IDX(i, j, 4)] =
-                    (-147.0 * u[IDX(i, j, 4)] + 360.0 * u[IDX(i, j, 5)] -
-                     450.0 * u[IDX(i, j, 6)] + 400.0 * u[IDX(i, j, 7)] -
-                     225.0 * u[IDX(i, j, 8)] + 72.0 * u[IDX(i, j, 9)] -
-                     10.0 * u[IDX(i, j, 10)]) *
-                    idz_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dzu[IDX(i, j, 5)] =
-                    (-10.0 * u[IDX(i, j, 4)] - 77.0 * u[IDX(i, j, 5)] +
-                     150.0 * u[IDX(i, j, 6)] - 100.0 * u[IDX(i, j, 7)] +
-                     50.0 * u[IDX(i, j, 8)] - 15.0 * u[IDX(i, j, 9)] +
-                     2.0 * u[IDX(i, j, 10)]) *
-                    idz_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dzu[IDX(i, j, 6)] =
-                    (2.0 * u[IDX(i, j, 4)] - 24.0 * u[IDX(i, j, 5)] -
-                     35.0 * u[IDX(i, j, 6)] + 80.0 * u[IDX(i, j, 7)] -
-                     30.0 * u[IDX(i, j, 8)] + 8.0 * u[IDX(i, j, 9)] -
-                     u[IDX(i, j, 10)]) *
-                    idz_by_60;
-
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, 7)] =
-                    (-u[IDX(i, j, 4)] + 9.0 * u[IDX(i, j, 5)] -
-                     45.0 * u[IDX(i, j, 6)] + 45.0 * u[IDX(i, j, 8)] -
-                     9.0 * u[IDX(i, j, 9)] + u[IDX(i, j, 10)]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                Dzu[IDX(i, j, ke - 4)] =
-                    (-u[IDX(i, j, ke - 7)] + 9.0 * u[IDX(i, j, ke - 6)] -
-                     45.0 * u[IDX(i, j, ke - 5)] + 45.0 * u[IDX(i, j, ke - 3)] -
-                     9.0 * u[IDX(i, j, ke - 2)] + u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a shifted sixth order stencil.
-                Dzu[IDX(i, j, ke - 3)] =
-                    (u[IDX(i, j, ke - 7)] - 8.0 * u[IDX(i, j, ke - 6)] +
-                     30.0 * u[IDX(i, j, ke - 5)] - 80.0 * u[IDX(i, j, ke - 4)] +
-                     35.0 * u[IDX(i, j, ke - 3)] + 24.0 * u[IDX(i, j, ke - 2)] -
-                     2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a (partially) shifted sixth order stencil.
-                Dzu[IDX(i, j, ke - 2)] =
-                    (-2.0 * u[IDX(i, j, ke - 7)] + 15.0 * u[IDX(i, j, ke - 6)] -
-                     50.0 * u[IDX(i, j, ke - 5)] +
-                     100.0 * u[IDX(i, j, ke - 4)] -
-                     150.0 * u[IDX(i, j, ke - 3)] +
-                     77.0 * u[IDX(i, j, ke - 2)] +
-                     10.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-
-                // This is a (totally) shifted sixth order stencil.
-                Dzu[IDX(i, j, ke - 1)] =
-                    (10.0 * u[IDX(i, j, ke - 7)] - 72.0 * u[IDX(i, j, ke - 6)] +
-                     225.0 * u[IDX(i, j, ke - 5)] -
-                     400.0 * u[IDX(i, j, ke - 4)] +
-                     450.0 * u[IDX(i, j, ke - 3)] -
-                     360.0 * u[IDX(i, j, ke - 2)] +
-                     147.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_by_60;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < sz[2] - 4; k++) {
-        for (int j = jb; j < sz[1] - 4; j++) {
-            for (int i = ib; i < sz[0] - 4; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(Dzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv8642adv_y(double *const Dyu, const double *const u, const double dy,
+                    const unsigned int *sz, const double *const betay,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8642_y(Dyu, u, dy, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -8323,154 +1654,47 @@ void deriv8666_z(double *const Dzu, const double *const u, const double dz,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8666_xx(double *const DxDxu, const double *const u, const double dx,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idx_sqrd = 1.0 / (dx * dx);
-    const double idx_sqrd_by_12 = idx_sqrd / 12.0;
-    const double idx_sqrd_by_180 = idx_sqrd / 180.0;
-    const double idx_sqrd_by_5040 = idx_sqrd / 5040.0;
+void deriv8642adv_z(double *const Dzu, const double *const u, const double dz,
+                    const unsigned int *sz, const double *const betaz,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8642_z(Dzu, u, dz, sz, bflag);
+}
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
+void deriv8664_x(double *const Dxu, const double *const u, const double dx,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8664, 0, 4>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
+void deriv8664_y(double *const Dyu, const double *const u, const double dy,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8664, 1, 4>(
+        Dyu, u, dy, sz, bflag);
+}
 
-                DxDxu[pp] =
-                    (-9.0 * u[pp - 4] + 128.0 * u[pp - 3] - 1008.0 * u[pp - 2] +
-                     8064.0 * u[pp - 1] - 14350.0 * u[pp] + 8064.0 * u[pp + 1] -
-                     1008.0 * u[pp + 2] + 128.0 * u[pp + 3] - 9.0 * u[pp + 4]) *
-                    idx_sqrd_by_5040;
-            }
-        }
-    }
+void deriv8664_z(double *const Dzu, const double *const u, const double dz,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8664, 2, 4>(
+        Dzu, u, dz, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_LEFT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a (totally) shifted sixth order stencil.
-                DxDxu[IDX(4, j, k)] =
-                    (938.0 * u[IDX(4, j, k)] - 4014.0 * u[IDX(5, j, k)] +
-                     7911.0 * u[IDX(6, j, k)] - 9490.0 * u[IDX(7, j, k)] +
-                     7380.0 * u[IDX(8, j, k)] - 3618.0 * u[IDX(9, j, k)] +
-                     1019.0 * u[IDX(10, j, k)] - 126.0 * u[IDX(11, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DxDxu[IDX(5, j, k)] =
-                    (126.0 * u[IDX(4, j, k)] - 70.0 * u[IDX(5, j, k)] -
-                     486.0 * u[IDX(6, j, k)] + 855.0 * u[IDX(7, j, k)] -
-                     670.0 * u[IDX(8, j, k)] + 324.0 * u[IDX(9, j, k)] -
-                     90.0 * u[IDX(10, j, k)] + 11.0 * u[IDX(11, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DxDxu[IDX(6, j, k)] =
-                    (-11.0 * u[IDX(4, j, k)] + 214.0 * u[IDX(5, j, k)] -
-                     378.0 * u[IDX(6, j, k)] + 130.0 * u[IDX(7, j, k)] +
-                     85.0 * u[IDX(8, j, k)] - 54.0 * u[IDX(9, j, k)] +
-                     16.0 * u[IDX(10, j, k)] - 2.0 * u[IDX(11, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(7, j, k)] =
-                    (2.0 * u[IDX(4, j, k)] - 27.0 * u[IDX(5, j, k)] +
-                     270.0 * u[IDX(6, j, k)] - 490.0 * u[IDX(7, j, k)] +
-                     270.0 * u[IDX(8, j, k)] - 27.0 * u[IDX(9, j, k)] +
-                     2.0 * u[IDX(10, j, k)]) *
-                    idx_sqrd_by_180;
-            }
-        }
-    }
+void deriv8664_xx(double *const DxDxu, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8664, 0, 4>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_RIGHT)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                // This is a centered sixth order stencil.
-                DxDxu[IDX(ie - 4, j, k)] =
-                    (2.0 * u[IDX(ie - 7, j, k)] - 27.0 * u[IDX(ie - 6, j, k)] +
-                     270.0 * u[IDX(ie - 5, j, k)] -
-                     490.0 * u[IDX(ie - 4, j, k)] +
-                     270.0 * u[IDX(ie - 3, j, k)] -
-                     27.0 * u[IDX(ie - 2, j, k)] + 2.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DxDxu[IDX(ie - 3, j, k)] =
-                    (-2.0 * u[IDX(ie - 8, j, k)] + 16.0 * u[IDX(ie - 7, j, k)] -
-                     54.0 * u[IDX(ie - 6, j, k)] + 85.0 * u[IDX(ie - 5, j, k)] +
-                     130.0 * u[IDX(ie - 4, j, k)] -
-                     378.0 * u[IDX(ie - 3, j, k)] +
-                     214.0 * u[IDX(ie - 2, j, k)] -
-                     11.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DxDxu[IDX(ie - 2, j, k)] =
-                    (11.0 * u[IDX(ie - 8, j, k)] - 90.0 * u[IDX(ie - 7, j, k)] +
-                     324.0 * u[IDX(ie - 6, j, k)] -
-                     670.0 * u[IDX(ie - 5, j, k)] +
-                     855.0 * u[IDX(ie - 4, j, k)] -
-                     486.0 * u[IDX(ie - 3, j, k)] -
-                     70.0 * u[IDX(ie - 2, j, k)] +
-                     126.0 * u[IDX(ie - 1, j, k)]) *
-                    idx_sqrd_by_180;
-
-                // XThis is a (totally) shifted sixth order stencil.
-                DxDxu[IDX(ie - 1, j, k)] = (-126.0 * u[IDX(ie - 8, j, k)] +
-                                            1019.0 * u[IDX(ie - 7, j, k)] -
-                                            3618.0 * u[IDX(ie - 6, j, k)] +
-                                            7380.0 * u[IDX(ie - 5, j, k)] -
-                                            9490.0 * u[IDX(ie - 4, j, k)] +
-                                            7911.0 * u[IDX(ie - 3, j, k)] -
-                                            4014.0 * u[IDX(ie - 2, j, k)] +
-                                            938.0 * u[IDX(ie - 1, j, k)]) *
-                                           idx_sqrd_by_180;
-            }
-        }
-    }
+void deriv8664_yy(double *const DyDyu, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8664, 1, 4>(
+        DyDyu, u, dy, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DxDxu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv8664_zz(double *const DzDzu, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8664, 2, 4>(
+        DzDzu, u, dz, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -8478,155 +1702,11 @@ void deriv8666_xx(double *const DxDxu, const double *const u, const double dx,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8666_yy(double *const DyDyu, const double *const u, const double dy,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idy_sqrd = 1.0 / (dy * dy);
-    const double idy_sqrd_by_12 = idy_sqrd / 12.0;
-    const double idy_sqrd_by_180 = idy_sqrd / 180.0;
-    const double idy_sqrd_by_5040 = idy_sqrd / 5040.0;
-
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
-
-    for (int k = kb; k < ke; k++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int j = jb; j < je; j++) {
-                const int pp = IDX(i, j, k);
-
-                DyDyu[pp] = (-9.0 * u[pp - 4 * nx] + 128.0 * u[pp - 3 * nx] -
-                             1008.0 * u[pp - 2 * nx] + 8064.0 * u[pp - nx] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + nx] -
-                             1008.0 * u[pp + 2 * nx] + 128.0 * u[pp + 3 * nx] -
-                             9.0 * u[pp + 4 * nx]) *
-                            idy_sqrd_by_5040;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_DOWN)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted sixth order stencil.
-                DyDyu[IDX(i, 4, k)] =
-                    (938.0 * u[IDX(i, 4, k)] - 4014.0 * u[IDX(i, 5, k)] +
-                     7911.0 * u[IDX(i, 6, k)] - 9490.0 * u[IDX(i, 7, k)] +
-                     7380.0 * u[IDX(i, 8, k)] - 3618.0 * u[IDX(i, 9, k)] +
-                     1019.0 * u[IDX(i, 10, k)] - 126.0 * u[IDX(i, 11, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DyDyu[IDX(i, 5, k)] =
-                    (126.0 * u[IDX(i, 4, k)] - 70.0 * u[IDX(i, 5, k)] -
-                     486.0 * u[IDX(i, 6, k)] + 855.0 * u[IDX(i, 7, k)] -
-                     670.0 * u[IDX(i, 8, k)] + 324.0 * u[IDX(i, 9, k)] -
-                     90.0 * u[IDX(i, 10, k)] + 11.0 * u[IDX(i, 11, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DyDyu[IDX(i, 6, k)] =
-                    (-11.0 * u[IDX(i, 4, k)] + 214.0 * u[IDX(i, 5, k)] -
-                     378.0 * u[IDX(i, 6, k)] + 130.0 * u[IDX(i, 7, k)] +
-                     85.0 * u[IDX(i, 8, k)] - 54.0 * u[IDX(i, 9, k)] +
-                     16.0 * u[IDX(i, 10, k)] - 2.0 * u[IDX(i, 11, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, 7, k)] =
-                    (2.0 * u[IDX(i, 4, k)] - 27.0 * u[IDX(i, 5, k)] +
-                     270.0 * u[IDX(i, 6, k)] - 490.0 * u[IDX(i, 7, k)] +
-                     270.0 * u[IDX(i, 8, k)] - 27.0 * u[IDX(i, 9, k)] +
-                     2.0 * u[IDX(i, 10, k)]) *
-                    idy_sqrd_by_180;
-            }
-        }
-    }
-
-    if (bflag & (1u << OCT_DIR_UP)) {
-        for (int k = kb; k < ke; k++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DyDyu[IDX(i, je - 4, k)] =
-                    (2.0 * u[IDX(i, je - 7, k)] - 27.0 * u[IDX(i, je - 6, k)] +
-                     270.0 * u[IDX(i, je - 5, k)] -
-                     490.0 * u[IDX(i, je - 4, k)] +
-                     270.0 * u[IDX(i, je - 3, k)] -
-                     27.0 * u[IDX(i, je - 2, k)] + 2.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DyDyu[IDX(i, je - 3, k)] =
-                    (-2.0 * u[IDX(i, je - 8, k)] + 16.0 * u[IDX(i, je - 7, k)] -
-                     54.0 * u[IDX(i, je - 6, k)] + 85.0 * u[IDX(i, je - 5, k)] +
-                     130.0 * u[IDX(i, je - 4, k)] -
-                     378.0 * u[IDX(i, je - 3, k)] +
-                     214.0 * u[IDX(i, je - 2, k)] -
-                     11.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DyDyu[IDX(i, je - 2, k)] =
-                    (11.0 * u[IDX(i, je - 8, k)] - 90.0 * u[IDX(i, je - 7, k)] +
-                     324.0 * u[IDX(i, je - 6, k)] -
-                     670.0 * u[IDX(i, je - 5, k)] +
-                     855.0 * u[IDX(i, je - 4, k)] -
-                     486.0 * u[IDX(i, je - 3, k)] -
-                     70.0 * u[IDX(i, je - 2, k)] +
-                     126.0 * u[IDX(i, je - 1, k)]) *
-                    idy_sqrd_by_180;
-
-                // XThis is a (totally) shifted sixth order stencil.
-                DyDyu[IDX(i, je - 1, k)] = (-126.0 * u[IDX(i, je - 8, k)] +
-                                            1019.0 * u[IDX(i, je - 7, k)] -
-                                            3618.0 * u[IDX(i, je - 6, k)] +
-                                            7380.0 * u[IDX(i, je - 5, k)] -
-                                            9490.0 * u[IDX(i, je - 4, k)] +
-                                            7911.0 * u[IDX(i, je - 3, k)] -
-                                            4014.0 * u[IDX(i, je - 2, k)] +
-                                            938.0 * u[IDX(i, je - 1, k)]) *
-                                           idy_sqrd_by_180;
-            }
-        }
-    }
-
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DyDyu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv8664adv_x(double *const Dxu, const double *const u, const double dx,
+                    const unsigned int *sz, const double *const betax,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8664_x(Dxu, u, dx, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -8634,157 +1714,59 @@ void deriv8666_yy(double *const DyDyu, const double *const u, const double dy,
  *
  *
  *----------------------------------------------------------------------*/
-void deriv8666_zz(double *const DzDzu, const double *const u, const double dz,
-                  const unsigned int *sz, unsigned bflag) {
-    const double idz_sqrd = 1.0 / (dz * dz);
-    const double idz_sqrd_by_12 = idz_sqrd / 12.0;
-    const double idz_sqrd_by_180 = idz_sqrd / 180.0;
-    const double idz_sqrd_by_5040 = idz_sqrd / 5040.0;
+void deriv8664adv_y(double *const Dyu, const double *const u, const double dy,
+                    const unsigned int *sz, const double *const betay,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8664_y(Dyu, u, dy, sz, bflag);
+}
 
-    const int nx = sz[0];
-    const int ny = sz[1];
-    const int nz = sz[2];
-    const int ib = 4;
-    const int jb = 4;
-    const int kb = 4;
-    const int ie = sz[0] - 4;
-    const int je = sz[1] - 4;
-    const int ke = sz[2] - 4;
+/*----------------------------------------------------------------------;
+ *
+ *
+ *
+ *----------------------------------------------------------------------*/
+void deriv8664adv_z(double *const Dzu, const double *const u, const double dz,
+                    const unsigned int *sz, const double *const betaz,
+                    unsigned bflag) {
+    // hardcoded for not to use adv derivs,
+    deriv8664_z(Dzu, u, dz, sz, bflag);
+}
 
-    const int n = nx * ny;
+void deriv8666_x(double *const Dxu, const double *const u, const double dx,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8666, 0, 4>(
+        Dxu, u, dx, sz, bflag);
+}
 
-    for (int j = jb; j < je; j++) {
-        for (int i = ib; i < ie; i++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int k = kb; k < ke; k++) {
-                const int pp = IDX(i, j, k);
+void deriv8666_y(double *const Dyu, const double *const u, const double dy,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8666, 1, 4>(
+        Dyu, u, dy, sz, bflag);
+}
 
-                DzDzu[pp] = (-9.0 * u[pp - 4 * n] + 128.0 * u[pp - 3 * n] -
-                             1008.0 * u[pp - 2 * n] + 8064.0 * u[pp - n] -
-                             14350.0 * u[pp] + 8064.0 * u[pp + n] -
-                             1008.0 * u[pp + 2 * n] + 128.0 * u[pp + 3 * n] -
-                             9.0 * u[pp + 4 * n]) *
-                            idz_sqrd_by_5040;
-            }
-        }
-    }
+void deriv8666_z(double *const Dzu, const double *const u, const double dz,
+                 const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD1_8666, 2, 4>(
+        Dzu, u, dz, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_BACK)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a (totally) shifted sixth order stencil.
-                DzDzu[IDX(i, j, 4)] =
-                    (938.0 * u[IDX(i, j, 4)] - 4014.0 * u[IDX(i, j, 5)] +
-                     7911.0 * u[IDX(i, j, 6)] - 9490.0 * u[IDX(i, j, 7)] +
-                     7380.0 * u[IDX(i, j, 8)] - 3618.0 * u[IDX(i, j, 9)] -
-                     1019.0 * u[IDX(i, j, 10)] - 126.0 * u[IDX(i, j, 11)]) *
-                    idz_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DzDzu[IDX(i, j, 5)] =
-                    (126.0 * u[IDX(i, j, 4)] - 70.0 * u[IDX(i, j, 5)] -
-                     486.0 * u[IDX(i, j, 6)] + 855.0 * u[IDX(i, j, 7)] -
-                     670.0 * u[IDX(i, j, 8)] + 324.0 * u[IDX(i, j, 9)] -
-                     90.0 * u[IDX(i, j, 10)] + 11.0 * u[IDX(i, j, 11)]) *
-                    idz_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DzDzu[IDX(i, j, 6)] =
-                    (-11.0 * u[IDX(i, j, 4)] + 214.0 * u[IDX(i, j, 5)] -
-                     378.0 * u[IDX(i, j, 6)] + 130.0 * u[IDX(i, j, 7)] +
-                     85.0 * u[IDX(i, j, 8)] - 54.0 * u[IDX(i, j, 9)] +
-                     16.0 * u[IDX(i, j, 10)] - 2.0 * u[IDX(i, j, 11)]) *
-                    idz_sqrd_by_180;
-
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, 7)] =
-                    (2.0 * u[IDX(i, j, 4)] - 27.0 * u[IDX(i, j, 5)] +
-                     270.0 * u[IDX(i, j, 6)] - 490.0 * u[IDX(i, j, 7)] +
-                     270.0 * u[IDX(i, j, 8)] - 27.0 * u[IDX(i, j, 9)] +
-                     2.0 * u[IDX(i, j, 10)]) *
-                    idz_sqrd_by_180;
-            }
-        }
-    }
+void deriv8666_xx(double *const DxDxu, const double *const u, const double dx,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8666, 0, 4>(
+        DxDxu, u, dx, sz, bflag);
+}
 
-    if (bflag & (1u << OCT_DIR_FRONT)) {
-        for (int j = jb; j < je; j++) {
-#ifdef DERIV_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__DERIV_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (int i = ib; i < ie; i++) {
-                // This is a centered sixth order stencil.
-                DzDzu[IDX(i, j, ke - 4)] =
-                    (2.0 * u[IDX(i, j, ke - 7)] - 27.0 * u[IDX(i, j, ke - 6)] +
-                     270.0 * u[IDX(i, j, ke - 5)] -
-                     490.0 * u[IDX(i, j, ke - 4)] +
-                     270.0 * u[IDX(i, j, ke - 3)] -
-                     27.0 * u[IDX(i, j, ke - 2)] + 2.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // This is a shifted sixth order stencil.
-                DzDzu[IDX(i, j, ke - 3)] =
-                    (-2.0 * u[IDX(i, j, ke - 8)] + 16.0 * u[IDX(i, j, ke - 7)] -
-                     54.0 * u[IDX(i, j, ke - 6)] + 85.0 * u[IDX(i, j, ke - 5)] +
-                     130.0 * u[IDX(i, j, ke - 4)] -
-                     378.0 * u[IDX(i, j, ke - 3)] +
-                     214.0 * u[IDX(i, j, ke - 2)] -
-                     11.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // This is a (partially) shifted sixth order stencil.
-                DzDzu[IDX(i, j, ke - 2)] =
-                    (11.0 * u[IDX(i, j, ke - 8)] - 90.0 * u[IDX(i, j, ke - 7)] -
-                     324.0 * u[IDX(i, j, ke - 6)] -
-                     670.0 * u[IDX(i, j, ke - 5)] +
-                     855.0 * u[IDX(i, j, ke - 4)] -
-                     486.0 * u[IDX(i, j, ke - 3)] -
-                     70.0 * u[IDX(i, j, ke - 2)] +
-                     126.0 * u[IDX(i, j, ke - 1)]) *
-                    idz_sqrd_by_180;
-
-                // XThis is a (totally) shifted sixth order stencil.
-                DzDzu[IDX(i, j, ke - 1)] = (-126.0 * u[IDX(i, j, ke - 8)] +
-                                            1019.0 * u[IDX(i, j, ke - 7)] -
-                                            3618.0 * u[IDX(i, j, ke - 6)] +
-                                            7380.0 * u[IDX(i, j, ke - 5)] -
-                                            9490.0 * u[IDX(i, j, ke - 4)] +
-                                            7911.0 * u[IDX(i, j, ke - 3)] -
-                                            4014.0 * u[IDX(i, j, ke - 2)] +
-                                            938.0 * u[IDX(i, j, ke - 1)]) *
-                                           idz_sqrd_by_180;
-            }
-        }
-    }
+void deriv8666_yy(double *const DyDyu, const double *const u, const double dy,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8666, 1, 4>(
+        DyDyu, u, dy, sz, bflag);
+}
 
-#ifdef DEBUG_DERIVS_COMP
-#pragma message("DEBUG_DERIVS_COMP: ON")
-    for (int k = kb; k < ke; k++) {
-        for (int j = jb; j < je; j++) {
-            for (int i = ib; i < ie; i++) {
-                const int pp = IDX(i, j, k);
-                if (std::isnan(DzDzu[pp]))
-                    std::cout << "NAN detected function " << __func__
-                              << " file: " << __FILE__ << " line: " << __LINE__
-                              << std::endl;
-            }
-        }
-    }
-#endif
+void deriv8666_zz(double *const DzDzu, const double *const u, const double dz,
+                  const unsigned int *sz, unsigned bflag) {
+    dendro_derivs::stencil_deriv<dendro_derivs::StencilD2_8666, 2, 4>(
+        DzDzu, u, dz, sz, bflag);
 }
 
 /*----------------------------------------------------------------------;
@@ -0,0 +1,141 @@
+/**
+ * @file ghost_exchange.cpp
+ * @brief Ghost exchange of the evolution variables with persistent MPI
+ * requests.
+ */
+
+#include "ghost_exchange.h"
+
+namespace dsolve {
+
+void GhostExchangePlan::build(const ot::Mesh *pMesh, const unsigned int dof) {
+    release();
+
+    if (!pMesh->isActive()) return;
+
+    m_uiDof = dof;
+
+    const std::vector<unsigned int> &sendProcs = pMesh->getSendProcList();
+    const std::vector<unsigned int> &recvProcs = pMesh->getRecvProcList();
+    const std::vector<unsigned int> &sendCounts = pMesh->getNodalSendCounts();
+    const std::vector<unsigned int> &sendOffsets =
+        pMesh->getNodalSendOffsets();
+    const std::vector<unsigned int> &recvCounts = pMesh->getNodalRecvCounts();
+    const std::vector<unsigned int> &recvOffsets =
+        pMesh->getNodalRecvOffsets();
+    const std::vector<unsigned int> &sendSM = pMesh->getSendNodeSM();
+    const std::vector<unsigned int> &recvSM = pMesh->getRecvNodeSM();
+
+    MPI_Comm comm = pMesh->getMPICommunicator();
+
+    // the node lists are copied so the hot loops index contiguous arrays
+    unsigned int total = 0;
+    for (const unsigned int p : sendProcs) {
+        m_uiSendCounts.push_back(sendCounts[p]);
+        m_uiSendOffsets.push_back(total);
+        m_uiSendNodes.insert(m_uiSendNodes.end(),
+                             sendSM.begin() + sendOffsets[p],
+                             sendSM.begin() + sendOffsets[p] + sendCounts[p]);
+        total += sendCounts[p];
+    }
+    m_uiSendBuf.resize((size_t)total * dof);
+
+    total = 0;
+    for (const unsigned int p : recvProcs) {
+        m_uiRecvCounts.push_back(recvCounts[p]);
+        m_uiRecvOffsets.push_back(total);
+        m_uiRecvNodes.insert(m_uiRecvNodes.end(),
+                             recvSM.begin() + recvOffsets[p],
+                             recvSM.begin() + recvOffsets[p] + recvCounts[p]);
+        total += recvCounts[p];
+    }
+    m_uiRecvBuf.resize((size_t)total * dof);
+
+    m_uiSendReqs.resize(sendProcs.size());
+    for (unsigned int i = 0; i < sendProcs.size(); i++)
+        MPI_Send_init(&m_uiSendBuf[(size_t)m_uiSendOffsets[i] * dof],
+                      m_uiSendCounts[i] * dof, MPI_DOUBLE, sendProcs[i], TAG,
+                      comm, &m_uiSendReqs[i]);
+
+    m_uiRecvReqs.resize(recvProcs.size());
+    for (unsigned int i = 0; i < recvProcs.size(); i++)
+        MPI_Recv_init(&m_uiRecvBuf[(size_t)m_uiRecvOffsets[i] * dof],
+                      m_uiRecvCounts[i] * dof, MPI_DOUBLE, recvProcs[i], TAG,
+                      comm, &m_uiRecvReqs[i]);
+}
+
+void GhostExchangePlan::release() {
+    for (MPI_Request &req : m_uiSendReqs) MPI_Request_free(&req);
+    for (MPI_Request &req : m_uiRecvReqs) MPI_Request_free(&req);
+    m_uiSendReqs.clear();
+    m_uiRecvReqs.clear();
+
+    m_uiSendCounts.clear();
+    m_uiSendOffsets.clear();
+    m_uiRecvCounts.clear();
+    m_uiRecvOffsets.clear();
+    m_uiSendNodes.clear();
+    m_uiRecvNodes.clear();
+
+    // release the memory too, the next mesh has other sizes anyway
+    std::vector<double>().swap(m_uiSendBuf);
+    std::vector<double>().swap(m_uiRecvBuf);
+}
+
+void GhostExchangePlan::start(const double *const *vars) {
+    // post the receives first so the messages do not wait for them
+    if (!m_uiRecvReqs.empty())
+        MPI_Startall(m_uiRecvReqs.size(), m_uiRecvReqs.data());
+
+    if (m_uiSendReqs.empty()) return;
+
+    const unsigned int dof = m_uiDof;
+    const unsigned int numNbrs = m_uiSendReqs.size();
+
+    // each neighbour's message: variable after variable
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (unsigned int i = 0; i < numNbrs; i++) {
+        const unsigned int n = m_uiSendCounts[i];
+        const unsigned int *nodes = &m_uiSendNodes[m_uiSendOffsets[i]];
+        double *buf = &m_uiSendBuf[(size_t)m_uiSendOffsets[i] * dof];
+        for (unsigned int v = 0; v < dof; v++) {
+            const double *u = vars[v];
+            for (unsigned int k = 0; k < n; k++) buf[v * n + k] = u[nodes[k]];
+        }
+    }
+
+    MPI_Startall(m_uiSendReqs.size(), m_uiSendReqs.data());
+}
+
+void GhostExchangePlan::finish(double *const *vars) {
+    if (!m_uiRecvReqs.empty()) {
+        MPI_Waitall(m_uiRecvReqs.size(), m_uiRecvReqs.data(),
+                    MPI_STATUSES_IGNORE);
+
+        const unsigned int dof = m_uiDof;
+        const unsigned int numNbrs = m_uiRecvReqs.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (unsigned int i = 0; i < numNbrs; i++) {
+            const unsigned int n = m_uiRecvCounts[i];
+            const unsigned int *nodes = &m_uiRecvNodes[m_uiRecvOffsets[i]];
+            const double *buf = &m_uiRecvBuf[(size_t)m_uiRecvOffsets[i] * dof];
+            for (unsigned int v = 0; v < dof; v++) {
+                double *u = vars[v];
+                for (unsigned int k = 0; k < n; k++)
+                    u[nodes[k]] = buf[v * n + k];
+            }
+        }
+    }
+
+    // the send buffers are packed again by the next start
+    if (!m_uiSendReqs.empty())
+        MPI_Waitall(m_uiSendReqs.size(), m_uiSendReqs.data(),
+                    MPI_STATUSES_IGNORE);
+}
+
+}  // namespace dsolve
@@ -16,6 +16,12 @@
 
 #include "grUtils.h"
 
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace dsolve {
 
 // NOTE: the read param file and dump param file are now included in
@@ -437,6 +443,26 @@ unsigned int getOctantWeight(const ot::TreeNode *pNode) {
     return (1u << (3 * pNode->getLevel())) * 1;
 }
 
+// memory pools for the worker threads of the RHS, thread 0 always uses
+// SOLVER_MEM_POOL so the pools are only ever created for the extra threads
+static std::vector<std::unique_ptr<mem::memory_pool<double>>> thread_mem_pools;
+
+static unsigned int get_num_rhs_threads() {
+#ifdef _OPENMP
+    return (unsigned int)omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+static unsigned int get_rhs_thread_id() {
+#ifdef _OPENMP
+    return (unsigned int)omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
 void allocate_deriv_workspace(const ot::Mesh *pMesh, unsigned int s_fac) {
     // start with deallocation of the workspace, needed when remeshing
     deallocate_deriv_workspace();
@@ -453,13 +479,28 @@ void allocate_deriv_workspace(const ot::Mesh *pMesh, unsigned int s_fac) {
         if (blk_sz > max_blk_sz) max_blk_sz = blk_sz;
     }
 
+    allocate_deriv_workspace(max_blk_sz, s_fac);
+}
+
+void allocate_deriv_workspace(unsigned int max_blk_sz, unsigned int s_fac) {
     // make sure the derivatives are deallocated? seems unnecessary since
     // it's done earlier?
     deallocate_deriv_workspace();
 
-    // allocate the new memory
+    // allocate the new memory, one slice per thread so the blocks can be
+    // handed out to threads in solverRHS. thread 0's slice starts at the
+    // base pointer, so serial users of the workspace are unaffected
+    const unsigned int num_threads = get_num_rhs_threads();
+    dsolve::SOLVER_DERIV_WORKSPACE_STRIDE =
+        (size_t)s_fac * max_blk_sz * dsolve::SOLVER_NUM_DERIVATIVES;
     dsolve::SOLVER_DERIV_WORKSPACE =
-        new double[s_fac * max_blk_sz * dsolve::SOLVER_NUM_DERIVATIVES];
+        new double[num_threads * dsolve::SOLVER_DERIV_WORKSPACE_STRIDE];
+
+    // the pools are created here (outside of any parallel region) and kept
+    // alive across remeshes, they only grow if the thread count goes up
+    while (thread_mem_pools.size() + 1 < num_threads) {
+        thread_mem_pools.emplace_back(new mem::memory_pool<double>(0, 16));
+    }
 }
 
 void deallocate_deriv_workspace() {
@@ -467,9 +508,21 @@ void deallocate_deriv_workspace() {
     if (dsolve::SOLVER_DERIV_WORKSPACE != nullptr) {
         delete[] dsolve::SOLVER_DERIV_WORKSPACE;
         dsolve::SOLVER_DERIV_WORKSPACE = nullptr;
+        dsolve::SOLVER_DERIV_WORKSPACE_STRIDE = 0;
     }
 }
 
+double *get_thread_deriv_workspace() {
+    return dsolve::SOLVER_DERIV_WORKSPACE +
+           get_rhs_thread_id() * dsolve::SOLVER_DERIV_WORKSPACE_STRIDE;
+}
+
+mem::memory_pool<double> *get_thread_mem_pool() {
+    const unsigned int tid = get_rhs_thread_id();
+    if (tid == 0) return &dsolve::SOLVER_MEM_POOL;
+    return thread_mem_pools[tid - 1].get();
+}
+
 }  // end of namespace dsolve
 
 namespace dsolve {
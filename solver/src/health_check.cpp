@@ -0,0 +1,162 @@
+/**
+ * @file health_check.cpp
+ * @brief NaN/Inf guard for the evolution variables.
+ */
+
+#include "health_check.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "grDef.h"
+#include "parameters.h"
+
+namespace dsolve {
+
+bool all_finite(const double *u, const unsigned int n) {
+    // NaN and Inf are exactly the values with all exponent bits set
+    const uint64_t exp_mask = 0x7ff0000000000000ull;
+    uint64_t bad = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        uint64_t bits;
+        std::memcpy(&bits, &u[i], sizeof(bits));
+        bad |= static_cast<uint64_t>((bits & exp_mask) == exp_mask);
+    }
+    return bad == 0;
+}
+
+bool local_state_finite(const ot::Mesh *pMesh, const double *const *zipVars,
+                        const unsigned int numVars) {
+    if (!pMesh->isActive()) return true;
+
+    const unsigned int nodeBegin = pMesh->getNodeLocalBegin();
+    const unsigned int numNodes = pMesh->getNodeLocalEnd() - nodeBegin;
+
+    bool finite = true;
+    for (unsigned int v = 0; v < numVars; v++) {
+        finite &= all_finite(zipVars[v] + nodeBegin, numNodes);
+    }
+    return finite;
+}
+
+unsigned int dump_unhealthy_blocks(const ot::Mesh *pMesh,
+                                   const double *const *unzipVars,
+                                   const unsigned int numVars,
+                                   const char *const *varNames,
+                                   const unsigned int step, const double time,
+                                   const std::string &prefix) {
+    if (!pMesh->isActive()) return 0;
+
+    const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
+                       dsolve::SOLVER_COMPD_MIN[2]);
+    const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
+                       dsolve::SOLVER_COMPD_MAX[2]);
+    const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
+    const unsigned int rank = pMesh->getMPIRank();
+
+    const std::vector<ot::Block> &blkList = pMesh->getLocalBlockList();
+
+    char fName[256];
+    sprintf(fName, "%s_health_%06d_%d.txt", prefix.c_str(), step, rank);
+    std::ofstream out;
+
+    unsigned int numBad = 0;
+    for (unsigned int blk = 0; blk < blkList.size(); blk++) {
+        const unsigned int offset = blkList[blk].getOffset();
+        const unsigned int nx = blkList[blk].getAllocationSzX();
+        const unsigned int ny = blkList[blk].getAllocationSzY();
+        const unsigned int nz = blkList[blk].getAllocationSzZ();
+
+        // the padding of boundary blocks is not filled by the unzip, only
+        // the interior tells if the block is bad
+        std::vector<bool> blkFinite(numVars, true);
+        bool anyBad = false;
+        for (unsigned int v = 0; v < numVars; v++) {
+            for (unsigned int k = PW; k < nz - PW; k++) {
+                for (unsigned int j = PW; j < ny - PW; j++) {
+                    if (!all_finite(
+                            &unzipVars[v][offset + PW + nx * (j + ny * k)],
+                            nx - 2 * PW)) {
+                        blkFinite[v] = false;
+                    }
+                }
+            }
+            anyBad |= !blkFinite[v];
+        }
+        if (!anyBad) continue;
+
+        const double dx = blkList[blk].computeDx(pt_min, pt_max);
+        const double dy = blkList[blk].computeDy(pt_min, pt_max);
+        const double dz = blkList[blk].computeDz(pt_min, pt_max);
+
+        double ptmin[3];
+        ptmin[0] = GRIDX_TO_X(blkList[blk].getBlockNode().minX()) - PW * dx;
+        ptmin[1] = GRIDY_TO_Y(blkList[blk].getBlockNode().minY()) - PW * dy;
+        ptmin[2] = GRIDZ_TO_Z(blkList[blk].getBlockNode().minZ()) - PW * dz;
+
+        if (!out.is_open()) {
+            out.open(fName);
+            out << std::setprecision(16);
+            out << "# step " << step << " time " << time << " rank " << rank
+                << std::endl;
+        }
+
+        out << "# block " << blk
+            << " level " << blkList[blk].getBlockNode().getLevel()
+            << " bflag " << blkList[blk].getBlkNodeFlag() << " sz " << nx
+            << " " << ny << " " << nz << " ptmin " << ptmin[0] << " "
+            << ptmin[1] << " " << ptmin[2] << " h " << dx << " " << dy << " "
+            << dz << std::endl;
+
+        std::cerr << "[health check] rank " << rank << " step " << step
+                  << ": block " << blk << " at (" << ptmin[0] << ", "
+                  << ptmin[1] << ", " << ptmin[2] << ") has non-finite";
+
+        for (unsigned int v = 0; v < numVars; v++) {
+            if (blkFinite[v]) continue;
+            std::cerr << " " << varNames[v];
+
+            out << "# var " << varNames[v] << " (i j k value)" << std::endl;
+            for (unsigned int k = 0; k < nz; k++) {
+                for (unsigned int j = 0; j < ny; j++) {
+                    for (unsigned int i = 0; i < nx; i++) {
+                        out << i << " " << j << " " << k << " "
+                            << unzipVars[v][offset + i + nx * (j + ny * k)]
+                            << "\n";
+                    }
+                }
+            }
+        }
+        std::cerr << ", written to " << fName << std::endl;
+        numBad++;
+    }
+
+    return numBad;
+}
+
+void abort_unhealthy_run(MPI_Comm comm, const unsigned int step,
+                         const double time) {
+    // MPI_Abort may take down the other ranks before they wrote their blocks
+    MPI_Barrier(comm);
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (!rank) {
+        std::cerr << "[health check] NaN or Inf in the evolution variables "
+                     "after step "
+                  << step << " (time " << time << "), aborting the run"
+                  << std::endl;
+    }
+
+    MPI_Abort(comm, 1);
+    // MPI_Abort should not return, make sure this rank does not go on either
+    std::abort();
+}
+
+}  // namespace dsolve
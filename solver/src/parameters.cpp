@@ -46,6 +46,9 @@ unsigned int SOLVER_FILTER_FREQ = 10;
 double SOLVER_KIM_FILTER_KC = 0.88 * M_PI;
 double SOLVER_KIM_FILTER_EPS = 0.25;
 
+std::string SOLVER_CFD_MATRIX_CACHE_DIR = "";
+unsigned int SOLVER_CFD_SHARE_MATRICES = 0;
+
 double EM2_NOISE_AMPLITUDE = 0.0;
 double EM2_ID_AMP1 = 5.0;
 double EM2_ID_LAMBDA1 = 0.05;
@@ -73,7 +76,9 @@ unsigned int SOLVER_CONSOLE_OUTPUT_CONSTRAINTS[2] = {0, 1};
 
 unsigned int SOLVER_REMESH_TEST_FREQ = 10;
 unsigned int SOLVER_CHECKPT_FREQ = 5000;
+unsigned int SOLVER_HEALTH_CHECK_FREQ = 10;
 unsigned int SOLVER_RESTORE_SOLVER = 0;
+unsigned int SOLVER_CHKPT_ASYNC = 0;
 unsigned int SOLVER_ENABLE_BLOCK_ADAPTIVITY = 0;
 std::string SOLVER_VTU_FILE_PREFIX = "vtu/solver_gr";
 std::string SOLVER_CHKPT_FILE_PREFIX = "cp/solver_cp";
@@ -96,6 +101,7 @@ double SOLVER_RK_TIME_END = 800;
 unsigned int SOLVER_RK_TYPE = 1;
 double SOLVER_RK45_TIME_STEP_SIZE = 0.01;
 double SOLVER_RK45_DESIRED_TOL = 0.001;
+double SOLVER_RK45_DT_MAX_FAC = 4.0;
 unsigned int DISSIPATION_TYPE = 0;
 unsigned int SOLVER_DISSIPATION_NC = 0;
 unsigned int SOLVER_DISSIPATION_S = 0;
@@ -133,6 +139,7 @@ unsigned int SOLVER_CURRENT_RK_STEP = 0;
 
 // NECESSARY ALLOCATION/START FOR DERIV WORKSPACE
 double* SOLVER_DERIV_WORKSPACE = nullptr;
+size_t SOLVER_DERIV_WORKSPACE_STRIDE = 0;
 }  // namespace dsolve
 namespace dsolve {
 void readParamFile(const char* inFile, MPI_Comm comm) {
@@ -208,6 +215,16 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
                 file["dsolve::SOLVER_KIM_FILTER_EPS"].as_floating();
         }
 
+        if (file.contains("dsolve::SOLVER_CFD_MATRIX_CACHE_DIR")) {
+            dsolve::SOLVER_CFD_MATRIX_CACHE_DIR =
+                file["dsolve::SOLVER_CFD_MATRIX_CACHE_DIR"].as_string();
+        }
+
+        if (file.contains("dsolve::SOLVER_CFD_SHARE_MATRICES")) {
+            dsolve::SOLVER_CFD_SHARE_MATRICES =
+                file["dsolve::SOLVER_CFD_SHARE_MATRICES"].as_integer();
+        }
+
         if (file.contains("dsolve::SOLVER_ELE_ORDER")) {
             dsolve::SOLVER_ELE_ORDER =
                 file["dsolve::SOLVER_ELE_ORDER"].as_integer();
@@ -265,11 +282,21 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
                 file["dsolve::SOLVER_CHECKPT_FREQ"].as_integer();
         }
 
+        if (file.contains("dsolve::SOLVER_HEALTH_CHECK_FREQ")) {
+            dsolve::SOLVER_HEALTH_CHECK_FREQ =
+                file["dsolve::SOLVER_HEALTH_CHECK_FREQ"].as_integer();
+        }
+
         if (file.contains("dsolve::SOLVER_RESTORE_SOLVER")) {
             dsolve::SOLVER_RESTORE_SOLVER =
                 file["dsolve::SOLVER_RESTORE_SOLVER"].as_integer();
         }
 
+        if (file.contains("dsolve::SOLVER_CHKPT_ASYNC")) {
+            dsolve::SOLVER_CHKPT_ASYNC =
+                file["dsolve::SOLVER_CHKPT_ASYNC"].as_integer();
+        }
+
         if (file.contains("dsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY")) {
             dsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY =
                 file["dsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY"].as_integer();
@@ -423,6 +450,19 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
                 file["dsolve::SOLVER_RK45_DESIRED_TOL"].as_floating();
         }
 
+        if (file.contains("dsolve::SOLVER_RK45_DT_MAX_FAC")) {
+            if (1.0 > file["dsolve::SOLVER_RK45_DT_MAX_FAC"].as_floating() ||
+                100.0 < file["dsolve::SOLVER_RK45_DT_MAX_FAC"].as_floating()) {
+                std::cerr
+                    << R"(Invalid value for "dsolve::SOLVER_RK45_DT_MAX_FAC")"
+                    << std::endl;
+                exit(-1);
+            }
+
+            dsolve::SOLVER_RK45_DT_MAX_FAC =
+                file["dsolve::SOLVER_RK45_DT_MAX_FAC"].as_floating();
+        }
+
         if (file.contains("dsolve::DISSIPATION_TYPE")) {
             dsolve::DISSIPATION_TYPE =
                 file["dsolve::DISSIPATION_TYPE"].as_integer();
@@ -764,6 +804,7 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
 
     par::Mpi_Bcast(&SOLVER_KIM_FILTER_KC, 1, 0, comm);
     par::Mpi_Bcast(&SOLVER_KIM_FILTER_EPS, 1, 0, comm);
+    par::Mpi_Bcast(&SOLVER_CFD_SHARE_MATRICES, 1, 0, comm);
 
     par::Mpi_Bcast(&(dsolve::SOLVER_ETA_CONST), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_ETA_R0), 1, 0, comm);
@@ -788,7 +829,9 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
 
     par::Mpi_Bcast(&(dsolve::SOLVER_REMESH_TEST_FREQ), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_CHECKPT_FREQ), 1, 0, comm);
+    par::Mpi_Bcast(&(dsolve::SOLVER_HEALTH_CHECK_FREQ), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_RESTORE_SOLVER), 1, 0, comm);
+    par::Mpi_Bcast(&(dsolve::SOLVER_CHKPT_ASYNC), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY), 1, 0, comm);
 
     par::Mpi_Bcast(&(dsolve::SOLVER_NUM_REFINE_VARS), 1, 0, comm);
@@ -810,6 +853,7 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
     par::Mpi_Bcast(&(dsolve::SOLVER_RK_TYPE), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_RK45_TIME_STEP_SIZE), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_RK45_DESIRED_TOL), 1, 0, comm);
+    par::Mpi_Bcast(&(dsolve::SOLVER_RK45_DT_MAX_FAC), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::DISSIPATION_TYPE), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_DISSIPATION_NC), 1, 0, comm);
     par::Mpi_Bcast(&(dsolve::SOLVER_DISSIPATION_S), 1, 0, comm);
@@ -844,7 +888,8 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
 
     unsigned int solver__solver_vtu_file_prefix_len,
         solver__solver_chkpt_file_prefix_len,
-        solver__solver_profile_file_prefix_len;
+        solver__solver_profile_file_prefix_len,
+        solver__solver_cfd_matrix_cache_dir_len;
 
     if (!rank) {
         solver__solver_vtu_file_prefix_len =
@@ -853,11 +898,14 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
             dsolve::SOLVER_CHKPT_FILE_PREFIX.size();
         solver__solver_profile_file_prefix_len =
             dsolve::SOLVER_PROFILE_FILE_PREFIX.size();
+        solver__solver_cfd_matrix_cache_dir_len =
+            dsolve::SOLVER_CFD_MATRIX_CACHE_DIR.size();
     }
 
     par::Mpi_Bcast(&solver__solver_vtu_file_prefix_len, 1, 0, comm);
     par::Mpi_Bcast(&solver__solver_chkpt_file_prefix_len, 1, 0, comm);
     par::Mpi_Bcast(&solver__solver_profile_file_prefix_len, 1, 0, comm);
+    par::Mpi_Bcast(&solver__solver_cfd_matrix_cache_dir_len, 1, 0, comm);
 
     char
         solver__solver_vtu_file_prefix_temp[solver__solver_vtu_file_prefix_len +
@@ -866,6 +914,8 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
         [solver__solver_chkpt_file_prefix_len + 1];
     char solver__solver_profile_file_prefix_temp
         [solver__solver_profile_file_prefix_len + 1];
+    char solver__solver_cfd_matrix_cache_dir_temp
+        [solver__solver_cfd_matrix_cache_dir_len + 1];
 
     if (!rank) {
         strcpy(solver__solver_vtu_file_prefix_temp,
@@ -874,6 +924,8 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
                dsolve::SOLVER_CHKPT_FILE_PREFIX.c_str());
         strcpy(solver__solver_profile_file_prefix_temp,
                dsolve::SOLVER_PROFILE_FILE_PREFIX.c_str());
+        strcpy(solver__solver_cfd_matrix_cache_dir_temp,
+               dsolve::SOLVER_CFD_MATRIX_CACHE_DIR.c_str());
     }
 
     MPI_Bcast(solver__solver_vtu_file_prefix_temp,
@@ -882,6 +934,8 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
               solver__solver_chkpt_file_prefix_len + 1, MPI_CHAR, 0, comm);
     MPI_Bcast(solver__solver_profile_file_prefix_temp,
               solver__solver_profile_file_prefix_len + 1, MPI_CHAR, 0, comm);
+    MPI_Bcast(solver__solver_cfd_matrix_cache_dir_temp,
+              solver__solver_cfd_matrix_cache_dir_len + 1, MPI_CHAR, 0, comm);
 
     dsolve::SOLVER_VTU_FILE_PREFIX =
         std::string(solver__solver_vtu_file_prefix_temp);
@@ -889,6 +943,8 @@ void readParamFile(const char* inFile, MPI_Comm comm) {
         std::string(solver__solver_chkpt_file_prefix_temp);
     dsolve::SOLVER_PROFILE_FILE_PREFIX =
         std::string(solver__solver_profile_file_prefix_temp);
+    dsolve::SOLVER_CFD_MATRIX_CACHE_DIR =
+        std::string(solver__solver_cfd_matrix_cache_dir_temp);
 
     // TODO: COMPD_MIN, COMPD_MAX should be GRID_MIN and GRID_MAX, not settable
     // by user
@@ -938,6 +994,12 @@ void dumpParamFile(std::ostream& sout, int root, MPI_Comm comm) {
         sout << "\tdsolve::SOLVER_KIM_FILTER_EPS: "
              << dsolve::SOLVER_KIM_FILTER_EPS << std::endl;
 
+        sout << "\tdsolve::SOLVER_CFD_MATRIX_CACHE_DIR: "
+             << dsolve::SOLVER_CFD_MATRIX_CACHE_DIR << std::endl;
+
+        sout << "\tdsolve::SOLVER_CFD_SHARE_MATRICES: "
+             << dsolve::SOLVER_CFD_SHARE_MATRICES << std::endl;
+
         sout << "\tdsolve::SOLVER_ELE_ORDER: " << dsolve::SOLVER_ELE_ORDER
              << std::endl;
         sout << "\tdsolve::SOLVER_PADDING_WIDTH: "
@@ -954,6 +1016,10 @@ void dumpParamFile(std::ostream& sout, int root, MPI_Comm comm) {
              << std::endl;
         sout << "\tdsolve::SOLVER_RK3_STAGES: " << dsolve::SOLVER_RK3_STAGES
              << std::endl;
+        sout << "\tdsolve::SOLVER_LSRK3_STAGES: "
+             << dsolve::SOLVER_LSRK3_STAGES << std::endl;
+        sout << "\tdsolve::SOLVER_LSRK4_STAGES: "
+             << dsolve::SOLVER_LSRK4_STAGES << std::endl;
         sout << "\tdsolve::SOLVER_SAFETY_FAC: " << dsolve::SOLVER_SAFETY_FAC
              << std::endl;
         sout << "\tdsolve::SOLVER_NUM_VARS_INTENL: "
@@ -1009,8 +1075,12 @@ void dumpParamFile(std::ostream& sout, int root, MPI_Comm comm) {
              << dsolve::SOLVER_REMESH_TEST_FREQ << std::endl;
         sout << "\tdsolve::SOLVER_CHECKPT_FREQ: " << dsolve::SOLVER_CHECKPT_FREQ
              << std::endl;
+        sout << "\tdsolve::SOLVER_HEALTH_CHECK_FREQ: "
+             << dsolve::SOLVER_HEALTH_CHECK_FREQ << std::endl;
         sout << "\tdsolve::SOLVER_RESTORE_SOLVER: "
              << dsolve::SOLVER_RESTORE_SOLVER << std::endl;
+        sout << "\tdsolve::SOLVER_CHKPT_ASYNC: " << dsolve::SOLVER_CHKPT_ASYNC
+             << std::endl;
         sout << "\tdsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY: "
              << dsolve::SOLVER_ENABLE_BLOCK_ADAPTIVITY << std::endl;
         sout << "\tdsolve::SOLVER_VTU_FILE_PREFIX: "
@@ -1071,6 +1141,8 @@ void dumpParamFile(std::ostream& sout, int root, MPI_Comm comm) {
              << dsolve::SOLVER_RK45_TIME_STEP_SIZE << std::endl;
         sout << "\tdsolve::SOLVER_RK45_DESIRED_TOL: "
              << dsolve::SOLVER_RK45_DESIRED_TOL << std::endl;
+        sout << "\tdsolve::SOLVER_RK45_DT_MAX_FAC: "
+             << dsolve::SOLVER_RK45_DT_MAX_FAC << std::endl;
         sout << "\tdsolve::DISSIPATION_TYPE: " << dsolve::DISSIPATION_TYPE
              << std::endl;
         sout << "\tdsolve::SOLVER_DISSIPATION_NC: "
@@ -1,8 +1,10 @@
 #include "physcon.h"
 
 #include "debugger_tools.h"
+#include "grUtils.h"
 #include "parameters.h"
 #include "solver_main.h"
+#include "sources.h"
 
 // TEMPORARY
 // #ifdef SOLVER_DEBUG_FLOATING_POINT
@@ -192,12 +194,22 @@ void physical_constraints(double **uZipConVars, const double **uZipVars,
 #include "../gencode/solver_physcon_deriv_calc.cpp.inc"
     // clang-format on
     //[[[end]]]
+#ifdef SOLVER_ENABLE_SOURCES
+    // only rho_e enters the constraints, J is scratch space here
+    mem::memory_pool<double> *__mem_pool = get_thread_mem_pool();
     double *rho_e = deriv_base + 9 * BLK_SZ;
+    double *J0 = __mem_pool->allocate(n);
+    double *J1 = __mem_pool->allocate(n);
+    double *J2 = __mem_pool->allocate(n);
 
-    // TODO: Why is Rho_e set to 0? Is this supposed to do something different?
-    for (unsigned int m = 0; m < n; m++) {
-        rho_e[m] = 0.0;
-    }
+    dsolve::get_source_function()(rho_e, J0, J1, J2, pmin, pmax, sz);
+
+    __mem_pool->free(J0);
+    __mem_pool->free(J1);
+    __mem_pool->free(J2);
+#else
+    const dsolve::ZeroSource rho_e;
+#endif
 
     // printf("ALL EXCEPTIONS AFTER COMPUTING DERIVATIVES: ");
     // show_fe_exceptions();
@@ -205,12 +217,7 @@ void physical_constraints(double **uZipConVars, const double **uZipVars,
     // enforce hamiltonian and momentum constraints
     for (unsigned int k = PW; k < nz - PW; k++) {
         for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+            SOLVER_SIMD_LOOP(__RHS_AVX_SIMD_LEN__)
             for (unsigned int i = PW; i < nx - PW; i++) {
                 const double x = pmin[0] + i * hx;
                 const double y = pmin[1] + j * hy;
@@ -561,12 +568,22 @@ void physical_constraints_compact_derivs(double **uZipConVars,
         cfd.cfd_zz(grad2_2_2_psi, psi, hz, sz, bflag);
     }
 
+#ifdef SOLVER_ENABLE_SOURCES
+    // only rho_e enters the constraints, J is scratch space here
+    mem::memory_pool<double> *__mem_pool = get_thread_mem_pool();
     double *rho_e = deriv_base + 9 * BLK_SZ;
+    double *J0 = __mem_pool->allocate(n);
+    double *J1 = __mem_pool->allocate(n);
+    double *J2 = __mem_pool->allocate(n);
 
-    // TODO: Why is Rho_e set to 0? Is this supposed to do something different?
-    for (unsigned int m = 0; m < n; m++) {
-        rho_e[m] = 0.0;
-    }
+    dsolve::get_source_function()(rho_e, J0, J1, J2, pmin, pmax, sz);
+
+    __mem_pool->free(J0);
+    __mem_pool->free(J1);
+    __mem_pool->free(J2);
+#else
+    const dsolve::ZeroSource rho_e;
+#endif
 
     // printf("ALL EXCEPTIONS AFTER COMPUTING DERIVATIVES: ");
     // show_fe_exceptions();
@@ -574,12 +591,7 @@ void physical_constraints_compact_derivs(double **uZipConVars,
     // enforce hamiltonian and momentum constraints
     for (unsigned int k = PW; k < nz - PW; k++) {
         for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+            SOLVER_SIMD_LOOP(__RHS_AVX_SIMD_LEN__)
             for (unsigned int i = PW; i < nx - PW; i++) {
                 const double x = pmin[0] + i * hx;
                 const double y = pmin[1] + j * hy;
@@ -2,9 +2,11 @@
 
 #include "compact_derivs.h"
 #include "debugger_tools.h"
+#include "grUtils.h"
 #include "hadrhs.h"
 #include "parameters.h"
 #include "solver_main.h"
+#include "sources.h"
 
 #define PI 3.14159265358979323846
 
@@ -27,11 +29,6 @@ using namespace dsolve;
 
 void solverRHS(double **uzipVarsRHS, double **uZipVars,
                const ot::Block *blkList, unsigned int numBlocks) {
-    unsigned int offset;
-    double ptmin[3], ptmax[3];
-    unsigned int sz[3];
-    unsigned int bflag;
-    double dx, dy, dz;
     const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
                        dsolve::SOLVER_COMPD_MIN[2]);
     const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
@@ -47,17 +44,26 @@ void solverRHS(double **uzipVarsRHS, double **uZipVars,
                      threadBlock, pt_min, pt_max, 1);
 #else
 
+    // blocks are independent, each thread works out of its own derivative
+    // workspace and memory pool (see allocate_deriv_workspace). dynamic
+    // scheduling since the block sizes vary a lot across the mesh
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (unsigned int blk = 0; blk < numBlocks; blk++) {
-        offset = blkList[blk].getOffset();
+        double ptmin[3], ptmax[3];
+        unsigned int sz[3];
+
+        const unsigned int offset = blkList[blk].getOffset();
         sz[0] = blkList[blk].getAllocationSzX();
         sz[1] = blkList[blk].getAllocationSzY();
         sz[2] = blkList[blk].getAllocationSzZ();
 
-        bflag = blkList[blk].getBlkNodeFlag();
+        const unsigned int bflag = blkList[blk].getBlkNodeFlag();
 
-        dx = blkList[blk].computeDx(pt_min, pt_max);
-        dy = blkList[blk].computeDy(pt_min, pt_max);
-        dz = blkList[blk].computeDz(pt_min, pt_max);
+        const double dx = blkList[blk].computeDx(pt_min, pt_max);
+        const double dy = blkList[blk].computeDy(pt_min, pt_max);
+        const double dz = blkList[blk].computeDz(pt_min, pt_max);
 
         ptmin[0] = GRIDX_TO_X(blkList[blk].getBlockNode().minX()) - PW * dx;
         ptmin[1] = GRIDY_TO_Y(blkList[blk].getBlockNode().minY()) - PW * dy;
@@ -82,11 +88,6 @@ void solverRHS(double **uzipVarsRHS, double **uZipVars,
 // reasons and does not touch CFD
 void solverRHS(double **uzipVarsRHS, const double **uZipVars,
                const ot::Block *blkList, unsigned int numBlocks) {
-    unsigned int offset;
-    double ptmin[3], ptmax[3];
-    unsigned int sz[3];
-    unsigned int bflag;
-    double dx, dy, dz;
     const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
                        dsolve::SOLVER_COMPD_MIN[2]);
     const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
@@ -102,17 +103,26 @@ void solverRHS(double **uzipVarsRHS, const double **uZipVars,
                      threadBlock, pt_min, pt_max, 1);
 #else
 
+    // blocks are independent, each thread works out of its own derivative
+    // workspace and memory pool (see allocate_deriv_workspace). dynamic
+    // scheduling since the block sizes vary a lot across the mesh
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (unsigned int blk = 0; blk < numBlocks; blk++) {
-        offset = blkList[blk].getOffset();
+        double ptmin[3], ptmax[3];
+        unsigned int sz[3];
+
+        const unsigned int offset = blkList[blk].getOffset();
         sz[0] = blkList[blk].getAllocationSzX();
         sz[1] = blkList[blk].getAllocationSzY();
         sz[2] = blkList[blk].getAllocationSzZ();
 
-        bflag = blkList[blk].getBlkNodeFlag();
+        const unsigned int bflag = blkList[blk].getBlkNodeFlag();
 
-        dx = blkList[blk].computeDx(pt_min, pt_max);
-        dy = blkList[blk].computeDy(pt_min, pt_max);
-        dz = blkList[blk].computeDz(pt_min, pt_max);
+        const double dx = blkList[blk].computeDx(pt_min, pt_max);
+        const double dy = blkList[blk].computeDy(pt_min, pt_max);
+        const double dz = blkList[blk].computeDz(pt_min, pt_max);
 
         ptmin[0] = GRIDX_TO_X(blkList[blk].getBlockNode().minX()) - PW * dx;
         ptmin[1] = GRIDY_TO_Y(blkList[blk].getBlockNode().minY()) - PW * dy;
@@ -128,6 +138,56 @@ void solverRHS(double **uzipVarsRHS, const double **uZipVars,
 #endif
 }
 
+void solverFilter(double **uZipVars, const ot::Block *blkList,
+                  unsigned int numBlocks) {
+    const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
+                       dsolve::SOLVER_COMPD_MIN[2]);
+    const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
+                       dsolve::SOLVER_COMPD_MAX[2]);
+
+    // same work split as the RHS, the filters use the thread's workspace
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (unsigned int blk = 0; blk < numBlocks; blk++) {
+        unsigned int sz[3];
+
+        const unsigned int offset = blkList[blk].getOffset();
+        sz[0] = blkList[blk].getAllocationSzX();
+        sz[1] = blkList[blk].getAllocationSzY();
+        sz[2] = blkList[blk].getAllocationSzZ();
+
+        const unsigned int bflag = blkList[blk].getBlkNodeFlag();
+
+        const double dx = blkList[blk].computeDx(pt_min, pt_max);
+        const double dy = blkList[blk].computeDy(pt_min, pt_max);
+        const double dz = blkList[blk].computeDz(pt_min, pt_max);
+
+        double *filt_vars[dsolve::SOLVER_NUM_VARS];
+        for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++) {
+            filt_vars[v] = &uZipVars[v][offset];
+        }
+
+        dendro_cfd::cfd.filter_cfd_x_batched(
+            filt_vars, dsolve::SOLVER_NUM_VARS, dx, sz, bflag);
+        dendro_cfd::cfd.filter_cfd_y_batched(
+            filt_vars, dsolve::SOLVER_NUM_VARS, dy, sz, bflag);
+        dendro_cfd::cfd.filter_cfd_z_batched(
+            filt_vars, dsolve::SOLVER_NUM_VARS, dz, sz, bflag);
+    }
+}
+
+bool solverUsesCompactFilter() {
+    return dsolve::SOLVER_FILTER_TYPE != dendro_cfd::FILT_NONE &&
+           dsolve::SOLVER_FILTER_TYPE != dendro_cfd::FILT_KO_DISS &&
+           dsolve::SOLVER_FILTER_TYPE != dendro_cfd::EXPLCT_KO;
+}
+
+bool solverFilterDue(unsigned int step) {
+    return solverUsesCompactFilter() && dsolve::SOLVER_FILTER_FREQ != 0 &&
+           (step % dsolve::SOLVER_FILTER_FREQ) == 0;
+}
+
 #if 0
 template <typename T>
 void printRHSVarStats(T **variables, unsigned int n, const unsigned int offset,
@@ -212,10 +272,12 @@ void printRHSVarStats(const T **variables, unsigned int n,
  * vector form of RHS
  *
  *----------------------------------------------------------------------*/
-void solverrhs(double **unzipVarsRHS, const double **uZipVars,
-               const unsigned int &offset, const double *pmin,
-               const double *pmax, const unsigned int *sz,
-               const unsigned int &bflag) {
+SOLVER_SIMD_CLONES void solverrhs(double **unzipVarsRHS,
+                                  const double **uZipVars,
+                                  const unsigned int &offset,
+                                  const double *pmin, const double *pmax,
+                                  const unsigned int *sz,
+                                  const unsigned int &bflag) {
     // std::cout << "Entering the RHS computation function..." << std::endl;
 
     // wait_for_debugger();
@@ -279,8 +341,6 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
     double *A_rhs1 = &unzipVarsRHS[VAR::U_A1][offset];
     double *A_rhs2 = &unzipVarsRHS[VAR::U_A2][offset];
 
-    mem::memory_pool<double> *__mem_pool = &SOLVER_MEM_POOL;
-
     const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
@@ -305,18 +365,12 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
     const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
     unsigned int n = sz[0] * sz[1] * sz[2];
 
-    dsolve::timer::t_deriv.start();
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
 
     const unsigned int BLK_SZ = n;
     const unsigned int bytes = n * sizeof(double);
-    // get derivative workspace
-    double *const deriv_base = dsolve::SOLVER_DERIV_WORKSPACE;
-
-    // Get the number of processes
-    int world_size;
-    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
-    int world_rank;
-    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    // get this thread's slice of the derivative workspace
+    double *const deriv_base = get_thread_deriv_workspace();
 
     // Create the necessary pre-derivatives
     // clang-format off
@@ -385,34 +439,28 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
     // clang-format on
     //[[[end]]]
 
-    dsolve::timer::t_deriv.stop();
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
 
-    // TODO: is this even necessary?
+#ifdef SOLVER_ENABLE_SOURCES
+    mem::memory_pool<double> *__mem_pool = get_thread_mem_pool();
     double *rho_e = __mem_pool->allocate(n);
 
     double *J0 = __mem_pool->allocate(n);
     double *J1 = __mem_pool->allocate(n);
     double *J2 = __mem_pool->allocate(n);
 
-    for (unsigned int m = 0; m < n; m++) {
-        rho_e[m] = 0.0;
-
-        J0[m] = 0.0;
-        J1[m] = 0.0;
-        J2[m] = 0.0;
-    }
+    dsolve::get_source_function()(rho_e, J0, J1, J2, pmin, pmax, sz);
+#else
+    // no sources, the zero terms fold away in the equations below
+    const dsolve::ZeroSource rho_e, J0, J1, J2;
+#endif
 
     // loop dep. removed allowing compiler to optmize for vectorization.
     // cout << "begin loop" << endl;
-    dsolve::timer::t_rhs.start();
+    dsolve::timer::start_master(dsolve::timer::t_rhs);
     for (unsigned int k = PW; k < nz - PW; k++) {
         for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+            SOLVER_SIMD_LOOP(__RHS_AVX_SIMD_LEN__)
             for (unsigned int i = PW; i < nx - PW; i++) {
                 const double x = pmin[0] + i * hx;
                 const double y = pmin[1] + j * hy;
@@ -442,7 +490,7 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
             }
         }
     }
-    dsolve::timer::t_rhs.stop();
+    dsolve::timer::stop_master(dsolve::timer::t_rhs);
 
     // Deallocate the pre-derivatives
     // TODO: is this the best place to put this? or should it reside at the end
@@ -462,7 +510,7 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
     //[[[end]]]
 
     if (bflag != 0) {
-        dsolve::timer::t_bdyc.start();
+        dsolve::timer::start_master(dsolve::timer::t_bdyc);
 
         asymptotic_and_falloff_bcs(E_rhs0, E0, grad_0_E0, grad_1_E0, grad_2_E0,
                                    pmin, pmax, 2.0, 0.0, sz, bflag);
@@ -486,68 +534,25 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
 
         //[[[end]]]
 
-        dsolve::timer::t_bdyc.stop();
+        dsolve::timer::stop_master(dsolve::timer::t_bdyc);
     }
 
-    dsolve::timer::t_deriv.start();
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
     // TODO: include more types of build options
 
-#include "../gencode/solver_rhs_ko_deriv_calc.cpp.inc"
-    dsolve::timer::t_deriv.stop();
-
-    dsolve::timer::t_rhs.start();
-
+    // Added KO DISSIPATION CALCULATIONS FROM EM2 CODE -AJC
+    // each variable's dissipation is accumulated straight into its RHS
     const double sigma = KO_DISS_SIGMA;
-
-    for (unsigned int k = PW; k < nz - PW; k++) {
-        for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-            for (unsigned int i = PW; i < nx - PW; i++) {
-                const unsigned int pp = i + nx * (j + ny * k);
-                // Added KO DISSIPATION CALCULATIONS FROM EM2 CODE -AJC
-                Gamma_rhs[pp] += sigma * (grad_0_Gamma[pp] + grad_1_Gamma[pp] +
-                                          grad_2_Gamma[pp]);
-
-                psi_rhs[pp] +=
-                    sigma * (grad_0_psi[pp] + grad_1_psi[pp] + grad_2_psi[pp]);
-
-                E_rhs0[pp] +=
-                    sigma * (grad_0_E0[pp] + grad_1_E0[pp] + grad_2_E0[pp]);
-                E_rhs1[pp] +=
-                    sigma * (grad_0_E1[pp] + grad_1_E1[pp] + grad_2_E1[pp]);
-                E_rhs2[pp] +=
-                    sigma * (grad_0_E2[pp] + grad_1_E2[pp] + grad_2_E2[pp]);
-
-                A_rhs0[pp] +=
-                    sigma * (grad_0_A0[pp] + grad_1_A0[pp] + grad_2_A0[pp]);
-                A_rhs1[pp] +=
-                    sigma * (grad_0_A1[pp] + grad_1_A1[pp] + grad_2_A1[pp]);
-                A_rhs2[pp] +=
-                    sigma * (grad_0_A2[pp] + grad_1_A2[pp] + grad_2_A2[pp]);
-
-                // clang-format off
-                /*[[[cog
-                cog.outl('// clang-format on')
-
-                cog.outl("// GENERATED KO DISSIPATION CALCULATIONS")
-                cog.outl(dendroconf.dendroConfigs.generate_ko_calculations("evolution"))
-
-                ]]]*/
-                // clang-format on
-
-                //[[[end]]]
-            }
-        }
+    const double *const ko_in[] = {Gamma, psi, E0, E1, E2, A0, A1, A2};
+    double *const ko_rhs[] = {Gamma_rhs, psi_rhs, E_rhs0, E_rhs1,
+                              E_rhs2,    A_rhs0,  A_rhs1, A_rhs2};
+    for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++) {
+        dendro_derivs::ko_dissipation(ko_rhs[v], ko_in[v], sigma, hx, hy, hz,
+                                      sz, bflag);
     }
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
 
-    dsolve::timer::t_rhs.stop();
-
-    dsolve::timer::t_deriv.start();
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
     // clang-format off
     /*[[[cog
     cog.outl('// clang-format on')
@@ -558,18 +563,20 @@ void solverrhs(double **unzipVarsRHS, const double **uZipVars,
     // clang-format on
 
     //[[[end]]]
+#ifdef SOLVER_ENABLE_SOURCES
     __mem_pool->free(J0);
     __mem_pool->free(J1);
     __mem_pool->free(J2);
 
     __mem_pool->free(rho_e);
-    dsolve::timer::t_deriv.stop();
+#endif
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
 }
 
-void solverrhs_compact_derivs(double **unzipVarsRHS, double **uZipVars,
-                              const unsigned int &offset, const double *pmin,
-                              const double *pmax, const unsigned int *sz,
-                              const unsigned int &bflag) {
+SOLVER_SIMD_CLONES void solverrhs_compact_derivs(
+    double **unzipVarsRHS, double **uZipVars, const unsigned int &offset,
+    const double *pmin, const double *pmax, const unsigned int *sz,
+    const unsigned int &bflag) {
     // NOTE: this has been cleaned up slightly to remove the code generation.
     // if the function above changes, be sure to reflect the changes here
     //
@@ -612,8 +619,6 @@ void solverrhs_compact_derivs(double **unzipVarsRHS, double **uZipVars,
         cfd.clear_boundary_padding_nans(Gamma, sz, bflag);
     }
 
-    mem::memory_pool<double> *__mem_pool = &SOLVER_MEM_POOL;
-
     const unsigned int nx = sz[0];
     const unsigned int ny = sz[1];
     const unsigned int nz = sz[2];
@@ -626,238 +631,128 @@ void solverrhs_compact_derivs(double **unzipVarsRHS, double **uZipVars,
     const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
     unsigned int n = sz[0] * sz[1] * sz[2];
 
-    dsolve::timer::t_deriv.start();
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
 
     const unsigned int BLK_SZ = n;
     const unsigned int bytes = n * sizeof(double);
-    // get derivative workspace
-    double *const deriv_base = dsolve::SOLVER_DERIV_WORKSPACE;
-
-    // Get the number of processes
-    int world_size;
-    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
-    int world_rank;
-    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    // get this thread's slice of the derivative workspace
+    double *const deriv_base = get_thread_deriv_workspace();
 
 #include "../gencode/solver_rhs_deriv_memalloc.cpp.inc"
 
-    // store a pointer to the variables that will be sent into our derivatives
-    // if we're not filtering there's no reason to change it
-    double *E0_cpy = (double *)E0;
-    double *E1_cpy = (double *)E1;
-    double *E2_cpy = (double *)E2;
-    double *A0_cpy = (double *)A0;
-    double *A1_cpy = (double *)A1;
-    double *A2_cpy = (double *)A2;
-    double *psi_cpy = (double *)psi;
-    double *Gamma_cpy = (double *)Gamma;
-
-    // make sure we only trigger this filtering if it's a filter designed for it
-    if (dsolve::SOLVER_FILTER_TYPE != dendro_cfd::FILT_NONE ||
-        dsolve::SOLVER_FILTER_TYPE != dendro_cfd::FILT_KO_DISS ||
-        dsolve::SOLVER_FILTER_TYPE != dendro_cfd::EXPLCT_KO) {
-        // first we need to update the pointer that feeds into the derivative
-        // calculation
-        E0_cpy = E_rhs0;
-        E1_cpy = E_rhs1;
-        E2_cpy = E_rhs2;
-        A0_cpy = A_rhs0;
-        A1_cpy = A_rhs1;
-        A2_cpy = A_rhs2;
-        psi_cpy = psi_rhs;
-        Gamma_cpy = Gamma_rhs;
-
-        // for each of the variables, we'll copy it over to the memory stored
-        // for it in the copy then it will be filtered. The filtered variables
-        // will then feed ONLY into the derivatives. We might want to use the
-        // "cpy" version for the RHS computations eventually to see if it helps,
-        // but at the very least the derivatives will get the filtered version.
-
-        // NOTE: grad_0_E0 is just a workspace, that's why it's reused
-        std::copy_n(E0, nx * ny * nz, E0_cpy);
-        cfd.filter_cfd_x(E0_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(E0_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(E0_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(E1, nx * ny * nz, E1_cpy);
-        cfd.filter_cfd_x(E1_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(E1_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(E1_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(E2, nx * ny * nz, E2_cpy);
-        cfd.filter_cfd_x(E2_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(E2_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(E2_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(A0, nx * ny * nz, A0_cpy);
-        cfd.filter_cfd_x(A0_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(A0_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(A0_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(A1, nx * ny * nz, A1_cpy);
-        cfd.filter_cfd_x(A1_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(A1_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(A1_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(A2, nx * ny * nz, A2_cpy);
-        cfd.filter_cfd_x(A2_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(A2_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(A2_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(psi, nx * ny * nz, A2_cpy);
-        cfd.filter_cfd_x(psi_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(psi_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(psi_cpy, grad_0_E0, hz, sz, bflag);
-
-        std::copy_n(Gamma, nx * ny * nz, A2_cpy);
-        cfd.filter_cfd_x(Gamma_cpy, grad_0_E0, hx, sz, bflag);
-        cfd.filter_cfd_y(Gamma_cpy, grad_0_E0, hy, sz, bflag);
-        cfd.filter_cfd_z(Gamma_cpy, grad_0_E0, hz, sz, bflag);
-    }
-
-    if (dsolve::SOLVER_DERIV_TYPE == dendro_cfd::CFD_NONE) {
-        dendro_derivs::deriv_x(grad_0_E0, E0_cpy, hx, sz, bflag);
-        dendro_derivs::deriv_y(grad_1_E0, E0_cpy, hy, sz, bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_E0, E0_cpy, hz, sz, bflag);  // needed
-
-        dendro_derivs::deriv_x(grad_0_E1, E1_cpy, hx, sz, bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_E1, E1_cpy, hy, sz, bflag);
-        dendro_derivs::deriv_z(grad_2_E1, E1_cpy, hz, sz, bflag);  // needed
-
-        dendro_derivs::deriv_x(grad_0_E2, E2_cpy, hx, sz, bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_E2, E2_cpy, hy, sz, bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_E2, E2_cpy, hz, sz, bflag);
-
-        dendro_derivs::deriv_x(grad_0_A0, A0_cpy, hx, sz, bflag);
-        dendro_derivs::deriv_y(grad_1_A0, A0_cpy, hy, sz, bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_A0, A0_cpy, hz, sz, bflag);  // needed
-
-        dendro_derivs::deriv_x(grad_0_A1, A1_cpy, hx, sz, bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_A1, A1_cpy, hy, sz, bflag);
-        dendro_derivs::deriv_z(grad_2_A1, A1_cpy, hz, sz, bflag);  // needed
-
-        dendro_derivs::deriv_x(grad_0_A2, A2_cpy, hx, sz, bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_A2, A2_cpy, hy, sz, bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_A2, A2_cpy, hz, sz, bflag);
-
-        dendro_derivs::deriv_x(grad_0_psi, psi_cpy, hx, sz, bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_psi, psi_cpy, hy, sz, bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_psi, psi_cpy, hz, sz, bflag);
-
-        dendro_derivs::deriv_x(grad_0_Gamma, Gamma_cpy, hx, sz,
-                               bflag);  // needed
-        dendro_derivs::deriv_y(grad_1_Gamma, Gamma_cpy, hy, sz,
-                               bflag);  // needed
-        dendro_derivs::deriv_z(grad_2_Gamma, Gamma_cpy, hz, sz, bflag);
+    const bool explicit_1st = dsolve::SOLVER_DERIV_TYPE == dendro_cfd::CFD_NONE;
+    const bool explicit_2nd =
+        dsolve::SOLVER_2ND_DERIV_TYPE == dendro_cfd::CFD2ND_NONE;
 
+    // Only the first derivatives of psi and Gamma appear in the RHS equations
+    // (solver_rhs_eqns.cpp.inc). The ones of E and A are read by the
+    // asymptotic boundary conditions alone, so they are only computed on
+    // boundary blocks, further down.
+    //
+    // psi needs both first and second derivatives. If both come from the same
+    // family, the fused kernel reads it only once.
+    const bool fuse_psi = (explicit_1st == explicit_2nd);
+
+    const double *const deriv_in[] = {Gamma, psi};
+    double *const deriv_x[] = {grad_0_Gamma, grad_0_psi};
+    double *const deriv_y[] = {grad_1_Gamma, grad_1_psi};
+    double *const deriv_z[] = {grad_2_Gamma, grad_2_psi};
+    const unsigned int num_1st = fuse_psi ? 1 : 2;
+
+    const double *const deriv2_in[] = {A0, A1, A2, psi};
+    double *const deriv2_xx[] = {grad2_0_0_A0, grad2_0_0_A1, grad2_0_0_A2,
+                                 grad2_0_0_psi};
+    double *const deriv2_yy[] = {grad2_1_1_A0, grad2_1_1_A1, grad2_1_1_A2,
+                                 grad2_1_1_psi};
+    double *const deriv2_zz[] = {grad2_2_2_A0, grad2_2_2_A1, grad2_2_2_A2,
+                                 grad2_2_2_psi};
+    const unsigned int num_2nd = fuse_psi ? 3 : 4;
+
+    if (explicit_1st) {
+        for (unsigned int v = 0; v < num_1st; v++) {
+            dendro_derivs::deriv_x(deriv_x[v], deriv_in[v], hx, sz, bflag);
+            dendro_derivs::deriv_y(deriv_y[v], deriv_in[v], hy, sz, bflag);
+            dendro_derivs::deriv_z(deriv_z[v], deriv_in[v], hz, sz, bflag);
+        }
     } else {
-        cfd.cfd_x(grad_0_E0, E0_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_E0, E0_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_E0, E0_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_E1, E1_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_E1, E1_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_E1, E1_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_E2, E2_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_E2, E2_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_E2, E2_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_A0, A0_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_A0, A0_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_A0, A0_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_A1, A1_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_A1, A1_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_A1, A1_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_A2, A2_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_A2, A2_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_A2, A2_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_psi, psi_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_psi, psi_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_psi, psi_cpy, hz, sz, bflag);
-
-        cfd.cfd_x(grad_0_Gamma, Gamma_cpy, hx, sz, bflag);
-        cfd.cfd_y(grad_1_Gamma, Gamma_cpy, hy, sz, bflag);
-        cfd.cfd_z(grad_2_Gamma, Gamma_cpy, hz, sz, bflag);
+        // the variables are differentiated at once along each direction
+        cfd.cfd_x_batched(deriv_x, deriv_in, num_1st, hx, sz, bflag);
+        cfd.cfd_y_batched(deriv_y, deriv_in, num_1st, hy, sz, bflag);
+        cfd.cfd_z_batched(deriv_z, deriv_in, num_1st, hz, sz, bflag);
     }
-    // after this point we no longer care about E0_cpy because we just needed it
-    // for our derivative inputs
-    //
 
-    if (dsolve::SOLVER_2ND_DERIV_TYPE == dendro_cfd::CFD2ND_NONE) {
-        // Second derivatives
-        //  2nd derivs for A0.
-        dendro_derivs::deriv_xx(grad2_0_0_A0, A0, hx, sz, bflag);
-        dendro_derivs::deriv_yy(grad2_1_1_A0, A0, hy, sz, bflag);
-        dendro_derivs::deriv_zz(grad2_2_2_A0, A0, hz, sz, bflag);
-
-        // 2nd derivs for A1
-        dendro_derivs::deriv_xx(grad2_0_0_A1, A1, hx, sz, bflag);
-        dendro_derivs::deriv_yy(grad2_1_1_A1, A1, hy, sz, bflag);
-        dendro_derivs::deriv_zz(grad2_2_2_A1, A1, hz, sz, bflag);
-
-        // 2nd derivs for A2
-        dendro_derivs::deriv_xx(grad2_0_0_A2, A2, hx, sz, bflag);
-        dendro_derivs::deriv_yy(grad2_1_1_A2, A2, hy, sz, bflag);
-        dendro_derivs::deriv_zz(grad2_2_2_A2, A2, hz, sz, bflag);
-
-        // 2nd derivs for psi
-        dendro_derivs::deriv_xx(grad2_0_0_psi, psi, hx, sz, bflag);
-        dendro_derivs::deriv_yy(grad2_1_1_psi, psi, hy, sz, bflag);
-        dendro_derivs::deriv_zz(grad2_2_2_psi, psi, hz, sz, bflag);
+    if (explicit_2nd) {
+        // Second derivatives of A0, A1, A2 (and psi)
+        for (unsigned int v = 0; v < num_2nd; v++) {
+            dendro_derivs::deriv_xx(deriv2_xx[v], deriv2_in[v], hx, sz, bflag);
+            dendro_derivs::deriv_yy(deriv2_yy[v], deriv2_in[v], hy, sz, bflag);
+            dendro_derivs::deriv_zz(deriv2_zz[v], deriv2_in[v], hz, sz, bflag);
+        }
     } else {
-        // Second derivatives
-        //  2nd derivs for A0.
-        cfd.cfd_xx(grad2_0_0_A0, A0, hx, sz, bflag);
-        cfd.cfd_yy(grad2_1_1_A0, A0, hy, sz, bflag);
-        cfd.cfd_zz(grad2_2_2_A0, A0, hz, sz, bflag);
-
-        // 2nd derivs for A1
-        cfd.cfd_xx(grad2_0_0_A1, A1, hx, sz, bflag);
-        cfd.cfd_yy(grad2_1_1_A1, A1, hy, sz, bflag);
-        cfd.cfd_zz(grad2_2_2_A1, A1, hz, sz, bflag);
-
-        // 2nd derivs for A2
-        cfd.cfd_xx(grad2_0_0_A2, A2, hx, sz, bflag);
-        cfd.cfd_yy(grad2_1_1_A2, A2, hy, sz, bflag);
-        cfd.cfd_zz(grad2_2_2_A2, A2, hz, sz, bflag);
-
-        // 2nd derivs for psi
-        cfd.cfd_xx(grad2_0_0_psi, psi, hx, sz, bflag);
-        cfd.cfd_yy(grad2_1_1_psi, psi, hy, sz, bflag);
-        cfd.cfd_zz(grad2_2_2_psi, psi, hz, sz, bflag);
+        // Second derivatives of A0, A1, A2 (and psi), batched like the first
+        cfd.cfd_xx_batched(deriv2_xx, deriv2_in, num_2nd, hx, sz, bflag);
+        cfd.cfd_yy_batched(deriv2_yy, deriv2_in, num_2nd, hy, sz, bflag);
+        cfd.cfd_zz_batched(deriv2_zz, deriv2_in, num_2nd, hz, sz, bflag);
     }
 
-    dsolve::timer::t_deriv.stop();
+    if (fuse_psi) {
+        if (explicit_2nd) {
+            dendro_derivs::deriv_grad_2nd(grad_0_psi, grad_1_psi, grad_2_psi,
+                                          grad2_0_0_psi, grad2_1_1_psi,
+                                          grad2_2_2_psi, psi, hx, hy, hz, sz,
+                                          bflag);
+        } else {
+            cfd.cfd_grad_2nd(grad_0_psi, grad_1_psi, grad_2_psi, grad2_0_0_psi,
+                             grad2_1_1_psi, grad2_2_2_psi, psi, hx, hy, hz, sz,
+                             bflag);
+        }
+    }
 
-    // TODO: is this even necessary?
+    if (bflag != 0) {
+        // gradients of E and A for the boundary conditions
+        const double *const bc_in[] = {E0, E1, E2, A0, A1, A2};
+        double *const bc_x[] = {grad_0_E0, grad_0_E1, grad_0_E2,
+                                grad_0_A0, grad_0_A1, grad_0_A2};
+        double *const bc_y[] = {grad_1_E0, grad_1_E1, grad_1_E2,
+                                grad_1_A0, grad_1_A1, grad_1_A2};
+        double *const bc_z[] = {grad_2_E0, grad_2_E1, grad_2_E2,
+                                grad_2_A0, grad_2_A1, grad_2_A2};
+
+        if (explicit_1st) {
+            for (unsigned int v = 0; v < 6; v++) {
+                dendro_derivs::deriv_face_grad(bc_x[v], bc_y[v], bc_z[v],
+                                               bc_in[v], hx, hy, hz, sz,
+                                               bflag);
+            }
+        } else {
+            // a compact derivative couples the whole line, so there is no
+            // cheaper face only version
+            cfd.cfd_x_batched(bc_x, bc_in, 6, hx, sz, bflag);
+            cfd.cfd_y_batched(bc_y, bc_in, 6, hy, sz, bflag);
+            cfd.cfd_z_batched(bc_z, bc_in, 6, hz, sz, bflag);
+        }
+    }
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
+
+#ifdef SOLVER_ENABLE_SOURCES
+    mem::memory_pool<double> *__mem_pool = get_thread_mem_pool();
     double *rho_e = __mem_pool->allocate(n);
 
     double *J0 = __mem_pool->allocate(n);
     double *J1 = __mem_pool->allocate(n);
     double *J2 = __mem_pool->allocate(n);
 
-    for (unsigned int m = 0; m < n; m++) {
-        rho_e[m] = 0.0;
-
-        J0[m] = 0.0;
-        J1[m] = 0.0;
-        J2[m] = 0.0;
-    }
+    dsolve::get_source_function()(rho_e, J0, J1, J2, pmin, pmax, sz);
+#else
+    // no sources, the zero terms fold away in the equations below
+    const dsolve::ZeroSource rho_e, J0, J1, J2;
+#endif
 
     // loop dep. removed allowing compiler to optmize for vectorization.
-    dsolve::timer::t_rhs.start();
+    dsolve::timer::start_master(dsolve::timer::t_rhs);
     for (unsigned int k = PW; k < nz - PW; k++) {
         for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
+            SOLVER_SIMD_LOOP(__RHS_AVX_SIMD_LEN__)
             for (unsigned int i = PW; i < nx - PW; i++) {
                 const double x = pmin[0] + i * hx;
                 const double y = pmin[1] + j * hy;
@@ -866,16 +761,14 @@ void solverrhs_compact_derivs(double **unzipVarsRHS, double **uZipVars,
                 const unsigned int pp = i + nx * (j + ny * k);
                 const double r_coord = sqrt(x * x + y * y + z * z);
 
-                // NOTE: (for now) we are not sending in the filtered E's and
-                // B's if they're used. (They're not! But it's good to note!)
 #include "../gencode/solver_rhs_eqns.cpp.inc"
             }
         }
     }
-    dsolve::timer::t_rhs.stop();
+    dsolve::timer::stop_master(dsolve::timer::t_rhs);
 
     if (bflag != 0) {
-        dsolve::timer::t_bdyc.start();
+        dsolve::timer::start_master(dsolve::timer::t_bdyc);
 
         asymptotic_and_falloff_bcs(E_rhs0, E0, grad_0_E0, grad_1_E0, grad_2_E0,
                                    pmin, pmax, 2.0, 0.0, sz, bflag);
@@ -899,66 +792,36 @@ void solverrhs_compact_derivs(double **unzipVarsRHS, double **uZipVars,
 
         //[[[end]]]
 
-        dsolve::timer::t_bdyc.stop();
+        dsolve::timer::stop_master(dsolve::timer::t_bdyc);
     }
 
     if (dsolve::SOLVER_FILTER_TYPE == dendro_cfd::FILT_KO_DISS ||
         dsolve::SOLVER_FILTER_TYPE == dendro_cfd::EXPLCT_KO) {
-        dsolve::timer::t_deriv.start();
+        dsolve::timer::start_master(dsolve::timer::t_deriv);
         // TODO: include more types of build options
 
         // TODO: support for CFD calculation of explicit KO derivs
-#include "../gencode/solver_rhs_ko_deriv_calc.cpp.inc"
-        dsolve::timer::t_deriv.stop();
-
-        dsolve::timer::t_rhs.start();
-
+        // each variable's dissipation is accumulated straight into its RHS
         const double sigma = KO_DISS_SIGMA;
-
-        for (unsigned int k = PW; k < nz - PW; k++) {
-            for (unsigned int j = PW; j < ny - PW; j++) {
-#ifdef SOLVER_ENABLE_AVX
-#ifdef __INTEL_COMPILER
-#pragma vector vectorlength(__RHS_AVX_SIMD_LEN__) vecremainder
-#pragma ivdep
-#endif
-#endif
-                for (unsigned int i = PW; i < nx - PW; i++) {
-                    const unsigned int pp = i + nx * (j + ny * k);
-                    Gamma_rhs[pp] +=
-                        sigma * (grad_0_Gamma[pp] + grad_1_Gamma[pp] +
-                                 grad_2_Gamma[pp]);
-
-                    psi_rhs[pp] += sigma * (grad_0_psi[pp] + grad_1_psi[pp] +
-                                            grad_2_psi[pp]);
-
-                    E_rhs0[pp] +=
-                        sigma * (grad_0_E0[pp] + grad_1_E0[pp] + grad_2_E0[pp]);
-                    E_rhs1[pp] +=
-                        sigma * (grad_0_E1[pp] + grad_1_E1[pp] + grad_2_E1[pp]);
-                    E_rhs2[pp] +=
-                        sigma * (grad_0_E2[pp] + grad_1_E2[pp] + grad_2_E2[pp]);
-
-                    A_rhs0[pp] +=
-                        sigma * (grad_0_A0[pp] + grad_1_A0[pp] + grad_2_A0[pp]);
-                    A_rhs1[pp] +=
-                        sigma * (grad_0_A1[pp] + grad_1_A1[pp] + grad_2_A1[pp]);
-                    A_rhs2[pp] +=
-                        sigma * (grad_0_A2[pp] + grad_1_A2[pp] + grad_2_A2[pp]);
-                }
-            }
+        const double *const ko_in[] = {Gamma, psi, E0, E1, E2, A0, A1, A2};
+        double *const ko_rhs[] = {Gamma_rhs, psi_rhs, E_rhs0, E_rhs1,
+                                  E_rhs2,    A_rhs0,  A_rhs1, A_rhs2};
+        for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++) {
+            dendro_derivs::ko_dissipation(ko_rhs[v], ko_in[v], sigma, hx, hy,
+                                          hz, sz, bflag);
         }
-
-        dsolve::timer::t_rhs.stop();
+        dsolve::timer::stop_master(dsolve::timer::t_deriv);
     }
 
-    dsolve::timer::t_deriv.start();
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
+#ifdef SOLVER_ENABLE_SOURCES
     __mem_pool->free(J0);
     __mem_pool->free(J1);
     __mem_pool->free(J2);
 
     __mem_pool->free(rho_e);
-    dsolve::timer::t_deriv.stop();
+#endif
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
 }
 
 /*----------------------------------------------------------------------;
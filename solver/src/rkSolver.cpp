@@ -38,6 +38,10 @@ RK_SOLVER::RK_SOLVER(ot::Mesh *pMesh, DendroScalar pTBegin, DendroScalar pTEnd,
         m_uiNumRKStages = dsolve::SOLVER_RK4_STAGES;
     else if (m_uiRKType == RKType::RK45)
         m_uiNumRKStages = dsolve::SOLVER_RK45_STAGES;
+    else if (m_uiRKType == RKType::LSRK3 || m_uiRKType == RKType::LSRK4)
+        // the low-storage schemes only need the dU register, which lives in
+        // m_uiVarIm, so no stage storage at all
+        m_uiNumRKStages = 0;
     else {
         if (!(pMesh->getMPIRankGlobal()))
             std::cout << "[RK Solver Error]: undefined rk solver type"
@@ -75,6 +79,7 @@ RK_SOLVER::RK_SOLVER(ot::Mesh *pMesh, DendroScalar pTBegin, DendroScalar pTEnd,
             m_uiMesh->createUnZippedVector<DendroScalar>();
 
     // mpi communication
+    m_uiGhostPlan.build(m_uiMesh, dsolve::SOLVER_NUM_VARS);
     m_uiSendNodeBuf = new DendroScalar *[dsolve::SOLVER_ASYNC_COMM_K];
     m_uiRecvNodeBuf = new DendroScalar *[dsolve::SOLVER_ASYNC_COMM_K];
 
@@ -288,13 +293,10 @@ void RK_SOLVER::initialGridConverge() {
         else {
             if (dsolve::SOLVER_REFINEMENT_MODE ==
                 dsolve::RefinementMode::WAMR) {
-                isRefine = m_uiMesh->isReMeshUnzip(
-                    (const double **)m_uiUnzipVar, refineVarIds, refineNumVars,
-                    waveletTolFunc, dsolve::SOLVER_DENDRO_AMR_FAC);
-                // isRefine = dsolve::isReMeshWAMR(
-                //     m_uiMesh, (const double **)m_uiUnzipVar, refineVarIds,
-                //     refineNumVars, waveletTolFunc,
-                //     dsolve::SOLVER_DENDRO_AMR_FAC);
+                isRefine = dsolve::isReMeshWAMR(
+                    m_uiMesh, (const double **)m_uiUnzipVar, refineVarIds,
+                    refineNumVars, waveletTolFunc,
+                    dsolve::SOLVER_DENDRO_AMR_FAC);
             } else {
                 std::cout << " Error : " << __func__
                           << " invalid refinement mode specified " << std::endl;
@@ -379,6 +381,7 @@ void RK_SOLVER::initialGridConverge() {
 
             std::swap(newMesh, m_uiMesh);
             delete newMesh;
+            m_uiGhostPlan.build(m_uiMesh, dsolve::SOLVER_NUM_VARS);
 
 #ifdef RK_SOLVER_OVERLAP_COMM_AND_COMP
             // reallocates mpi resources for the the new mesh. (this will
@@ -684,8 +687,8 @@ void RK_SOLVER::writeEvolutionAndRHStoVTU(double **evolZipVarIn,
 void RK_SOLVER::performGhostExchangeVars(DendroScalar **zipIn) {
     dsolve::timer::t_ghostEx_sync.start();
 
-    for (unsigned int v = 0; v < dsolve::SOLVER_NUM_VARS; v++)
-        m_uiMesh->performGhostExchange(zipIn[v]);
+    m_uiGhostPlan.start(zipIn);
+    m_uiGhostPlan.finish(zipIn);
 
     dsolve::timer::t_ghostEx_sync.stop();
 }
@@ -741,6 +744,92 @@ void RK_SOLVER::zipVars(DendroScalar **uzipIn, DendroScalar **zipOut) {
     dsolve::timer::t_zip.stop();
 }
 
+void RK_SOLVER::filterVars(DendroScalar **zipIn) {
+    performGhostExchangeVars(zipIn);
+    unzipVars(zipIn, m_uiUnzipVar);
+
+    dsolve::timer::t_deriv.start();
+    solverFilter(m_uiUnzipVar, m_uiMesh->getLocalBlockList().data(),
+                 m_uiMesh->getLocalBlockList().size());
+    dsolve::timer::t_deriv.stop();
+
+    zipVars(m_uiUnzipVar, zipIn);
+}
+
+void RK_SOLVER::checkHealth(DendroScalar **zipIn) {
+    int localBad =
+        dsolve::local_state_finite(m_uiMesh, zipIn, dsolve::SOLVER_NUM_VARS)
+            ? 0
+            : 1;
+    int globalBad = 0;
+    par::Mpi_Allreduce(&localBad, &globalBad, 1, MPI_MAX,
+                       m_uiMesh->getMPIGlobalCommunicator());
+    if (!globalBad) return;
+
+    // failure path only, find and write out the blocks
+    if (m_uiMesh->isActive()) {
+        performGhostExchangeVars(zipIn);
+        unzipVars(zipIn, m_uiUnzipVar);
+        if (localBad) {
+            dsolve::dump_unhealthy_blocks(
+                m_uiMesh, m_uiUnzipVar, dsolve::SOLVER_NUM_VARS,
+                dsolve::SOLVER_VAR_NAMES, m_uiCurrentStep, m_uiCurrentTime,
+                dsolve::SOLVER_VTU_FILE_PREFIX);
+        }
+    }
+
+    // let a checkpoint in flight finish, it is the last good state
+    m_uiCheckpointWriter.flush();
+    dsolve::abort_unhealthy_run(m_uiMesh->getMPIGlobalCommunicator(),
+                                m_uiCurrentStep, m_uiCurrentTime);
+}
+
+void RK_SOLVER::zipAndUpdateStage(DendroScalar **uzipRHS,
+                                  const unsigned int stage,
+                                  const double *coeffs,
+                                  DendroScalar **prevVar,
+                                  DendroScalar **varOut) {
+    const unsigned int nodeLocalBegin = m_uiMesh->getNodeLocalBegin();
+    const unsigned int nodeLocalEnd = m_uiMesh->getNodeLocalEnd();
+
+    // only the stages that actually contribute to the update
+    const DendroScalar *k[dsolve::SOLVER_RK45_STAGES];
+    double a[dsolve::SOLVER_RK45_STAGES];
+
+    for (unsigned int var = 0; var < dsolve::SOLVER_NUM_VARS; var++) {
+        dsolve::timer::t_zip.start();
+        m_uiMesh->zip(uzipRHS[var], m_uiStage[stage][var]);
+        dsolve::timer::t_zip.stop();
+
+        unsigned int num_terms = 0;
+        for (unsigned int s = 0; s <= stage; s++) {
+            if (coeffs[s] == 0.0) continue;
+            k[num_terms] = m_uiStage[s][var];
+            a[num_terms] = coeffs[s] * m_uiT_h;
+            num_terms++;
+        }
+
+        const DendroScalar *const prev = prevVar[var];
+        DendroScalar *const out = varOut[var];
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd; node++) {
+            DendroScalar u = prev[node];
+            for (unsigned int t = 0; t < num_terms; t++) u += a[t] * k[t][node];
+            out[node] = u;
+        }
+    }
+
+    // the constraints need every variable at a node, so they get their own
+    // pass, but only if there are any
+    if (dsolve::SOLVER_HAS_SYSTEM_CONSTRAINTS) {
+        for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd; node++)
+            enforce_system_constraints(varOut, node);
+    }
+}
+
 void RK_SOLVER::applyBoundaryConditions() {}
 
 void RK_SOLVER::performSingleIterationRK3() {
@@ -1123,8 +1212,13 @@ void RK_SOLVER::performSingleIterationRK4() {
             ot::test::isUnzipInternalNaN(m_uiMesh, m_uiUnzipVarRHS[index]);
 #endif
 
-        // zip the calculated RHS variables into the "stage" variable
-        zipVars(m_uiUnzipVarRHS, m_uiStage[stage]);
+        // zip the calculated RHS variables into the "stage" variable and
+        // assign the "previous" variable values plus the stage contribution
+        // to the intermediate step in the same pass
+        double stage_coeffs[dsolve::SOLVER_RK4_STAGES] = {};
+        stage_coeffs[stage] = RK4_U[stage + 1];
+        zipAndUpdateStage(m_uiUnzipVarRHS, stage, stage_coeffs, m_uiPrevVar,
+                          m_uiVarIm);
 
 #ifdef DEBUG_RK_SOLVER
         for (unsigned int index = 0; index < dsolve::SOLVER_NUM_VARS; index++)
@@ -1136,28 +1230,6 @@ void RK_SOLVER::performSingleIterationRK4() {
                           << std::endl;
 #endif
 
-        /*for(unsigned int index=0;index<dsolve::SOLVER_NUM_VARS;index++)
-            for(unsigned int node=nodeLocalBegin;node<nodeLocalEnd;node++)
-                m_uiStage[stage][index][node]*=m_uiT_h;*/
-
-        // throughout the nodes we need to assign the "previous" variable
-        // values to the intermediate step and enforce constraints
-        for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd; node++) {
-            for (unsigned int index = 0; index < dsolve::SOLVER_NUM_VARS;
-                 index++) {
-                m_uiVarIm[index][node] = m_uiPrevVar[index][node];
-
-                m_uiVarIm[index][node] += (RK4_U[stage + 1] * m_uiT_h *
-                                           m_uiStage[stage][index][node]);
-            }
-
-            // if ( node == 101 ) {
-            // std::cout << "yo 5 node=" << node << std::endl ;
-            //}
-
-            enforce_system_constraints(m_uiVarIm, node);
-        }
-
 #ifdef SOLVER_SAVE_RHS_EVERY_SINGLE_STEP
         // TEMP: save the output of the current variables!!!
         std::cout << "Now saving RHS portion" << std::endl;
@@ -1201,31 +1273,96 @@ void RK_SOLVER::performSingleIterationRK4() {
         ot::test::isUnzipInternalNaN(m_uiMesh, m_uiUnzipVarRHS[index]);
 #endif
     // put the unziped RHS values into the "stage" storage for the final RK4
-    // stage
-    zipVars(m_uiUnzipVarRHS, m_uiStage[(dsolve::SOLVER_RK4_STAGES - 1)]);
+    // stage and update the variables with the weighted sum of all stages
+    zipAndUpdateStage(m_uiUnzipVarRHS, (dsolve::SOLVER_RK4_STAGES - 1), RK4_C,
+                      m_uiPrevVar, m_uiVar);
+
+    // std::cout << "Finished RK4 Step!" << std::endl;
+}
 
-    // std::cout << "Running final step for RK4 solver with " << nodeLocalEnd <<
-    // " nodes:" << std::endl;
+void RK_SOLVER::performSingleIterationLSRK(const double *A, const double *B,
+                                           const double *T,
+                                           const unsigned int numStages) {
+    double current_t = m_uiCurrentTime;
+    double current_t_adv = current_t;
 
-    // update the variables with the calculated update based on RHS
-    for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd; node++) {
-        for (unsigned int index = 0; index < dsolve::SOLVER_NUM_VARS; index++) {
-            m_uiVar[index][node] = m_uiPrevVar[index][node];
-            for (unsigned int s = 0; s < (dsolve::SOLVER_RK4_STAGES); s++) {
-                m_uiVar[index][node] +=
-                    (RK4_C[s] * m_uiT_h * m_uiStage[s][index][node]);
+#ifdef RK_SOLVER_OVERLAP_COMM_AND_COMP
+    // async unzip to assign the "prevVar" values to the unzip variable
+    unzipVars_async(m_uiPrevVar, m_uiUnzipVar);
+#else
+    // ghost exchange and then unzip if there is no overlap enabled
+    performGhostExchangeVars(m_uiPrevVar);
+    unzipVars(m_uiPrevVar, m_uiUnzipVar);
+#endif
+
+    const unsigned int nodeLocalBegin = m_uiMesh->getNodeLocalBegin();
+    const unsigned int nodeLocalEnd = m_uiMesh->getNodeLocalEnd();
+
+    const std::vector<ot::Block> &blkList = m_uiMesh->getLocalBlockList();
+
+    // the solution is updated in place in m_uiVar and the dU register is
+    // m_uiVarIm. m_uiPrevVar is only read by the first stage, after that it
+    // is free and used as the zip target for the RHS
+    for (unsigned int stage = 0; stage < numStages; stage++) {
+        current_t_adv = current_t + T[stage] * m_uiT_h;
+
+        solverRHS(m_uiUnzipVarRHS, (const DendroScalar **)m_uiUnzipVar,
+                  &(*(blkList.begin())), blkList.size());
+
+        for (unsigned int var = 0; var < dsolve::SOLVER_NUM_VARS; var++) {
+            DendroScalar *const du = m_uiVarIm[var];
+            DendroScalar *const u = m_uiVar[var];
+
+            if (stage == 0) {
+                // A[0] is zero, so the RHS can go straight into dU
+                dsolve::timer::t_zip.start();
+                m_uiMesh->zip(m_uiUnzipVarRHS[var], du);
+                dsolve::timer::t_zip.stop();
+
+                const DendroScalar *const u_prev = m_uiPrevVar[var];
+                const double b = B[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd;
+                     node++) {
+                    du[node] = m_uiT_h * du[node];
+                    u[node] = u_prev[node] + b * du[node];
+                }
+            } else {
+                DendroScalar *const k = m_uiPrevVar[var];
+                dsolve::timer::t_zip.start();
+                m_uiMesh->zip(m_uiUnzipVarRHS[var], k);
+                dsolve::timer::t_zip.stop();
+
+                const double a = A[stage];
+                const double b = B[stage];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd;
+                     node++) {
+                    du[node] = a * du[node] + m_uiT_h * k[node];
+                    u[node] += b * du[node];
+                }
             }
         }
 
-        // if ( node == 101 ) {
-        // std::cout << "yo 6 node=" << node << std::endl ;
-        //}
+        if (dsolve::SOLVER_HAS_SYSTEM_CONSTRAINTS) {
+            for (unsigned int node = nodeLocalBegin; node < nodeLocalEnd;
+                 node++)
+                enforce_system_constraints(m_uiVar, node);
+        }
 
-        // enforce constraints again just to make sure we didn't mess up
-        enforce_system_constraints(m_uiVar, node);
-    }
+        if (stage == numStages - 1) break;
 
-    // std::cout << "Finished RK4 Step!" << std::endl;
+#ifdef RK_SOLVER_OVERLAP_COMM_AND_COMP
+        unzipVars_async(m_uiVar, m_uiUnzipVar);
+#else
+        performGhostExchangeVars(m_uiVar);
+        unzipVars(m_uiVar, m_uiUnzipVar);
+#endif
+    }
 }
 
 void RK_SOLVER::performSingleIterationRK45() {
@@ -1617,6 +1754,14 @@ void RK_SOLVER::performSingleIteration() {
         } else if (m_uiRKType == RKType::RK45) {
             // rk45 solver
             performSingleIterationRK45();
+        } else if (m_uiRKType == RKType::LSRK3) {
+            // low-storage rk3 solver
+            performSingleIterationLSRK(LSRK3_A, LSRK3_B, LSRK3_T,
+                                       dsolve::SOLVER_LSRK3_STAGES);
+        } else if (m_uiRKType == RKType::LSRK4) {
+            // low-storage rk4 solver
+            performSingleIterationLSRK(LSRK4_A, LSRK4_B, LSRK4_T,
+                                       dsolve::SOLVER_LSRK4_STAGES);
         }
     }
 
@@ -1731,14 +1876,10 @@ void RK_SOLVER::rkSolve() {
                 // rely on black hole positioning
                 if (dsolve::SOLVER_REFINEMENT_MODE ==
                     dsolve::RefinementMode::WAMR) {
-                    isRefine = m_uiMesh->isReMeshUnzip(
-                        (const double **)m_uiUnzipVar, refineVarIds,
-                        refineNumVars, waveletTolFunc,
+                    isRefine = dsolve::isReMeshWAMR(
+                        m_uiMesh, (const double **)m_uiUnzipVar,
+                        refineVarIds, refineNumVars, waveletTolFunc,
                         dsolve::SOLVER_DENDRO_AMR_FAC);
-                    // isRefine = dsolve::isReMeshWAMR(
-                    //     m_uiMesh, (const double **)m_uiUnzipVar,
-                    //     refineVarIds, refineNumVars, waveletTolFunc,
-                    //     dsolve::SOLVER_DENDRO_AMR_FAC);
                 } else {
                     std::cout << " Error : " << __func__
                               << " invalid refinement mode specified "
@@ -1818,6 +1959,9 @@ void RK_SOLVER::rkSolve() {
                                  fN4, globalComm);
 
 #endif
+                // a checkpoint in flight still refers to the old mesh
+                m_uiCheckpointWriter.flush();
+
                 dsolve::timer::t_mesh.start();
                 ot::Mesh *newMesh = m_uiMesh->ReMesh(
                     dsolve::SOLVER_DENDRO_GRAIN_SZ, dsolve::SOLVER_LOAD_IMB_TOL,
@@ -1884,6 +2028,7 @@ void RK_SOLVER::rkSolve() {
 
                 std::swap(newMesh, m_uiMesh);
                 delete newMesh;
+                m_uiGhostPlan.build(m_uiMesh, dsolve::SOLVER_NUM_VARS);
 
                 if (m_uiCurrentStep == 0) applyInitialConditions(m_uiPrevVar);
 
@@ -1956,9 +2101,20 @@ void RK_SOLVER::rkSolve() {
         dsolve::timer::t_rkStep.stop();
 
         std::swap(m_uiVar, m_uiPrevVar);
+
+        // same cadence as SOLVERCtx::post_timestep, the step counter was
+        // already advanced
+        if (m_uiMesh->isActive() && solverFilterDue(m_uiCurrentStep))
+            filterVars(m_uiPrevVar);
+
+        if (dsolve::SOLVER_HEALTH_CHECK_FREQ != 0 &&
+            (m_uiCurrentStep % dsolve::SOLVER_HEALTH_CHECK_FREQ) == 0)
+            checkHealth(m_uiPrevVar);
         // dsolve::artificial_dissipation(m_uiMesh,m_uiPrevVar,dsolve::SOLVER_NUM_VARS,dsolve::SOLVER_DISSIPATION_NC,dsolve::SOLVER_DISSIPATION_S,false);
         // if(m_uiCurrentStep==1) break;
     }
+
+    m_uiCheckpointWriter.flush();
 }
 
 void RK_SOLVER::storeCheckPoint(const char *fNamePrefix) {
@@ -1968,38 +2124,11 @@ void RK_SOLVER::storeCheckPoint(const char *fNamePrefix) {
             ? cpIndex = 0
             : cpIndex = 1;  // to support alternate file writing.
         unsigned int rank = m_uiMesh->getMPIRank();
-        unsigned int npes = m_uiMesh->getMPICommSize();
-
-        char fName[256];
-        const ot::TreeNode *pNodes = &(*(m_uiMesh->getAllElements().begin() +
-                                         m_uiMesh->getElementLocalBegin()));
-        sprintf(fName, "%s_octree_%d_%d.oct", fNamePrefix, cpIndex, rank);
-        io::checkpoint::writeOctToFile(fName, pNodes,
-                                       m_uiMesh->getNumLocalMeshElements());
 
         unsigned int numVars = dsolve::SOLVER_NUM_VARS;
-        const char **varNames = dsolve::SOLVER_VAR_NAMES;
-
-        /*for(unsigned int i=0;i<numVars;i++)
-{
-    sprintf(fName,"%s_%s_%d_%d.var",fNamePrefix,varNames[i],cpIndex,rank);
-    io::checkpoint::writeVecToFile(fName,m_uiMesh,m_uiPrevVar[i]);
-}*/
-
-        sprintf(fName, "%s_%d_%d.var", fNamePrefix, cpIndex, rank);
-        io::checkpoint::writeVecToFile(fName, m_uiMesh,
-                                       (const double **)m_uiPrevVar,
-                                       dsolve::SOLVER_NUM_VARS);
 
+        std::string cpJson;
         if (!rank) {
-            sprintf(fName, "%s_step_%d.cp", fNamePrefix, cpIndex);
-            std::cout << "writing : " << fName << std::endl;
-            std::ofstream outfile(fName);
-            if (!outfile) {
-                std::cout << fName << " file open failed " << std::endl;
-                return;
-            }
-
             json checkPoint;
             checkPoint["DENDRO_RK45_TIME_BEGIN"] = m_uiTimeBegin;
             checkPoint["DENDRO_RK45_TIME_END"] = m_uiTimeEnd;
@@ -2020,9 +2149,14 @@ void RK_SOLVER::storeCheckPoint(const char *fNamePrefix) {
                 m_uiMesh
                     ->getMPICommSize();  // (note that rank 0 is always active).
 
-            outfile << std::setw(4) << checkPoint << std::endl;
-            outfile.close();
+            cpJson = checkPoint.dump(4);
         }
+
+        // .oct/.var files are written from a snapshot of m_uiPrevVar, the
+        // .cp file is committed once every rank finished them
+        m_uiCheckpointWriter.write(m_uiMesh, m_uiPrevVar, numVars, cpIndex,
+                                   fNamePrefix, cpJson,
+                                   dsolve::SOLVER_CHKPT_ASYNC);
     }
 }
 
@@ -2260,6 +2394,7 @@ void RK_SOLVER::restoreCheckPoint(const char *fNamePrefix, MPI_Comm comm) {
 
         std::swap(m_uiMesh, newMesh);
         delete newMesh;
+        m_uiGhostPlan.build(m_uiMesh, dsolve::SOLVER_NUM_VARS);
 
         dsolve::deallocate_deriv_workspace();
         dsolve::allocate_deriv_workspace(m_uiMesh, 1);
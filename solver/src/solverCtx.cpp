@@ -14,7 +14,11 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cassert>
 #include <ios>
+#include <limits>
+#include <string>
 
 #include "dendro.h"
 #include "derivs.h"
@@ -90,6 +94,7 @@ SOLVERCtx::SOLVERCtx(ot::Mesh *pMesh) : Ctx() {
                                       SOLVER_ASYNC_COMM_K);
     ot::alloc_mpi_ctx<DendroScalar>(m_uiMesh, m_mpi_ctx, SOLVER_NUM_VARS,
                                     SOLVER_ASYNC_COMM_K);
+    m_uiGhostPlan.build(m_uiMesh, SOLVER_NUM_VARS);
 
     // then initialize the CFD stuff
 
@@ -102,6 +107,13 @@ SOLVERCtx::SOLVERCtx(ot::Mesh *pMesh) : Ctx() {
                                    dsolve::SOLVER_KIM_FILTER_EPS);
     dendro_cfd::cfd.set_deriv_boundary_type(dsolve::SOLVER_DERIV_CLOSURE_TYPE);
 
+    dendro_cfd::cfd.set_matrix_cache_dir(dsolve::SOLVER_CFD_MATRIX_CACHE_DIR);
+    if (dsolve::SOLVER_CFD_SHARE_MATRICES) {
+        // collective, every rank builds a ctx
+        dendro_cfd::cfd.set_shared_matrices(
+            m_uiMesh->getMPIGlobalCommunicator());
+    }
+
     // NOTE: calling this function will reinitialize the entire cfd object.
     // It should calculate everything!
     dendro_cfd::cfd.change_dim_size(2 * dsolve::SOLVER_ELE_ORDER + 1);
@@ -117,11 +129,15 @@ SOLVERCtx::SOLVERCtx(ot::Mesh *pMesh) : Ctx() {
 }
 
 SOLVERCtx::~SOLVERCtx() {
+    // the mesh is still alive here, commit a checkpoint in flight
+    m_uiCheckpointWriter.flush();
+
     for (unsigned int i = 0; i < VL::END; i++) m_var[i].destroy_vector();
 
     deallocate_deriv_workspace();
     ot::dealloc_mpi_ctx<DendroScalar>(m_uiMesh, m_mpi_ctx, SOLVER_NUM_VARS,
                                       SOLVER_ASYNC_COMM_K);
+    m_uiGhostPlan.release();
 }
 
 int SOLVERCtx::rhs(DVec *in, DVec *out, unsigned int sz, DendroScalar time) {
@@ -130,17 +146,73 @@ int SOLVERCtx::rhs(DVec *in, DVec *out, unsigned int sz, DendroScalar time) {
     // DendroScalar **sVar;
     // in[0].Get2DArray(sVar, false);
 
-    this->unzip(*in, m_var[VL::CPU_EV_UZ_IN], dsolve::SOLVER_ASYNC_COMM_K);
+    DendroScalar *unzipIn[SOLVER_NUM_VARS];
+    DendroScalar *unzipOut[SOLVER_NUM_VARS];
+
+    m_var[CPU_EV_UZ_IN].to_2d(unzipIn);
+    m_var[CPU_EV_UZ_OUT].to_2d(unzipOut);
+
+    DendroScalar *zipIn[SOLVER_NUM_VARS];
+    in->to_2d(zipIn);
+
+    // the first stage of a step evaluates the evolution variables themselves,
+    // if the remesh test (or the constraints) unzipped them already the
+    // exchange and unzip are skipped. Either way the unzip buffer holds a
+    // stage input afterwards. The steppers pass their own DVec handles (ETS
+    // keeps a copy of the one set_evolve_vars got), so the storage is
+    // compared, not the handles
+    DendroScalar *evar[SOLVER_NUM_VARS];
+    m_var[VL::CPU_EV].to_2d(evar);
+    const bool reuseUnzip = (zipIn[0] == evar[0]) && m_uiEvUnzipSynced;
+    m_uiEvUnzipSynced = false;
+
+#ifdef SOLVER_OVERLAP_COMM_AND_COMP
+    if (!m_uiBlkSplitSynced) split_blocks_by_ghost_dependence();
+
+    // post the ghost exchange and unzip the independent blocks right away,
+    // they only read local nodes so their RHS hides the exchange
+    if (!reuseUnzip) {
+        m_uiGhostPlan.start(zipIn);
+        for (unsigned int v = 0; v < SOLVER_NUM_VARS; v++)
+            m_uiMesh->unzip(zipIn[v], unzipIn[v], m_uiIndepBlkIds.data(),
+                            m_uiIndepBlkIds.size());
+    }
 
 #ifdef __PROFILE_CTX__
     this->m_uiCtxpt[ts::CTXPROFILE::RHS].start();
 #endif
+    solverRHS(unzipOut, unzipIn, m_uiIndepBlocks.data(),
+              m_uiIndepBlocks.size());
+#ifdef __PROFILE_CTX__
+    this->m_uiCtxpt[ts::CTXPROFILE::RHS].stop();
+#endif
 
-    DendroScalar *unzipIn[SOLVER_NUM_VARS];
-    DendroScalar *unzipOut[SOLVER_NUM_VARS];
+    // each block is unzipped exactly once per stage, as without the overlap
+    if (!reuseUnzip) {
+        m_uiGhostPlan.finish(zipIn);
+        for (unsigned int v = 0; v < SOLVER_NUM_VARS; v++)
+            m_uiMesh->unzip(zipIn[v], unzipIn[v], m_uiDepBlkIds.data(),
+                            m_uiDepBlkIds.size());
+    }
 
-    m_var[CPU_EV_UZ_IN].to_2d(unzipIn);
-    m_var[CPU_EV_UZ_OUT].to_2d(unzipOut);
+#ifdef __PROFILE_CTX__
+    this->m_uiCtxpt[ts::CTXPROFILE::RHS].start();
+#endif
+    solverRHS(unzipOut, unzipIn, m_uiDepBlocks.data(), m_uiDepBlocks.size());
+#ifdef __PROFILE_CTX__
+    this->m_uiCtxpt[ts::CTXPROFILE::RHS].stop();
+#endif
+#else
+    if (!reuseUnzip) {
+        m_uiGhostPlan.start(zipIn);
+        m_uiGhostPlan.finish(zipIn);
+        for (unsigned int v = 0; v < SOLVER_NUM_VARS; v++)
+            m_uiMesh->unzip(zipIn[v], unzipIn[v]);
+    }
+
+#ifdef __PROFILE_CTX__
+    this->m_uiCtxpt[ts::CTXPROFILE::RHS].start();
+#endif
 
     const ot::Block *blkList = m_uiMesh->getLocalBlockList().data();
     const unsigned int numBlocks = m_uiMesh->getLocalBlockList().size();
@@ -149,6 +221,7 @@ int SOLVERCtx::rhs(DVec *in, DVec *out, unsigned int sz, DendroScalar time) {
 
 #ifdef __PROFILE_CTX__
     this->m_uiCtxpt[ts::CTXPROFILE::RHS].stop();
+#endif
 #endif
 
     // NOTE: here is where dumping to binary file would be appropriate for
@@ -159,6 +232,56 @@ int SOLVERCtx::rhs(DVec *in, DVec *out, unsigned int sz, DendroScalar time) {
     return 0;
 }
 
+void SOLVERCtx::split_blocks_by_ghost_dependence() {
+    m_uiIndepBlocks.clear();
+    m_uiDepBlocks.clear();
+    m_uiIndepBlkIds.clear();
+    m_uiDepBlkIds.clear();
+    m_uiBlkSplitSynced = true;
+
+    if (!m_uiMesh->isActive()) return;
+
+    const std::vector<ot::Block> &blkList = m_uiMesh->getLocalBlockList();
+    const unsigned int nodeLocalBegin = m_uiMesh->getNodeLocalBegin();
+    const unsigned int nodeLocalEnd = m_uiMesh->getNodeLocalEnd();
+
+    // NaN survives any interpolation weight (0 * NaN is NaN), so a block
+    // picks up a NaN exactly when its unzip touches a ghost node. The
+    // padding of boundary blocks is not written by the unzip and stays 0
+    DendroScalar *probe = m_uiMesh->createVector<DendroScalar>(
+        std::numeric_limits<DendroScalar>::quiet_NaN());
+    DendroScalar *probeUnzip = m_uiMesh->createUnZippedVector<DendroScalar>();
+    std::fill(probeUnzip, probeUnzip + m_uiMesh->getDegOfFreedomUnZip(),
+              (DendroScalar)0);
+    std::fill(probe + nodeLocalBegin, probe + nodeLocalEnd, (DendroScalar)0);
+
+    m_uiMesh->unzip(probe, probeUnzip);
+
+    for (unsigned int b = 0; b < blkList.size(); b++) {
+        const ot::Block &blk = blkList[b];
+        const unsigned int sz = blk.getAllocationSzX() *
+                                blk.getAllocationSzY() *
+                                blk.getAllocationSzZ();
+        if (all_finite(probeUnzip + blk.getOffset(), sz)) {
+            m_uiIndepBlocks.push_back(blk);
+            m_uiIndepBlkIds.push_back(b);
+        } else {
+            m_uiDepBlocks.push_back(blk);
+            m_uiDepBlkIds.push_back(b);
+        }
+    }
+
+    delete[] probe;
+    delete[] probeUnzip;
+}
+
+void SOLVERCtx::unzip_evolution_vars() {
+    if (m_uiEvUnzipSynced) return;
+    this->unzip(m_var[VL::CPU_EV], m_var[VL::CPU_EV_UZ_IN],
+                dsolve::SOLVER_ASYNC_COMM_K);
+    m_uiEvUnzipSynced = true;
+}
+
 void SOLVERCtx::compute_constraints() {
     // early exit if the constraints have already been computed
     // this is fine for any and all processes, even inactive ones
@@ -169,7 +292,7 @@ void SOLVERCtx::compute_constraints() {
         DVec &m_evar_unz = m_var[VL::CPU_EV_UZ_IN];
         DVec &m_cvar = m_var[VL::CPU_CV];
         DVec &m_cvar_unz = m_var[VL::CPU_CV_UZ_IN];
-        this->unzip(m_evar, m_evar_unz, SOLVER_ASYNC_COMM_K);
+        this->unzip_evolution_vars();
 
         DendroScalar *consUnzipVar[dsolve::SOLVER_CONSTRAINT_NUM_VARS];
         DendroScalar *consVar[dsolve::SOLVER_CONSTRAINT_NUM_VARS];
@@ -429,8 +552,8 @@ void SOLVERCtx::compute_analytical() {
     m_analyticalComputed = true;
 }
 
-// NOTE: the blkwise computations are *not* considered anymore, but there are a
-// few changes made to BSSN code
+// NOTE: the DVec based blkwise RHS is *not* used anymore, the local time
+// stepper (ts::ExplicitNUTS) works through rhs_blk and the *_blk hooks below
 #if 0
 int SOLVERCtx::rhs_blkwise(DVec in, DVec out, const unsigned int *const blkIDs,
                          unsigned int numIds, DendroScalar *blk_time) const {
@@ -494,74 +617,42 @@ int SOLVERCtx::rhs_blkwise(DVec in, DVec out, const unsigned int *const blkIDs,
 
     return 0;
 }
+#endif
 
 int SOLVERCtx::rhs_blk(const DendroScalar *in, DendroScalar *out,
-                     unsigned int dof, unsigned int local_blk_id,
-                     DendroScalar blk_time) const {
-    // return 0;
-    // std::cout<<"solver_rhs"<<std::endl;
-    DendroScalar **unzipIn = new DendroScalar *[dof];
-    DendroScalar **unzipOut = new DendroScalar *[dof];
-
+                       unsigned int dof, unsigned int local_blk_id,
+                       DendroScalar blk_time) const {
+    assert(dof == SOLVER_NUM_VARS);
     const unsigned int blk = local_blk_id;
-
     const ot::Block *blkList = m_uiMesh->getLocalBlockList().data();
-    const unsigned int numBlocks = m_uiMesh->getLocalBlockList().size();
-    double ptmin[3], ptmax[3];
-    unsigned int sz[3];
-    unsigned int bflag;
-    double dx, dy, dz;
+
     const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
                        dsolve::SOLVER_COMPD_MIN[2]);
     const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
                        dsolve::SOLVER_COMPD_MAX[2]);
     const unsigned int PW = dsolve::SOLVER_PADDING_WIDTH;
 
+    unsigned int sz[3];
     sz[0] = blkList[blk].getAllocationSzX();
     sz[1] = blkList[blk].getAllocationSzY();
     sz[2] = blkList[blk].getAllocationSzZ();
-
     const unsigned int NN = sz[0] * sz[1] * sz[2];
 
-    for (unsigned int v = 0; v < dof; v++) {
+    // the padded block of each variable follows the previous one
+    DendroScalar *unzipIn[SOLVER_NUM_VARS];
+    DendroScalar *unzipOut[SOLVER_NUM_VARS];
+    for (unsigned int v = 0; v < SOLVER_NUM_VARS; v++) {
         unzipIn[v] = (DendroScalar *)(in + v * NN);
-        unzipOut[v] = (DendroScalar *)(out + v * NN);
+        unzipOut[v] = out + v * NN;
     }
 
-    bflag = blkList[blk].getBlkNodeFlag();
-    const unsigned int pw = blkList[blk].get1DPadWidth();
-
-    // if(!bflag)
-    // {
-    //     // for(unsigned int node=0; node < NN; node++)
-    //     //     enforce_system_constraints(unzipIn, node);
-    //     for(unsigned int k=pw; k < sz[2]-pw; k++)
-    //     for(unsigned int j=pw; j < sz[1]-pw; j++)
-    //     for(unsigned int i=pw; i < sz[0]-pw; i++)
-    //     {
-    //         const unsigned nid = k*sz[1]*sz[0] + j*sz[0] + i;
-    //         enforce_system_constraints(unzipIn,nid);
-    //     }
-
-    // }else
-    // {
-    //     // note that we can apply enforce solver constraints in the right padd,
-    //     at the left boundary block,
-    //     // currently we only apply internal parts of the boundary blocks.
-    //     for(unsigned int k=pw; k < sz[2]-pw; k++)
-    //     for(unsigned int j=pw; j < sz[1]-pw; j++)
-    //     for(unsigned int i=pw; i < sz[0]-pw; i++)
-    //     {
-    //         const unsigned nid = k*sz[1]*sz[0] + j*sz[0] + i;
-    //         enforce_system_constraints(unzipIn,nid);
-    //     }
-
-    // }
-
-    dx = blkList[blk].computeDx(pt_min, pt_max);
-    dy = blkList[blk].computeDy(pt_min, pt_max);
-    dz = blkList[blk].computeDz(pt_min, pt_max);
+    const unsigned int bflag = blkList[blk].getBlkNodeFlag();
+
+    const double dx = blkList[blk].computeDx(pt_min, pt_max);
+    const double dy = blkList[blk].computeDy(pt_min, pt_max);
+    const double dz = blkList[blk].computeDz(pt_min, pt_max);
 
+    double ptmin[3], ptmax[3];
     ptmin[0] = GRIDX_TO_X(blkList[blk].getBlockNode().minX()) - PW * dx;
     ptmin[1] = GRIDY_TO_Y(blkList[blk].getBlockNode().minY()) - PW * dy;
     ptmin[2] = GRIDZ_TO_Z(blkList[blk].getBlockNode().minZ()) - PW * dz;
@@ -570,147 +661,79 @@ int SOLVERCtx::rhs_blk(const DendroScalar *in, DendroScalar *out,
     ptmax[1] = GRIDY_TO_Y(blkList[blk].getBlockNode().maxY()) + PW * dy;
     ptmax[2] = GRIDZ_TO_Z(blkList[blk].getBlockNode().maxZ()) + PW * dz;
 
-#ifdef SOLVER_RHS_STAGED_COMP
-    solverrhs_sep(unzipOut, (const DendroScalar **)unzipIn, 0, ptmin, ptmax, sz,
-                bflag);
+    // same kernels as solverRHS, just for one block
+#ifdef EM2_ENABLE_COMPACT_DERIVS
+    solverrhs_compact_derivs(unzipOut, unzipIn, 0, ptmin, ptmax, sz, bflag);
 #else
     solverrhs(unzipOut, (const DendroScalar **)unzipIn, 0, ptmin, ptmax, sz,
-            bflag);
+              bflag);
 #endif
 
-    delete[] unzipIn;
-    delete[] unzipOut;
-
     return 0;
 }
 
-int SOLVERCtx::pre_stage_blk(DendroScalar *in, unsigned int dof,
-                           unsigned int local_blk_id,
-                           DendroScalar blk_time) const {
-    DendroScalar **unzipIn = new DendroScalar *[dof];
-    const unsigned int blk = local_blk_id;
-
-    const ot::Block *blkList = m_uiMesh->getLocalBlockList().data();
-    const unsigned int numBlocks = m_uiMesh->getLocalBlockList().size();
-    double ptmin[3], ptmax[3];
-    unsigned int sz[3];
-    unsigned int bflag;
-    double dx, dy, dz;
-    const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
-                       dsolve::SOLVER_COMPD_MIN[2]);
-    const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
-                       dsolve::SOLVER_COMPD_MAX[2]);
-
-    sz[0] = blkList[blk].getAllocationSzX();
-    sz[1] = blkList[blk].getAllocationSzY();
-    sz[2] = blkList[blk].getAllocationSzZ();
-
+/**
+ * @brief applies enforce_system_constraints to the interior of a padded
+ * block (the whole block if it is not at the boundary, the padding of
+ * boundary blocks is not filled).
+ */
+static void enforce_system_constraints_blk(DendroScalar *in,
+                                           const ot::Block &block) {
+    const unsigned int sz[3] = {block.getAllocationSzX(),
+                                block.getAllocationSzY(),
+                                block.getAllocationSzZ()};
     const unsigned int NN = sz[0] * sz[1] * sz[2];
+    const unsigned int pw = block.getBlkNodeFlag() ? block.get1DPadWidth() : 0;
 
-    for (unsigned int v = 0; v < dof; v++) {
-        unzipIn[v] = (DendroScalar *)(in + v * NN);
+    DendroScalar *unzipIn[SOLVER_NUM_VARS];
+    for (unsigned int v = 0; v < SOLVER_NUM_VARS; v++) {
+        unzipIn[v] = in + v * NN;
     }
 
-    bflag = blkList[blk].getBlkNodeFlag();
-    const unsigned int pw = blkList[blk].get1DPadWidth();
-
-    if (!bflag) {
-        for (unsigned int node = 0; node < NN; node++)
-            enforce_system_constraints(unzipIn, node);
-        // for(unsigned int k=pw; k < sz[2]-pw; k++)
-        // for(unsigned int j=pw; j < sz[1]-pw; j++)
-        // for(unsigned int i=pw; i < sz[0]-pw; i++)
-        // {
-        //     const unsigned nid = k*sz[1]*sz[0] + j*sz[0] + i;
-        //     enforce_system_constraints(unzipIn,nid);
-        // }
-    } else {
-        // note that we can apply enforce solver constraints in the right padd, at
-        // the left boundary block, currently we only apply internal parts of
-        // the boundary blocks.
-        for (unsigned int k = pw; k < sz[2] - pw; k++)
-            for (unsigned int j = pw; j < sz[1] - pw; j++)
-                for (unsigned int i = pw; i < sz[0] - pw; i++) {
-                    const unsigned nid = k * sz[1] * sz[0] + j * sz[0] + i;
-                    enforce_system_constraints(unzipIn, nid);
-                }
-    }
+    for (unsigned int k = pw; k < sz[2] - pw; k++)
+        for (unsigned int j = pw; j < sz[1] - pw; j++)
+            for (unsigned int i = pw; i < sz[0] - pw; i++) {
+                const unsigned nid = k * sz[1] * sz[0] + j * sz[0] + i;
+                enforce_system_constraints(unzipIn, nid);
+            }
+}
 
-    delete[] unzipIn;
+int SOLVERCtx::pre_stage_blk(DendroScalar *in, unsigned int dof,
+                             unsigned int local_blk_id,
+                             DendroScalar blk_time) const {
+    assert(dof == SOLVER_NUM_VARS);
+    if (dsolve::SOLVER_HAS_SYSTEM_CONSTRAINTS) {
+        enforce_system_constraints_blk(
+            in, m_uiMesh->getLocalBlockList()[local_blk_id]);
+    }
     return 0;
 }
 
 int SOLVERCtx::post_stage_blk(DendroScalar *in, unsigned int dof,
-                            unsigned int local_blk_id,
-                            DendroScalar blk_time) const {
+                              unsigned int local_blk_id,
+                              DendroScalar blk_time) const {
     return 0;
 }
 
 int SOLVERCtx::pre_timestep_blk(DendroScalar *in, unsigned int dof,
-                              unsigned int local_blk_id,
-                              DendroScalar blk_time) const {
+                                unsigned int local_blk_id,
+                                DendroScalar blk_time) const {
     return 0;
 }
 
 int SOLVERCtx::post_timestep_blk(DendroScalar *in, unsigned int dof,
-                               unsigned int local_blk_id,
-                               DendroScalar blk_time) const {
-    DendroScalar **unzipIn = new DendroScalar *[dof];
-    const unsigned int blk = local_blk_id;
-
-    const ot::Block *blkList = m_uiMesh->getLocalBlockList().data();
-    const unsigned int numBlocks = m_uiMesh->getLocalBlockList().size();
-    double ptmin[3], ptmax[3];
-    unsigned int sz[3];
-    unsigned int bflag;
-    double dx, dy, dz;
-    const Point pt_min(dsolve::SOLVER_COMPD_MIN[0], dsolve::SOLVER_COMPD_MIN[1],
-                       dsolve::SOLVER_COMPD_MIN[2]);
-    const Point pt_max(dsolve::SOLVER_COMPD_MAX[0], dsolve::SOLVER_COMPD_MAX[1],
-                       dsolve::SOLVER_COMPD_MAX[2]);
-
-    sz[0] = blkList[blk].getAllocationSzX();
-    sz[1] = blkList[blk].getAllocationSzY();
-    sz[2] = blkList[blk].getAllocationSzZ();
-
-    const unsigned int NN = sz[0] * sz[1] * sz[2];
-
-    for (unsigned int v = 0; v < dof; v++) {
-        unzipIn[v] = (DendroScalar *)(in + v * NN);
-    }
-
-    bflag = blkList[blk].getBlkNodeFlag();
-    const unsigned int pw = blkList[blk].get1DPadWidth();
-
-    if (!bflag) {
-        for (unsigned int node = 0; node < NN; node++)
-            enforce_system_constraints(unzipIn, node);
-        // for(unsigned int k=pw; k < sz[2]-pw; k++)
-        // for(unsigned int j=pw; j < sz[1]-pw; j++)
-        // for(unsigned int i=pw; i < sz[0]-pw; i++)
-        // {
-        //     const unsigned nid = k*sz[1]*sz[0] + j*sz[0] + i;
-        //     enforce_system_constraints(unzipIn,nid);
-        // }
-    } else {
-        // note that we can apply enforce solver constraints in the right padd, at
-        // the left boundary block, currently we only apply internal parts of
-        // the boundary blocks.
-        for (unsigned int k = pw; k < sz[2] - pw; k++)
-            for (unsigned int j = pw; j < sz[1] - pw; j++)
-                for (unsigned int i = pw; i < sz[0] - pw; i++) {
-                    const unsigned nid = k * sz[1] * sz[0] + j * sz[0] + i;
-                    enforce_system_constraints(unzipIn, nid);
-                }
+                                 unsigned int local_blk_id,
+                                 DendroScalar blk_time) const {
+    assert(dof == SOLVER_NUM_VARS);
+    if (dsolve::SOLVER_HAS_SYSTEM_CONSTRAINTS) {
+        enforce_system_constraints_blk(
+            in, m_uiMesh->getLocalBlockList()[local_blk_id]);
     }
-
-    delete[] unzipIn;
     return 0;
 }
 
-#endif
-
 int SOLVERCtx::initialize() {
+    m_uiEvUnzipSynced = false;
     if (dsolve::SOLVER_RESTORE_SOLVER) {
         this->restore_checkpt();
         return 0;
@@ -761,15 +784,8 @@ int SOLVERCtx::initialize() {
         else {
             if (dsolve::SOLVER_REFINEMENT_MODE ==
                 dsolve::RefinementMode::WAMR) {
-                // isRefine =
-                //     dsolve::isReMeshWAMR(m_uiMesh, (const double
-                //     **)unzipVar,
-                //                        refineVarIds,
-                //                        dsolve::SOLVER_NUM_REFINE_VARS,
-                //                        waveletTolFunc,
-                //                        dsolve::SOLVER_DENDRO_AMR_FAC);
-                isRefine = m_uiMesh->isReMeshUnzip(
-                    (const double **)unzipVar, refineVarIds,
+                isRefine = dsolve::isReMeshWAMR(
+                    m_uiMesh, (const double **)unzipVar, refineVarIds,
                     dsolve::SOLVER_NUM_REFINE_VARS, waveletTolFunc,
                     dsolve::SOLVER_DENDRO_AMR_FAC);
 
@@ -877,6 +893,7 @@ int SOLVERCtx::initialize() {
 }
 
 int SOLVERCtx::init_grid() {
+    m_uiEvUnzipSynced = false;
     DVec &m_evar = m_var[VL::CPU_EV];
     DVec &m_dptr_evar = m_var[VL::GPU_EV];
 
@@ -944,7 +961,10 @@ int SOLVERCtx::init_grid() {
     return 0;
 }
 
-int SOLVERCtx::finalize() { return 0; }
+int SOLVERCtx::finalize() {
+    m_uiCheckpointWriter.flush();
+    return 0;
+}
 
 int SOLVERCtx::write_vtu() {
     if (!m_uiMesh->isActive()) return 0;
@@ -1077,39 +1097,15 @@ int SOLVERCtx::write_checkpt() {
         : cpIndex = 1;  // to support alternate file writing.
 
     unsigned int rank = m_uiMesh->getMPIRank();
-    unsigned int npes = m_uiMesh->getMPICommSize();
 
     DendroScalar *eVar[SOLVER_NUM_VARS];
     DVec &m_evar = m_var[VL::CPU_EV];
     m_evar.to_2d(eVar);
 
-    char fName[256];
-    const ot::TreeNode *pNodes = &(*(m_uiMesh->getAllElements().begin() +
-                                     m_uiMesh->getElementLocalBegin()));
-    sprintf(fName, "%s_octree_%d_%d.oct",
-            dsolve::SOLVER_CHKPT_FILE_PREFIX.c_str(), cpIndex, rank);
-    io::checkpoint::writeOctToFile(fName, pNodes,
-                                   m_uiMesh->getNumLocalMeshElements());
-
     unsigned int numVars = dsolve::SOLVER_NUM_VARS;
-    const char **varNames = dsolve::SOLVER_VAR_NAMES;
-
-    sprintf(fName, "%s_%d_%d.var", dsolve::SOLVER_CHKPT_FILE_PREFIX.c_str(),
-            cpIndex, rank);
-    io::checkpoint::writeVecToFile(fName, m_uiMesh, (const double **)eVar,
-                                   dsolve::SOLVER_NUM_VARS);
 
+    std::string cpJson;
     if (!rank) {
-        sprintf(fName, "%s_step_%d.cp",
-                dsolve::SOLVER_CHKPT_FILE_PREFIX.c_str(), cpIndex);
-        std::cout << "[SOLVERCtx] \t writing checkpoint file : " << fName
-                  << std::endl;
-        std::ofstream outfile(fName);
-        if (!outfile) {
-            std::cout << fName << " file open failed " << std::endl;
-            return 0;
-        }
-
         json checkPoint;
         checkPoint["DENDRO_TS_TIME_BEGIN"] = m_uiTinfo._m_uiTb;
         checkPoint["DENDRO_TS_TIME_END"] = m_uiTinfo._m_uiTe;
@@ -1128,10 +1124,15 @@ int SOLVERCtx::write_checkpt() {
         checkPoint["DENDRO_TS_ACTIVE_COMM_SZ"] =
             m_uiMesh->getMPICommSize();  // (note that rank 0 is always active).
 
-        outfile << std::setw(4) << checkPoint << std::endl;
-        outfile.close();
+        cpJson = checkPoint.dump(4);
     }
 
+    // .oct/.var files are written from a snapshot of the evolution vars, the
+    // .cp file is committed once every rank finished them
+    m_uiCheckpointWriter.write(m_uiMesh, eVar, numVars, cpIndex,
+                               dsolve::SOLVER_CHKPT_FILE_PREFIX, cpJson,
+                               dsolve::SOLVER_CHKPT_ASYNC);
+
     return 0;
 }
 
@@ -1345,6 +1346,7 @@ int SOLVERCtx::restore_checkpt() {
                                       SOLVER_ASYNC_COMM_K);
     ot::alloc_mpi_ctx<DendroScalar>(newMesh, m_mpi_ctx, SOLVER_NUM_VARS,
                                     SOLVER_ASYNC_COMM_K);
+    m_uiGhostPlan.build(newMesh, SOLVER_NUM_VARS);
 
     // only reads the evolution variables.
     if (isActive) {
@@ -1392,21 +1394,79 @@ int SOLVERCtx::restore_checkpt() {
                   << " restored mesh size: " << totalElems << std::endl;
 
     m_uiIsETSSynced = false;
+    m_uiBlkSplitSynced = false;
+    m_uiEvUnzipSynced = false;
     return 0;
 }
 
 int SOLVERCtx::post_stage(DVec &sIn) { return 0; }
 
 int SOLVERCtx::post_timestep(DVec &sIn) {
+    // the step counter is incremented after this call
+    if (solverFilterDue(m_uiTinfo._m_uiStep + 1)) this->filter(sIn);
+
     // we need to enforce constraint before computing the HAM and MOM_i
     // constraints.
+    if (dsolve::SOLVER_HAS_SYSTEM_CONSTRAINTS) {
+        DendroScalar *evar[SOLVER_NUM_VARS];
+        sIn.to_2d(evar);
+        for (unsigned int node = m_uiMesh->getNodeLocalBegin();
+             node < m_uiMesh->getNodeLocalEnd(); node++)
+            enforce_system_constraints(evar, node);
+    }
+
+    if (dsolve::SOLVER_HEALTH_CHECK_FREQ != 0 &&
+        ((m_uiTinfo._m_uiStep + 1) % dsolve::SOLVER_HEALTH_CHECK_FREQ) == 0) {
+        this->check_health(sIn);
+    }
+
+    return 0;
+}
+
+void SOLVERCtx::filter(DVec &sIn) {
+    m_uiEvUnzipSynced = false;
+    this->unzip(sIn, m_var[VL::CPU_EV_UZ_IN], dsolve::SOLVER_ASYNC_COMM_K);
+
+    dsolve::timer::start_master(dsolve::timer::t_deriv);
+    DendroScalar *unzipIn[SOLVER_NUM_VARS];
+    m_var[CPU_EV_UZ_IN].to_2d(unzipIn);
+
+    const ot::Block *blkList = m_uiMesh->getLocalBlockList().data();
+    const unsigned int numBlocks = m_uiMesh->getLocalBlockList().size();
+
+    solverFilter(unzipIn, blkList, numBlocks);
+    dsolve::timer::stop_master(dsolve::timer::t_deriv);
+
+    this->zip(m_var[CPU_EV_UZ_IN], sIn);
+}
+
+void SOLVERCtx::check_health(DVec &sIn) {
     DendroScalar *evar[SOLVER_NUM_VARS];
     sIn.to_2d(evar);
-    for (unsigned int node = m_uiMesh->getNodeLocalBegin();
-         node < m_uiMesh->getNodeLocalEnd(); node++)
-        enforce_system_constraints(evar, node);
 
-    return 0;
+    int localBad = dsolve::local_state_finite(m_uiMesh, evar, SOLVER_NUM_VARS)
+                       ? 0
+                       : 1;
+    int globalBad = 0;
+    par::Mpi_Allreduce(&localBad, &globalBad, 1, MPI_MAX,
+                       m_uiMesh->getMPIGlobalCommunicator());
+    if (!globalBad) return;
+
+    // failure path only, find and write out the blocks
+    const unsigned int step = m_uiTinfo._m_uiStep + 1;
+    this->unzip(sIn, m_var[VL::CPU_EV_UZ_IN], dsolve::SOLVER_ASYNC_COMM_K);
+    if (localBad) {
+        DendroScalar *unzipIn[SOLVER_NUM_VARS];
+        m_var[CPU_EV_UZ_IN].to_2d(unzipIn);
+        dsolve::dump_unhealthy_blocks(m_uiMesh, unzipIn, SOLVER_NUM_VARS,
+                                      SOLVER_VAR_NAMES, step, m_uiTinfo._m_uiT,
+                                      dsolve::SOLVER_VTU_FILE_PREFIX);
+    }
+
+    // let a checkpoint in flight finish, it is the last good state
+    m_uiCheckpointWriter.flush();
+    dsolve::abort_unhealthy_run(m_uiMesh->getMPIGlobalCommunicator(), step,
+                                m_uiTinfo._m_uiT);
 }
 
 int SOLVERCtx::pre_timestep(DVec &sIn) { return 0; }
@@ -1419,10 +1479,10 @@ bool SOLVERCtx::is_remesh() {
 
     MPI_Comm comm = m_uiMesh->getMPIGlobalCommunicator();
 
-    DVec &m_evar = m_var[VL::CPU_EV];
     DVec &m_evar_unz = m_var[VL::CPU_EV_UZ_IN];
 
-    this->unzip(m_evar, m_evar_unz, dsolve::SOLVER_ASYNC_COMM_K);
+    // the first stage of the next step picks this unzip up again
+    this->unzip_evolution_vars();
 
     DendroScalar *unzipVar[SOLVER_NUM_VARS];
     m_evar_unz.to_2d(unzipVar);
@@ -1439,14 +1499,8 @@ bool SOLVERCtx::is_remesh() {
         };
 
     if (dsolve::SOLVER_REFINEMENT_MODE == dsolve::RefinementMode::WAMR) {
-        // isRefine =
-        //     dsolve::isReMeshWAMR(m_uiMesh, (const double **)unzipVar,
-        //                        refineVarIds,
-        //                        dsolve::SOLVER_NUM_REFINE_VARS,
-        //                        waveletTolFunc,
-        //                        dsolve::SOLVER_DENDRO_AMR_FAC);
-        isRefine = m_uiMesh->isReMeshUnzip(
-            (const double **)unzipVar, refineVarIds,
+        isRefine = dsolve::isReMeshWAMR(
+            m_uiMesh, (const double **)unzipVar, refineVarIds,
             dsolve::SOLVER_NUM_REFINE_VARS, waveletTolFunc,
             dsolve::SOLVER_DENDRO_AMR_FAC);
     } else if (dsolve::SOLVER_REFINEMENT_MODE ==
@@ -1576,6 +1630,9 @@ int SOLVERCtx::grid_transfer(const ot::Mesh *m_new) {
 #ifdef __PROFILE_CTX__
     m_uiCtxpt[ts::CTXPROFILE::GRID_TRASFER].start();
 #endif
+    // a checkpoint in flight still refers to the old mesh
+    m_uiCheckpointWriter.flush();
+
     DVec &m_evar = m_var[VL::CPU_EV];
     DVec::grid_transfer(m_uiMesh, m_new, m_evar);
     // printf("igt ended\n");
@@ -1626,8 +1683,11 @@ int SOLVERCtx::grid_transfer(const ot::Mesh *m_new) {
                                       SOLVER_ASYNC_COMM_K);
     ot::alloc_mpi_ctx<DendroScalar>(m_new, m_mpi_ctx, SOLVER_NUM_VARS,
                                     SOLVER_ASYNC_COMM_K);
+    m_uiGhostPlan.build(m_new, SOLVER_NUM_VARS);
 
     m_uiIsETSSynced = false;
+    m_uiBlkSplitSynced = false;
+    m_uiEvUnzipSynced = false;
 
 #ifdef __PROFILE_CTX__
     m_uiCtxpt[ts::CTXPROFILE::GRID_TRASFER].stop();
@@ -0,0 +1,25 @@
+#include "sources.h"
+
+#include <algorithm>
+
+namespace dsolve {
+
+static SourceFunction source_function = zero_sources;
+
+void zero_sources(double *const rho_e, double *const J0, double *const J1,
+                  double *const J2, const double *pmin, const double *pmax,
+                  const unsigned int *sz) {
+    const unsigned int n = sz[0] * sz[1] * sz[2];
+    std::fill_n(rho_e, n, 0.0);
+    std::fill_n(J0, n, 0.0);
+    std::fill_n(J1, n, 0.0);
+    std::fill_n(J2, n, 0.0);
+}
+
+void set_source_function(SourceFunction f) {
+    source_function = (f != nullptr) ? f : zero_sources;
+}
+
+SourceFunction get_source_function() { return source_function; }
+
+}  // namespace dsolve